@@ -64,6 +64,16 @@ bool ILoadingProcessInterface::ShouldShowLoadingScreen(UObject* TestObject, FStr
 	return false;
 }
 
+void ILoadingProcessInterface::NotifyLoadingScreenStateChanged(UObject* Processor)
+{
+	UWorld* World = Processor ? Processor->GetWorld() : nullptr;
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (ULoadingScreenManager* LoadingScreenManager = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenManager>() : nullptr)
+	{
+		LoadingScreenManager->MarkLoadingProcessorsDirty();
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 
 namespace LoadingScreenCVars
@@ -89,6 +99,20 @@ namespace LoadingScreenCVars
 		ForceLoadingScreenVisible,
 		TEXT("Force the loading screen to show."),
 		ECVF_Default);
+
+	static bool CacheLoadingProcessorResult = true;
+	static FAutoConsoleVariableRef CVarCacheLoadingProcessorResult(
+		TEXT("CommonLoadingScreen.CacheLoadingProcessorResult"),
+		CacheLoadingProcessorResult,
+		TEXT("When true, the game state, player controllers, their components and external loading processors are only queried when something changed, instead of every frame."),
+		ECVF_Default);
+
+	static float LoadingProcessorRescanIntervalSecs = 0.5f;
+	static FAutoConsoleVariableRef CVarLoadingProcessorRescanIntervalSecs(
+		TEXT("CommonLoadingScreen.LoadingProcessorRescanIntervalSecs"),
+		LoadingProcessorRescanIntervalSecs,
+		TEXT("Safety net for loading processors that don't call NotifyLoadingScreenStateChanged: how often (in seconds) to query them even if nothing reported a change. 0 disables the periodic query."),
+		ECVF_Default);
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -191,11 +215,18 @@ UWorld* ULoadingScreenManager::GetTickableGameObjectWorld() const
 void ULoadingScreenManager::RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Add(Interface.GetObject());
+	MarkLoadingProcessorsDirty();
 }
 
 void ULoadingScreenManager::UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Remove(Interface.GetObject());
+	MarkLoadingProcessorsDirty();
+}
+
+void ULoadingScreenManager::MarkLoadingProcessorsDirty()
+{
+	bLoadingProcessorsDirty = true;
 }
 
 void ULoadingScreenManager::HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
@@ -203,6 +234,7 @@ void ULoadingScreenManager::HandlePreLoadMap(const FWorldContext& WorldContext,
 	if (WorldContext.OwningGameInstance == GetGameInstance())
 	{
 		bCurrentlyInLoadMap = true;
+		MarkLoadingProcessorsDirty();
 
 		// Update the loading screen immediately if the engine is initialized
 		if (GEngine->IsInitialized())
@@ -217,6 +249,7 @@ void ULoadingScreenManager::HandlePostLoadMap(UWorld* World)
 	if ((World != nullptr) && (World->GetGameInstance() == GetGameInstance()))
 	{
 		bCurrentlyInLoadMap = false;
+		MarkLoadingProcessorsDirty();
 	}
 }
 
@@ -322,8 +355,76 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 		return true;
 	}
 
+	if (ShouldRescanLoadingProcessors(LocalGameInstance, GameState))
+	{
+		bCachedLoadingProcessorsNeedLoadingScreen = ScanLoadingProcessorsForNeedToShowLoadingScreen(LocalGameInstance, GameState, /*out*/ CachedLoadingProcessorsReason);
+	}
+
+	DebugReasonForShowingOrHidingLoadingScreen = CachedLoadingProcessorsReason;
+	return bCachedLoadingProcessorsNeedLoadingScreen;
+}
+
+bool ULoadingScreenManager::ShouldRescanLoadingProcessors(const UGameInstance* LocalGameInstance, AGameStateBase* GameState)
+{
+	if (!LoadingScreenCVars::CacheLoadingProcessorResult || bLoadingProcessorsDirty)
+	{
+		return true;
+	}
+
+	// 需要显示的时候每帧都查，保证隐藏的时机和之前一致；加载期间的开销无所谓，省的是游戏中每帧的遍历
+	if (bCachedLoadingProcessorsNeedLoadingScreen)
+	{
+		return true;
+	}
+
+	// GameState、PC 换了或者组件增减了，都可能带来新的 LoadingProcessor
+	if ((LastScannedGameState != GameState) || (GameState->GetComponents().Num() != LastScannedGameStateComponentCount))
+	{
+		return true;
+	}
+
+	const TArray<ULocalPlayer*>& LocalPlayers = LocalGameInstance->GetLocalPlayers();
+	if (LocalPlayers.Num() != LastScannedPlayerControllers.Num())
+	{
+		return true;
+	}
+
+	for (int32 PlayerIndex = 0; PlayerIndex < LocalPlayers.Num(); ++PlayerIndex)
+	{
+		const ULocalPlayer* LP = LocalPlayers[PlayerIndex];
+		APlayerController* PC = LP ? LP->PlayerController.Get() : nullptr;
+		const TPair<TWeakObjectPtr<APlayerController>, int32>& LastScanned = LastScannedPlayerControllers[PlayerIndex];
+		if ((LastScanned.Key != PC) || (LastScanned.Value != (PC ? PC->GetComponents().Num() : INDEX_NONE)))
+		{
+			return true;
+		}
+	}
+
+	// 兜底：没有主动通知的 LoadingProcessor 也能在一定时间内被发现
+	const double RescanInterval = LoadingScreenCVars::LoadingProcessorRescanIntervalSecs;
+	return (RescanInterval > 0.0) && ((FPlatformTime::Seconds() - TimeOfLastLoadingProcessorScan) >= RescanInterval);
+}
+
+bool ULoadingScreenManager::ScanLoadingProcessorsForNeedToShowLoadingScreen(const UGameInstance* LocalGameInstance, AGameStateBase* GameState, FString& OutReason)
+{
+	++NumLoadingProcessorScans;
+	bLoadingProcessorsDirty = false;
+	TimeOfLastLoadingProcessorScan = FPlatformTime::Seconds();
+
+	// 记录这次看到的对象，之后有变化就重新查
+	LastScannedGameState = GameState;
+	LastScannedGameStateComponentCount = GameState->GetComponents().Num();
+	LastScannedPlayerControllers.Reset();
+	for (ULocalPlayer* LP : LocalGameInstance->GetLocalPlayers())
+	{
+		APlayerController* PC = LP ? LP->PlayerController.Get() : nullptr;
+		LastScannedPlayerControllers.Emplace(PC, PC ? PC->GetComponents().Num() : INDEX_NONE);
+	}
+
+	OutReason = TEXT("Reason for Showing/Hiding LoadingScreen is unknown!");
+
 	// Ask the game state if it needs a loading screen	
-	if (ILoadingProcessInterface::ShouldShowLoadingScreen(GameState, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+	if (ILoadingProcessInterface::ShouldShowLoadingScreen(GameState, /*out*/ OutReason))
 	{
 		return true;
 	}
@@ -331,7 +432,7 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	// Ask any game state components if they need a loading screen
 	for (UActorComponent* TestComponent : GameState->GetComponents())
 	{
-		if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+		if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ OutReason))
 		{
 			return true;
 		}
@@ -342,7 +443,7 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	// streaming in.
 	for (const TWeakInterfacePtr<ILoadingProcessInterface>& Processor : ExternalLoadingProcessors)
 	{
-		if (ILoadingProcessInterface::ShouldShowLoadingScreen(Processor.GetObject(), /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+		if (ILoadingProcessInterface::ShouldShowLoadingScreen(Processor.GetObject(), /*out*/ OutReason))
 		{
 			return true;
 		}
@@ -361,7 +462,7 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 				bFoundAnyLocalPC = true;
 
 				// Ask the PC itself if it needs a loading screen
-				if (ILoadingProcessInterface::ShouldShowLoadingScreen(PC, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+				if (ILoadingProcessInterface::ShouldShowLoadingScreen(PC, /*out*/ OutReason))
 				{
 					return true;
 				}
@@ -369,7 +470,7 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 				// Ask any PC components if they need a loading screen
 				for (UActorComponent* TestComponent : PC->GetComponents())
 				{
-					if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+					if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ OutReason))
 					{
 						return true;
 					}
@@ -383,24 +484,24 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	}
 
 	UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient();
-	const bool bIsInSplitscreen = GameViewportClient->GetCurrentSplitscreenConfiguration() != ESplitScreenType::None;
+	const bool bIsInSplitscreen = (GameViewportClient != nullptr) && (GameViewportClient->GetCurrentSplitscreenConfiguration() != ESplitScreenType::None);
 
 	// In splitscreen we need all player controllers to be present
 	if (bIsInSplitscreen && bMissingAnyLocalPC)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("At least one missing local player controller in splitscreen"));
+		OutReason = FString(TEXT("At least one missing local player controller in splitscreen"));
 		return true;
 	}
 
 	// And in non-splitscreen we need at least one player controller to be present
 	if (!bIsInSplitscreen && !bFoundAnyLocalPC)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("Need at least one local player controller"));
+		OutReason = FString(TEXT("Need at least one local player controller"));
 		return true;
 	}
 
 	// Victory! The loading screen can go away now
-	DebugReasonForShowingOrHidingLoadingScreen = TEXT("(nothing wants to show it anymore)");
+	OutReason = TEXT("(nothing wants to show it anymore)");
 	return false;
 }
 
@@ -0,0 +1,192 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LoadingScreenManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "LoadingProcessTask.h"
+#include "Misc/AutomationTest.h"
+
+struct FLoadingScreenManagerTestAccess
+{
+	static bool CheckForAnyNeedToShowLoadingScreen(ULoadingScreenManager& LoadingScreenManager)
+	{
+		return LoadingScreenManager.CheckForAnyNeedToShowLoadingScreen();
+	}
+};
+
+namespace LoadingScreenManagerTests
+{
+	struct FScopedConsoleVariable
+	{
+		FScopedConsoleVariable(const TCHAR* Name, const TCHAR* Value)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (CVar)
+			{
+				PreviousValue = CVar->GetString();
+				CVar->Set(Value, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedConsoleVariable()
+		{
+			if (CVar)
+			{
+				CVar->Set(*PreviousValue, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* CVar = nullptr;
+		FString PreviousValue;
+	};
+
+	/** 独立的游戏实例和世界，没有视口，用 -nullrhi 跑 */
+	struct FScopedStandaloneGameInstance
+	{
+		FScopedStandaloneGameInstance()
+		{
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone(TEXT("LoadingScreenTestWorld"));
+		}
+
+		~FScopedStandaloneGameInstance()
+		{
+			UWorld* World = GameInstance->GetWorld();
+			GameInstance->Shutdown();
+			if (World)
+			{
+				GEngine->DestroyWorldContext(World);
+				World->DestroyWorld(/*bInformEngineOfWorld=*/ false);
+			}
+			GameInstance->RemoveFromRoot();
+		}
+
+		UGameInstance* GameInstance = nullptr;
+	};
+
+	/**
+	 * 先按缓存的方式判断一帧并记下查询 LoadingProcessor 的次数，再关掉缓存按原来每帧都查的方式判断一次，两者的结论和原因要一致
+	 * 返回这一帧缓存方式查询了几次
+	 */
+	uint64 CheckFrame(FAutomationTestBase& Test, ULoadingScreenManager& LoadingScreenManager, const TCHAR* What, bool bExpectedShow)
+	{
+		const uint64 ScansBefore = LoadingScreenManager.GetNumLoadingProcessorScans();
+		const bool bCachedShow = FLoadingScreenManagerTestAccess::CheckForAnyNeedToShowLoadingScreen(LoadingScreenManager);
+		const FString CachedReason = LoadingScreenManager.GetDebugReasonForShowingOrHidingLoadingScreen();
+		const uint64 NumScans = LoadingScreenManager.GetNumLoadingProcessorScans() - ScansBefore;
+
+		bool bUncachedShow = false;
+		FString UncachedReason;
+		{
+			const FScopedConsoleVariable DisableCache(TEXT("CommonLoadingScreen.CacheLoadingProcessorResult"), TEXT("0"));
+			bUncachedShow = FLoadingScreenManagerTestAccess::CheckForAnyNeedToShowLoadingScreen(LoadingScreenManager);
+			UncachedReason = LoadingScreenManager.GetDebugReasonForShowingOrHidingLoadingScreen();
+		}
+
+		Test.TestTrue(FString::Printf(TEXT("%s: cached decision"), What), bCachedShow == bExpectedShow);
+		Test.TestTrue(FString::Printf(TEXT("%s: cached decision matches the per-frame scan"), What), bCachedShow == bUncachedShow);
+		Test.TestEqual(FString::Printf(TEXT("%s: cached reason matches the per-frame scan"), What), CachedReason, UncachedReason);
+
+		return NumScans;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoadingScreenManagerCachedScanTest, "CommonLoadingScreen.LoadingScreenManager.CachedProcessorScan", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLoadingScreenManagerCachedScanTest::RunTest(const FString& Parameters)
+{
+	using namespace LoadingScreenManagerTests;
+
+	const FScopedConsoleVariable EnableCache(TEXT("CommonLoadingScreen.CacheLoadingProcessorResult"), TEXT("1"));
+	// 关掉定时兜底，查询次数只取决于状态变化
+	FScopedConsoleVariable RescanInterval(TEXT("CommonLoadingScreen.LoadingProcessorRescanIntervalSecs"), TEXT("0"));
+
+	const FScopedStandaloneGameInstance ScopedGameInstance;
+	UGameInstance* GameInstance = ScopedGameInstance.GameInstance;
+	UWorld* World = GameInstance->GetWorld();
+
+	ULoadingScreenManager* LoadingScreenManager = GameInstance->GetSubsystem<ULoadingScreenManager>();
+	if (!TestNotNull(TEXT("LoadingScreenManager"), LoadingScreenManager) || !TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+
+	// 引擎层面的检查在查询 LoadingProcessor 之前就返回
+	TestEqual(TEXT("No game state: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("No game state"), true), 0ull);
+
+	AGameStateBase* GameState = World->SpawnActor<AGameStateBase>();
+	World->SetGameState(GameState);
+	TestEqual(TEXT("Not begun play: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("Not begun play"), true), 0ull);
+
+	World->GetWorldSettings()->NotifyBeginPlay();
+	TestTrue(TEXT("World has begun play"), World->HasBegunPlay());
+
+	// 还需要显示的时候每帧都查
+	TestEqual(TEXT("No local player controller: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("No local player controller"), true), 1ull);
+	TestEqual(TEXT("No local player controller, next frame: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("No local player controller, next frame"), true), 1ull);
+
+	FString Error;
+	ULocalPlayer* LocalPlayer = GameInstance->CreateLocalPlayer(0, Error, /*bSpawnPlayerController=*/ false);
+	if (!TestNotNull(FString::Printf(TEXT("Local player (%s)"), *Error), LocalPlayer))
+	{
+		return false;
+	}
+
+	APlayerController* PlayerController = World->SpawnActor<APlayerController>();
+	LocalPlayer->PlayerController = PlayerController;
+	TestEqual(TEXT("Player controller ready: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("Player controller ready"), false), 1ull);
+
+	// 没有任何变化的帧不再查询
+	uint64 SteadyScans = 0;
+	for (int32 FrameIndex = 0; FrameIndex < 100; ++FrameIndex)
+	{
+		SteadyScans += CheckFrame(*this, *LoadingScreenManager, TEXT("Steady state"), false);
+	}
+	TestEqual(TEXT("Steady state: scans over 100 frames"), SteadyScans, 0ull);
+
+	// 注册、改原因、注销都会通知
+	ULoadingProcessTask* Task = ULoadingProcessTask::CreateLoadingScreenProcessTask(World, TEXT("Loading screen test task"));
+	if (!TestNotNull(TEXT("Loading process task"), Task))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Task registered: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("Task registered"), true), 1ull);
+	TestEqual(TEXT("Task registered: reason"), LoadingScreenManager->GetDebugReasonForShowingOrHidingLoadingScreen(), FString(TEXT("Loading screen test task")));
+
+	Task->SetShowLoadingScreenReason(TEXT("Loading screen test task, second step"));
+	TestEqual(TEXT("Task reason changed: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("Task reason changed"), true), 1ull);
+	TestEqual(TEXT("Task reason changed: reason"), LoadingScreenManager->GetDebugReasonForShowingOrHidingLoadingScreen(), FString(TEXT("Loading screen test task, second step")));
+
+	Task->Unregister();
+	TestEqual(TEXT("Task unregistered: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("Task unregistered"), false), 1ull);
+	TestEqual(TEXT("Task unregistered, next frame: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("Task unregistered, next frame"), false), 0ull);
+
+	// GameState 上新增的组件可能是新的 LoadingProcessor
+	USceneComponent* NewComponent = NewObject<USceneComponent>(GameState);
+	NewComponent->RegisterComponent();
+	TestEqual(TEXT("Game state component added: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("Game state component added"), false), 1ull);
+	TestEqual(TEXT("Game state component added, next frame: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("Game state component added, next frame"), false), 0ull);
+
+	// 兜底：没有任何通知，过了间隔也会重新查询
+	RescanInterval.CVar->Set(TEXT("0.001"), ECVF_SetByCode);
+	FPlatformProcess::Sleep(0.01f);
+	TestEqual(TEXT("Rescan interval elapsed: scans"), CheckFrame(*this, *LoadingScreenManager, TEXT("Rescan interval elapsed"), false), 1ull);
+
+	LocalPlayer->PlayerController = nullptr;
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -25,6 +25,10 @@ public:
 	// be currently showing a loading screen
 	static UE_API bool ShouldShowLoadingScreen(UObject* TestObject, FString& OutReason);
 
+	// Lets the loading screen manager of the object's game instance know that the answer of ShouldShowLoadingScreen
+	// may have changed, so it re-queries the loading processors on its next update instead of waiting for the periodic scan
+	static UE_API void NotifyLoadingScreenStateChanged(UObject* Processor);
+
 	virtual bool ShouldShowLoadingScreen(FString& OutReason) const
 	{
 		return false;
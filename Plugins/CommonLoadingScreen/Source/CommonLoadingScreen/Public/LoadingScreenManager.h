@@ -12,10 +12,13 @@
 
 template <typename InterfaceType> class TScriptInterface;
 
+class AGameStateBase;
+class APlayerController;
 class FSubsystemCollectionBase;
 class IInputProcessor;
 class ILoadingProcessInterface;
 class SWidget;
+class UGameInstance;
 class UObject;
 class UWorld;
 struct FFrame;
@@ -62,6 +65,15 @@ public:
 
 	UE_API void RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
 	UE_API void UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
+
+	/** Marks the cached loading processor result as stale, the processors will be queried again on the next update */
+	UE_API void MarkLoadingProcessorsDirty();
+
+	/** Returns how many times the loading processors have been queried, for profiling */
+	uint64 GetNumLoadingProcessorScans() const
+	{
+		return NumLoadingProcessorScans;
+	}
 	
 private:
 	UE_API void HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName);
@@ -73,6 +85,12 @@ private:
 	/** Returns true if we need to be showing the loading screen. */
 	UE_API bool CheckForAnyNeedToShowLoadingScreen();
 
+	/** Asks the game state, player controllers (and their components) and external processors if they need the loading screen. */
+	UE_API bool ScanLoadingProcessorsForNeedToShowLoadingScreen(const UGameInstance* LocalGameInstance, AGameStateBase* GameState, FString& OutReason);
+
+	/** Returns true if the cached loading processor result can't be trusted anymore. */
+	UE_API bool ShouldRescanLoadingProcessors(const UGameInstance* LocalGameInstance, AGameStateBase* GameState);
+
 	/** Returns true if we want to be showing the loading screen (if we need to or are artificially forcing it on for other reasons). */
 	UE_API bool ShouldShowLoadingScreen();
 
@@ -126,6 +144,28 @@ private:
 
 	/** True when the loading screen is currently being shown */
 	bool bCurrentlyShowingLoadingScreen = false;
+
+	/** True when a loading processor reported a change since the last scan */
+	bool bLoadingProcessorsDirty = true;
+
+	/** Result of the last loading processor scan */
+	bool bCachedLoadingProcessorsNeedLoadingScreen = true;
+
+	/** Reason of the last loading processor scan */
+	FString CachedLoadingProcessorsReason;
+
+	/** The time of the last loading processor scan */
+	double TimeOfLastLoadingProcessorScan = -1.0;
+
+	/** The objects and component counts seen by the last scan, if any of them change we scan again */
+	TWeakObjectPtr<AGameStateBase> LastScannedGameState;
+	int32 LastScannedGameStateComponentCount = INDEX_NONE;
+	TArray<TPair<TWeakObjectPtr<APlayerController>, int32>> LastScannedPlayerControllers;
+
+	/** Number of loading processor scans */
+	uint64 NumLoadingProcessorScans = 0;
+
+	friend struct FLoadingScreenManagerTestAccess;
 };
 
 #undef UE_API
@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DataSource/GameSettingDataSourceDynamic.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "GameSettingsTestTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+namespace GameSettingDataSourceDynamicTests
+{
+	constexpr int32 NumBenchmarkIterations = 10000;
+
+	struct FScopedFastPath
+	{
+		explicit FScopedFastPath(bool bUseFastPath)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(TEXT("GameSettings.DynamicDataSource.UseFastPath")))
+		{
+			if (CVar)
+			{
+				bPrevious = CVar->GetBool();
+				CVar->Set(bUseFastPath, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedFastPath()
+		{
+			if (CVar)
+			{
+				CVar->Set(bPrevious, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* CVar = nullptr;
+		bool bPrevious = true;
+	};
+
+	struct FValueCase
+	{
+		const TCHAR* Name;
+		FString GetterName;
+		FString SetterName;
+		TFunction<double(const UGameSettingTestValues&)> ReadField;
+		TArray<double> Values;
+
+		/** What the field should hold after writing the value through SetValueFromDouble. */
+		TFunction<double(double)> ExpectedValue;
+
+		/** Enums can't be imported from a number string and huge uint64 values don't survive the float text, those are only checked on the typed path. */
+		bool bCompareWithStringPath = true;
+	};
+
+	double Truncate(double Value)
+	{
+		return static_cast<double>(FMath::TruncToInt64(Value));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameSettingDataSourceDynamicTypedValueTest, "GameSettings.DataSourceDynamic.TypedValues", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGameSettingDataSourceDynamicTypedValueTest::RunTest(const FString& Parameters)
+{
+	using namespace GameSettingDataSourceDynamicTests;
+
+	UGameSettingTestLocalPlayer* LocalPlayer = NewObject<UGameSettingTestLocalPlayer>(GEngine);
+	LocalPlayer->TestValues = NewObject<UGameSettingTestValues>(LocalPlayer);
+	UGameSettingTestValues& TestValues = *LocalPlayer->TestValues;
+
+	const FValueCase ValueCases[] =
+	{
+		{ TEXT("int32"), TEXT("IntValue"), TEXT("IntValue"), [](const UGameSettingTestValues& Values) { return static_cast<double>(Values.IntValue); },
+			{ 0.0, 3.0, 2.2, 2.7, -2.7, -0.5, 99.999, 1000.0 }, &Truncate },
+		{ TEXT("uint8"), TEXT("ByteValue"), TEXT("ByteValue"), [](const UGameSettingTestValues& Values) { return static_cast<double>(Values.ByteValue); },
+			{ 0.0, 7.0, 7.9, 255.0 }, &Truncate },
+		{ TEXT("uint64"), TEXT("UInt64Value"), TEXT("UInt64Value"), [](const UGameSettingTestValues& Values) { return static_cast<double>(Values.UInt64Value); },
+			{ 0.0, 7.9, 4294967296.0, 18000000000000000000.0 }, [](double Value) { return static_cast<double>(static_cast<uint64>(Value)); }, /*bCompareWithStringPath=*/ false },
+		{ TEXT("int32 through getter and setter"), TEXT("GetIntThroughFunction"), TEXT("SetIntThroughFunction"), [](const UGameSettingTestValues& Values) { return static_cast<double>(Values.IntThroughFunction); },
+			{ 5.0, 2.7, -2.7 }, &Truncate },
+		{ TEXT("float"), TEXT("FloatValue"), TEXT("FloatValue"), [](const UGameSettingTestValues& Values) { return static_cast<double>(Values.FloatValue); },
+			{ 0.0, 0.25, 0.1, -1.5, 1234.5 }, [](double Value) { return static_cast<double>(static_cast<float>(Value)); } },
+		{ TEXT("double"), TEXT("DoubleValue"), TEXT("DoubleValue"), [](const UGameSettingTestValues& Values) { return Values.DoubleValue; },
+			{ 0.0, 0.25, 0.1, -7.125 }, [](double Value) { return Value; } },
+		{ TEXT("bool"), TEXT("bBoolValue"), TEXT("bBoolValue"), [](const UGameSettingTestValues& Values) { return Values.bBoolValue ? 1.0 : 0.0; },
+			{ 0.0, 1.0, 0.5, 1.5 }, [](double Value) { return Truncate(Value) != 0.0 ? 1.0 : 0.0; } },
+		{ TEXT("enum"), TEXT("EnumValue"), TEXT("EnumValue"), [](const UGameSettingTestValues& Values) { return static_cast<double>(Values.EnumValue); },
+			{ 0.0, 1.0, 2.0, 1.6 }, &Truncate, /*bCompareWithStringPath=*/ false },
+	};
+
+	for (const FValueCase& ValueCase : ValueCases)
+	{
+		FGameSettingDataSourceDynamic Getter({ TEXT("GetTestValues"), ValueCase.GetterName });
+		FGameSettingDataSourceDynamic Setter({ TEXT("GetTestValues"), ValueCase.SetterName });
+		if (!TestTrue(FString::Printf(TEXT("%s: getter resolves"), ValueCase.Name), Getter.Resolve(LocalPlayer)) ||
+			!TestTrue(FString::Printf(TEXT("%s: setter resolves"), ValueCase.Name), Setter.Resolve(LocalPlayer)))
+		{
+			continue;
+		}
+
+		for (const double Value : ValueCase.Values)
+		{
+			const FString What = FString::Printf(TEXT("%s <- %s"), ValueCase.Name, *LexToString(Value));
+
+			// Typed write and read back
+			TestValues.IntValue = 0;
+			TestValues.ByteValue = 0;
+			TestValues.UInt64Value = 0;
+			TestValues.FloatValue = 0.0f;
+			TestValues.DoubleValue = 0.0;
+			TestValues.bBoolValue = false;
+			TestValues.EnumValue = EGameSettingTestEnum::First;
+			TestValues.IntThroughFunction = 0;
+
+			TestTrue(What + TEXT(": typed write"), Setter.SetValueFromDouble(LocalPlayer, Value));
+			const double TypedField = ValueCase.ReadField(TestValues);
+			TestEqual(What + TEXT(": typed write result"), TypedField, ValueCase.ExpectedValue(Value));
+
+			double TypedRead = 0.0;
+			TestTrue(What + TEXT(": typed read"), Getter.GetValueAsDouble(LocalPlayer, TypedRead));
+			TestEqual(What + TEXT(": typed read round trip"), TypedRead, TypedField);
+
+			const FString TypedString = Getter.GetValueAsString(LocalPlayer);
+
+			if (!ValueCase.bCompareWithStringPath)
+			{
+				continue;
+			}
+
+			// The same write through the original string path, the way UGameSettingValueScalarDynamic did it
+			const FScopedFastPath DisableFastPath(false);
+			Setter.SetValue(LocalPlayer, LexToString(Value));
+			TestEqual(What + TEXT(": typed write matches the string path"), TypedField, ValueCase.ReadField(TestValues));
+			TestEqual(What + TEXT(": string read matches"), Getter.GetValueAsString(LocalPlayer), TypedString);
+		}
+	}
+
+	// Scalar sliders read the value on every drag update, compare the two paths for a float setting
+	{
+		FGameSettingDataSourceDynamic Getter({ TEXT("GetTestValues"), TEXT("FloatValue") });
+		Getter.Resolve(LocalPlayer);
+		TestValues.FloatValue = 0.75f;
+
+		double Sum = 0.0;
+		const double TypedStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumBenchmarkIterations; ++Iteration)
+		{
+			double Value = 0.0;
+			Getter.GetValueAsDouble(LocalPlayer, Value);
+			Sum += Value;
+		}
+		const double TypedSeconds = FPlatformTime::Seconds() - TypedStartTime;
+
+		const FScopedFastPath DisableFastPath(false);
+		const double StringStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumBenchmarkIterations; ++Iteration)
+		{
+			double Value = 0.0;
+			LexFromString(Value, *Getter.GetValueAsString(LocalPlayer));
+			Sum -= Value;
+		}
+		const double StringSeconds = FPlatformTime::Seconds() - StringStartTime;
+
+		TestEqual(TEXT("Both paths read the same values"), Sum, 0.0);
+		AddInfo(FString::Printf(TEXT("%d reads: typed %.3f ms, string path %.3f ms"), NumBenchmarkIterations, TypedSeconds * 1000.0, StringSeconds * 1000.0));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,208 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameSettingRegistry.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GameSettingCollection.h"
+#include "GameSettingFilterState.h"
+#include "GameSettingsTestTypes.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+namespace GameSettingRegistryTests
+{
+	constexpr int32 NumTopLevelCollections = 20;
+	constexpr int32 NumSubCollections = 10;
+	constexpr int32 NumSettingsPerCollection = 15;
+	constexpr int32 NumIterations = 20;
+
+	const TCHAR* const DescriptionWords[] = { TEXT("Audio"), TEXT("Video"), TEXT("Controls"), TEXT("Gameplay"), TEXT("Accessibility") };
+
+	struct FSyntheticSettings
+	{
+		TArray<UGameSettingCollection*> TopLevelCollections;
+		TArray<UGameSettingCollection*> SubCollections;
+		TArray<UGameSetting*> AllSettings;
+	};
+
+	void InitSetting(UGameSetting* Setting, const FString& DevName, int32 WordIndex)
+	{
+		Setting->SetDevName(FName(*DevName));
+		Setting->SetDisplayName(FText::FromString(DevName));
+		Setting->SetDescriptionRichText(FText::FromString(FString::Printf(TEXT("%s setting <b>%s</>"), DescriptionWords[WordIndex % UE_ARRAY_COUNT(DescriptionWords)], *DevName)));
+	}
+
+	/** A few thousand settings in three levels. Without a registry the settings take the original uncached filter path. */
+	FSyntheticSettings BuildSettings(UGameSettingTestRegistry* Registry)
+	{
+		FSyntheticSettings Result;
+
+		for (int32 TopIndex = 0; TopIndex < NumTopLevelCollections; ++TopIndex)
+		{
+			UGameSettingCollection* TopLevel = NewObject<UGameSettingCollection>(GetTransientPackage());
+			InitSetting(TopLevel, FString::Printf(TEXT("Top_%d"), TopIndex), TopIndex);
+			Result.TopLevelCollections.Add(TopLevel);
+			Result.AllSettings.Add(TopLevel);
+
+			for (int32 SubIndex = 0; SubIndex < NumSubCollections; ++SubIndex)
+			{
+				UGameSettingCollection* SubCollection = NewObject<UGameSettingCollection>(GetTransientPackage());
+				InitSetting(SubCollection, FString::Printf(TEXT("Sub_%d_%d"), TopIndex, SubIndex), SubIndex);
+				TopLevel->AddSetting(SubCollection);
+				Result.SubCollections.Add(SubCollection);
+				Result.AllSettings.Add(SubCollection);
+
+				for (int32 SettingIndex = 0; SettingIndex < NumSettingsPerCollection; ++SettingIndex)
+				{
+					UGameSettingTestAction* Setting = NewObject<UGameSettingTestAction>(GetTransientPackage());
+					InitSetting(Setting, FString::Printf(TEXT("Setting_%d_%d_%d"), TopIndex, SubIndex, SettingIndex), TopIndex + SubIndex + SettingIndex);
+					SubCollection->AddSetting(Setting);
+					Result.AllSettings.Add(Setting);
+				}
+			}
+
+			if (Registry)
+			{
+				Registry->RegisterTestSetting(TopLevel);
+			}
+		}
+
+		return Result;
+	}
+
+	struct FFilterCase
+	{
+		const TCHAR* Name;
+		TFunction<void(const FSyntheticSettings&, FGameSettingFilterState&)> Setup;
+	};
+
+	TArray<FName> GetFilteredDevNames(const FSyntheticSettings& Settings, const FGameSettingFilterState& FilterState)
+	{
+		TArray<UGameSetting*> Filtered;
+		const TArray<UGameSetting*>& RootList = FilterState.GetSettingRootList();
+		for (UGameSettingCollection* TopLevel : Settings.TopLevelCollections)
+		{
+			if (RootList.Num() == 0 || RootList.Contains(TopLevel))
+			{
+				TopLevel->GetSettingsForFilter(FilterState, Filtered);
+			}
+		}
+
+		TArray<FName> DevNames;
+		DevNames.Reserve(Filtered.Num());
+		for (const UGameSetting* Setting : Filtered)
+		{
+			DevNames.Add(Setting->GetDevName());
+		}
+		return DevNames;
+	}
+
+	/** Refreshes the list NumIterations times with the same filter state, like the settings panel does, and returns the average time in ms. */
+	double TimeFiltering(const FSyntheticSettings& Settings, const FGameSettingFilterState& FilterState)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			GetFilteredDevNames(Settings, FilterState);
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameSettingRegistryFilterBenchmarkTest, "GameSettings.Registry.FilterBenchmark", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FGameSettingRegistryFilterBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace GameSettingRegistryTests;
+
+	UGameSettingTestRegistry* Registry = NewObject<UGameSettingTestRegistry>(GetTransientPackage());
+	const FSyntheticSettings Indexed = BuildSettings(Registry);
+	const FSyntheticSettings Unindexed = BuildSettings(nullptr);
+
+	AddInfo(FString::Printf(TEXT("%d synthetic settings"), Indexed.AllSettings.Num()));
+	TestEqual(TEXT("Every setting is registered"), Registry->GetRegisteredSettings().Num(), Indexed.AllSettings.Num());
+
+	// Dev name lookup against a linear scan of the registered settings
+	{
+		bool bAllFound = true;
+		const double MapStartTime = FPlatformTime::Seconds();
+		for (const UGameSetting* Setting : Indexed.AllSettings)
+		{
+			bAllFound &= (Registry->FindSettingByDevName(Setting->GetDevName()) == Setting);
+		}
+		const double MapSeconds = FPlatformTime::Seconds() - MapStartTime;
+
+		const double ScanStartTime = FPlatformTime::Seconds();
+		for (const UGameSetting* Setting : Indexed.AllSettings)
+		{
+			const TObjectPtr<UGameSetting>* Found = Registry->GetRegisteredSettings().FindByPredicate([Setting](const UGameSetting* Existing) { return Existing->GetDevName() == Setting->GetDevName(); });
+			bAllFound &= (Found && *Found == Setting);
+		}
+		const double ScanSeconds = FPlatformTime::Seconds() - ScanStartTime;
+
+		TestTrue(TEXT("FindSettingByDevName finds every setting"), bAllFound);
+		TestNull(TEXT("FindSettingByDevName with an unknown name"), Registry->FindSettingByDevName(TEXT("NotARegisteredSetting")));
+		AddInfo(FString::Printf(TEXT("FindSettingByDevName x%d: map %.3f ms, linear scan %.3f ms"), Indexed.AllSettings.Num(), MapSeconds * 1000.0, ScanSeconds * 1000.0));
+	}
+
+	const FFilterCase FilterCases[] =
+	{
+		{ TEXT("No filter"), [](const FSyntheticSettings&, FGameSettingFilterState&) {} },
+		{ TEXT("Search text"), [](const FSyntheticSettings&, FGameSettingFilterState& FilterState) { FilterState.SetSearchText(TEXT("Gameplay")); } },
+		{ TEXT("Root list"), [](const FSyntheticSettings& Settings, FGameSettingFilterState& FilterState)
+			{
+				FilterState.AddSettingToRootList(Settings.TopLevelCollections[3]);
+				FilterState.AddSettingToRootList(Settings.TopLevelCollections[11]);
+			} },
+		{ TEXT("Allow list and search text"), [](const FSyntheticSettings& Settings, FGameSettingFilterState& FilterState)
+			{
+				for (int32 Index = 0; Index < Settings.SubCollections.Num(); Index += 7)
+				{
+					FilterState.AddSettingToAllowList(Settings.SubCollections[Index]);
+				}
+				FilterState.AddSettingToAllowList(Settings.AllSettings.Last());
+				FilterState.SetSearchText(TEXT("Audio"));
+			} },
+	};
+
+	for (const FFilterCase& FilterCase : FilterCases)
+	{
+		FGameSettingFilterState IndexedFilter;
+		FilterCase.Setup(Indexed, IndexedFilter);
+		FGameSettingFilterState UnindexedFilter;
+		FilterCase.Setup(Unindexed, UnindexedFilter);
+
+		const TArray<FName> IndexedResult = GetFilteredDevNames(Indexed, IndexedFilter);
+		const TArray<FName> UnindexedResult = GetFilteredDevNames(Unindexed, UnindexedFilter);
+		TestTrue(FString::Printf(TEXT("%s: indexed filtering matches the uncached path"), FilterCase.Name), IndexedResult == UnindexedResult);
+		TestTrue(FString::Printf(TEXT("%s: filter keeps some settings"), FilterCase.Name), IndexedResult.Num() > 0);
+
+		const double IndexedMs = TimeFiltering(Indexed, IndexedFilter);
+		const double UnindexedMs = TimeFiltering(Unindexed, UnindexedFilter);
+		AddInfo(FString::Printf(TEXT("%s: %d settings pass, indexed %.3f ms, uncached %.3f ms per refresh"), FilterCase.Name, IndexedResult.Num(), IndexedMs, UnindexedMs));
+	}
+
+	// Filter state reused after the search text changes and after an edit condition change
+	{
+		FGameSettingFilterState IndexedFilter;
+		FGameSettingFilterState UnindexedFilter;
+		IndexedFilter.SetSearchText(TEXT("Video"));
+		UnindexedFilter.SetSearchText(TEXT("Video"));
+		GetFilteredDevNames(Indexed, IndexedFilter);
+
+		IndexedFilter.SetSearchText(TEXT("Controls"));
+		UnindexedFilter.SetSearchText(TEXT("Controls"));
+		TestTrue(TEXT("Search text changed: indexed filtering matches the uncached path"), GetFilteredDevNames(Indexed, IndexedFilter) == GetFilteredDevNames(Unindexed, UnindexedFilter));
+
+		const uint32 Generation = Registry->GetFilterCacheGeneration();
+		CastChecked<UGameSettingTestAction>(Indexed.AllSettings.Last())->SimulateEditConditionsChanged();
+		TestTrue(TEXT("Edit condition change bumps the filter generation"), Registry->GetFilterCacheGeneration() != Generation);
+		TestTrue(TEXT("Edit condition changed: indexed filtering matches the uncached path"), GetFilteredDevNames(Indexed, IndexedFilter) == GetFilteredDevNames(Unindexed, UnindexedFilter));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
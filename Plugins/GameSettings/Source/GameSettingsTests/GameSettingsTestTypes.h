@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/LocalPlayer.h"
+#include "GameSettingAction.h"
+#include "GameSettingRegistry.h"
+
+#include "GameSettingsTestTypes.generated.h"
+
+/**
+ * UGameSettingTestRegistry
+ *
+ *	Registry used by automation tests, settings are registered directly instead of being built in OnInitialize.
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UGameSettingTestRegistry : public UGameSettingRegistry
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterTestSetting(UGameSetting* InSetting) { RegisterSetting(InSetting); }
+
+protected:
+	virtual void OnInitialize(ULocalPlayer* InLocalPlayer) override { }
+};
+
+/**
+ * UGameSettingTestAction
+ *
+ *	Setting used by automation tests that can raise its edit condition change event without a local player.
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UGameSettingTestAction : public UGameSettingAction
+{
+	GENERATED_BODY()
+
+public:
+	void SimulateEditConditionsChanged() { NotifyEditConditionsChanged(); }
+};
+
+UENUM()
+enum class EGameSettingTestEnum : uint8
+{
+	First,
+	Second,
+	Third
+};
+
+/**
+ * UGameSettingTestValues
+ *
+ *	Values for dynamic data source tests, reached from UGameSettingTestLocalPlayer::GetTestValues.
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UGameSettingTestValues : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION()
+	int32 GetIntThroughFunction() const { return IntThroughFunction; }
+
+	UFUNCTION()
+	void SetIntThroughFunction(int32 InValue) { IntThroughFunction = InValue; }
+
+	UPROPERTY()
+	int32 IntValue = 0;
+
+	UPROPERTY()
+	uint8 ByteValue = 0;
+
+	UPROPERTY()
+	uint64 UInt64Value = 0;
+
+	UPROPERTY()
+	float FloatValue = 0.0f;
+
+	UPROPERTY()
+	double DoubleValue = 0.0;
+
+	UPROPERTY()
+	bool bBoolValue = false;
+
+	UPROPERTY()
+	EGameSettingTestEnum EnumValue = EGameSettingTestEnum::First;
+
+	UPROPERTY()
+	int32 IntThroughFunction = 0;
+};
+
+/**
+ * UGameSettingTestLocalPlayer
+ *
+ *	Local player whose settings object is a UGameSettingTestValues, the root of dynamic data source paths in tests.
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UGameSettingTestLocalPlayer : public ULocalPlayer
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION()
+	UGameSettingTestValues* GetTestValues() const { return TestValues; }
+
+	UPROPERTY()
+	TObjectPtr<UGameSettingTestValues> TestValues;
+};
@@ -3,6 +3,99 @@
 #include "DataSource/GameSettingDataSourceDynamic.h"
 
 #include "Engine/LocalPlayer.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UnrealType.h"
+
+namespace GameSettingDataSourceDynamic
+{
+	static bool bUseFastPath = true;
+	static FAutoConsoleVariableRef CVarUseFastPath(
+		TEXT("GameSettings.DynamicDataSource.UseFastPath"),
+		bUseFastPath,
+		TEXT("Read and write dynamic game setting values through the resolved properties/functions instead of resolving the property path and converting through strings every time."),
+		ECVF_Default);
+
+	static bool IsTypedValueProperty(const FProperty* Property)
+	{
+		return CastField<FNumericProperty>(Property) || CastField<FBoolProperty>(Property) || CastField<FEnumProperty>(Property);
+	}
+
+	static bool IsUnsignedIntProperty(const FNumericProperty* Property)
+	{
+		return CastField<FByteProperty>(Property) || CastField<FUInt16Property>(Property) || CastField<FUInt32Property>(Property) || CastField<FUInt64Property>(Property);
+	}
+
+	static bool ReadAsDouble(const FProperty* Property, const void* ValuePtr, double& OutValue)
+	{
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			Property = EnumProperty->GetUnderlyingProperty();
+		}
+
+		if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (NumericProperty->IsFloatingPoint())
+			{
+				OutValue = NumericProperty->GetFloatingPointPropertyValue(ValuePtr);
+			}
+			else if (IsUnsignedIntProperty(NumericProperty))
+			{
+				// Unsigned values above the signed range would come back negative through GetSignedIntPropertyValue.
+				OutValue = static_cast<double>(NumericProperty->GetUnsignedIntPropertyValue(ValuePtr));
+			}
+			else
+			{
+				OutValue = static_cast<double>(NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+			}
+			return true;
+		}
+
+		if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			OutValue = BoolProperty->GetPropertyValue(ValuePtr) ? 1.0 : 0.0;
+			return true;
+		}
+
+		return false;
+	}
+
+	static bool WriteFromDouble(const FProperty* Property, void* ValuePtr, double Value)
+	{
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			Property = EnumProperty->GetUnderlyingProperty();
+		}
+
+		if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (NumericProperty->IsFloatingPoint())
+			{
+				NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Value);
+			}
+			else
+			{
+				// Truncate like the string path does, importing "2.700000" into an integer stops at the decimal point.
+				if (IsUnsignedIntProperty(NumericProperty) && Value >= 0.0)
+				{
+					NumericProperty->SetIntPropertyValue(ValuePtr, static_cast<uint64>(Value));
+				}
+				else
+				{
+					NumericProperty->SetIntPropertyValue(ValuePtr, FMath::TruncToInt64(Value));
+				}
+			}
+			return true;
+		}
+
+		if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			BoolProperty->SetPropertyValue(ValuePtr, FMath::TruncToInt64(Value) != 0);
+			return true;
+		}
+
+		return false;
+	}
+}
 
 //--------------------------------------
 // FGameSettingDataSourceDynamic
@@ -10,18 +103,223 @@
 
 FGameSettingDataSourceDynamic::FGameSettingDataSourceDynamic(const TArray<FString>& InDynamicPath)
 	: DynamicPath(InDynamicPath)
+	, DynamicPathSegments(InDynamicPath)
 {
 }
 
 bool FGameSettingDataSourceDynamic::Resolve(ULocalPlayer* InLocalPlayer)
 {
-	return DynamicPath.Resolve(InLocalPlayer);
+	const bool bResolved = DynamicPath.Resolve(InLocalPlayer);
+	bFastPathResolved = bResolved && ResolveFastPath(InLocalPlayer);
+	return bResolved;
+}
+
+bool FGameSettingDataSourceDynamic::ResolveFastPath(ULocalPlayer* InLocalPlayer)
+{
+	ResolvedSegments.Reset();
+	LeafValueProperty = nullptr;
+
+	if (InLocalPlayer == nullptr || DynamicPathSegments.Num() == 0)
+	{
+		return false;
+	}
+
+	UClass* ContainerClass = InLocalPlayer->GetClass();
+	for (int32 SegmentIndex = 0; SegmentIndex < DynamicPathSegments.Num(); ++SegmentIndex)
+	{
+		const FString& SegmentName = DynamicPathSegments[SegmentIndex];
+
+		// Array element access stays on the property path.
+		if (ContainerClass == nullptr || SegmentName.Contains(TEXT("[")))
+		{
+			return false;
+		}
+
+		const bool bIsLeaf = (SegmentIndex == DynamicPathSegments.Num() - 1);
+
+		FResolvedSegment& Segment = ResolvedSegments.AddDefaulted_GetRef();
+		Segment.OwnerClass = ContainerClass;
+
+		if (UFunction* Function = ContainerClass->FindFunctionByName(*SegmentName))
+		{
+			// Only getters without parameters and setters with a single parameter.
+			if (Function->NumParms != 1)
+			{
+				return false;
+			}
+
+			Segment.Function = Function;
+			FProperty* ReturnProperty = Function->GetReturnProperty();
+
+			if (!bIsLeaf)
+			{
+				const FObjectPropertyBase* ObjectReturnProperty = CastField<FObjectPropertyBase>(ReturnProperty);
+				if (ObjectReturnProperty == nullptr)
+				{
+					return false;
+				}
+				ContainerClass = ObjectReturnProperty->PropertyClass;
+			}
+			else if (ReturnProperty)
+			{
+				LeafValueProperty = ReturnProperty;
+			}
+			else
+			{
+				for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+				{
+					// Non-const references would write back into our buffer, leave those to the property path.
+					if (It->HasAnyPropertyFlags(CPF_OutParm) && !It->HasAnyPropertyFlags(CPF_ConstParm))
+					{
+						return false;
+					}
+					LeafValueProperty = *It;
+				}
+			}
+		}
+		else if (FProperty* Property = FindFProperty<FProperty>(ContainerClass, *SegmentName))
+		{
+			Segment.Property = Property;
+
+			if (!bIsLeaf)
+			{
+				const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property);
+				if (ObjectProperty == nullptr)
+				{
+					return false;
+				}
+				ContainerClass = ObjectProperty->PropertyClass;
+			}
+			else
+			{
+				LeafValueProperty = Property;
+			}
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return LeafValueProperty != nullptr;
+}
+
+UObject* FGameSettingDataSourceDynamic::GetLeafContainer(ULocalPlayer* InLocalPlayer) const
+{
+	// Getters like GetLocalSettings may hand back a different object later on, so the container is walked each
+	// time, but only through the resolved properties and functions.
+	UObject* Container = InLocalPlayer;
+	for (int32 SegmentIndex = 0; SegmentIndex < ResolvedSegments.Num() - 1; ++SegmentIndex)
+	{
+		const FResolvedSegment& Segment = ResolvedSegments[SegmentIndex];
+		if (Container == nullptr || !Container->IsA(Segment.OwnerClass))
+		{
+			return nullptr;
+		}
+
+		if (Segment.Function)
+		{
+			const FObjectPropertyBase* ReturnProperty = CastFieldChecked<FObjectPropertyBase>(Segment.Function->GetReturnProperty());
+
+			uint8* Params = static_cast<uint8*>(FMemory_Alloca_Aligned(Segment.Function->ParmsSize, Segment.Function->GetMinAlignment()));
+			Segment.Function->InitializeStruct(Params);
+			Container->ProcessEvent(Segment.Function, Params);
+			Container = ReturnProperty->GetObjectPropertyValue_InContainer(Params);
+			Segment.Function->DestroyStruct(Params);
+		}
+		else
+		{
+			Container = CastFieldChecked<FObjectPropertyBase>(Segment.Property)->GetObjectPropertyValue_InContainer(Container);
+		}
+	}
+
+	const FResolvedSegment& LeafSegment = ResolvedSegments.Last();
+	return (Container && Container->IsA(LeafSegment.OwnerClass)) ? Container : nullptr;
+}
+
+bool FGameSettingDataSourceDynamic::ReadLeafValue(ULocalPlayer* InLocalPlayer, void* ValueBuffer) const
+{
+	UObject* Container = GetLeafContainer(InLocalPlayer);
+	if (Container == nullptr)
+	{
+		return false;
+	}
+
+	const FResolvedSegment& LeafSegment = ResolvedSegments.Last();
+	if (LeafSegment.Function)
+	{
+		// Only getters can be read.
+		if (LeafValueProperty != LeafSegment.Function->GetReturnProperty())
+		{
+			return false;
+		}
+
+		uint8* Params = static_cast<uint8*>(FMemory_Alloca_Aligned(LeafSegment.Function->ParmsSize, LeafSegment.Function->GetMinAlignment()));
+		LeafSegment.Function->InitializeStruct(Params);
+		Container->ProcessEvent(LeafSegment.Function, Params);
+		LeafValueProperty->CopyCompleteValue(ValueBuffer, LeafValueProperty->ContainerPtrToValuePtr<void>(Params));
+		LeafSegment.Function->DestroyStruct(Params);
+	}
+	else
+	{
+		LeafValueProperty->CopyCompleteValue(ValueBuffer, LeafValueProperty->ContainerPtrToValuePtr<void>(Container));
+	}
+
+	return true;
+}
+
+bool FGameSettingDataSourceDynamic::WriteLeafValue(ULocalPlayer* InLocalPlayer, const void* ValueBuffer) const
+{
+	UObject* Container = GetLeafContainer(InLocalPlayer);
+	if (Container == nullptr)
+	{
+		return false;
+	}
+
+	const FResolvedSegment& LeafSegment = ResolvedSegments.Last();
+	if (LeafSegment.Function)
+	{
+		// Only setters can be written.
+		if (LeafSegment.Function->GetReturnProperty() != nullptr)
+		{
+			return false;
+		}
+
+		uint8* Params = static_cast<uint8*>(FMemory_Alloca_Aligned(LeafSegment.Function->ParmsSize, LeafSegment.Function->GetMinAlignment()));
+		LeafSegment.Function->InitializeStruct(Params);
+		LeafValueProperty->CopyCompleteValue(LeafValueProperty->ContainerPtrToValuePtr<void>(Params), ValueBuffer);
+		Container->ProcessEvent(LeafSegment.Function, Params);
+		LeafSegment.Function->DestroyStruct(Params);
+	}
+	else
+	{
+		LeafValueProperty->CopyCompleteValue(LeafValueProperty->ContainerPtrToValuePtr<void>(Container), ValueBuffer);
+	}
+
+	return true;
 }
 
 FString FGameSettingDataSourceDynamic::GetValueAsString(ULocalPlayer* InLocalPlayer) const
 {
 	FString OutStringValue;
 
+	if (bFastPathResolved && GameSettingDataSourceDynamic::bUseFastPath)
+	{
+		void* ValueBuffer = FMemory_Alloca_Aligned(LeafValueProperty->GetSize(), LeafValueProperty->GetMinAlignment());
+		LeafValueProperty->InitializeValue(ValueBuffer);
+		const bool bRead = ReadLeafValue(InLocalPlayer, ValueBuffer);
+		if (bRead)
+		{
+			LeafValueProperty->ExportTextItem_Direct(OutStringValue, ValueBuffer, nullptr, nullptr, PPF_None);
+		}
+		LeafValueProperty->DestroyValue(ValueBuffer);
+
+		if (bRead)
+		{
+			return OutStringValue;
+		}
+	}
+
 	const bool bSuccess = PropertyPathHelpers::GetPropertyValueAsString(InLocalPlayer, DynamicPath, OutStringValue);
 	ensure(bSuccess);
 
@@ -30,10 +328,53 @@ FString FGameSettingDataSourceDynamic::GetValueAsString(ULocalPlayer* InLocalPla
 
 void FGameSettingDataSourceDynamic::SetValue(ULocalPlayer* InLocalPlayer, const FString& InStringValue)
 {
+	if (bFastPathResolved && GameSettingDataSourceDynamic::bUseFastPath)
+	{
+		void* ValueBuffer = FMemory_Alloca_Aligned(LeafValueProperty->GetSize(), LeafValueProperty->GetMinAlignment());
+		LeafValueProperty->InitializeValue(ValueBuffer);
+		const bool bWritten = (LeafValueProperty->ImportText_Direct(*InStringValue, ValueBuffer, nullptr, PPF_None) != nullptr) && WriteLeafValue(InLocalPlayer, ValueBuffer);
+		LeafValueProperty->DestroyValue(ValueBuffer);
+
+		if (bWritten)
+		{
+			return;
+		}
+	}
+
 	const bool bSuccess = PropertyPathHelpers::SetPropertyValueFromString(InLocalPlayer, DynamicPath, InStringValue);
 	ensure(bSuccess);
 }
 
+bool FGameSettingDataSourceDynamic::GetValueAsDouble(ULocalPlayer* InLocalPlayer, double& OutValue) const
+{
+	if (!bFastPathResolved || !GameSettingDataSourceDynamic::bUseFastPath || !GameSettingDataSourceDynamic::IsTypedValueProperty(LeafValueProperty))
+	{
+		return false;
+	}
+
+	void* ValueBuffer = FMemory_Alloca_Aligned(LeafValueProperty->GetSize(), LeafValueProperty->GetMinAlignment());
+	LeafValueProperty->InitializeValue(ValueBuffer);
+	const bool bRead = ReadLeafValue(InLocalPlayer, ValueBuffer) && GameSettingDataSourceDynamic::ReadAsDouble(LeafValueProperty, ValueBuffer, OutValue);
+	LeafValueProperty->DestroyValue(ValueBuffer);
+
+	return bRead;
+}
+
+bool FGameSettingDataSourceDynamic::SetValueFromDouble(ULocalPlayer* InLocalPlayer, double Value)
+{
+	if (!bFastPathResolved || !GameSettingDataSourceDynamic::bUseFastPath || !GameSettingDataSourceDynamic::IsTypedValueProperty(LeafValueProperty))
+	{
+		return false;
+	}
+
+	void* ValueBuffer = FMemory_Alloca_Aligned(LeafValueProperty->GetSize(), LeafValueProperty->GetMinAlignment());
+	LeafValueProperty->InitializeValue(ValueBuffer);
+	const bool bWritten = GameSettingDataSourceDynamic::WriteFromDouble(LeafValueProperty, ValueBuffer, Value) && WriteLeafValue(InLocalPlayer, ValueBuffer);
+	LeafValueProperty->DestroyValue(ValueBuffer);
+
+	return bWritten;
+}
+
 FString FGameSettingDataSourceDynamic::ToString() const
 {
 	return DynamicPath.ToString();
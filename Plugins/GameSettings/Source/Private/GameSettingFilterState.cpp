@@ -2,6 +2,7 @@
 
 #include "GameSettingFilterState.h"
 #include "GameSetting.h"
+#include "GameSettingRegistry.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameSettingFilterState)
 
@@ -40,16 +41,102 @@ void FGameSettingFilterState::AddSettingToRootList(UGameSetting* InSetting)
 {
 	SettingAllowList.Add(InSetting);
 	SettingRootList.Add(InSetting);
+	InvalidateFilterCache();
 }
 
 void FGameSettingFilterState::AddSettingToAllowList(UGameSetting* InSetting)
 {
 	SettingAllowList.Add(InSetting);
+	InvalidateFilterCache();
 }
 
 void FGameSettingFilterState::SetSearchText(const FString& InSearchText)
 {
 	SearchTextEvaluator.SetFilterText(FText::FromString(InSearchText));
+	InvalidateFilterCache();
+}
+
+void FGameSettingFilterState::InvalidateFilterCache()
+{
+	FilterCacheRegistry.Reset();
+	AncestorAllowedBits.Empty();
+	SearchTextTestedBits.Empty();
+	SearchTextPassedBits.Empty();
+}
+
+bool FGameSettingFilterState::PrepareFilterCache(const UGameSetting& InSetting) const
+{
+	const UGameSettingRegistry* Registry = InSetting.GetOwningRegistry();
+	const int32 SettingIndex = InSetting.GetRegistryIndex();
+	if (Registry == nullptr || SettingIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (FilterCacheRegistry != Registry || FilterCacheGeneration != Registry->GetFilterCacheGeneration())
+	{
+		FilterCacheRegistry = Registry;
+		FilterCacheGeneration = Registry->GetFilterCacheGeneration();
+
+		const TArray<TObjectPtr<UGameSetting>>& RegisteredSettings = Registry->GetRegisteredSettings();
+		const int32 NumSettings = RegisteredSettings.Num();
+
+		// Parents are registered before their children, so a single pass can inherit the parent's result
+		// instead of walking the parent chain for every setting.
+		AncestorAllowedBits.Init(false, NumSettings);
+		if (SettingAllowList.Num() > 0)
+		{
+			TSet<const UGameSetting*> AllowSet;
+			AllowSet.Reserve(SettingAllowList.Num());
+			for (const UGameSetting* AllowedSetting : SettingAllowList)
+			{
+				AllowSet.Add(AllowedSetting);
+			}
+
+			for (int32 Index = 0; Index < NumSettings; ++Index)
+			{
+				const UGameSetting* Setting = RegisteredSettings[Index];
+				bool bAllowed = AllowSet.Contains(Setting);
+				if (!bAllowed)
+				{
+					if (const UGameSetting* Parent = Setting->GetSettingParent())
+					{
+						const int32 ParentIndex = Parent->GetRegistryIndex();
+						if (Parent->GetOwningRegistry() == Registry && ParentIndex != INDEX_NONE && ParentIndex < Index)
+						{
+							bAllowed = AncestorAllowedBits[ParentIndex];
+						}
+						else
+						{
+							bAllowed = IsSettingOrAncestorInAllowList(*Setting);
+						}
+					}
+				}
+				AncestorAllowedBits[Index] = bAllowed;
+			}
+		}
+
+		SearchTextTestedBits.Init(false, NumSettings);
+		SearchTextPassedBits.Init(false, NumSettings);
+	}
+
+	return SettingIndex < AncestorAllowedBits.Num();
+}
+
+bool FGameSettingFilterState::IsSettingOrAncestorInAllowList(const UGameSetting& InSetting) const
+{
+	const UGameSetting* NextSetting = &InSetting;
+	while (NextSetting)
+	{
+		if (SettingAllowList.Contains(NextSetting))
+		{
+			return true;
+		}
+
+		NextSetting = NextSetting->GetSettingParent();
+	}
+
+	return false;
 }
 
 bool FGameSettingFilterState::DoesSettingPassFilter(const UGameSetting& InSetting) const
@@ -71,34 +158,33 @@ bool FGameSettingFilterState::DoesSettingPassFilter(const UGameSetting& InSettin
 		return false;
 	}
 
+	const bool bUseCache = PrepareFilterCache(InSetting);
+	const int32 SettingIndex = InSetting.GetRegistryIndex();
+
 	// Are we filtering settings?
 	if (SettingAllowList.Num() > 0)
 	{
-		if (!SettingAllowList.Contains(&InSetting))
+		const bool bAllowed = bUseCache ? AncestorAllowedBits[SettingIndex] : IsSettingOrAncestorInAllowList(InSetting);
+		if (!bAllowed)
 		{
-			bool bAllowed = false;
-			const UGameSetting* NextSetting = &InSetting;
-			while (const UGameSetting* Parent = NextSetting->GetSettingParent())
-			{
-				if (SettingAllowList.Contains(Parent))
-				{
-					bAllowed = true;
-					break;
-				}
-
-				NextSetting = Parent;
-			}
-
-			if (!bAllowed)
-			{
-				return false;
-			}
+			return false;
 		}
 	}
 
 	// TODO more filters...
 
 	// Always search text last, it's generally the most expensive filter.
+	if (bUseCache)
+	{
+		if (!SearchTextTestedBits[SettingIndex])
+		{
+			SearchTextTestedBits[SettingIndex] = true;
+			SearchTextPassedBits[SettingIndex] = SearchTextEvaluator.TestTextFilter(FSettingFilterExpressionContext(InSetting));
+		}
+
+		return SearchTextPassedBits[SettingIndex];
+	}
+
 	if (!SearchTextEvaluator.TestTextFilter(FSettingFilterExpressionContext(InSetting)))
 	{
 		return false;
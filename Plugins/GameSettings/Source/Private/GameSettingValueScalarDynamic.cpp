@@ -161,6 +161,13 @@ void UGameSettingValueScalarDynamic::SetMaximumLimit(const TOptional<double>& In
 
 double UGameSettingValueScalarDynamic::GetValue() const
 {
+	// Sliders read the value on every drag update, skip the string round trip when the data source can.
+	double TypedValue;
+	if (Getter->GetValueAsDouble(LocalPlayer, TypedValue))
+	{
+		return TypedValue;
+	}
+
 	const FString OutValue = Getter->GetValueAsString(LocalPlayer);
 
 	double Value;
@@ -199,8 +206,11 @@ void UGameSettingValueScalarDynamic::SetValue(double InValue, EGameSettingChange
 		InValue = FMath::Min(Maximum.GetValue(), InValue);
 	}
 
-	const FString StringValue = LexToString(InValue);
-	Setter->SetValue(LocalPlayer, StringValue);
+	if (!Setter->SetValueFromDouble(LocalPlayer, InValue))
+	{
+		const FString StringValue = LexToString(InValue);
+		Setter->SetValue(LocalPlayer, StringValue);
+	}
 
 	NotifySettingChanged(Reason);
 }
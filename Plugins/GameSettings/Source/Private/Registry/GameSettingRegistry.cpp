@@ -33,7 +33,9 @@ void UGameSettingRegistry::Regenerate()
 		Setting->MarkAsGarbage();
 	}
 	RegisteredSettings.Reset();
+	RegisteredSettingsByDevName.Reset();
 	TopLevelSettings.Reset();
+	++FilterCacheGeneration;
 
 	OnInitialize(OwningLocalPlayer);
 }
@@ -88,15 +90,8 @@ void UGameSettingRegistry::GetSettingsForFilter(const FGameSettingFilterState& F
 
 UGameSetting* UGameSettingRegistry::FindSettingByDevName(const FName& SettingDevName)
 {
-	for (UGameSetting* Setting : RegisteredSettings)
-	{
-		if (Setting->GetDevName() == SettingDevName)
-		{
-			return Setting;
-		}
-	}
-
-	return nullptr;
+	const TObjectPtr<UGameSetting>* Setting = RegisteredSettingsByDevName.Find(SettingDevName);
+	return Setting ? Setting->Get() : nullptr;
 }
 
 void UGameSettingRegistry::RegisterSetting(UGameSetting* InSetting)
@@ -128,10 +123,13 @@ void UGameSettingRegistry::RegisterInnerSettings(UGameSetting* InSetting)
 
 #if !UE_BUILD_SHIPPING
 	ensureAlwaysMsgf(!RegisteredSettings.Contains(InSetting), TEXT("This setting has already been registered!"));
-	ensureAlwaysMsgf(nullptr == RegisteredSettings.FindByPredicate([&InSetting](UGameSetting* ExistingSetting) { return InSetting->GetDevName() == ExistingSetting->GetDevName(); }), TEXT("A setting with this DevName has already been registered!  DevNames must be unique within a registry."));
+	ensureAlwaysMsgf(!RegisteredSettingsByDevName.Contains(InSetting->GetDevName()), TEXT("A setting with this DevName has already been registered!  DevNames must be unique within a registry."));
 #endif
 
-	RegisteredSettings.Add(InSetting);
+	InSetting->SetRegistry(this);
+	InSetting->RegistryIndex = RegisteredSettings.Add(InSetting);
+	RegisteredSettingsByDevName.FindOrAdd(InSetting->GetDevName(), InSetting);
+	++FilterCacheGeneration;
 
 	for (UGameSetting* ChildSetting : InSetting->GetChildSettings())
 	{
@@ -146,11 +144,13 @@ void UGameSettingRegistry::HandleSettingApplied(UGameSetting* Setting)
 
 void UGameSettingRegistry::HandleSettingChanged(UGameSetting* Setting, EGameSettingChangeReason Reason)
 {
+	++FilterCacheGeneration;
 	OnSettingChangedEvent.Broadcast(Setting, Reason);
 }
 
 void UGameSettingRegistry::HandleSettingEditConditionsChanged(UGameSetting* Setting)
 {
+	++FilterCacheGeneration;
 	OnSettingEditConditionChangedEvent.Broadcast(Setting);
 }
 
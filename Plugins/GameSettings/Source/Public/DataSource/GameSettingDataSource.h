@@ -27,5 +27,12 @@ public:
 
 	virtual void SetValue(ULocalPlayer* InContext, const FString& Value) = 0;
 
+	/**
+	 * Typed access for numeric, bool and enum values.  Data sources that can read or write the value without
+	 * going through a string return true, otherwise callers should fall back to the string functions.
+	 */
+	virtual bool GetValueAsDouble(ULocalPlayer* InContext, double& OutValue) const { return false; }
+	virtual bool SetValueFromDouble(ULocalPlayer* InContext, double Value) { return false; }
+
 	virtual FString ToString() const = 0;
 };
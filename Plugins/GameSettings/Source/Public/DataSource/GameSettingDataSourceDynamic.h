@@ -7,7 +7,11 @@
 
 #define UE_API GAMESETTINGS_API
 
+class FProperty;
+class UClass;
 class ULocalPlayer;
+class UFunction;
+class UObject;
 
 //--------------------------------------
 // FGameSettingDataSourceDynamic
@@ -24,10 +28,43 @@ public:
 
 	UE_API virtual void SetValue(ULocalPlayer* InLocalPlayer, const FString& Value) override;
 
+	UE_API virtual bool GetValueAsDouble(ULocalPlayer* InLocalPlayer, double& OutValue) const override;
+
+	UE_API virtual bool SetValueFromDouble(ULocalPlayer* InLocalPlayer, double Value) override;
+
 	UE_API virtual FString ToString() const override;
 
 private:
+	/** One step of the path, either an object property / parameterless getter, or the final value. */
+	struct FResolvedSegment
+	{
+		UClass* OwnerClass = nullptr;
+		FProperty* Property = nullptr;
+		UFunction* Function = nullptr;
+	};
+
+	/** Resolves the path into properties and functions once, so reads and writes don't have to look up names or parse the path. */
+	bool ResolveFastPath(ULocalPlayer* InLocalPlayer);
+
+	/** Walks the resolved segments to find the object that owns the final value. */
+	UObject* GetLeafContainer(ULocalPlayer* InLocalPlayer) const;
+
+	/** Reads the final value into a buffer laid out for LeafValueProperty, returns false if the fast path can't be used. */
+	bool ReadLeafValue(ULocalPlayer* InLocalPlayer, void* ValueBuffer) const;
+
+	/** Writes the final value from a buffer laid out for LeafValueProperty, returns false if the fast path can't be used. */
+	bool WriteLeafValue(ULocalPlayer* InLocalPlayer, const void* ValueBuffer) const;
+
 	FCachedPropertyPath DynamicPath;
+
+	TArray<FString> DynamicPathSegments;
+
+	TArray<FResolvedSegment> ResolvedSegments;
+
+	/** The property describing the value, the leaf property itself or the getter return / setter parameter. */
+	FProperty* LeafValueProperty = nullptr;
+
+	bool bFastPathResolved = false;
 };
 
 #undef UE_API
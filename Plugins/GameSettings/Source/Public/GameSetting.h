@@ -76,6 +76,10 @@ public:
 	void AddTag(const FGameplayTag& TagToAdd) { Tags.AddTag(TagToAdd); }
 
 	void SetRegistry(UGameSettingRegistry* InOwningRegistry) { OwningRegistry = InOwningRegistry; }
+	UGameSettingRegistry* GetOwningRegistry() const { return OwningRegistry; }
+
+	/** Index of this setting in its registry, INDEX_NONE if it hasn't been registered.  Filters use it to cache per-setting results. */
+	int32 GetRegistryIndex() const { return RegistryIndex; }
 
 	/** Gets the searchable plain text for the description. */
 	UE_API const FString& GetDescriptionPlainText() const;
@@ -252,6 +256,11 @@ private:
 
 	/** We cache the editable state of a setting when it changes rather than reprocessing it any time it's needed.  */
 	FGameSettingEditableState EditableStateCache;
+
+	/** Assigned by the registry when the setting is registered. */
+	int32 RegistryIndex = INDEX_NONE;
+
+	friend class UGameSettingRegistry;
 };
 
 #undef UE_API
@@ -12,6 +12,7 @@
 class ULocalPlayer;
 class UGameSetting;
 class UGameSettingCollection;
+class UGameSettingRegistry;
 
 /** Why did the setting change? */
 enum class EGameSettingChangeReason : uint8
@@ -66,8 +67,28 @@ public:
 	}
 
 private:
+	/** Returns true if the setting or one of its parents is in the allow list. */
+	bool IsSettingOrAncestorInAllowList(const UGameSetting& InSetting) const;
+
+	/** Makes sure the cached results belong to the setting's registry and are still current, returns false if the setting can't use the cache. */
+	bool PrepareFilterCache(const UGameSetting& InSetting) const;
+
+	/** Drops every cached result. */
+	void InvalidateFilterCache();
+
 	FTextFilterExpressionEvaluator SearchTextEvaluator;
 
+	/**
+	 * Per-setting results, indexed by the setting's registry index.  Filtering is run over the whole registry
+	 * every time the settings list refreshes, so the allow list parent walk and search text test are only
+	 * done once until the registry reports a change.
+	 */
+	mutable TWeakObjectPtr<const UGameSettingRegistry> FilterCacheRegistry;
+	mutable uint32 FilterCacheGeneration = 0;
+	mutable TBitArray<> AncestorAllowedBits;
+	mutable TBitArray<> SearchTextTestedBits;
+	mutable TBitArray<> SearchTextPassedBits;
+
 	UPROPERTY()
 	TArray<TObjectPtr<UGameSetting>> SettingRootList;
 
@@ -57,6 +57,12 @@ public:
 
 	UE_API UGameSetting* FindSettingByDevName(const FName& SettingDevName);
 
+	/** All registered settings, parents are always registered before their children. */
+	const TArray<TObjectPtr<UGameSetting>>& GetRegisteredSettings() const { return RegisteredSettings; }
+
+	/** Changes whenever settings are registered, regenerated or change their edit state, filters drop their cached results when it does. */
+	uint32 GetFilterCacheGeneration() const { return FilterCacheGeneration; }
+
 	template<typename T = UGameSetting>
 	T* FindSettingByDevNameChecked(const FName& SettingDevName)
 	{
@@ -86,6 +92,11 @@ protected:
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UGameSetting>> RegisteredSettings;
 
+	UPROPERTY(Transient)
+	TMap<FName, TObjectPtr<UGameSetting>> RegisteredSettingsByDevName;
+
+	uint32 FilterCacheGeneration = 0;
+
 	UPROPERTY(Transient)
 	TObjectPtr<ULocalPlayer> OwningLocalPlayer;
 };
@@ -95,5 +95,18 @@ var global = global || (function () { return this; }());
         }
     };
     
+    // entries: [[moduleName, url, source], ...]，按顺序重载，被依赖的模块在前
+    async function reloadBatch(entries) {
+        await enableDebugger();
+        for (const [moduleName, url, source] of entries) {
+            try {
+                await reload(moduleName, url, source);
+            } catch (e) {
+                console.error(`reload ${url} fail: ${e}`);
+            }
+        }
+    };
+    
     puerts.__reload = reload;
+    puerts.__reloadBatch = reloadBatch;
 }(global));
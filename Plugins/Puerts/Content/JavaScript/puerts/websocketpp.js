@@ -117,9 +117,15 @@ var global = global || (function () { return this; }());
             if (this._pendingEvents.length === 0 && this._readyState != WebSocket.CLOSING) {
                 this._raw.poll();
             } 
-            const ev = this._pendingEvents.shift();
-            if (ev) this.dispatchEvent(ev);
-            if ((this._pendingEvents.length === 0 && this._readyState == WebSocket.CLOSING) || (ev && ev.type === 'close')) {
+            // dispatch everything the network thread delivered since last poll
+            const events = this._pendingEvents;
+            this._pendingEvents = [];
+            let closed = false;
+            for (let i = 0; i < events.length && !closed; i++) {
+                this.dispatchEvent(events[i]);
+                closed = events[i].type === 'close';
+            }
+            if ((this._pendingEvents.length === 0 && this._readyState == WebSocket.CLOSING) || closed) {
                 this._raw = undefined;
                 clearInterval(this._tid);
                 this._readyState = WebSocket.CLOSED;
@@ -127,6 +133,11 @@ var global = global || (function () { return this; }());
             }
         }
         
+        // [messagesReceived, messagesSent, bytesCopied]
+        stats() {
+            return this._raw ? this._raw.stats() : [0, 0, 0];
+        }
+        
         close(code, data) {
             try {
                 this._raw.close(code, data);
@@ -10,6 +10,11 @@
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "Algo/Reverse.h"
+#include "JSLogger.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
 #if (ENGINE_MAJOR_VERSION >= 5)
 #include "HAL/PlatformFileManager.h"
 #else
@@ -50,9 +55,47 @@ static FString PathNormalize(const FString& PathIn)
     }
 }
 
+static std::atomic<uint32> GResolutionCacheEpoch{0};
+
+static const TCHAR* ResolutionManifestFileName = TEXT("ModuleResolution.manifest");
+
+static const TCHAR* ResolutionManifestContentToken = TEXT("{Content}");
+
+static FString MakeResolutionCacheKey(const FString& RequiredDir, const FString& RequiredModule)
+{
+    return RequiredDir + TEXT("|") + RequiredModule;
+}
+
+DefaultJSModuleLoader::DefaultJSModuleLoader(const FString& InScriptRoot) : ScriptRoot(InScriptRoot)
+{
+#if !WITH_EDITOR
+    const FString ManifestPath = FPaths::ProjectContentDir() / ScriptRoot / ResolutionManifestFileName;
+    if (FPaths::FileExists(ManifestPath))
+    {
+        LoadResolutionManifest(ManifestPath);
+    }
+#endif
+}
+
+DefaultJSModuleLoader::~DefaultJSModuleLoader()
+{
+    // 打包前跑一遍游戏，加上 -PuertsModuleManifestOut=<path> 生成清单，放到 ScriptRoot 下随包发布
+    FString ManifestOutPath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("PuertsModuleManifestOut="), ManifestOutPath))
+    {
+        SaveResolutionManifest(ManifestOutPath);
+    }
+
+    if (ResolutionStats.NumSearches > 0)
+    {
+        LogResolutionStats();
+    }
+}
+
 bool DefaultJSModuleLoader::CheckExists(const FString& PathIn, FString& Path, FString& AbsolutePath)
 {
     IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    ++ResolutionStats.NumFileProbes;
     FString NormalizedPath = PathNormalize(PathIn);
     if (PlatformFile.FileExists(*NormalizedPath))
     {
@@ -90,6 +133,53 @@ bool DefaultJSModuleLoader::SearchModuleWithExtInDir(
 }
 
 bool DefaultJSModuleLoader::Search(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath)
+{
+    FScopeLock ScopeLock(&ResolutionCacheCritical);
+    const double StartTime = FPlatformTime::Seconds();
+    ++ResolutionStats.NumSearches;
+
+    if (!EnableResolutionCache)
+    {
+        const bool Found = SearchUncached(RequiredDir, RequiredModule, Path, AbsolutePath);
+        ResolutionStats.SearchSeconds += FPlatformTime::Seconds() - StartTime;
+        return Found;
+    }
+
+    const uint32 CurrentEpoch = GResolutionCacheEpoch.load();
+    if (ResolutionCacheEpoch != CurrentEpoch || ResolutionCacheScriptRoot != ScriptRoot)
+    {
+        ResolutionCache.Reset();
+        ResolutionCacheEpoch = CurrentEpoch;
+        ResolutionCacheScriptRoot = ScriptRoot;
+    }
+
+    const FString Key = MakeResolutionCacheKey(RequiredDir, RequiredModule);
+    if (const FModuleResolution* Cached = ResolutionCache.Find(Key))
+    {
+        ++ResolutionStats.NumCacheHits;
+        if (Cached->Found)
+        {
+            Path = Cached->Path;
+            AbsolutePath = Cached->AbsolutePath;
+        }
+        ResolutionStats.SearchSeconds += FPlatformTime::Seconds() - StartTime;
+        return Cached->Found;
+    }
+
+    FModuleResolution Resolution;
+    Resolution.Found = SearchUncached(RequiredDir, RequiredModule, Resolution.Path, Resolution.AbsolutePath);
+    if (Resolution.Found)
+    {
+        Path = Resolution.Path;
+        AbsolutePath = Resolution.AbsolutePath;
+    }
+    const bool Found = Resolution.Found;
+    ResolutionCache.Emplace(Key, MoveTemp(Resolution));
+    ResolutionStats.SearchSeconds += FPlatformTime::Seconds() - StartTime;
+    return Found;
+}
+
+bool DefaultJSModuleLoader::SearchUncached(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath)
 {
     if (SearchModuleInDir(RequiredDir, RequiredModule, Path, AbsolutePath))
     {
@@ -143,4 +233,94 @@ FString& DefaultJSModuleLoader::GetScriptRoot()
     return ScriptRoot;
 }
 
+void DefaultJSModuleLoader::InvalidateResolutionCache()
+{
+    FScopeLock ScopeLock(&ResolutionCacheCritical);
+    ResolutionCache.Reset();
+}
+
+void DefaultJSModuleLoader::InvalidateAllResolutionCaches()
+{
+    ++GResolutionCacheEpoch;
+}
+
+bool DefaultJSModuleLoader::LoadResolutionManifest(const FString& ManifestPath)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *ManifestPath))
+    {
+        UE_LOG(Puerts, Warning, TEXT("load module resolution manifest fail: %s"), *ManifestPath);
+        return false;
+    }
+
+    const FString ContentDir = PathNormalize(FPaths::ProjectContentDir());
+    IFileManager& FileManager = IFileManager::Get();
+
+    FScopeLock ScopeLock(&ResolutionCacheCritical);
+    ResolutionCacheEpoch = GResolutionCacheEpoch.load();
+    ResolutionCacheScriptRoot = ScriptRoot;
+    for (const FString& Line : Lines)
+    {
+        // RequiredDir \t RequiredModule \t Path
+        TArray<FString> Fields;
+        if (Line.ParseIntoArray(Fields, TEXT("\t"), false) != 3)
+        {
+            continue;
+        }
+        const FString RequiredDir = Fields[0].Replace(ResolutionManifestContentToken, *ContentDir);
+        FModuleResolution Resolution;
+        Resolution.Found = true;
+        Resolution.Path = Fields[2].Replace(ResolutionManifestContentToken, *ContentDir);
+        Resolution.AbsolutePath = FileManager.ConvertToAbsolutePathForExternalAppForRead(*Resolution.Path);
+        ResolutionCache.Emplace(MakeResolutionCacheKey(RequiredDir, Fields[1]), MoveTemp(Resolution));
+    }
+    UE_LOG(Puerts, Log, TEXT("load %d module resolutions from %s"), ResolutionCache.Num(), *ManifestPath);
+    return true;
+}
+
+bool DefaultJSModuleLoader::SaveResolutionManifest(const FString& ManifestPath)
+{
+    const FString ContentDir = PathNormalize(FPaths::ProjectContentDir());
+
+    FScopeLock ScopeLock(&ResolutionCacheCritical);
+    TArray<FString> Lines;
+    for (const auto& KV : ResolutionCache)
+    {
+        // 找不到的结果和内容目录以外的模块不写入，这些在运行时仍然按原来的方式查找
+        FString RequiredDir, RequiredModule;
+        if (!KV.Value.Found || !KV.Value.Path.StartsWith(ContentDir) || !KV.Key.Split(TEXT("|"), &RequiredDir, &RequiredModule))
+        {
+            continue;
+        }
+        if (RequiredDir.StartsWith(ContentDir))
+        {
+            RequiredDir = ResolutionManifestContentToken + RequiredDir.Mid(ContentDir.Len());
+        }
+        const FString Path = ResolutionManifestContentToken + KV.Value.Path.Mid(ContentDir.Len());
+        Lines.Add(FString::Join(TArray<FString>{RequiredDir, RequiredModule, Path}, TEXT("\t")));
+    }
+    Lines.Sort();
+
+    if (!FFileHelper::SaveStringArrayToFile(Lines, *ManifestPath))
+    {
+        UE_LOG(Puerts, Error, TEXT("save module resolution manifest fail: %s"), *ManifestPath);
+        return false;
+    }
+    UE_LOG(Puerts, Log, TEXT("save %d module resolutions to %s"), Lines.Num(), *ManifestPath);
+    return true;
+}
+
+FModuleResolutionStats DefaultJSModuleLoader::GetResolutionStats()
+{
+    FScopeLock ScopeLock(&ResolutionCacheCritical);
+    return ResolutionStats;
+}
+
+void DefaultJSModuleLoader::LogResolutionStats()
+{
+    const FModuleResolutionStats Stats = GetResolutionStats();
+    UE_LOG(Puerts, Log, TEXT("module resolution: %llu searches, %llu cache hits, %llu file probes, %.3f ms"), Stats.NumSearches,
+        Stats.NumCacheHits, Stats.NumFileProbes, Stats.SearchSeconds * 1000.0);
+}
+
 }    // namespace PUERTS_NAMESPACE
@@ -76,6 +76,26 @@ void FJsEnv::InitExtensionMethodsMap()
     GameScript->InitExtensionMethodsMap();
 }
 
+bool FJsEnv::GetHeapStatistics(FJsHeapStatistics& OutStatistics)
+{
+    return GameScript->GetHeapStatistics(OutStatistics);
+}
+
+bool FJsEnv::WriteHeapSnapshot(const FString& FilePath)
+{
+    return GameScript->WriteHeapSnapshot(FilePath);
+}
+
+bool FJsEnv::StartHeapSampling(uint64 SampleInterval, int32 StackDepth)
+{
+    return GameScript->StartHeapSampling(SampleInterval, StackDepth);
+}
+
+bool FJsEnv::StopHeapSampling(const FString& FilePath)
+{
+    return GameScript->StopHeapSampling(FilePath);
+}
+
 void FJsEnv::ReloadModule(FName ModuleName, const FString& JsSource)
 {
     GameScript->ReloadModule(ModuleName, JsSource);
@@ -86,6 +106,11 @@ void FJsEnv::ReloadSource(const FString& Path, const PString& JsSource)
     GameScript->ReloadSource(Path, JsSource);
 }
 
+void FJsEnv::ReloadSources(const TArray<TPair<FString, PString>>& Sources)
+{
+    GameScript->ReloadSources(Sources);
+}
+
 void FJsEnv::OnSourceLoaded(std::function<void(const FString&)> Callback)
 {
     GameScript->OnSourceLoaded(Callback);
@@ -32,6 +32,15 @@
 #include "ContainerMeta.h"
 
 #include "V8InspectorImpl.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#ifndef WITH_QUICKJS
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8-profiler.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#endif
 #if USE_WASM3
 #include "WasmModuleInstance.h"
 #endif
@@ -91,6 +100,11 @@ void InitWebsocketPPWrap(v8::Local<v8::Context> Context);
 
 namespace PUERTS_NAMESPACE
 {
+// 关掉后FName和v8字符串之间每次都重新转换，用于对比测试
+static bool bUseNameStringCache = true;
+static FAutoConsoleVariableRef CVarUseNameStringCache(TEXT("puerts.NameStringCache"), bUseNameStringCache,
+    TEXT("Cache the conversions between FName and v8 strings."), ECVF_Default);
+
 #if !defined(WITH_QUICKJS)
 void LoadPesapiDll(const v8::FunctionCallbackInfo<v8::Value>& Info);
 #endif
@@ -103,7 +117,9 @@ FJsEnvImpl::FJsEnvImpl(const FString& ScriptRoot)
 
 static void FNameToArrayBuffer(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
-    FName Name = FV8Utils::ToFName(Info.GetIsolate(), Info[0]);
+    FName Name = Info[0]->IsString() ? FV8Utils::IsolateData<IObjectMapper>(Info.GetIsolate())
+                                           ->V8StringToName(Info.GetIsolate(), Info[0].As<v8::String>())
+                                     : FV8Utils::ToFName(Info.GetIsolate(), Info[0]);
     v8::Local<v8::ArrayBuffer> Ab = v8::ArrayBuffer::New(Info.GetIsolate(), sizeof(FName));
     void* Buff = DataTransfer::GetArrayBufferData(Ab);
     ::memcpy(Buff, &Name, sizeof(FName));
@@ -158,8 +174,10 @@ static void ToCPtrArray(const v8::FunctionCallbackInfo<v8::Value>& Info)
 
 static void GetFNameString(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
-    FName RequiredFName(*FV8Utils::ToFString(Info.GetIsolate(), Info[0]));
-    Info.GetReturnValue().Set(FV8Utils::ToV8String(Info.GetIsolate(), RequiredFName));
+    IObjectMapper* Mapper = FV8Utils::IsolateData<IObjectMapper>(Info.GetIsolate());
+    FName RequiredFName = Info[0]->IsString() ? Mapper->V8StringToName(Info.GetIsolate(), Info[0].As<v8::String>())
+                                              : FName(*FV8Utils::ToFString(Info.GetIsolate(), Info[0]));
+    Info.GetReturnValue().Set(Mapper->NameToV8String(Info.GetIsolate(), RequiredFName));
 }
 
 #if defined(WITH_NODEJS)
@@ -638,6 +656,11 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
         Isolate, PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "getESMMain")).ToLocalChecked().As<v8::Function>());
 
     ReloadJs.Reset(Isolate, PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "__reload")).ToLocalChecked().As<v8::Function>());
+    auto ReloadBatchValue = PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "__reloadBatch")).ToLocalChecked();
+    if (ReloadBatchValue->IsFunction())
+    {
+        ReloadBatchJs.Reset(Isolate, ReloadBatchValue.As<v8::Function>());
+    }
 #if !PUERTS_FORCE_CPP_UFUNCTION
     MergePrototype.Reset(
         Isolate, PuertsObj->Get(Context, FV8Utils::ToV8String(Isolate, "__mergePrototype")).ToLocalChecked().As<v8::Function>());
@@ -668,7 +691,7 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 #if USE_WASM3
     PuertsWasmEnv = std::make_shared<WasmEnv>();
     //创建默认的runtime
-    PuertsWasmRuntimeList.Add(std::make_shared<WasmRuntime>(PuertsWasmEnv.get()));
+    PuertsWasmRuntimeList.Add(WasmRuntime::Acquire(PuertsWasmEnv.get()));
     ExecuteModule("puerts/wasm3_helper.js");
 #endif
 #if defined(WITH_V8_BYTECODE)
@@ -736,6 +759,7 @@ FJsEnvImpl::~FJsEnvImpl()
     Require.Reset();
     GetESMMain.Reset();
     ReloadJs.Reset();
+    ReloadBatchJs.Reset();
     JsPromiseRejectCallback.Reset();
 
     FUETicker::GetCoreTicker().RemoveTicker(DelegateProxiesCheckerHandler);
@@ -784,6 +808,13 @@ FJsEnvImpl::~FJsEnvImpl()
         }
         ContainerCache.Empty();
 
+        NameStringCache.Empty();
+#ifndef WITH_QUICKJS
+        V8NameToNameCache.Empty();
+#endif
+
+        ObjectMergers.clear();    // 合并计划里持有属性名的Global
+
         for (auto Iter = DelegateMap.begin(); Iter != DelegateMap.end(); Iter++)
         {
             Iter->second.JSObject.Reset();
@@ -983,13 +1014,24 @@ void FJsEnvImpl::InitExtensionMethodsMap()
     ExtensionMethodsMapInited = true;
 }
 
+// 关掉后每次都按名字查translator，用于对比测试
+static bool bUseObjectMergePlans = true;
+static FAutoConsoleVariableRef CVarUseObjectMergePlans(TEXT("puerts.ObjectMergePlans"), bUseObjectMergePlans,
+    TEXT("Reuse per-shape merge plans when merging js objects into structs."), ECVF_Default);
+
+bool FJsEnvImpl::ObjectMerger::UsePlans()
+{
+    return bUseObjectMergePlans;
+}
+
 std::unique_ptr<FJsEnvImpl::ObjectMerger>& FJsEnvImpl::GetObjectMerger(UStruct* Struct)
 {
-    if (ObjectMergers.find(Struct) == ObjectMergers.end())
+    auto& Merger = ObjectMergers[Struct];
+    if (!Merger)
     {
-        ObjectMergers[Struct] = std::make_unique<ObjectMerger>(this, Struct);
+        Merger = std::make_unique<ObjectMerger>(this, Struct);
     }
-    return ObjectMergers[Struct];
+    return Merger;
 }
 
 void FJsEnvImpl::Merge(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Object> Src, UStruct* DesType, void* Des)
@@ -1164,6 +1206,13 @@ void FJsEnvImpl::LowMemoryNotification()
 #ifdef THREAD_SAFE
     v8::Locker Locker(MainIsolate);
 #endif
+    {
+        v8::Isolate::Scope IsolateScope(MainIsolate);
+        NameStringCache.Empty();
+#ifndef WITH_QUICKJS
+        V8NameToNameCache.Empty();
+#endif
+    }
     MainIsolate->LowMemoryNotification();
 }
 
@@ -1187,6 +1236,191 @@ void FJsEnvImpl::RequestFullGarbageCollectionForTesting()
 #endif
 }
 
+bool FJsEnvImpl::GetHeapStatistics(FJsHeapStatistics& OutStatistics)
+{
+#ifndef WITH_QUICKJS
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    v8::HeapStatistics Statistics;
+    MainIsolate->GetHeapStatistics(&Statistics);
+
+    OutStatistics.TotalHeapSize = Statistics.total_heap_size();
+    OutStatistics.TotalPhysicalSize = Statistics.total_physical_size();
+    OutStatistics.TotalAvailableSize = Statistics.total_available_size();
+    OutStatistics.UsedHeapSize = Statistics.used_heap_size();
+    OutStatistics.HeapSizeLimit = Statistics.heap_size_limit();
+    OutStatistics.MallocedMemory = Statistics.malloced_memory();
+    OutStatistics.ExternalMemory = Statistics.external_memory();
+    OutStatistics.NumberOfNativeContexts = Statistics.number_of_native_contexts();
+    OutStatistics.NumberOfDetachedContexts = Statistics.number_of_detached_contexts();
+
+    OutStatistics.Spaces.Reset();
+    for (size_t i = 0; i < MainIsolate->NumberOfHeapSpaces(); ++i)
+    {
+        v8::HeapSpaceStatistics SpaceStatistics;
+        if (MainIsolate->GetHeapSpaceStatistics(&SpaceStatistics, i))
+        {
+            FJsHeapSpaceStatistics& Space = OutStatistics.Spaces.AddDefaulted_GetRef();
+            Space.Name = UTF8_TO_TCHAR(SpaceStatistics.space_name());
+            Space.SpaceSize = SpaceStatistics.space_size();
+            Space.UsedSize = SpaceStatistics.space_used_size();
+            Space.AvailableSize = SpaceStatistics.space_available_size();
+            Space.PhysicalSize = SpaceStatistics.physical_space_size();
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifndef WITH_QUICKJS
+// 把HeapSnapshot::Serialize的输出直接写到文件里，不在内存里拼整个快照
+class FHeapSnapshotFileStream : public v8::OutputStream
+{
+public:
+    explicit FHeapSnapshotFileStream(FArchive* InWriter) : Writer(InWriter)
+    {
+    }
+
+    virtual void EndOfStream() override
+    {
+    }
+
+    virtual int GetChunkSize() override
+    {
+        return 64 * 1024;
+    }
+
+    virtual WriteResult WriteAsciiChunk(char* Data, int Size) override
+    {
+        Writer->Serialize(Data, Size);
+        return Writer->IsError() ? kAbort : kContinue;
+    }
+
+private:
+    FArchive* Writer;
+};
+
+static void WriteSamplingHeapProfileNode(FString& Out, const v8::AllocationProfile::Node* Node, uint32& NextId)
+{
+    int64 SelfSize = 0;
+    for (const auto& Allocation : Node->allocations)
+    {
+        SelfSize += static_cast<int64>(Allocation.size) * Allocation.count;
+    }
+
+    v8::Isolate* Isolate = v8::Isolate::GetCurrent();
+    FString FunctionName = Node->name.IsEmpty() ? FString() : FV8Utils::ToFString(Isolate, Node->name);
+    FString Url = Node->script_name.IsEmpty() ? FString() : FV8Utils::ToFString(Isolate, Node->script_name);
+    FunctionName.ReplaceInline(TEXT("\\"), TEXT("\\\\"));
+    FunctionName.ReplaceInline(TEXT("\""), TEXT("\\\""));
+    Url.ReplaceInline(TEXT("\\"), TEXT("\\\\"));
+    Url.ReplaceInline(TEXT("\""), TEXT("\\\""));
+
+    // 行列号在DevTools的格式里是从0开始的
+    Out += FString::Printf(TEXT("{\"callFrame\":{\"functionName\":\"%s\",\"scriptId\":\"%d\",\"url\":\"%s\",\"lineNumber\":%d,")
+                           TEXT("\"columnNumber\":%d},\"selfSize\":%lld,\"id\":%u,\"children\":["),
+        *FunctionName, Node->script_id, *Url, Node->line_number - 1, Node->column_number - 1, SelfSize, NextId++);
+    for (size_t i = 0; i < Node->children.size(); ++i)
+    {
+        if (i > 0)
+        {
+            Out += TEXT(",");
+        }
+        WriteSamplingHeapProfileNode(Out, Node->children[i], NextId);
+    }
+    Out += TEXT("]}");
+}
+#endif
+
+bool FJsEnvImpl::WriteHeapSnapshot(const FString& FilePath)
+{
+#ifndef WITH_QUICKJS
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    v8::Isolate::Scope IsolateScope(MainIsolate);
+    v8::HandleScope HandleScope(MainIsolate);
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer)
+    {
+        UE_LOG(Puerts, Error, TEXT("can not open %s for heap snapshot"), *FilePath);
+        return false;
+    }
+
+    const v8::HeapSnapshot* Snapshot = MainIsolate->GetHeapProfiler()->TakeHeapSnapshot();
+    if (!Snapshot)
+    {
+        return false;
+    }
+    FHeapSnapshotFileStream Stream(Writer.Get());
+    Snapshot->Serialize(&Stream, v8::HeapSnapshot::kJSON);
+    const_cast<v8::HeapSnapshot*>(Snapshot)->Delete();
+
+    const bool Succeeded = Writer->Close();
+    UE_LOG(Puerts, Log, TEXT("heap snapshot written to %s"), *FilePath);
+    return Succeeded;
+#else
+    return false;
+#endif
+}
+
+bool FJsEnvImpl::StartHeapSampling(uint64 SampleInterval, int32 StackDepth)
+{
+#ifndef WITH_QUICKJS
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    if (IsHeapSampling)
+    {
+        return false;
+    }
+    IsHeapSampling = MainIsolate->GetHeapProfiler()->StartSamplingHeapProfiler(SampleInterval, StackDepth);
+    return IsHeapSampling;
+#else
+    return false;
+#endif
+}
+
+bool FJsEnvImpl::StopHeapSampling(const FString& FilePath)
+{
+#ifndef WITH_QUICKJS
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    if (!IsHeapSampling)
+    {
+        return false;
+    }
+    v8::Isolate::Scope IsolateScope(MainIsolate);
+    v8::HandleScope HandleScope(MainIsolate);
+
+    v8::HeapProfiler* HeapProfiler = MainIsolate->GetHeapProfiler();
+    std::unique_ptr<v8::AllocationProfile> Profile(HeapProfiler->GetAllocationProfile());
+    HeapProfiler->StopSamplingHeapProfiler();
+    IsHeapSampling = false;
+
+    if (!Profile)
+    {
+        return false;
+    }
+
+    FString Json = TEXT("{\"head\":");
+    uint32 NextId = 1;
+    WriteSamplingHeapProfileNode(Json, Profile->GetRootNode(), NextId);
+    Json += TEXT("}");
+
+    const bool Succeeded = FFileHelper::SaveStringToFile(Json, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+    UE_LOG(Puerts, Log, TEXT("sampling heap profile written to %s"), *FilePath);
+    return Succeeded;
+#else
+    return false;
+#endif
+}
+
 #if !defined(ENGINE_INDEPENDENT_JSENV)
 void FJsEnvImpl::FinishInjection(UClass* InClass)
 {
@@ -1541,6 +1775,59 @@ void FJsEnvImpl::ReloadSource(const FString& Path, const PString& JsSource)
     }
 }
 
+void FJsEnvImpl::ReloadSources(const TArray<TPair<FString, PString>>& Sources)
+{
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+    if (Sources.Num() == 0)
+    {
+        return;
+    }
+
+    // 老版本的 hot_reload.js 没有批量接口，逐个重载
+    if (ReloadBatchJs.IsEmpty())
+    {
+        for (const TPair<FString, PString>& Source : Sources)
+        {
+            ReloadSource(Source.Key, Source.Value);
+        }
+        return;
+    }
+
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    auto Isolate = MainIsolate;
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    auto Context = DefaultContext.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+    auto LocalReloadBatchJs = ReloadBatchJs.Get(Isolate);
+
+    Logger->Info(FString::Printf(TEXT("reload %d js files"), Sources.Num()));
+    v8::TryCatch TryCatch(Isolate);
+
+    // [[moduleName, url, source], ...]
+    auto Batch = v8::Array::New(Isolate, Sources.Num());
+    for (int32 i = 0; i < Sources.Num(); ++i)
+    {
+        auto Entry = v8::Array::New(Isolate, 3);
+        (void) (Entry->Set(Context, 0, v8::Undefined(Isolate)));
+        (void) (Entry->Set(Context, 1, FV8Utils::ToV8String(Isolate, Sources[i].Key)));
+        (void) (Entry->Set(Context, 2, FV8Utils::ToV8String(Isolate, Sources[i].Value.c_str())));
+        (void) (Batch->Set(Context, i, Entry));
+    }
+
+    v8::Local<v8::Value> Args[] = {Batch};
+    (void) (LocalReloadBatchJs->Call(Context, v8::Undefined(Isolate), 1, Args));
+
+    if (TryCatch.HasCaught())
+    {
+        Logger->Error(FString::Printf(TEXT("reload module exception %s"), *FV8Utils::TryCatchToString(Isolate, &TryCatch)));
+    }
+}
+
 void FJsEnvImpl::OnSourceLoaded(std::function<void(const FString&)> Callback)
 {
     OnSourceLoadedCallback = Callback;
@@ -3221,6 +3508,28 @@ v8::Local<v8::Value> FJsEnvImpl::AddSoftObjectPtr(
     return JSObject;
 }
 
+v8::Local<v8::String> FJsEnvImpl::NameToV8String(v8::Isolate* Isolate, const FName& Name)
+{
+    if (!bUseNameStringCache)
+    {
+        return FV8Utils::ToV8String(Isolate, Name);
+    }
+    return NameStringCache.Get(Isolate, Name);
+}
+
+FName FJsEnvImpl::V8StringToName(v8::Isolate* Isolate, v8::Local<v8::Name> Name)
+{
+#ifdef WITH_QUICKJS
+    return FV8Utils::ToFName(Isolate, Name);
+#else
+    if (!bUseNameStringCache)
+    {
+        return FV8Utils::ToFName(Isolate, Name);
+    }
+    return V8NameToNameCache.Get(Isolate, Name);
+#endif
+}
+
 v8::Local<v8::Value> FJsEnvImpl::UETypeToJsClass(v8::Isolate* Isolate, v8::Local<v8::Context> Context, UField* Type)
 {
     if (const auto Struct = Cast<UStruct>(Type))
@@ -4625,7 +4934,7 @@ void FJsEnvImpl::Wasm_NewMemory(const v8::FunctionCallbackInfo<v8::Value>& Info)
     int InitPages = Info[0]->Int32Value(Context).ToChecked();
     int MaxPages = Info[1]->Int32Value(Context).ToChecked();
     check(InitPages >= 0 && MaxPages > 0 && MaxPages >= InitPages);
-    auto Runtime = std::make_shared<WasmRuntime>(PuertsWasmEnv.get(), MaxPages, InitPages);
+    auto Runtime = WasmRuntime::Acquire(PuertsWasmEnv.get(), MaxPages, InitPages);
     PuertsWasmRuntimeList.Add(Runtime);
     Info.GetReturnValue().Set(Runtime->GetRuntimeSeq());
 }
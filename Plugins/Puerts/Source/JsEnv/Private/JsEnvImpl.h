@@ -12,6 +12,7 @@
 #include "DynamicDelegateProxy.h"
 #include "StructWrapper.h"
 #include "CppObjectMapper.h"
+#include "NameStringCache.h"
 #include "V8Utils.h"
 #include "ObjectMapper.h"
 #include "JSLogger.h"
@@ -23,6 +24,7 @@
 #include "ContainerMeta.h"
 #include "ObjectCacheNode.h"
 #include <unordered_map>
+#include <algorithm>
 
 #if ENGINE_MINOR_VERSION >= 25 || ENGINE_MAJOR_VERSION > 4
 #include "UObject/WeakFieldPtr.h"
@@ -125,12 +127,22 @@ public:
 
     virtual void InitExtensionMethodsMap() override;
 
+    virtual bool GetHeapStatistics(FJsHeapStatistics& OutStatistics) override;
+
+    virtual bool WriteHeapSnapshot(const FString& FilePath) override;
+
+    virtual bool StartHeapSampling(uint64 SampleInterval, int32 StackDepth) override;
+
+    virtual bool StopHeapSampling(const FString& FilePath) override;
+
     void JsHotReload(FName ModuleName, const FString& JsSource);
 
     virtual void ReloadModule(FName ModuleName, const FString& JsSource) override;
 
     virtual void ReloadSource(const FString& Path, const PString& JsSource) override;
 
+    virtual void ReloadSources(const TArray<TPair<FString, PString>>& Sources) override;
+
     std::function<void(const FString&)> OnSourceLoadedCallback;
 
     virtual void OnSourceLoaded(std::function<void(const FString&)> Callback) override;
@@ -228,6 +240,10 @@ public:
     virtual v8::Local<v8::Value> AddSoftObjectPtr(v8::Isolate* Isolate, v8::Local<v8::Context> Context,
         FSoftObjectPtr* SoftObjectPtr, UClass* Class, bool IsSoftClass) override;
 
+    virtual v8::Local<v8::String> NameToV8String(v8::Isolate* Isolate, const FName& Name) override;
+
+    virtual FName V8StringToName(v8::Isolate* Isolate, v8::Local<v8::Name> Name) override;
+
     bool CheckDelegateProxies(float Tick);
 
     virtual v8::Local<v8::Value> CreateArray(
@@ -376,6 +392,23 @@ private:
         UStruct* Struct;
         FJsEnvImpl* Parent;
 
+        // 一种JS对象形状(自有属性名及其顺序)对应的合并计划，同形状的对象直接按下标拿translator，不用再按名字查
+        struct MergePlan
+        {
+            std::vector<v8::Global<v8::Value>> Keys;
+            std::vector<FPropertyTranslator*> Translators;    // 不是结构体字段的属性为nullptr
+            std::vector<UStruct*> FieldStructs;               // 字段是UObject/结构体时，嵌套对象要递归合并
+        };
+
+        // 最近用过的在前面，满了淘汰最久没用过的，Merge期间会持有一份引用，重入时淘汰掉也不会被释放
+        std::vector<std::shared_ptr<MergePlan>> Plans;
+
+        // 同一个结构体交替传入的对象形状超过这个数才会反复重新编译
+        static constexpr size_t MaxPlans = 32;
+
+        // 控制台变量puerts.ObjectMergePlans
+        static bool UsePlans();
+
         ObjectMerger(FJsEnvImpl* InParent, UStruct* InStruct)
         {
             Parent = InParent;
@@ -388,6 +421,111 @@ private:
             }
         }
 
+        FPropertyTranslator* FindField(v8::Isolate* Isolate, v8::Local<v8::Value> Key)
+        {
+            auto Iter = Fields.find(*v8::String::Utf8Value(Isolate, Key));
+            return Iter != Fields.end() ? Iter->second.get() : nullptr;
+        }
+
+        static UStruct* GetFieldStruct(FPropertyTranslator* Translator)
+        {
+            if (auto ObjectPropertyBase = CastFieldMacro<ObjectPropertyBaseMacro>(Translator->Property))
+            {
+                return ObjectPropertyBase->PropertyClass;
+            }
+            else if (auto StructProperty = CastFieldMacro<StructPropertyMacro>(Translator->Property))
+            {
+                return StructProperty->Struct;
+            }
+            return nullptr;
+        }
+
+        std::shared_ptr<MergePlan> FindOrCompilePlan(v8::Isolate* Isolate, const std::vector<v8::Local<v8::Value>>& Keys)
+        {
+            for (size_t PlanIndex = 0; PlanIndex < Plans.size(); ++PlanIndex)
+            {
+                MergePlan* Plan = Plans[PlanIndex].get();
+                if (Plan->Keys.size() != Keys.size())
+                {
+                    continue;
+                }
+                bool Match = true;
+                for (size_t i = 0; i < Keys.size(); ++i)
+                {
+                    // 属性名都是内部化的字符串，StrictEquals基本只是指针比较
+                    if (!Keys[i]->StrictEquals(Plan->Keys[i].Get(Isolate)))
+                    {
+                        Match = false;
+                        break;
+                    }
+                }
+                if (Match)
+                {
+                    if (PlanIndex != 0)
+                    {
+                        std::rotate(Plans.begin(), Plans.begin() + PlanIndex, Plans.begin() + PlanIndex + 1);
+                    }
+                    return Plans[0];
+                }
+            }
+
+            std::shared_ptr<MergePlan> Plan;
+            if (Plans.size() >= MaxPlans)
+            {
+                Plan = std::move(Plans.back());
+                Plans.pop_back();
+            }
+            if (Plan && Plan.use_count() == 1)
+            {
+                // 没有正在进行的Merge引用它，直接复用已经分配好的空间
+                Plan->Keys.clear();
+                Plan->Translators.clear();
+                Plan->FieldStructs.clear();
+            }
+            else
+            {
+                Plan = std::make_shared<MergePlan>();
+            }
+            Plan->Keys.reserve(Keys.size());
+            Plan->Translators.reserve(Keys.size());
+            Plan->FieldStructs.reserve(Keys.size());
+            for (auto& Key : Keys)
+            {
+                FPropertyTranslator* Translator = FindField(Isolate, Key);
+                Plan->Keys.emplace_back(Isolate, Key);
+                Plan->Translators.push_back(Translator);
+                Plan->FieldStructs.push_back(Translator ? GetFieldStruct(Translator) : nullptr);
+            }
+
+            Plans.insert(Plans.begin(), Plan);
+            return Plan;
+        }
+
+        void MergeField(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Object> JsObject, void* Ptr,
+            v8::Local<v8::Value> Key, FPropertyTranslator* Translator, UStruct* FieldStruct)
+        {
+            auto MaybeValue = JsObject->Get(Context, Key);
+            if (!MaybeValue.IsEmpty())
+            {
+                auto Value = MaybeValue.ToLocalChecked();
+                if (Value->IsObject())
+                {
+                    auto JsObjectField = Value->ToObject(Context).ToLocalChecked();
+                    if (!FV8Utils::GetPointerFast<void>(JsObjectField))
+                    {
+                        if (FieldStruct)
+                        {
+                            Parent->GetObjectMerger(FieldStruct)
+                                ->Merge(Isolate, Context, JsObjectField, Translator->Property->ContainerPtrToValuePtr<void>(Ptr));
+                        }
+                        return;
+                    }
+                }
+                if (!Value->IsUndefined())
+                    Translator->JsToUEInContainer(Isolate, Context, Value, Ptr, true);
+            }
+        }
+
         void Merge(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Object> JsObject, void* Ptr)
         {
             if (auto Class = Cast<UClass>(Struct))
@@ -400,45 +538,44 @@ private:
                 }
             }
             auto Keys = JsObject->GetOwnPropertyNames(Context).ToLocalChecked();
+#ifndef WITH_QUICKJS
+            if (UsePlans())
+            {
+                MergeWithPlan(Isolate, Context, JsObject, Ptr, Keys);
+                return;
+            }
+#endif
             for (decltype(Keys->Length()) i = 0; i < Keys->Length(); ++i)
             {
                 auto Key = Keys->Get(Context, i).ToLocalChecked();
-                auto Iter = Fields.find(*v8::String::Utf8Value(Isolate, Key));
-                if (Iter != Fields.end())
+                if (FPropertyTranslator* Translator = FindField(Isolate, Key))
                 {
-                    auto MaybeValue = JsObject->Get(Context, Key);
-                    if (!MaybeValue.IsEmpty())
-                    {
-                        auto Value = MaybeValue.ToLocalChecked();
-                        if (Value->IsObject())
-                        {
-                            auto JsObjectField = Value->ToObject(Context).ToLocalChecked();
-                            if (!FV8Utils::GetPointerFast<void>(JsObjectField))
-                            {
-                                UStruct* FieldStruct = nullptr;
-                                if (auto ObjectPropertyBase = CastFieldMacro<ObjectPropertyBaseMacro>(Iter->second->Property))
-                                {
-                                    FieldStruct = ObjectPropertyBase->PropertyClass;
-                                }
-                                else if (auto StructProperty = CastFieldMacro<StructPropertyMacro>(Iter->second->Property))
-                                {
-                                    FieldStruct = StructProperty->Struct;
-                                }
-                                if (FieldStruct)
-                                {
-                                    Parent->GetObjectMerger(FieldStruct)
-                                        ->Merge(Isolate, Context, JsObjectField,
-                                            Iter->second->Property->ContainerPtrToValuePtr<void>(Ptr));
-                                }
-                                continue;
-                            }
-                        }
-                        if (!Value->IsUndefined())
-                            Iter->second->JsToUEInContainer(Isolate, Context, Value, Ptr, true);
-                    }
+                    MergeField(Isolate, Context, JsObject, Ptr, Key, Translator, GetFieldStruct(Translator));
                 }
             }
         }
+
+#ifndef WITH_QUICKJS
+        void MergeWithPlan(
+            v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Object> JsObject, void* Ptr, v8::Local<v8::Array> Keys)
+        {
+            std::vector<v8::Local<v8::Value>> KeyList;
+            KeyList.reserve(Keys->Length());
+            for (decltype(Keys->Length()) i = 0; i < Keys->Length(); ++i)
+            {
+                KeyList.push_back(Keys->Get(Context, i).ToLocalChecked());
+            }
+            // 读取属性会执行js的getter，递归合并也会用到同一个merger，重入可能把这个计划淘汰掉
+            const std::shared_ptr<MergePlan> Plan = FindOrCompilePlan(Isolate, KeyList);
+            for (size_t i = 0; i < KeyList.size(); ++i)
+            {
+                if (FPropertyTranslator* Translator = Plan->Translators[i])
+                {
+                    MergeField(Isolate, Context, JsObject, Ptr, KeyList[i], Translator, Plan->FieldStructs[i]);
+                }
+            }
+        }
+#endif
     };
 
     friend ObjectMerger;
@@ -555,6 +692,8 @@ private:
 
     v8::Global<v8::Function> ReloadJs;
 
+    v8::Global<v8::Function> ReloadBatchJs;
+
 #if !PUERTS_FORCE_CPP_UFUNCTION
     v8::Global<v8::Function> MergePrototype;
 #endif
@@ -586,6 +725,12 @@ private:
 
     TMap<void*, ContainerCacheItem> ContainerCache;
 
+    FNameStringCache NameStringCache;
+
+#ifndef WITH_QUICKJS
+    FV8NameToNameCache V8NameToNameCache;
+#endif
+
     FCppObjectMapper CppObjectMapper;
 
     v8::UniquePersistent<v8::FunctionTemplate> ArrayTemplate;
@@ -714,6 +859,8 @@ private:
 
     V8Inspector* Inspector;
 
+    bool IsHeapSampling = false;
+
     V8InspectorChannel* InspectorChannel;
 
     v8::Global<v8::Function> InspectorMessageHandler;
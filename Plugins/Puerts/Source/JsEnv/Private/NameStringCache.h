@@ -0,0 +1,251 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NamespaceDef.h"
+#include "V8Utils.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+namespace PUERTS_NAMESPACE
+{
+// FName -> v8::String 的缓存，每个isolate一个
+// 属性名、GameplayTag名、枚举名这类FName会反复跨越边界，缓存内部化后的字符串，避免每次都构造FString再创建v8字符串
+// 按FName的比较索引+Number做key，超过容量后淘汰最久没用过的
+class FNameStringCache
+{
+public:
+    explicit FNameStringCache(int32 InCapacity = 4096) : Capacity(FMath::Max(InCapacity, 1))
+    {
+    }
+
+    FNameStringCache(const FNameStringCache&) = delete;
+    FNameStringCache& operator=(const FNameStringCache&) = delete;
+
+    v8::Local<v8::String> Get(v8::Isolate* Isolate, const FName& Name)
+    {
+        if (int32* IndexPtr = Index.Find(Name))
+        {
+            ++NumHits;
+            const int32 EntryIndex = *IndexPtr;
+            if (EntryIndex != Head)
+            {
+                Unlink(EntryIndex);
+                LinkFront(EntryIndex);
+            }
+            return Entries[EntryIndex].String.Get(Isolate);
+        }
+
+        ++NumMisses;
+        const FString Str = FV8Utils::ComparisonNameToString(Name);
+#ifdef WITH_QUICKJS
+        v8::Local<v8::String> Result = FV8Utils::ToV8String(Isolate, Str);
+#else
+        v8::Local<v8::String> Result =
+            v8::String::NewFromTwoByte(Isolate, TCHAR_TO_UTF16(*Str), v8::NewStringType::kInternalized).ToLocalChecked();
+#endif
+
+        int32 EntryIndex;
+        if (Entries.Num() < Capacity)
+        {
+            if (Entries.Num() == 0)
+            {
+                Entries.Reserve(Capacity);    // v8::Global不能拷贝，一次预留好
+            }
+            EntryIndex = Entries.AddDefaulted();
+        }
+        else
+        {
+            // 复用最久没用过的那一项
+            EntryIndex = Tail;
+            Unlink(EntryIndex);
+            Index.Remove(Entries[EntryIndex].Name);
+            Entries[EntryIndex].String.Reset();
+        }
+
+        FEntry& Entry = Entries[EntryIndex];
+        Entry.Name = Name;
+        Entry.String.Reset(Isolate, Result);
+        Index.Add(Name, EntryIndex);
+        LinkFront(EntryIndex);
+        return Result;
+    }
+
+    // 必须在isolate销毁前调用
+    void Empty()
+    {
+        for (FEntry& Entry : Entries)
+        {
+            Entry.String.Reset();
+        }
+        Entries.Empty();
+        Index.Empty();
+        Head = INDEX_NONE;
+        Tail = INDEX_NONE;
+    }
+
+    int32 Num() const
+    {
+        return Entries.Num();
+    }
+
+    uint64 GetNumHits() const
+    {
+        return NumHits;
+    }
+
+    uint64 GetNumMisses() const
+    {
+        return NumMisses;
+    }
+
+private:
+    struct FEntry
+    {
+        FName Name;
+        v8::Global<v8::String> String;
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+    };
+
+    void Unlink(int32 EntryIndex)
+    {
+        FEntry& Entry = Entries[EntryIndex];
+        if (Entry.Prev != INDEX_NONE)
+        {
+            Entries[Entry.Prev].Next = Entry.Next;
+        }
+        else
+        {
+            Head = Entry.Next;
+        }
+        if (Entry.Next != INDEX_NONE)
+        {
+            Entries[Entry.Next].Prev = Entry.Prev;
+        }
+        else
+        {
+            Tail = Entry.Prev;
+        }
+        Entry.Prev = INDEX_NONE;
+        Entry.Next = INDEX_NONE;
+    }
+
+    void LinkFront(int32 EntryIndex)
+    {
+        FEntry& Entry = Entries[EntryIndex];
+        Entry.Prev = INDEX_NONE;
+        Entry.Next = Head;
+        if (Head != INDEX_NONE)
+        {
+            Entries[Head].Prev = EntryIndex;
+        }
+        Head = EntryIndex;
+        if (Tail == INDEX_NONE)
+        {
+            Tail = EntryIndex;
+        }
+    }
+
+    int32 Capacity;
+
+    TArray<FEntry> Entries;
+
+    TMap<FName, int32> Index;
+
+    // 最近使用的在Head，最久没用的在Tail
+    int32 Head = INDEX_NONE;
+
+    int32 Tail = INDEX_NONE;
+
+    uint64 NumHits = 0;
+
+    uint64 NumMisses = 0;
+};
+
+#ifndef WITH_QUICKJS
+// v8::Name -> FName 的缓存，每个isolate一个，和FNameStringCache方向相反
+// 属性拦截器和FName参数每次都要把js字符串转成FName，按v8字符串的hash直接定位槽位，命中时不用构造FString也不用查FName表
+// 槽位数固定，hash冲突时直接覆盖
+class FV8NameToNameCache
+{
+public:
+    FV8NameToNameCache() = default;
+
+    FV8NameToNameCache(const FV8NameToNameCache&) = delete;
+    FV8NameToNameCache& operator=(const FV8NameToNameCache&) = delete;
+
+    FName Get(v8::Isolate* Isolate, v8::Local<v8::Name> Key)
+    {
+        // 字符串的IdentityHash就是内容的hash，内容相同的字符串落在同一个槽位
+        const int Hash = Key->GetIdentityHash();
+        FSlot& Slot = Slots[static_cast<uint32>(Hash) & (NumSlots - 1)];
+        if (Slot.Hash == Hash && !Slot.Key.IsEmpty())
+        {
+            v8::Local<v8::Name> CachedKey = Slot.Key.Get(Isolate);
+            // 内部化的字符串直接比较地址，其他的再比较内容
+            if (CachedKey == Key || CachedKey->StrictEquals(Key))
+            {
+                ++NumHits;
+                return Slot.Name;
+            }
+        }
+
+        ++NumMisses;
+        const FName Name(*FV8Utils::ToFString(Isolate, Key));
+        Slot.Hash = Hash;
+        Slot.Key.Reset(Isolate, Key);
+        Slot.Name = Name;
+        return Name;
+    }
+
+    // 必须在isolate销毁前调用
+    void Empty()
+    {
+        for (FSlot& Slot : Slots)
+        {
+            Slot.Key.Reset();
+            Slot.Name = NAME_None;
+            Slot.Hash = 0;
+        }
+    }
+
+    uint64 GetNumHits() const
+    {
+        return NumHits;
+    }
+
+    uint64 GetNumMisses() const
+    {
+        return NumMisses;
+    }
+
+private:
+    static constexpr int32 NumSlots = 1024;
+
+    struct FSlot
+    {
+        int Hash = 0;
+        v8::Global<v8::Name> Key;
+        FName Name;
+    };
+
+    FSlot Slots[NumSlots];
+
+    uint64 NumHits = 0;
+
+    uint64 NumMisses = 0;
+};
+#endif
+}    // namespace PUERTS_NAMESPACE
@@ -114,6 +114,12 @@ public:
 
     virtual v8::Local<v8::Value> AddSoftObjectPtr(
         v8::Isolate* Isolate, v8::Local<v8::Context> Context, FSoftObjectPtr* SoftObjectPtr, UClass* Class, bool IsSoftClass) = 0;
+
+    // 带缓存的FName转换，返回内部化的字符串
+    virtual v8::Local<v8::String> NameToV8String(v8::Isolate* Isolate, const FName& Name) = 0;
+
+    // 带缓存的反向转换，按v8字符串本身查找，命中时不构造FString
+    virtual FName V8StringToName(v8::Isolate* Isolate, v8::Local<v8::Name> Name) = 0;
 };
 #endif
 
@@ -20,6 +20,7 @@
 #include "ArrayBuffer.h"
 #include "ContainerWrapper.h"
 #include "JsObject.h"
+#include "HAL/IConsoleManager.h"
 #ifdef PUERTS_FTEXT_AS_OBJECT
 #include "TypeInfo.hpp"
 #endif
@@ -156,6 +157,248 @@ void FPropertyTranslator::DelegateGetter(const v8::FunctionCallbackInfo<v8::Valu
         Isolate, Context, Object, PropertyTranslator->Property, DelegatePtr, true));
 }
 
+// 常用的基础类型属性(int/float/double/bool/FName/枚举)按偏移直接读写，
+// 不走虚函数UEToJs/JsToUE，也不需要取Context，值类型对不上时退回通用的Getter/Setter
+// 关掉后全部走通用路径，只影响之后才生成的类模板，用于对比测试
+static bool bUseFastPropertyAccessors = true;
+static FAutoConsoleVariableRef CVarUseFastPropertyAccessors(TEXT("puerts.FastPropertyAccessors"), bUseFastPropertyAccessors,
+    TEXT("Use type specialized accessors for primitive properties. Only affects class templates built afterwards."), ECVF_Default);
+
+enum class EFastPropertyKind : uint8
+{
+    None,
+    Int32,
+    UInt8,
+    Float,
+    Double,
+    Bool,
+    Name,
+};
+
+static EFastPropertyKind GetFastPropertyKind(PropertyMacro* Property)
+{
+    if (Property->ArrayDim != 1)
+    {
+        return EFastPropertyKind::None;
+    }
+    if (auto EnumProperty = CastFieldMacro<EnumPropertyMacro>(Property))
+    {
+        Property = EnumProperty->GetUnderlyingProperty();
+    }
+    if (Property->IsA<IntPropertyMacro>())
+    {
+        return EFastPropertyKind::Int32;
+    }
+    else if (Property->IsA<BytePropertyMacro>())
+    {
+        return EFastPropertyKind::UInt8;
+    }
+    else if (Property->IsA<FloatPropertyMacro>())
+    {
+        return EFastPropertyKind::Float;
+    }
+    else if (Property->IsA<DoublePropertyMacro>())
+    {
+        return EFastPropertyKind::Double;
+    }
+    else if (Property->IsA<BoolPropertyMacro>())
+    {
+        return EFastPropertyKind::Bool;
+    }
+    else if (Property->IsA<NamePropertyMacro>())
+    {
+        return EFastPropertyKind::Name;
+    }
+    return EFastPropertyKind::None;
+}
+
+template <EFastPropertyKind Kind>
+FORCEINLINE static void* GetFastAccessValuePtr(
+    v8::Isolate* Isolate, FPropertyTranslator* This, const v8::FunctionCallbackInfo<v8::Value>& Info, bool& OutUseGeneric)
+{
+    OutUseGeneric = false;
+    if (!This->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "Property is invalid!");
+        return nullptr;
+    }
+#if WITH_EDITOR
+    // 编辑器下属性可能被重新生成，类型变了就走通用路径
+    if (GetFastPropertyKind(This->Property) != Kind)
+    {
+        OutUseGeneric = true;
+        return nullptr;
+    }
+#endif
+
+    void* Container;
+    if (This->OwnerIsClass)
+    {
+        UObject* Object = FV8Utils::GetUObject(Info.Holder());
+        if (!Object)
+        {
+            FV8Utils::ThrowException(Isolate, "access a null object");
+            return nullptr;
+        }
+        if (FV8Utils::IsReleasedPtr(Object))
+        {
+            FV8Utils::ThrowException(Isolate, "access a invalid object");
+            return nullptr;
+        }
+        Container = Object;
+    }
+    else
+    {
+        Container = FV8Utils::GetPointer(Info.Holder());
+        if (!Container)
+        {
+            FV8Utils::ThrowException(Isolate, "access a null struct");
+            return nullptr;
+        }
+    }
+    return This->Property->ContainerPtrToValuePtr<void>(Container);
+}
+
+template <EFastPropertyKind Kind>
+static void FastGetter(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    FPropertyTranslator* This = static_cast<FPropertyTranslator*>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
+
+    bool UseGeneric;
+    void* ValuePtr = GetFastAccessValuePtr<Kind>(Isolate, This, Info, UseGeneric);
+    if (UseGeneric)
+    {
+        FPropertyTranslator::Getter(Info);
+        return;
+    }
+    if (!ValuePtr)
+    {
+        return;
+    }
+
+    switch (Kind)
+    {
+        case EFastPropertyKind::Int32:
+            Info.GetReturnValue().Set(*static_cast<int32*>(ValuePtr));
+            break;
+        case EFastPropertyKind::UInt8:
+            Info.GetReturnValue().Set(static_cast<int32>(*static_cast<uint8*>(ValuePtr)));
+            break;
+        case EFastPropertyKind::Float:
+            Info.GetReturnValue().Set(static_cast<double>(*static_cast<float*>(ValuePtr)));
+            break;
+        case EFastPropertyKind::Double:
+            Info.GetReturnValue().Set(*static_cast<double*>(ValuePtr));
+            break;
+        case EFastPropertyKind::Bool:
+            Info.GetReturnValue().Set(This->BoolProperty->GetPropertyValue(ValuePtr));
+            break;
+        case EFastPropertyKind::Name:
+            Info.GetReturnValue().Set(
+                FV8Utils::IsolateData<IObjectMapper>(Isolate)->NameToV8String(Isolate, *static_cast<FName*>(ValuePtr)));
+            break;
+        default:
+            break;
+    }
+}
+
+template <EFastPropertyKind Kind>
+static void FastSetter(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    FPropertyTranslator* This = static_cast<FPropertyTranslator*>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
+    v8::Local<v8::Value> Value = Info[0];
+
+    // 需要类型转换的值交给通用路径，保持原来的转换语义
+    bool Handled;
+    switch (Kind)
+    {
+        case EFastPropertyKind::Int32:
+        case EFastPropertyKind::UInt8:
+            Handled = Value->IsInt32();
+            break;
+        case EFastPropertyKind::Float:
+        case EFastPropertyKind::Double:
+            Handled = Value->IsNumber();
+            break;
+        case EFastPropertyKind::Bool:
+            Handled = true;
+            break;
+        default:
+            Handled = false;
+            break;
+    }
+
+    bool UseGeneric = !Handled;
+    void* ValuePtr = Handled ? GetFastAccessValuePtr<Kind>(Isolate, This, Info, UseGeneric) : nullptr;
+    if (UseGeneric)
+    {
+        FPropertyTranslator::Setter(Info);
+        return;
+    }
+    if (!ValuePtr)
+    {
+        return;
+    }
+
+    switch (Kind)
+    {
+        case EFastPropertyKind::Int32:
+            *static_cast<int32*>(ValuePtr) = Value.As<v8::Int32>()->Value();
+            break;
+        case EFastPropertyKind::UInt8:
+            *static_cast<uint8*>(ValuePtr) = static_cast<uint8>(Value.As<v8::Int32>()->Value());
+            break;
+        case EFastPropertyKind::Float:
+            *static_cast<float*>(ValuePtr) = static_cast<float>(Value.As<v8::Number>()->Value());
+            break;
+        case EFastPropertyKind::Double:
+            *static_cast<double*>(ValuePtr) = Value.As<v8::Number>()->Value();
+            break;
+        case EFastPropertyKind::Bool:
+            This->BoolProperty->SetPropertyValue(ValuePtr, Value->BooleanValue(Isolate));
+            break;
+        default:
+            break;
+    }
+}
+
+static void GetAccessorCallbacks(PropertyMacro* Property, v8::FunctionCallback& OutGetter, v8::FunctionCallback& OutSetter)
+{
+    switch (bUseFastPropertyAccessors ? GetFastPropertyKind(Property) : EFastPropertyKind::None)
+    {
+        case EFastPropertyKind::Int32:
+            OutGetter = FastGetter<EFastPropertyKind::Int32>;
+            OutSetter = FastSetter<EFastPropertyKind::Int32>;
+            break;
+        case EFastPropertyKind::UInt8:
+            OutGetter = FastGetter<EFastPropertyKind::UInt8>;
+            OutSetter = FastSetter<EFastPropertyKind::UInt8>;
+            break;
+        case EFastPropertyKind::Float:
+            OutGetter = FastGetter<EFastPropertyKind::Float>;
+            OutSetter = FastSetter<EFastPropertyKind::Float>;
+            break;
+        case EFastPropertyKind::Double:
+            OutGetter = FastGetter<EFastPropertyKind::Double>;
+            OutSetter = FastSetter<EFastPropertyKind::Double>;
+            break;
+        case EFastPropertyKind::Bool:
+            OutGetter = FastGetter<EFastPropertyKind::Bool>;
+            OutSetter = FastSetter<EFastPropertyKind::Bool>;
+            break;
+        case EFastPropertyKind::Name:
+            OutGetter = FastGetter<EFastPropertyKind::Name>;
+            OutSetter = FPropertyTranslator::Setter;    // 写FName还要处理ArrayBuffer，走通用路径
+            break;
+        default:
+            OutGetter = FPropertyTranslator::Getter;
+            OutSetter = FPropertyTranslator::Setter;
+            break;
+    }
+}
+
 void FPropertyTranslator::SetAccessor(v8::Isolate* Isolate, v8::Local<v8::FunctionTemplate> Template)
 {
     if (Property->IsA<DelegatePropertyMacro>() || Property->IsA<MulticastDelegatePropertyMacro>()
@@ -175,8 +418,11 @@ void FPropertyTranslator::SetAccessor(v8::Isolate* Isolate, v8::Local<v8::Functi
     {
         auto OwnerStruct = Property->GetOwnerStruct();
         auto Self = v8::External::New(Isolate, this);
-        auto GetterTemplate = v8::FunctionTemplate::New(Isolate, Getter, Self);
-        auto SetterTemplate = v8::FunctionTemplate::New(Isolate, Setter, Self);
+        v8::FunctionCallback GetterCallback;
+        v8::FunctionCallback SetterCallback;
+        GetAccessorCallbacks(Property, GetterCallback, SetterCallback);
+        auto GetterTemplate = v8::FunctionTemplate::New(Isolate, GetterCallback, Self);
+        auto SetterTemplate = v8::FunctionTemplate::New(Isolate, SetterCallback, Self);
 #if !defined(ENGINE_INDEPENDENT_JSENV)
         FString PropertyName = OwnerStruct && OwnerStruct->IsA<UUserDefinedStruct>() ?
 #if ENGINE_MINOR_VERSION >= 23 || ENGINE_MAJOR_VERSION > 4
@@ -406,7 +652,7 @@ public:
     v8::Local<v8::Value> UEToJs(
         v8::Isolate* Isolate, v8::Local<v8::Context>& Context, const void* ValuePtr, bool PassByPointer) const override
     {
-        return FV8Utils::ToV8String(Isolate, NameProperty->GetPropertyValue(ValuePtr));
+        return FV8Utils::IsolateData<IObjectMapper>(Isolate)->NameToV8String(Isolate, NameProperty->GetPropertyValue(ValuePtr));
     }
 
     bool JsToUE(v8::Isolate* Isolate, v8::Local<v8::Context>& Context, const v8::Local<v8::Value>& Value, void* ValuePtr,
@@ -423,6 +669,12 @@ public:
                 return true;
             }
         }
+        else if (Value->IsString())
+        {
+            NameProperty->SetPropertyValue(
+                ValuePtr, FV8Utils::IsolateData<IObjectMapper>(Isolate)->V8StringToName(Isolate, Value.As<v8::String>()));
+            return true;
+        }
         NameProperty->SetPropertyValue(ValuePtr, FV8Utils::ToFName(Isolate, Value));
         return true;
     }
@@ -20,82 +20,209 @@
 
 namespace PUERTS_NAMESPACE
 {
-static void NormalInstanceCall(const v8::FunctionCallbackInfo<v8::Value>& Info)
+// 参数直接从 v8 值写到 wasm3 的栈上，不再经过中间的指针数组
+static FORCEINLINE bool WriteWasmArg(v8::Local<v8::Context>& Context, int Type, v8::Local<v8::Value> Value, uint64* Slot)
+{
+    switch (Type)
+    {
+        case c_m3Type_i32:
+            if (Value->IsInt32())
+            {
+                *((int32*) Slot) = Value.As<v8::Int32>()->Value();
+                return true;
+            }
+            if (Value->IsNumber())
+            {
+                *((int32*) Slot) = Value->Int32Value(Context).ToChecked();
+                return true;
+            }
+            return false;
+        case c_m3Type_i64:
+            if (Value->IsBigInt())
+            {
+                *((int64*) Slot) = Value.As<v8::BigInt>()->Int64Value();
+                return true;
+            }
+            return false;
+        case c_m3Type_f32:
+            if (Value->IsNumber())
+            {
+                *((float*) Slot) = (float) Value.As<v8::Number>()->Value();
+                return true;
+            }
+            return false;
+        case c_m3Type_f64:
+            if (Value->IsNumber())
+            {
+                *((double*) Slot) = Value.As<v8::Number>()->Value();
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+static FORCEINLINE void SetWasmReturnValue(const v8::FunctionCallbackInfo<v8::Value>& Info, int Type, const uint64* Slot)
+{
+    switch (Type)
+    {
+        case c_m3Type_i32:
+            Info.GetReturnValue().Set(*((const int32*) Slot));
+            break;
+        case c_m3Type_i64:
+            Info.GetReturnValue().Set(v8::BigInt::New(Info.GetIsolate(), *((const int64*) Slot)));
+            break;
+        case c_m3Type_f32:
+            Info.GetReturnValue().Set(*((const float*) Slot));
+            break;
+        case c_m3Type_f64:
+            Info.GetReturnValue().Set(*((const double*) Slot));
+            break;
+        default:
+            check(0);
+    }
+}
+
+static FORCEINLINE IM3Function GetCallStubFunction(const v8::FunctionCallbackInfo<v8::Value>& Info, uint64*& ArgStack)
 {
     IM3Function _Function = static_cast<IM3Function>((v8::Local<v8::External>::Cast(Info.Data()))->Value());
-    int argCount = _Function->funcType->numArgs;
-    check(Info.Length() >= argCount);
+    check(Info.Length() >= (int) _Function->funcType->numArgs);
+    check(_Function->funcType->numRets <= 1);
+    if (!Export_m3_PrepareCallArgs(_Function, &ArgStack))
+    {
+        FV8Utils::ThrowException(Info.GetIsolate(), "call wasm failed");
+        return nullptr;
+    }
+    return _Function;
+}
 
-    auto Isolate = Info.GetIsolate();
-    auto Context = Isolate->GetCurrentContext();
-    int64* args = (int64*) FMemory_Alloca(sizeof(int64) * argCount);
-    void** argsPointer = (void**) FMemory_Alloca(sizeof(void*) * argCount);
-    for (int Index = 0; Index < argCount; Index++)
+// 任意签名
+static void NormalInstanceCall(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    uint64* ArgStack = nullptr;
+    IM3Function _Function = GetCallStubFunction(Info, ArgStack);
+    if (!_Function)
     {
-        const int type = _Function->funcType->types[_Function->funcType->numRets + Index];
-        switch (type)
+        return;
+    }
+
+    auto Context = Info.GetIsolate()->GetCurrentContext();
+    IM3FuncType FuncType = _Function->funcType;
+    for (uint32 Index = 0; Index < FuncType->numArgs; Index++)
+    {
+        if (!WriteWasmArg(Context, FuncType->types[FuncType->numRets + Index], Info[Index], ArgStack + Index))
         {
-            case c_m3Type_i32:
-                check(Info[Index]->IsNumber());
-                *((int*) (args + Index)) = Info[Index]->Int32Value(Context).ToChecked();
-                argsPointer[Index] = args + Index;
-                break;
-            case c_m3Type_i64:
-                check(Info[Index]->IsBigInt());
-                *(args + Index) = Info[Index]->ToBigInt(Context).ToLocalChecked()->Int64Value();
-                argsPointer[Index] = args + Index;
-                break;
-            case c_m3Type_f32:
-                check(Info[Index]->IsNumber());
-                *((float*) (args + Index)) = (float) Info[Index]->NumberValue(Context).ToChecked();
-                argsPointer[Index] = args + Index;
-                break;
-            case c_m3Type_f64:
-                check(Info[Index]->IsNumber());
-                *((double*) (args + Index)) = Info[Index]->NumberValue(Context).ToChecked();
-                argsPointer[Index] = args + Index;
-                break;
-            default:
-                check(0);
+            FV8Utils::ThrowException(Info.GetIsolate(), "invalid argument for wasm function");
+            return;
+        }
+    }
+
+    if (!Export_m3_CallPreparedArgs(_Function))
+    {
+        FV8Utils::ThrowException(Info.GetIsolate(), "call wasm failed");
+        return;
+    }
+    if (FuncType->numRets == 1)
+    {
+        SetWasmReturnValue(Info, FuncType->types[0], ArgStack - 1);
+    }
+}
+
+// 参数全是 i32，返回 i32 或者没有返回值，整数运算的热点函数基本都是这种
+static void Int32InstanceCall(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    uint64* ArgStack = nullptr;
+    IM3Function _Function = GetCallStubFunction(Info, ArgStack);
+    if (!_Function)
+    {
+        return;
+    }
+
+    const uint32 ArgCount = _Function->funcType->numArgs;
+    for (uint32 Index = 0; Index < ArgCount; Index++)
+    {
+        v8::Local<v8::Value> Arg = Info[Index];
+        if (Arg->IsInt32())
+        {
+            *((int32*) (ArgStack + Index)) = Arg.As<v8::Int32>()->Value();
+        }
+        else if (Arg->IsNumber())
+        {
+            *((int32*) (ArgStack + Index)) = Arg->Int32Value(Info.GetIsolate()->GetCurrentContext()).ToChecked();
+        }
+        else
+        {
+            FV8Utils::ThrowException(Info.GetIsolate(), "invalid argument for wasm function");
+            return;
         }
     }
-    if (Export_m3_Call(_Function, argCount, (const void**) argsPointer))
+
+    if (!Export_m3_CallPreparedArgs(_Function))
+    {
+        FV8Utils::ThrowException(Info.GetIsolate(), "call wasm failed");
+        return;
+    }
+    if (_Function->funcType->numRets == 1)
+    {
+        Info.GetReturnValue().Set(*((const int32*) (ArgStack - 1)));
+    }
+}
+
+// 参数全是 f64，返回 f64 或者没有返回值
+static void Float64InstanceCall(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    uint64* ArgStack = nullptr;
+    IM3Function _Function = GetCallStubFunction(Info, ArgStack);
+    if (!_Function)
     {
-        check(_Function->funcType->numRets <= 1);
-        if (_Function->funcType->numRets == 1)
+        return;
+    }
+
+    const uint32 ArgCount = _Function->funcType->numArgs;
+    for (uint32 Index = 0; Index < ArgCount; Index++)
+    {
+        v8::Local<v8::Value> Arg = Info[Index];
+        if (!Arg->IsNumber())
         {
-            int64 RetValue;
-            void* ret[1] = {&RetValue};
-            if (Export_m3_GetResults(_Function, 1, (const void**) ret))
-            {
-                const int type = _Function->funcType->types[0];
-                switch (type)
-                {
-                    case c_m3Type_i32:
-                        Info.GetReturnValue().Set(*((int*) (&RetValue)));
-                        break;
-                    case c_m3Type_i64:
-                        Info.GetReturnValue().Set(v8::BigInt::New(Isolate, RetValue));
-                        break;
-                    case c_m3Type_f32:
-                        Info.GetReturnValue().Set(*((float*) (&RetValue)));
-                        break;
-                    case c_m3Type_f64:
-                        Info.GetReturnValue().Set(*((double*) (&RetValue)));
-                    default:
-                        check(0);
-                }
-            }
-            else
-            {
-                FV8Utils::ThrowException(Isolate, "call wasm get results failed");
-            }
+            FV8Utils::ThrowException(Info.GetIsolate(), "invalid argument for wasm function");
+            return;
         }
+        *((double*) (ArgStack + Index)) = Arg.As<v8::Number>()->Value();
     }
-    else
+
+    if (!Export_m3_CallPreparedArgs(_Function))
+    {
+        FV8Utils::ThrowException(Info.GetIsolate(), "call wasm failed");
+        return;
+    }
+    if (_Function->funcType->numRets == 1)
     {
-        FV8Utils::ThrowException(Isolate, "call wasm failed");
+        Info.GetReturnValue().Set(*((const double*) (ArgStack - 1)));
+    }
+}
+
+// 导出时按签名选好调用函数，调用时不用再逐个判断类型
+static v8::FunctionCallback ResolveInstanceCallStub(IM3Function _Function)
+{
+    IM3FuncType FuncType = _Function->funcType;
+    if (FuncType->numRets > 1)
+    {
+        return NormalInstanceCall;
+    }
+    for (const int Type : {c_m3Type_i32, c_m3Type_f64})
+    {
+        bool Matched = FuncType->numRets == 0 || FuncType->types[0] == Type;
+        for (uint32 Index = 0; Matched && Index < FuncType->numArgs; Index++)
+        {
+            Matched = FuncType->types[FuncType->numRets + Index] == Type;
+        }
+        if (Matched)
+        {
+            return Type == c_m3Type_i32 ? Int32InstanceCall : Float64InstanceCall;
+        }
     }
+    return NormalInstanceCall;
 }
 
 static const void* NormalInstanceLink(IM3Runtime runtime, IM3ImportContext _ctx, uint64_t* _sp, void* _mem)
@@ -312,7 +439,7 @@ WasmRuntime* NormalInstanceModule(v8::Isolate* Isolate, v8::Local<v8::Context>&
             if (f->compiled && f->export_name && *(f->export_name))
             {
                 auto Data = v8::External::New(Isolate, f);
-                auto Func = v8::Function::New(Context, NormalInstanceCall, Data).ToLocalChecked();
+                auto Func = v8::Function::New(Context, ResolveInstanceCallStub(f), Data).ToLocalChecked();
                 Func->Set(Context, FV8Utils::ToV8String(Isolate, M3_FUNCTION_KEY), Data);
                 (void) ExportsObject->Set(Context, FV8Utils::ToV8String(Isolate, f->export_name), Func);
             }
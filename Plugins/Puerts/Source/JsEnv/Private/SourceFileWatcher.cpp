@@ -10,12 +10,31 @@
 #include "DirectoryWatcherModule.h"
 #include "Modules/ModuleManager.h"
 #include "JSLogger.h"
+#include "JSModuleLoader.h"
 #include "Misc/ScopeLock.h"
+#include "Async/Async.h"
 
 namespace PUERTS_NAMESPACE
 {
 FSourceFileWatcher::FSourceFileWatcher(std::function<void(const FString&)> InOnWatchedFileChanged)
-    : OnWatchedFileChanged(InOnWatchedFileChanged)
+    : FSourceFileWatcher(
+          [InOnWatchedFileChanged](const TArray<FString>& ChangedFiles)
+          {
+              if (InOnWatchedFileChanged)
+              {
+                  for (const FString& ChangedFile : ChangedFiles)
+                  {
+                      InOnWatchedFileChanged(ChangedFile);
+                  }
+              }
+          },
+          0.0f)
+{
+}
+
+FSourceFileWatcher::FSourceFileWatcher(
+    std::function<void(const TArray<FString>&)> InOnWatchedFilesChanged, float InQuietWindowSeconds)
+    : QuietWindowSeconds(InQuietWindowSeconds), OnWatchedFilesChanged(InOnWatchedFilesChanged)
 {
 }
 
@@ -46,13 +65,23 @@ void FSourceFileWatcher::OnSourceLoaded(const FString& InPath)
         UE_LOG(Puerts, Log, TEXT("add watched file: %s"), *InPath);
         FMD5Hash Hash = FMD5Hash::HashFile(*InPath);
         WatchedFiles[Dir].Add(FileName, Hash);
+        LoadOrder.Add(Dir / FileName, LoadOrder.Num());
     }
 }
 
 void FSourceFileWatcher::OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
 {
     FScopeLock ScopeLock(&SourceFileWatcherCritical);
-    if (!OnWatchedFileChanged)
+    for (const FFileChangeData& Change : FileChanges)
+    {
+        // 新增、删除文件或者改了 package.json 都可能改变模块的查找结果
+        if (Change.Action != FFileChangeData::FCA_Modified || Change.Filename.EndsWith(TEXT("package.json")))
+        {
+            DefaultJSModuleLoader::InvalidateAllResolutionCaches();
+            break;
+        }
+    }
+    if (!OnWatchedFilesChanged)
         return;
     for (auto Change : FileChanges)
     {
@@ -72,13 +101,9 @@ void FSourceFileWatcher::OnDirectoryChanged(const TArray<FFileChangeData>& FileC
             {
                 if (WatchedFiles[Dir].Contains(FileName))
                 {
-                    FString NotifyPath = Dir + Splitter + FileName;
-                    FMD5Hash Hash = FMD5Hash::HashFile(*NotifyPath);
-                    if (WatchedFiles[Dir][FileName] != Hash)
-                    {
-                        OnWatchedFileChanged(NotifyPath);
-                        WatchedFiles[Dir][FileName] = Hash;
-                    }
+                    // 一次 tsc 输出会连续改很多文件，先收集起来，安静期过后再统一计算哈希
+                    PendingFiles.Add(Dir + Splitter + FileName);
+                    LastChangeTime = FPlatformTime::Seconds();
                 }
             }
             else
@@ -87,6 +112,95 @@ void FSourceFileWatcher::OnDirectoryChanged(const TArray<FFileChangeData>& FileC
             }
         }
     }
+
+    if (PendingFiles.Num() > 0 && !TickerHandle.IsValid())
+    {
+        TickerHandle = FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSourceFileWatcher::Tick));
+    }
+}
+
+bool FSourceFileWatcher::Tick(float DeltaTime)
+{
+    {
+        FScopeLock ScopeLock(&SourceFileWatcherCritical);
+        if (HashTask.IsValid() && !HashTask.IsReady())
+        {
+            return true;
+        }
+    }
+
+    FinishHashTask();
+
+    FScopeLock ScopeLock(&SourceFileWatcherCritical);
+    if (PendingFiles.Num() > 0)
+    {
+        if (FPlatformTime::Seconds() - LastChangeTime >= QuietWindowSeconds)
+        {
+            TArray<FString> FilesToHash = PendingFiles.Array();
+            PendingFiles.Reset();
+            HashTask = Async(EAsyncExecution::ThreadPool,
+                [FilesToHash = MoveTemp(FilesToHash)]()
+                {
+                    TArray<TPair<FString, FMD5Hash>> Hashes;
+                    Hashes.Reserve(FilesToHash.Num());
+                    for (const FString& File : FilesToHash)
+                    {
+                        Hashes.Emplace(File, FMD5Hash::HashFile(*File));
+                    }
+                    return Hashes;
+                });
+        }
+        return true;
+    }
+
+    if (HashTask.IsValid())
+    {
+        return true;
+    }
+
+    TickerHandle.Reset();
+    return false;
+}
+
+void FSourceFileWatcher::FinishHashTask()
+{
+    TArray<FString> ChangedFiles;
+    {
+        FScopeLock ScopeLock(&SourceFileWatcherCritical);
+        if (!HashTask.IsValid())
+        {
+            return;
+        }
+
+        TArray<TPair<FString, FMD5Hash>> Hashes = HashTask.Get();
+        HashTask.Reset();
+
+        for (const TPair<FString, FMD5Hash>& Hash : Hashes)
+        {
+            TMap<FString, FMD5Hash>* DirFiles = WatchedFiles.Find(FPaths::GetPath(Hash.Key));
+            FMD5Hash* WatchedHash = DirFiles ? DirFiles->Find(FPaths::GetCleanFilename(Hash.Key)) : nullptr;
+            if (WatchedHash && *WatchedHash != Hash.Value)
+            {
+                *WatchedHash = Hash.Value;
+                ChangedFiles.Add(Hash.Key);
+            }
+        }
+
+        // 被依赖的模块先重载
+        ChangedFiles.Sort(
+            [this](const FString& A, const FString& B)
+            {
+                const int32* OrderA = LoadOrder.Find(FPaths::GetPath(A) / FPaths::GetCleanFilename(A));
+                const int32* OrderB = LoadOrder.Find(FPaths::GetPath(B) / FPaths::GetCleanFilename(B));
+                return (OrderA ? *OrderA : -1) > (OrderB ? *OrderB : -1);
+            });
+    }
+
+    if (ChangedFiles.Num() > 0)
+    {
+        UE_LOG(Puerts, Log, TEXT("%d watched files changed"), ChangedFiles.Num());
+        OnWatchedFilesChanged(ChangedFiles);
+    }
 }
 
 FSourceFileWatcher::~FSourceFileWatcher()
@@ -96,6 +210,14 @@ FSourceFileWatcher::~FSourceFileWatcher()
     IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get();
 
     FScopeLock ScopeLock(&SourceFileWatcherCritical);
+    if (TickerHandle.IsValid())
+    {
+        FUETicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    }
+    if (HashTask.IsValid())
+    {
+        HashTask.Wait();
+    }
     for (auto KV : WatchedDirs)
     {
         DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(KV.Key, KV.Value);
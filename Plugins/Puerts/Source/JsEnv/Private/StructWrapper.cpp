@@ -376,8 +376,8 @@ v8::Local<v8::FunctionTemplate> FStructWrapper::ToFunctionTemplate(v8::Isolate*
                 auto InnerIsolate = Info.GetIsolate();
                 auto Context = InnerIsolate->GetCurrentContext();
                 auto This = Info.This();
-                FName RequiredFName(*FV8Utils::ToFString(Info.GetIsolate(), Property));
-                auto FixedPropertyName = FV8Utils::ToV8String(InnerIsolate, RequiredFName);
+                IObjectMapper* Mapper = FV8Utils::IsolateData<IObjectMapper>(InnerIsolate);
+                auto FixedPropertyName = Mapper->NameToV8String(InnerIsolate, Mapper->V8StringToName(InnerIsolate, Property));
                 if (This->GetPrototype()->IsObject())
                 {
                     auto Proto = This->GetPrototype().As<v8::Object>();
@@ -420,8 +420,8 @@ v8::Local<v8::FunctionTemplate> FStructWrapper::ToFunctionTemplate(v8::Isolate*
                 auto InnerIsolate = Info.GetIsolate();
                 auto Context = InnerIsolate->GetCurrentContext();
                 auto This = Info.This();
-                FName RequiredFName(*FV8Utils::ToFString(Info.GetIsolate(), Property));
-                auto FixedPropertyName = FV8Utils::ToV8String(InnerIsolate, RequiredFName);
+                IObjectMapper* Mapper = FV8Utils::IsolateData<IObjectMapper>(InnerIsolate);
+                auto FixedPropertyName = Mapper->NameToV8String(InnerIsolate, Mapper->V8StringToName(InnerIsolate, Property));
                 if (This->GetPrototype()->IsObject())
                 {
                     auto Proto = This->GetPrototype().As<v8::Object>();
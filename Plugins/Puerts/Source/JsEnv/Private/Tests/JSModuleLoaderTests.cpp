@@ -0,0 +1,265 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JSModuleLoader.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Internationalization/Regex.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace PUERTS_NAMESPACE
+{
+namespace ModuleLoaderTests
+{
+    // 测试用的脚本目录，模块名都带前缀，不会和项目里的脚本重名
+    static const TCHAR* TestScriptRoot = TEXT("PuertsModuleLoaderTestRoot");
+
+    struct FQuery
+    {
+        FString RequiredDir;
+        FString RequiredModule;
+    };
+
+    struct FResult
+    {
+        bool Found = false;
+        FString Path;
+        FString AbsolutePath;
+    };
+
+    static FResult RunSearch(IJSModuleLoader& Loader, const FQuery& Query)
+    {
+        FResult Result;
+        Result.Found = Loader.Search(Query.RequiredDir, Query.RequiredModule, Result.Path, Result.AbsolutePath);
+        return Result;
+    }
+
+    static void WriteFile(const FString& Path)
+    {
+        FFileHelper::SaveStringToFile(TEXT("module.exports = {};"), *Path);
+    }
+
+    struct FGraphWalk
+    {
+        // 解析到的模块文件，按访问顺序
+        TArray<FString> Modules;
+
+        int32 NumRequires = 0;
+
+        int32 NumUnresolved = 0;
+
+        double Seconds = 0.0;
+    };
+
+    // 和 modular.js 的 require 一样从入口模块出发：每个文件里的每个模块名查找一次，同一个文件只执行一次
+    // 内置模块不经过 Search，跳过
+    static FGraphWalk WalkModuleGraph(DefaultJSModuleLoader& Loader, const FString& EntryModule)
+    {
+        static const TCHAR* BuiltinModules[] = {TEXT("ue"), TEXT("puerts"), TEXT("cpp")};
+        const FRegexPattern RequirePattern(TEXT("require\\(\\s*[\"']([^\"']+)[\"']\\s*\\)"));
+
+        FGraphWalk Walk;
+        TSet<FString> Visited;
+        TArray<TPair<FString, FString>> Pending;
+        Pending.Emplace(TEXT(""), EntryModule);
+
+        const double StartTime = FPlatformTime::Seconds();
+        while (Pending.Num() > 0)
+        {
+            const TPair<FString, FString> Require = Pending.Pop();
+            ++Walk.NumRequires;
+
+            FString Path, AbsolutePath;
+            if (!Loader.Search(Require.Key, Require.Value, Path, AbsolutePath))
+            {
+                ++Walk.NumUnresolved;
+                continue;
+            }
+            bool bAlreadyVisited = false;
+            Visited.Add(Path, &bAlreadyVisited);
+            if (bAlreadyVisited)
+            {
+                continue;
+            }
+            Walk.Modules.Add(Path);
+
+            FString Source;
+            if (Path.EndsWith(TEXT(".json")) || !FFileHelper::LoadFileToString(Source, *Path))
+            {
+                continue;
+            }
+
+            TSet<FString> Specifiers;
+            FRegexMatcher Matcher(RequirePattern, Source);
+            while (Matcher.FindNext())
+            {
+                Specifiers.Add(Matcher.GetCaptureGroup(1));
+            }
+            const FString Dir = FPaths::GetPath(Path);
+            for (const FString& Specifier : Specifiers)
+            {
+                bool bBuiltin = false;
+                for (const TCHAR* Builtin : BuiltinModules)
+                {
+                    bBuiltin |= Specifier == Builtin;
+                }
+                if (!bBuiltin)
+                {
+                    Pending.Emplace(Dir, Specifier);
+                }
+            }
+        }
+        Walk.Seconds = FPlatformTime::Seconds() - StartTime;
+        return Walk;
+    }
+}    // namespace ModuleLoaderTests
+}    // namespace PUERTS_NAMESPACE
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsModuleResolutionCacheTest, "Puerts.JsEnv.ModuleLoader.ResolutionCache",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPuertsModuleResolutionCacheTest::RunTest(const FString& Parameters)
+{
+    using namespace PUERTS_NAMESPACE;
+    using namespace PUERTS_NAMESPACE::ModuleLoaderTests;
+
+    const FString TestDir = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("PuertsModuleLoader"));
+    IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+
+    const FString SubDir = TestDir / TEXT("sub/deeper");
+    WriteFile(TestDir / TEXT("puerts_cache_test_a.js"));
+    WriteFile(SubDir / TEXT("puerts_cache_test_b.js"));
+    WriteFile(TestDir / TEXT("node_modules/puerts_cache_test_pkg/index.js"));
+
+    // 覆盖相对路径、向上查找 node_modules、带扩展名和找不到的情况
+    const TArray<FQuery> Queries = {
+        {TestDir, TEXT("puerts_cache_test_a")},
+        {TestDir, TEXT("puerts_cache_test_a.js")},
+        {SubDir, TEXT("puerts_cache_test_b")},
+        {SubDir, TEXT("puerts_cache_test_pkg")},
+        {TestDir, TEXT("puerts_cache_test_pkg")},
+        {SubDir, TEXT("puerts_cache_test_missing")},
+        {TestDir, TEXT("sub/deeper/puerts_cache_test_b")},
+    };
+
+    DefaultJSModuleLoader UncachedLoader(TestScriptRoot);
+    UncachedLoader.EnableResolutionCache = false;
+    DefaultJSModuleLoader CachedLoader(TestScriptRoot);
+
+    // 冷缓存和热缓存的结果都要和不走缓存的查找一致
+    for (int32 Pass = 0; Pass < 2; ++Pass)
+    {
+        for (const FQuery& Query : Queries)
+        {
+            const FResult Expected = RunSearch(UncachedLoader, Query);
+            const FResult Actual = RunSearch(CachedLoader, Query);
+            const FString What = FString::Printf(TEXT("pass %d: %s from %s"), Pass, *Query.RequiredModule, *Query.RequiredDir);
+            TestEqual(*(What + TEXT(" found")), Actual.Found, Expected.Found);
+            TestEqual(*(What + TEXT(" path")), Actual.Path, Expected.Path);
+            TestEqual(*(What + TEXT(" absolute path")), Actual.AbsolutePath, Expected.AbsolutePath);
+        }
+    }
+
+    const FModuleResolutionStats WarmStats = CachedLoader.GetResolutionStats();
+    TestEqual(TEXT("Second pass is served from the cache"), WarmStats.NumCacheHits, static_cast<uint64>(Queries.Num()));
+
+    // 热缓存不访问文件系统
+    for (const FQuery& Query : Queries)
+    {
+        RunSearch(CachedLoader, Query);
+    }
+    TestEqual(TEXT("Warm searches do not probe the file system"), CachedLoader.GetResolutionStats().NumFileProbes, WarmStats.NumFileProbes);
+
+    // 新增文件后，找不到的缓存结果要在失效后更新
+    const FQuery MissingQuery = {SubDir, TEXT("puerts_cache_test_missing")};
+    WriteFile(SubDir / TEXT("puerts_cache_test_missing.js"));
+    DefaultJSModuleLoader::InvalidateAllResolutionCaches();
+    TestTrue(TEXT("Added module is found after invalidation"), RunSearch(CachedLoader, MissingQuery).Found);
+    TestEqual(TEXT("Invalidated result matches uncached search"), RunSearch(CachedLoader, MissingQuery).Path,
+        RunSearch(UncachedLoader, MissingQuery).Path);
+
+    // 删除之后同理
+    IFileManager::Get().Delete(*(SubDir / TEXT("puerts_cache_test_missing.js")));
+    CachedLoader.InvalidateResolutionCache();
+    TestFalse(TEXT("Removed module is not found after invalidation"), RunSearch(CachedLoader, MissingQuery).Found);
+
+    // ScriptRoot 变化后缓存清空
+    const uint64 HitsBeforeRootChange = CachedLoader.GetResolutionStats().NumCacheHits;
+    CachedLoader.GetScriptRoot() = TEXT("PuertsModuleLoaderOtherTestRoot");
+    RunSearch(CachedLoader, Queries[0]);
+    TestEqual(TEXT("Changing ScriptRoot drops the cache"), CachedLoader.GetResolutionStats().NumCacheHits, HitsBeforeRootChange);
+
+    IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsModuleResolutionColdStartBenchmark, "Puerts.JsEnv.ModuleLoader.ColdStartBenchmark",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FPuertsModuleResolutionColdStartBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace PUERTS_NAMESPACE;
+    using namespace PUERTS_NAMESPACE::ModuleLoaderTests;
+
+    // 游戏实例启动的就是 JavaScript/Main，需要先编译 TypeScript
+    const TCHAR* ScriptRoot = TEXT("JavaScript");
+    const TCHAR* EntryModule = TEXT("Main");
+
+    // 原来的做法：每次 require 都逐个探测文件
+    DefaultJSModuleLoader UncachedLoader(ScriptRoot);
+    UncachedLoader.EnableResolutionCache = false;
+    const FGraphWalk Uncached = WalkModuleGraph(UncachedLoader, EntryModule);
+    if (Uncached.Modules.Num() == 0)
+    {
+        AddWarning(FString::Printf(TEXT("%s/%s.js not found, build the TypeScript output to run the benchmark"), ScriptRoot, EntryModule));
+        return true;
+    }
+
+    // 冷启动，缓存是空的，只有重复的 require 命中
+    DefaultJSModuleLoader CachedLoader(ScriptRoot);
+    CachedLoader.InvalidateResolutionCache();
+    const FGraphWalk Cached = WalkModuleGraph(CachedLoader, EntryModule);
+
+    // 打包后的冷启动，缓存由清单预先填好
+    const FString ManifestPath = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("PuertsModuleLoader/ModuleResolution.manifest"));
+    TestTrue(TEXT("Manifest saved"), CachedLoader.SaveResolutionManifest(ManifestPath));
+    DefaultJSModuleLoader ManifestLoader(ScriptRoot);
+    ManifestLoader.InvalidateResolutionCache();
+    TestTrue(TEXT("Manifest loaded"), ManifestLoader.LoadResolutionManifest(ManifestPath));
+    const FGraphWalk Seeded = WalkModuleGraph(ManifestLoader, EntryModule);
+    IFileManager::Get().Delete(*ManifestPath);
+
+    TestEqual(TEXT("Cached walk resolves the same modules"), Cached.Modules, Uncached.Modules);
+    TestEqual(TEXT("Manifest walk resolves the same modules"), Seeded.Modules, Uncached.Modules);
+
+    const FModuleResolutionStats UncachedStats = UncachedLoader.GetResolutionStats();
+    const FModuleResolutionStats CachedStats = CachedLoader.GetResolutionStats();
+    const FModuleResolutionStats SeededStats = ManifestLoader.GetResolutionStats();
+    TestTrue(TEXT("Cache never probes more than the uncached search"), CachedStats.NumFileProbes <= UncachedStats.NumFileProbes);
+    // 清单里只有找到的结果，找不到的模块名仍然要探测
+    TestTrue(TEXT("Manifest leaves only unresolved requires to probe"), Seeded.NumUnresolved > 0 || SeededStats.NumFileProbes == 0);
+
+    auto Report = [this](const TCHAR* Name, const FGraphWalk& Walk, const FModuleResolutionStats& Stats)
+    {
+        AddInfo(FString::Printf(TEXT("%s: %d modules, %d requires (%d unresolved), %llu searches, %llu cache hits, %llu file probes, search %.3f ms, walk %.3f ms"),
+            Name, Walk.Modules.Num(), Walk.NumRequires, Walk.NumUnresolved, Stats.NumSearches, Stats.NumCacheHits, Stats.NumFileProbes,
+            Stats.SearchSeconds * 1000.0, Walk.Seconds * 1000.0));
+    };
+    Report(TEXT("Uncached"), Uncached, UncachedStats);
+    Report(TEXT("Cold cache"), Cached, CachedStats);
+    Report(TEXT("Manifest"), Seeded, SeededStats);
+
+    return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,131 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JsEnv.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/FileManager.h"
+#include "JSLogger.h"
+#include "JSModuleLoader.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace PUERTS_NAMESPACE
+{
+namespace HeapStatisticsTests
+{
+    static const TCHAR* TestModuleName = TEXT("__puerts_heap_statistics_test");
+
+    // 测试模块只存在于内存里，其他模块照常从脚本目录加载
+    static const char* TestModuleSource = "const retained = [];\n"
+                                          "for (let i = 0; i < 200000; ++i) {\n"
+                                          "    retained.push({ index: i, name: 'item' + i, values: [i, i * 2, i * 3] });\n"
+                                          "}\n"
+                                          "globalThis.__puertsHeapStatisticsTestRetained = retained;\n";
+
+    class FTestModuleLoader : public DefaultJSModuleLoader
+    {
+    public:
+        FTestModuleLoader() : DefaultJSModuleLoader(TEXT("JavaScript"))
+        {
+        }
+
+        virtual bool Search(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath) override
+        {
+            if (RequiredModule == TestModuleName || RequiredModule == FString(TestModuleName) + TEXT(".js"))
+            {
+                Path = FString(TestModuleName) + TEXT(".js");
+                AbsolutePath = Path;
+                return true;
+            }
+            return DefaultJSModuleLoader::Search(RequiredDir, RequiredModule, Path, AbsolutePath);
+        }
+
+        virtual bool Load(const FString& Path, TArray<uint8>& Content) override
+        {
+            if (Path == FString(TestModuleName) + TEXT(".js"))
+            {
+                Content.Append(reinterpret_cast<const uint8*>(TestModuleSource), FCStringAnsi::Strlen(TestModuleSource));
+                return true;
+            }
+            return DefaultJSModuleLoader::Load(Path, Content);
+        }
+    };
+}    // namespace HeapStatisticsTests
+}    // namespace PUERTS_NAMESPACE
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsHeapStatisticsTest, "Puerts.JsEnv.HeapStatistics",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPuertsHeapStatisticsTest::RunTest(const FString& Parameters)
+{
+    using namespace PUERTS_NAMESPACE;
+    using namespace PUERTS_NAMESPACE::HeapStatisticsTests;
+
+    const FString TestDir = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("PuertsHeapStatistics"));
+    IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+    IFileManager::Get().MakeDirectory(*TestDir, true);
+
+    FJsEnv JsEnv(std::make_shared<FTestModuleLoader>(), std::make_shared<FDefaultLogger>(), -1);
+
+    FJsHeapStatistics Before;
+    if (!JsEnv.GetHeapStatistics(Before))
+    {
+        AddInfo(TEXT("Heap statistics are not supported by this script backend"));
+        return true;
+    }
+    TestTrue(TEXT("Heap has spaces"), Before.Spaces.Num() > 0);
+    TestTrue(TEXT("Heap has a native context"), Before.NumberOfNativeContexts > 0);
+
+    TestTrue(TEXT("Start heap sampling"), JsEnv.StartHeapSampling(4096, 16));
+
+    // 脚本里分配二十万个对象并一直持有，使用量至少要涨几MB
+    JsEnv.Start(TestModuleName);
+
+    FJsHeapStatistics After;
+    TestTrue(TEXT("Heap statistics after allocating"), JsEnv.GetHeapStatistics(After));
+    const int64 Growth = static_cast<int64>(After.UsedHeapSize) - static_cast<int64>(Before.UsedHeapSize);
+    AddInfo(FString::Printf(TEXT("Used heap grew from %.2f MB to %.2f MB"), Before.UsedHeapSize / (1024.0 * 1024.0),
+        After.UsedHeapSize / (1024.0 * 1024.0)));
+    TestTrue(TEXT("Used heap grew by at least 4 MB"), Growth >= 4 * 1024 * 1024);
+    TestTrue(TEXT("Used heap fits in the total heap"), After.UsedHeapSize <= After.TotalHeapSize);
+    TestTrue(TEXT("Heap size limit is reported"), After.HeapSizeLimit >= After.TotalHeapSize);
+
+    uint64 SpacesUsed = 0;
+    for (const FJsHeapSpaceStatistics& Space : After.Spaces)
+    {
+        TestFalse(TEXT("Space has a name"), Space.Name.IsEmpty());
+        TestTrue(FString::Printf(TEXT("Space %s used fits in its size"), *Space.Name), Space.UsedSize <= Space.SpaceSize);
+        SpacesUsed += Space.UsedSize;
+    }
+    TestTrue(TEXT("Per-space usage is reported"), SpacesUsed > 0 && SpacesUsed <= After.TotalHeapSize);
+
+    const FString ProfilePath = TestDir / TEXT("Test.heapprofile");
+    TestTrue(TEXT("Stop heap sampling"), JsEnv.StopHeapSampling(ProfilePath));
+    FString Profile;
+    TestTrue(TEXT("Heap profile written"), FFileHelper::LoadFileToString(Profile, *ProfilePath));
+    TestTrue(TEXT("Heap profile has a call tree"), Profile.Contains(TEXT("\"head\"")));
+    TestTrue(TEXT("Heap profile has samples"), Profile.Contains(TEXT("\"selfSize\"")));
+
+    const FString SnapshotPath = TestDir / TEXT("Test.heapsnapshot");
+    TestTrue(TEXT("Write heap snapshot"), JsEnv.WriteHeapSnapshot(SnapshotPath));
+    const int64 SnapshotSize = IFileManager::Get().FileSize(*SnapshotPath);
+    TestTrue(TEXT("Heap snapshot is not empty"), SnapshotSize > 0);
+    FString SnapshotHeader;
+    if (FFileHelper::LoadFileToString(SnapshotHeader, *SnapshotPath))
+    {
+        TestTrue(TEXT("Heap snapshot has snapshot metadata"), SnapshotHeader.StartsWith(TEXT("{\"snapshot\"")));
+    }
+
+    IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+    return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
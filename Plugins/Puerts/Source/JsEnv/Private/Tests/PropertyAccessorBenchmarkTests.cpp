@@ -0,0 +1,157 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JsEnv.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "JSLogger.h"
+#include "JSModuleLoader.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace PUERTS_NAMESPACE
+{
+namespace PropertyAccessorBenchmarkTests
+{
+    // 和下面脚本里的循环次数一致
+    constexpr int32 NumIterations = 10000000;
+
+    static const TCHAR* IntModuleName = TEXT("__puerts_property_int_benchmark");
+    static const TCHAR* VectorModuleName = TEXT("__puerts_property_vector_benchmark");
+
+    // UObject上的int32属性，每次循环一写一读
+    static const char* IntModuleSource = "const target = puerts.argv.getByName('Target');\n"
+                                         "let sum = 0;\n"
+                                         "for (let i = 0; i < 10000000; ++i) {\n"
+                                         "    target.MaxSimulationIterations = i & 0xff;\n"
+                                         "    sum += target.MaxSimulationIterations;\n"
+                                         "}\n"
+                                         "target.HomingAccelerationMagnitude = sum;\n";
+
+    // FVector结构体的X/Y/Z(double)，每次循环四读三写，最后写回UObject方便检查结果
+    static const char* VectorModuleSource = "const UE = require('ue');\n"
+                                            "const target = puerts.argv.getByName('Target');\n"
+                                            "const v = new UE.Vector(0, 0, 0);\n"
+                                            "for (let i = 0; i < 10000000; ++i) {\n"
+                                            "    v.X = v.X + 1;\n"
+                                            "    v.Y = v.X * 0.5;\n"
+                                            "    v.Z = v.Y - v.X;\n"
+                                            "}\n"
+                                            "target.Velocity = v;\n";
+
+    class FTestModuleLoader : public DefaultJSModuleLoader
+    {
+    public:
+        FTestModuleLoader() : DefaultJSModuleLoader(TEXT("JavaScript"))
+        {
+        }
+
+        virtual bool Search(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath) override
+        {
+            for (const TCHAR* ModuleName : {IntModuleName, VectorModuleName})
+            {
+                if (RequiredModule == ModuleName || RequiredModule == FString(ModuleName) + TEXT(".js"))
+                {
+                    Path = FString(ModuleName) + TEXT(".js");
+                    AbsolutePath = Path;
+                    return true;
+                }
+            }
+            return DefaultJSModuleLoader::Search(RequiredDir, RequiredModule, Path, AbsolutePath);
+        }
+
+        virtual bool Load(const FString& Path, TArray<uint8>& Content) override
+        {
+            const char* Source = Path == FString(IntModuleName) + TEXT(".js")      ? IntModuleSource
+                                 : Path == FString(VectorModuleName) + TEXT(".js") ? VectorModuleSource
+                                                                                   : nullptr;
+            if (Source)
+            {
+                Content.Append(reinterpret_cast<const uint8*>(Source), FCStringAnsi::Strlen(Source));
+                return true;
+            }
+            return DefaultJSModuleLoader::Load(Path, Content);
+        }
+    };
+
+    // 类模板是第一次访问时生成的，每次运行都新建一个虚拟机，才能让开关生效
+    static double RunModule(const TCHAR* ModuleName, UObject* Target, bool bUseFastAccessors)
+    {
+        IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("puerts.FastPropertyAccessors"));
+        const bool bPrevious = CVar ? CVar->GetBool() : true;
+        if (CVar)
+        {
+            CVar->Set(bUseFastAccessors, ECVF_SetByCode);
+        }
+
+        double Seconds;
+        {
+            FJsEnv JsEnv(std::make_shared<FTestModuleLoader>(), std::make_shared<FDefaultLogger>(), -1);
+            TArray<TPair<FString, UObject*>> Arguments;
+            Arguments.Add(TPair<FString, UObject*>(TEXT("Target"), Target));
+
+            const double StartTime = FPlatformTime::Seconds();
+            JsEnv.Start(ModuleName, Arguments);
+            Seconds = FPlatformTime::Seconds() - StartTime;
+        }
+
+        if (CVar)
+        {
+            CVar->Set(bPrevious, ECVF_SetByCode);
+        }
+        return Seconds;
+    }
+}    // namespace PropertyAccessorBenchmarkTests
+}    // namespace PUERTS_NAMESPACE
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsPropertyAccessorBenchmark, "Puerts.JsEnv.PropertyAccessors.Benchmark",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FPuertsPropertyAccessorBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace PUERTS_NAMESPACE;
+    using namespace PUERTS_NAMESPACE::PropertyAccessorBenchmarkTests;
+
+    // 引擎自带的类，有int32和FVector属性，测试不需要额外定义UCLASS
+    TStrongObjectPtr<UProjectileMovementComponent> Target(NewObject<UProjectileMovementComponent>(GetTransientPackage()));
+
+    // 0..255循环，每256次的和是固定的
+    const double ExpectedIntSum = static_cast<double>(NumIterations / 256) * (255.0 * 256.0 / 2.0) +
+                                  static_cast<double>((NumIterations % 256) * ((NumIterations % 256) - 1) / 2);
+    const double Iterations = static_cast<double>(NumIterations);
+    const FVector ExpectedVelocity(Iterations, Iterations * 0.5, -Iterations * 0.5);
+
+    for (const bool bUseFastAccessors : {false, true})
+    {
+        const TCHAR* PathName = bUseFastAccessors ? TEXT("fast") : TEXT("generic");
+
+        Target->MaxSimulationIterations = -1;
+        Target->HomingAccelerationMagnitude = 0.0f;
+        const double IntSeconds = RunModule(IntModuleName, Target.Get(), bUseFastAccessors);
+        TestEqual(*FString::Printf(TEXT("%s: last int written"), PathName), Target->MaxSimulationIterations, (NumIterations - 1) & 0xff);
+        TestEqual(*FString::Printf(TEXT("%s: int reads summed"), PathName), static_cast<double>(Target->HomingAccelerationMagnitude),
+            static_cast<double>(static_cast<float>(ExpectedIntSum)));
+
+        Target->Velocity = FVector::ZeroVector;
+        const double VectorSeconds = RunModule(VectorModuleName, Target.Get(), bUseFastAccessors);
+        TestEqual(*FString::Printf(TEXT("%s: vector fields written"), PathName), Target->Velocity, ExpectedVelocity);
+
+        AddInfo(FString::Printf(TEXT("%s accessors, %d iterations: int32 get/set %.1f ms (%.1f ns/iter), FVector X/Y/Z get/set %.1f ms (%.1f ns/iter)"),
+            PathName, NumIterations, IntSeconds * 1000.0, IntSeconds * 1e9 / NumIterations, VectorSeconds * 1000.0,
+            VectorSeconds * 1e9 / NumIterations));
+    }
+
+    return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
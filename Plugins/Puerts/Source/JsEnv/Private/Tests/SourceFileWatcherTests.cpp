@@ -0,0 +1,108 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "SourceFileWatcher.h"
+
+#if WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace PUERTS_NAMESPACE
+{
+namespace SourceFileWatcherTests
+{
+    constexpr float QuietWindowSeconds = 0.1f;
+
+    // 驱动安静期计时和哈希任务，直到回调次数达到 ExpectedCalls 或超时
+    static void TickUntil(const TArray<TArray<FString>>& Batches, int32 ExpectedCalls, double TimeoutSeconds)
+    {
+        const double EndTime = FPlatformTime::Seconds() + TimeoutSeconds;
+        while (Batches.Num() < ExpectedCalls && FPlatformTime::Seconds() < EndTime)
+        {
+            FUETicker::GetCoreTicker().Tick(0.01f);
+            FPlatformProcess::Sleep(0.01f);
+        }
+    }
+
+    static FFileChangeData Modified(const FString& File)
+    {
+        return FFileChangeData(File, FFileChangeData::FCA_Modified);
+    }
+}    // namespace SourceFileWatcherTests
+}    // namespace PUERTS_NAMESPACE
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsSourceFileWatcherBatchTest, "Puerts.JsEnv.SourceFileWatcher.BatchesChanges",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPuertsSourceFileWatcherBatchTest::RunTest(const FString& Parameters)
+{
+    using namespace PUERTS_NAMESPACE;
+    using namespace PUERTS_NAMESPACE::SourceFileWatcherTests;
+
+    const FString TestDir = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("PuertsSourceFileWatcher"));
+    IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+    IFileManager::Get().MakeDirectory(*TestDir, true);
+
+    // 按 require 的顺序加载：main 先加载，它依赖的 util 再依赖 base
+    const FString MainFile = TestDir / TEXT("main.js");
+    const FString UtilFile = TestDir / TEXT("util.js");
+    const FString BaseFile = TestDir / TEXT("base.js");
+    const FString UntouchedFile = TestDir / TEXT("untouched.js");
+    for (const FString& File : {MainFile, UtilFile, BaseFile, UntouchedFile})
+    {
+        FFileHelper::SaveStringToFile(TEXT("exports.version = 1;\n"), *File);
+    }
+
+    TArray<TArray<FString>> Batches;
+    {
+        FSourceFileWatcher Watcher([&Batches](const TArray<FString>& ChangedFiles) { Batches.Add(ChangedFiles); }, QuietWindowSeconds);
+        for (const FString& File : {MainFile, UtilFile, BaseFile, UntouchedFile})
+        {
+            Watcher.OnSourceLoaded(File);
+        }
+
+        // 像一次 tsc 输出一样，分几次通知、每个文件改多次，内容没变的文件也收到通知
+        for (int32 Version = 2; Version <= 4; ++Version)
+        {
+            for (const FString& File : {MainFile, UtilFile, BaseFile})
+            {
+                FFileHelper::SaveStringToFile(FString::Printf(TEXT("exports.version = %d;\n"), Version), *File);
+                Watcher.OnDirectoryChanged({Modified(File)});
+            }
+            Watcher.OnDirectoryChanged({Modified(UntouchedFile)});
+        }
+
+        TickUntil(Batches, 1, 5.0);
+
+        // 再多等几个安静期，确认没有第二次回调
+        TickUntil(Batches, 2, QuietWindowSeconds * 5.0);
+    }
+
+    if (TestEqual(TEXT("Exactly one batched notification"), Batches.Num(), 1))
+    {
+        const TArray<FString>& ChangedFiles = Batches[0];
+        TestEqual(TEXT("Only files whose content changed are reported"), ChangedFiles.Num(), 3);
+        if (ChangedFiles.Num() == 3)
+        {
+            // 越晚加载的越底层，先重载
+            TestTrue(TEXT("base.js is reloaded first"), FPaths::IsSamePath(ChangedFiles[0], BaseFile));
+            TestTrue(TEXT("util.js is reloaded second"), FPaths::IsSamePath(ChangedFiles[1], UtilFile));
+            TestTrue(TEXT("main.js is reloaded last"), FPaths::IsSamePath(ChangedFiles[2], MainFile));
+        }
+    }
+
+    IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+    return true;
+}
+
+#endif    // WITH_EDITOR && WITH_DEV_AUTOMATION_TESTS
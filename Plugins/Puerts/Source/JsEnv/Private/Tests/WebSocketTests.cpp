@@ -0,0 +1,384 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JsEnv.h"
+
+#if defined(WITH_WEBSOCKET) && WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "JSLogger.h"
+#include "JSModuleLoader.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "UECompatible.h"
+
+#ifndef THIRD_PARTY_INCLUDES_START
+#define THIRD_PARTY_INCLUDES_START
+#endif
+
+#ifndef THIRD_PARTY_INCLUDES_END
+#define THIRD_PARTY_INCLUDES_END
+#endif
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#define ASIO_NO_TYPEID    // UE需避免使用RTTI功能
+
+#define ASIO_STANDALONE
+#define _WEBSOCKETPP_CPP11_TYPE_TRAITS_
+#define UI UI_ST
+THIRD_PARTY_INCLUDES_START
+#include "websocketpp/config/asio_no_tls.hpp"
+#include "websocketpp/server.hpp"
+THIRD_PARTY_INCLUDES_END
+#undef UI
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+#include <thread>
+
+namespace PUERTS_NAMESPACE
+{
+namespace WebSocketTests
+{
+    static const TCHAR* EchoModuleName = TEXT("__puerts_websocket_echo_benchmark");
+    static const TCHAR* SendFailModuleName = TEXT("__puerts_websocket_send_fail_test");
+
+    constexpr int32 NumEchoMessages = 100000;
+    constexpr int32 EchoMessageSize = 1024;
+    constexpr int32 EchoWindow = 64;
+
+    // 收到这条文本后服务器主动关闭连接
+    static const char* CloseRequest = "close-me";
+
+    // 本机回环的 echo 服务器，跑在自己的线程上
+    class FEchoServer
+    {
+    public:
+        using wspp_server = websocketpp::server<websocketpp::config::asio>;
+
+        ~FEchoServer()
+        {
+            Stop();
+        }
+
+        bool Start()
+        {
+            Server.set_reuse_addr(true);
+            Server.set_access_channels(websocketpp::log::alevel::none);
+            Server.set_error_channels(websocketpp::log::elevel::none);
+            Server.set_message_handler(
+                [this](websocketpp::connection_hdl Hdl, wspp_server::message_ptr Message)
+                {
+                    websocketpp::lib::error_code ec;
+                    if (Message->get_opcode() == websocketpp::frame::opcode::TEXT && Message->get_payload() == CloseRequest)
+                    {
+                        Server.close(Hdl, websocketpp::close::status::going_away, "", ec);
+                        return;
+                    }
+                    Server.send(Hdl, Message->get_payload(), Message->get_opcode(), ec);
+                });
+
+            websocketpp::lib::error_code ec;
+            Server.init_asio(ec);
+            if (!ec)
+            {
+                // 端口由系统分配，避免和本机其他服务冲突
+                Server.listen("127.0.0.1", "0", ec);
+            }
+            if (!ec)
+            {
+                Server.start_accept(ec);
+            }
+            if (ec)
+            {
+                return false;
+            }
+
+            websocketpp::lib::puerts_asio::error_code aec;
+            Port = Server.get_local_endpoint(aec).port();
+            if (aec)
+            {
+                return false;
+            }
+
+            IoThread = std::thread([this]() { Server.run(); });
+            return true;
+        }
+
+        void Stop()
+        {
+            if (IoThread.joinable())
+            {
+                websocketpp::lib::error_code ec;
+                Server.stop_listening(ec);
+                Server.stop();
+                IoThread.join();
+            }
+        }
+
+        FString GetUrl() const
+        {
+            return FString::Printf(TEXT("ws://127.0.0.1:%d"), Port);
+        }
+
+    private:
+        wspp_server Server;
+
+        std::thread IoThread;
+
+        uint16_t Port = 0;
+    };
+
+    // console.log 的输出交给测试检查结果
+    class FCapturingLogger : public FDefaultLogger
+    {
+    public:
+        void Log(const FString& Message) const override
+        {
+            Lines.Add(Message);
+            FDefaultLogger::Log(Message);
+        }
+
+        const FString* FindLine(const FString& Prefix) const
+        {
+            return Lines.FindByPredicate([&Prefix](const FString& Line) { return Line.StartsWith(Prefix); });
+        }
+
+        mutable TArray<FString> Lines;
+    };
+
+    class FTestModuleLoader : public DefaultJSModuleLoader
+    {
+    public:
+        FTestModuleLoader() : DefaultJSModuleLoader(TEXT("JavaScript"))
+        {
+        }
+
+        virtual bool Search(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath) override
+        {
+            for (const TPair<FString, FString>& Module : Sources)
+            {
+                if (RequiredModule == Module.Key || RequiredModule == Module.Key + TEXT(".js"))
+                {
+                    Path = Module.Key + TEXT(".js");
+                    AbsolutePath = Path;
+                    return true;
+                }
+            }
+            return DefaultJSModuleLoader::Search(RequiredDir, RequiredModule, Path, AbsolutePath);
+        }
+
+        virtual bool Load(const FString& Path, TArray<uint8>& Content) override
+        {
+            if (const FString* Source = Sources.Find(FPaths::GetBaseFilename(Path)))
+            {
+                FTCHARToUTF8 Utf8(**Source);
+                Content.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+                return true;
+            }
+            return DefaultJSModuleLoader::Load(Path, Content);
+        }
+
+        TMap<FString, FString> Sources;
+    };
+
+    // 连接建立后保持 EchoWindow 条消息在路上，每收到一条回显就再发一条，全部收回后输出统计
+    static FString MakeEchoModuleSource(const FString& Url)
+    {
+        return FString::Printf(TEXT("const ws = new WebSocket('%s');\n"
+                                    "const total = %d;\n"
+                                    "const payload = new Uint8Array(%d);\n"
+                                    "let sent = 0;\n"
+                                    "let received = 0;\n"
+                                    "let badSize = 0;\n"
+                                    "let start = 0;\n"
+                                    "ws.addEventListener('open', () => {\n"
+                                    "    start = Date.now();\n"
+                                    "    for (; sent < %d && sent < total; ++sent) ws.send(payload);\n"
+                                    "});\n"
+                                    "ws.addEventListener('message', (ev) => {\n"
+                                    "    if (ev.data.byteLength !== payload.length) ++badSize;\n"
+                                    "    if (++received === total) {\n"
+                                    "        const stats = ws.stats();\n"
+                                    "        console.log(`echo-done ${Date.now() - start} ${badSize} ${stats[0]} ${stats[1]} ${stats[2]}`);\n"
+                                    "        ws.close();\n"
+                                    "    } else if (sent < total) {\n"
+                                    "        ws.send(payload);\n"
+                                    "        ++sent;\n"
+                                    "    }\n"
+                                    "});\n"
+                                    "ws.addEventListener('error', () => console.log('echo-error'));\n"),
+            *Url, NumEchoMessages, EchoMessageSize, EchoWindow);
+    }
+
+    // 服务器关闭连接后，js 还没处理关闭事件就继续发送：
+    // 先停掉轮询让关闭事件留在队列里，等网络线程处理完关闭再发送，然后恢复轮询
+    static FString MakeSendFailModuleSource(const FString& Url)
+    {
+        return FString::Printf(TEXT("const ws = new WebSocket('%s');\n"
+                                    "const events = [];\n"
+                                    "ws.addEventListener('error', () => events.push('error'));\n"
+                                    "ws.addEventListener('close', (ev) => {\n"
+                                    "    events.push('close:' + ev.code);\n"
+                                    "    setTimeout(() => console.log(`send-fail-done ${ws.readyState} ${events.join(',')}`), 10);\n"
+                                    "});\n"
+                                    "ws.addEventListener('open', () => {\n"
+                                    "    clearInterval(ws._tid);\n"
+                                    "    ws.send('%s');\n"
+                                    "    setTimeout(() => {\n"
+                                    "        try {\n"
+                                    "            ws.send('after-close');\n"
+                                    "            events.push('sent');\n"
+                                    "        } catch (e) {\n"
+                                    "            events.push('threw');\n"
+                                    "        }\n"
+                                    "        ws._tid = setInterval(() => ws._poll(), 1);\n"
+                                    "    }, 200);\n"
+                                    "});\n"),
+            *Url, UTF8_TO_TCHAR(CloseRequest));
+    }
+
+    // js 的定时器和 websocket 轮询都挂在 core ticker 上
+    static bool TickUntilLogged(const FCapturingLogger& Logger, const FString& Prefix, double TimeoutSeconds, bool bSleep, FString& OutLine)
+    {
+        const double EndTime = FPlatformTime::Seconds() + TimeoutSeconds;
+        while (FPlatformTime::Seconds() < EndTime)
+        {
+            if (const FString* Line = Logger.FindLine(Prefix))
+            {
+                OutLine = *Line;
+                return true;
+            }
+            FUETicker::GetCoreTicker().Tick(0.001f);
+            FPlatformProcess::Sleep(bSleep ? 0.001f : 0.0f);
+        }
+        return false;
+    }
+}    // namespace WebSocketTests
+}    // namespace PUERTS_NAMESPACE
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsWebSocketEchoBenchmark, "Puerts.JsEnv.WebSocket.EchoBenchmark",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FPuertsWebSocketEchoBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace PUERTS_NAMESPACE;
+    using namespace PUERTS_NAMESPACE::WebSocketTests;
+
+    FEchoServer Server;
+    if (!TestTrue(TEXT("Echo server listening"), Server.Start()))
+    {
+        return false;
+    }
+
+    auto Loader = std::make_shared<FTestModuleLoader>();
+    Loader->Sources.Add(EchoModuleName, MakeEchoModuleSource(Server.GetUrl()));
+    auto Logger = std::make_shared<FCapturingLogger>();
+
+    FString Result;
+    bool bDone = false;
+    {
+        FJsEnv JsEnv(Loader, Logger, -1);
+        JsEnv.Start(EchoModuleName);
+        bDone = TickUntilLogged(*Logger, TEXT("echo-done"), 60.0, false, Result);
+        TestNull(TEXT("No error event"), Logger->FindLine(TEXT("echo-error")));
+    }
+    Server.Stop();
+
+    if (!TestTrue(TEXT("All echoes received"), bDone))
+    {
+        return false;
+    }
+
+    // echo-done <ms> <badSize> <messagesReceived> <messagesSent> <bytesCopied>
+    TArray<FString> Fields;
+    Result.ParseIntoArrayWS(Fields);
+    if (!TestEqual(TEXT("Result fields"), Fields.Num(), 6))
+    {
+        return false;
+    }
+    const double Milliseconds = FCString::Atod(*Fields[1]);
+    const int64 BadSize = FCString::Atoi64(*Fields[2]);
+    const int64 MessagesReceived = FCString::Atoi64(*Fields[3]);
+    const int64 MessagesSent = FCString::Atoi64(*Fields[4]);
+    const int64 BytesCopied = FCString::Atoi64(*Fields[5]);
+    const int64 PayloadBytes = static_cast<int64>(NumEchoMessages) * EchoMessageSize;
+
+    TestEqual(TEXT("Echoes have the sent size"), BadSize, 0ll);
+    TestEqual(TEXT("Messages received"), MessagesReceived, static_cast<int64>(NumEchoMessages));
+    TestEqual(TEXT("Messages sent"), MessagesSent, static_cast<int64>(NumEchoMessages));
+    // 发送拷贝一次；接收在能接管内存的后端上不拷贝，其余后端拷贝一次
+    TestTrue(TEXT("At most one copy per direction"), BytesCopied >= PayloadBytes && BytesCopied <= PayloadBytes * 2);
+
+    AddInfo(FString::Printf(TEXT("%d x %d byte echoes in %.1f ms: %.0f messages/s, %.2f bytes copied per payload byte"),
+        NumEchoMessages, EchoMessageSize, Milliseconds, Milliseconds > 0.0 ? NumEchoMessages * 1000.0 / Milliseconds : 0.0,
+        static_cast<double>(BytesCopied) / PayloadBytes));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsWebSocketSendFailTest, "Puerts.JsEnv.WebSocket.SendAfterRemoteClose",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPuertsWebSocketSendFailTest::RunTest(const FString& Parameters)
+{
+    using namespace PUERTS_NAMESPACE;
+    using namespace PUERTS_NAMESPACE::WebSocketTests;
+
+    FEchoServer Server;
+    if (!TestTrue(TEXT("Echo server listening"), Server.Start()))
+    {
+        return false;
+    }
+
+    auto Loader = std::make_shared<FTestModuleLoader>();
+    Loader->Sources.Add(SendFailModuleName, MakeSendFailModuleSource(Server.GetUrl()));
+    auto Logger = std::make_shared<FCapturingLogger>();
+
+    FString Result;
+    bool bDone = false;
+    {
+        FJsEnv JsEnv(Loader, Logger, -1);
+        JsEnv.Start(SendFailModuleName);
+        bDone = TickUntilLogged(*Logger, TEXT("send-fail-done"), 10.0, true, Result);
+    }
+    Server.Stop();
+
+    if (!TestTrue(TEXT("Socket closed"), bDone))
+    {
+        return false;
+    }
+
+    // send-fail-done <readyState> <events>
+    TArray<FString> Fields;
+    Result.ParseIntoArrayWS(Fields);
+    if (!TestEqual(TEXT("Result fields"), Fields.Num(), 3))
+    {
+        return false;
+    }
+    TestEqual(TEXT("Socket is CLOSED"), Fields[1], FString(TEXT("3")));
+
+    TArray<FString> Events;
+    Fields[2].ParseIntoArray(Events, TEXT(","));
+    AddInfo(FString::Printf(TEXT("Events: %s"), *Fields[2]));
+
+    // send 失败不会抛到 js：
+    // 连接已经释放时同步失败，派发 error 再以 1006 关闭；
+    // 否则由网络线程发送失败，这时服务器的关闭已经先到，js 只收到服务器的关闭码，随后的 ON_FAIL 在 Cleanup 后丢弃
+    if (TestTrue(TEXT("send did not throw"), Events.Num() >= 2 && Events[0] == TEXT("sent")))
+    {
+        const bool bFailedInSend = Events.Num() == 3 && Events[1] == TEXT("error") && Events[2] == TEXT("close:1006");
+        const bool bFailedOnIoThread = Events.Num() == 2 && Events[1] == FString::Printf(TEXT("close:%d"),
+                                                                              websocketpp::close::status::going_away);
+        TestTrue(TEXT("Exactly one close event, preceded by error when the socket failed"), bFailedInSend || bFailedOnIoThread);
+    }
+
+    return true;
+}
+
+#endif    // defined(WITH_WEBSOCKET) && WITH_DEV_AUTOMATION_TESTS
@@ -43,7 +43,18 @@ THIRD_PARTY_INCLUDES_END
 #undef UI
 PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 
+#include <atomic>
+#include <memory>
 #include <sstream>
+#include <thread>
+
+// 收到的二进制消息直接交给 ArrayBuffer 持有，不再拷贝一次
+#if defined(HAS_ARRAYBUFFER_NEW_WITHOUT_STL) || \
+    !(V8_MAJOR_VERSION < 8 || defined(WITH_QUICKJS) || defined(WITH_NODEJS) || (WITH_EDITOR && !defined(FORCE_USE_STATIC_V8_LIB)))
+#define WEBSOCKET_ADOPT_BINARY_PAYLOAD 1
+#else
+#define WEBSOCKET_ADOPT_BINARY_PAYLOAD 0
+#endif
 
 namespace PUERTS_NAMESPACE
 {
@@ -75,11 +86,64 @@ public:
 };
 #endif
 
+// 多生产者单消费者的无锁队列，ConsumeAll 按入队顺序取出当前所有元素
+template <typename T>
+class LockFreeEventQueue
+{
+public:
+    ~LockFreeEventQueue()
+    {
+        ConsumeAll([](T&&) {});
+    }
+
+    // 返回入队前队列是否为空
+    bool Push(T&& Value)
+    {
+        Node* NewNode = new Node{std::move(Value), Head.load(std::memory_order_relaxed)};
+        while (!Head.compare_exchange_weak(NewNode->Next, NewNode, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        return NewNode->Next == nullptr;
+    }
+
+    template <typename Func>
+    void ConsumeAll(Func&& Consumer)
+    {
+        Node* Reversed = Head.exchange(nullptr, std::memory_order_acquire);
+        Node* Ordered = nullptr;
+        while (Reversed)
+        {
+            Node* Next = Reversed->Next;
+            Reversed->Next = Ordered;
+            Ordered = Reversed;
+            Reversed = Next;
+        }
+        while (Ordered)
+        {
+            Node* Next = Ordered->Next;
+            Consumer(std::move(Ordered->Value));
+            delete Ordered;
+            Ordered = Next;
+        }
+    }
+
+private:
+    struct Node
+    {
+        T Value;
+        Node* Next;
+    };
+
+    std::atomic<Node*> Head{nullptr};
+};
+
 class V8WebSocketClientImpl
 {
 public:
     V8WebSocketClientImpl(v8::Isolate* InIsolate, v8::Local<v8::Context> InContext, v8::Local<v8::Object> InSelf);
 
+    ~V8WebSocketClientImpl();
+
 #if defined(WITH_WEBSOCKET_SSL)
     using wspp_client = websocketpp::client<websocketpp::config::asio_tls>;
 #else
@@ -92,6 +156,8 @@ public:
 
     using wspp_exception = websocketpp::exception;
 
+    using wspp_opcode = websocketpp::frame::opcode::value;
+
     enum HandlerType
     {
         ON_OPEN,
@@ -111,11 +177,25 @@ public:
 
     void Statue(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    void Stats(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
     void CloseImmediately(websocketpp::close::status::value const code, std::string const& reason);
 
+    // 游戏线程每帧调用一次，把网络线程收到的事件一次性派发给 js
     void PollOne();
 
 private:
+    struct Event
+    {
+        HandlerType Type;
+        wspp_opcode Opcode;
+        std::string* Payload;    // ON_MESSAGE 的内容，派发时交给 ArrayBuffer 或者释放
+        wspp_connection_hdl Handle;
+        int32_t CloseCode;
+        std::string Reason;
+    };
+
+    // 以下四个在网络线程上执行，只入队，不碰 v8
     void OnOpen(wspp_connection_hdl Handle);
 
     void OnMessage(wspp_connection_hdl Handle, wspp_message_ptr Message);
@@ -124,6 +204,15 @@ private:
 
     void OnFail(wspp_connection_hdl Handle);
 
+    void DispatchEvent(Event& InEvent);
+
+    v8::Local<v8::Value> TakeBinaryPayload(std::string* Payload);
+
+    // 在网络线程上把排队的消息一起发出去，发送失败时入队一个 ON_FAIL 事件，由游戏线程通知 js
+    void FlushOutgoing(wspp_connection_hdl InHandle);
+
+    void StopIoThread();
+
     void Cleanup();
 
 private:
@@ -140,6 +229,18 @@ private:
     bool Connenting = false;
 
     v8::Global<v8::Function> Handles[HANDLE_TYPE_END];
+
+    std::thread IoThread;
+
+    LockFreeEventQueue<Event> IncomingEvents;
+
+    LockFreeEventQueue<wspp_message_ptr> OutgoingMessages;
+
+    uint64_t MessagesReceived = 0;
+
+    uint64_t MessagesSent = 0;
+
+    uint64_t BytesCopied = 0;
 };
 
 static void OnGarbageCollectedWithFree(const v8::WeakCallbackInfo<V8WebSocketClientImpl>& Data)
@@ -156,6 +257,12 @@ V8WebSocketClientImpl::V8WebSocketClientImpl(v8::Isolate* InIsolate, v8::Local<v
     // UE_LOG(LogTemp, Warning, TEXT(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> set weak %p"), this);
 }
 
+V8WebSocketClientImpl::~V8WebSocketClientImpl()
+{
+    StopIoThread();
+    IncomingEvents.ConsumeAll([](Event&& InEvent) { delete InEvent.Payload; });
+}
+
 #if defined(WITH_WEBSOCKET_SSL)
 websocketpp::lib::shared_ptr<puerts_asio::ssl::context> on_tls_init(websocketpp::connection_hdl)
 {
@@ -198,6 +305,9 @@ void V8WebSocketClientImpl::Connect(const v8::FunctionCallbackInfo<v8::Value>& I
     // exchanged until the event loop starts running in the next line.
     Client.connect(con);
     Connenting = true;
+
+    // 收发都在网络线程上进行，连接断开后 run 返回
+    IoThread = std::thread([this]() { Client.run(); });
 }
 
 void V8WebSocketClientImpl::Send(const v8::FunctionCallbackInfo<v8::Value>& Info)
@@ -209,14 +319,26 @@ void V8WebSocketClientImpl::Send(const v8::FunctionCallbackInfo<v8::Value>& Info
     }
     websocketpp::lib::error_code ec;
 
+    wspp_client::connection_ptr con = Client.get_con_from_hdl(Handle, ec);
+    if (ec)
+    {
+        std::stringstream ss;
+        ss << "could send because: " << ec.message() << "[" << ec.value() << "]" << std::endl;
+        FV8Utils::ThrowException(Isolate, ss.str().c_str());
+        return;
+    }
+
     auto Value = Info[0];
     const void* bin = nullptr;
     size_t bin_len = 0;
+    wspp_opcode opcode = websocketpp::frame::opcode::BINARY;
+    std::unique_ptr<v8::String::Utf8Value> str;
     if (Value->IsString())
     {
-        v8::String::Utf8Value str(Isolate, Value);
-        std::string payload(*str, str.length());
-        Client.send(Handle, payload, websocketpp::frame::opcode::TEXT, ec);
+        str.reset(new v8::String::Utf8Value(Isolate, Value));
+        bin = **str;
+        bin_len = str->length();
+        opcode = websocketpp::frame::opcode::TEXT;
     }
     else if (Value->IsArrayBufferView())
     {
@@ -238,19 +360,42 @@ void V8WebSocketClientImpl::Send(const v8::FunctionCallbackInfo<v8::Value>& Info
         return;
     }
 
-    if (bin)
-    {
-        Client.send(Handle, bin, bin_len, websocketpp::frame::opcode::BINARY, ec);
-    }
+    // js 的内存随时可能被改写或回收，这里拷贝一次到消息里，之后不再拷贝
+    wspp_message_ptr msg = con->get_message(opcode, bin_len);
+    msg->set_payload(bin, bin_len);
+    BytesCopied += bin_len;
+    ++MessagesSent;
 
-    if (ec)
+    // 队列原来是空的才需要投递一次发送，同一帧里后续的消息会在那一次里一起发出
+    if (OutgoingMessages.Push(std::move(msg)))
     {
-        std::stringstream ss;
-        ss << "could send because: " << ec.message() << "[" << ec.value() << "]" << std::endl;
-        FV8Utils::ThrowException(Isolate, ss.str().c_str());
+        Client.get_io_service().post(std::bind(&V8WebSocketClientImpl::FlushOutgoing, this, Handle));
     }
 }
 
+void V8WebSocketClientImpl::FlushOutgoing(wspp_connection_hdl InHandle)
+{
+    bool Failed = false;
+    OutgoingMessages.ConsumeAll(
+        [this, &InHandle, &Failed](wspp_message_ptr&& msg)
+        {
+            // 连接已经出错，剩下的消息直接丢弃，只上报第一个错误
+            if (Failed)
+            {
+                return;
+            }
+            websocketpp::lib::error_code ec;
+            Client.send(InHandle, msg, ec);
+            if (ec)
+            {
+                Failed = true;
+                std::stringstream ss;
+                ss << "send fail: " << ec.message() << "[" << ec.value() << "]" << std::endl;
+                IncomingEvents.Push(Event{ON_FAIL, websocketpp::frame::opcode::TEXT, nullptr, InHandle, 0, ss.str()});
+            }
+        });
+}
+
 void V8WebSocketClientImpl::SetHandles(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     for (int i = 0; i < HANDLE_TYPE_END; ++i)
@@ -325,6 +470,18 @@ void V8WebSocketClientImpl::Statue(const v8::FunctionCallbackInfo<v8::Value>& In
     Info.GetReturnValue().Set(res);
 }
 
+void V8WebSocketClientImpl::Stats(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    auto isolate = Info.GetIsolate();
+    auto context = isolate->GetCurrentContext();
+    auto res = v8::Array::New(isolate);
+
+    res->Set(context, 0, v8::Number::New(isolate, static_cast<double>(MessagesReceived))).Check();
+    res->Set(context, 1, v8::Number::New(isolate, static_cast<double>(MessagesSent))).Check();
+    res->Set(context, 2, v8::Number::New(isolate, static_cast<double>(BytesCopied))).Check();
+    Info.GetReturnValue().Set(res);
+}
+
 void V8WebSocketClientImpl::CloseImmediately(websocketpp::close::status::value const code, std::string const& reason)
 {
     if (!Handle.expired())
@@ -333,97 +490,152 @@ void V8WebSocketClientImpl::CloseImmediately(websocketpp::close::status::value c
         Client.close(Handle, code, reason, ec);
     }
 
-    Client.stop();
+    StopIoThread();
     Cleanup();
 }
 
-void V8WebSocketClientImpl::PollOne()
+void V8WebSocketClientImpl::StopIoThread()
 {
-    if (Connenting || !Handle.expired())
+    Client.stop();
+    if (IoThread.joinable() && IoThread.get_id() != std::this_thread::get_id())
     {
-        Client.poll_one();
+        IoThread.join();
     }
 }
 
-void V8WebSocketClientImpl::OnOpen(wspp_connection_hdl InHandle)
+void V8WebSocketClientImpl::PollOne()
 {
-    Handle = InHandle;
-    Connenting = false;
+    IncomingEvents.ConsumeAll(
+        [this](Event&& InEvent)
+        {
+            // Cleanup 之后的事件直接丢弃
+            if (Isolate)
+            {
+                DispatchEvent(InEvent);
+            }
+            delete InEvent.Payload;
+        });
+}
 
-    v8::Isolate::Scope IsolateScope(Isolate);
-    v8::HandleScope HandleScope(Isolate);
-    if (!Handles[ON_OPEN].IsEmpty())
-    {
-        v8::Local<v8::Value> args[1];
-        // must not raise exception in js, recommend just push a pending msg and process later.
-        Handles[ON_OPEN].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 0, args);
-    }
+void V8WebSocketClientImpl::OnOpen(wspp_connection_hdl InHandle)
+{
+    IncomingEvents.Push(Event{ON_OPEN, websocketpp::frame::opcode::TEXT, nullptr, InHandle, 0, std::string()});
 }
 
 void V8WebSocketClientImpl::OnMessage(wspp_connection_hdl InHandle, wspp_message_ptr InMessage)
 {
-    v8::Isolate::Scope IsolateScope(Isolate);
-    v8::HandleScope HandleScope(Isolate);
-
-    if (!Handles[ON_MESSAGE].IsEmpty())
-    {
-        v8::Local<v8::Value> args[1];
-        if (InMessage->get_opcode() == websocketpp::frame::opcode::TEXT)
-        {
-            args[0] = v8::String::NewFromUtf8(
-                Isolate, InMessage->get_payload().c_str(), v8::NewStringType::kNormal, InMessage->get_payload().size())
-                          .ToLocalChecked();
-        }
-        else if (InMessage->get_opcode() == websocketpp::frame::opcode::BINARY)
-        {
-            v8::Local<v8::ArrayBuffer> Ab = v8::ArrayBuffer::New(Isolate, InMessage->get_payload().size());
-            void* Buff = DataTransfer::GetArrayBufferData(Ab);
-            ::memcpy(Buff, InMessage->get_payload().data(), InMessage->get_payload().size());
-            args[0] = Ab;
-        }
-        else
-        {
-            args[0] = v8::Undefined(Isolate);
-        }
-        // must not raise exception in js, recommend just push a pending msg and process later.
-        Handles[ON_MESSAGE].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 1, args);
-    }
+    // 直接接管消息的内容，派发时交给 ArrayBuffer
+    std::string* Payload = new std::string(std::move(InMessage->get_raw_payload()));
+    IncomingEvents.Push(Event{ON_MESSAGE, InMessage->get_opcode(), Payload, InHandle, 0, std::string()});
 }
 
 void V8WebSocketClientImpl::OnClose(wspp_connection_hdl InHandle)
 {
-    v8::Isolate::Scope IsolateScope(Isolate);
-    v8::HandleScope HandleScope(Isolate);
-
-    if (!Handles[ON_CLOSE].IsEmpty())
-    {
-        wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle);
-        v8::Local<v8::Value> args[2] = {v8::Integer::New(Isolate, con->get_remote_close_code()),
-            v8::String::NewFromUtf8(
-                Isolate, con->get_remote_close_reason().c_str(), v8::NewStringType::kNormal, con->get_remote_close_reason().size())
-                .ToLocalChecked()};
-        // must not raise exception in js, recommend just push a pending msg and process later.
-        Handles[ON_CLOSE].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 2, args);
-    }
-    Cleanup();
+    wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle);
+    IncomingEvents.Push(Event{ON_CLOSE, websocketpp::frame::opcode::TEXT, nullptr, InHandle, con->get_remote_close_code(),
+        con->get_remote_close_reason()});
 }
 
 void V8WebSocketClientImpl::OnFail(wspp_connection_hdl InHandle)
+{
+    wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle);
+    std::stringstream ss;
+    ss << "on fail: " << con->get_ec().message() << "[" << con->get_ec().value() << "]" << std::endl;
+    IncomingEvents.Push(Event{ON_FAIL, websocketpp::frame::opcode::TEXT, nullptr, InHandle, 0, ss.str()});
+}
+
+v8::Local<v8::Value> V8WebSocketClientImpl::TakeBinaryPayload(std::string* Payload)
+{
+    auto Deleter = [](void* Data, size_t Length, void* DeleterData) { delete static_cast<std::string*>(DeleterData); };
+#if defined(HAS_ARRAYBUFFER_NEW_WITHOUT_STL)
+    return v8::ArrayBuffer_New_Without_Stl(Isolate, &(*Payload)[0], Payload->size(), Deleter, Payload);
+#elif WEBSOCKET_ADOPT_BINARY_PAYLOAD
+    auto Backing = v8::ArrayBuffer::NewBackingStore(&(*Payload)[0], Payload->size(), Deleter, Payload);
+    return v8::ArrayBuffer::New(Isolate, std::move(Backing));
+#else
+    v8::Local<v8::ArrayBuffer> Ab = v8::ArrayBuffer::New(Isolate, Payload->size());
+    void* Buff = DataTransfer::GetArrayBufferData(Ab);
+    ::memcpy(Buff, Payload->data(), Payload->size());
+    BytesCopied += Payload->size();
+    delete Payload;
+    return Ab;
+#endif
+}
+
+void V8WebSocketClientImpl::DispatchEvent(Event& InEvent)
 {
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
 
-    if (!Handles[ON_FAIL].IsEmpty())
+    switch (InEvent.Type)
     {
-        wspp_client::connection_ptr con = Client.get_con_from_hdl(InHandle);
-        std::stringstream ss;
-        ss << "on fail: " << con->get_ec().message() << "[" << con->get_ec().value() << "]" << std::endl;
-        v8::Local<v8::Value> args[1] = {
-            v8::String::NewFromUtf8(Isolate, ss.str().c_str(), v8::NewStringType::kNormal, ss.str().size()).ToLocalChecked()};
-        // must not raise exception in js, recommend just push a pending msg and process later.
-        Handles[ON_FAIL].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 1, args);
+        case ON_OPEN:
+        {
+            Handle = InEvent.Handle;
+            Connenting = false;
+            if (!Handles[ON_OPEN].IsEmpty())
+            {
+                v8::Local<v8::Value> args[1];
+                // must not raise exception in js, recommend just push a pending msg and process later.
+                Handles[ON_OPEN].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 0, args);
+            }
+            break;
+        }
+        case ON_MESSAGE:
+        {
+            ++MessagesReceived;
+            if (!Handles[ON_MESSAGE].IsEmpty())
+            {
+                v8::Local<v8::Value> args[1];
+                if (InEvent.Opcode == websocketpp::frame::opcode::TEXT)
+                {
+                    args[0] = v8::String::NewFromUtf8(
+                        Isolate, InEvent.Payload->c_str(), v8::NewStringType::kNormal, InEvent.Payload->size())
+                                  .ToLocalChecked();
+                }
+                else if (InEvent.Opcode == websocketpp::frame::opcode::BINARY)
+                {
+                    args[0] = TakeBinaryPayload(InEvent.Payload);
+                    InEvent.Payload = nullptr;
+                }
+                else
+                {
+                    args[0] = v8::Undefined(Isolate);
+                }
+                // must not raise exception in js, recommend just push a pending msg and process later.
+                Handles[ON_MESSAGE].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 1, args);
+            }
+            break;
+        }
+        case ON_CLOSE:
+        {
+            if (!Handles[ON_CLOSE].IsEmpty())
+            {
+                v8::Local<v8::Value> args[2] = {v8::Integer::New(Isolate, InEvent.CloseCode),
+                    v8::String::NewFromUtf8(Isolate, InEvent.Reason.c_str(), v8::NewStringType::kNormal, InEvent.Reason.size())
+                        .ToLocalChecked()};
+                // must not raise exception in js, recommend just push a pending msg and process later.
+                Handles[ON_CLOSE].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 2, args);
+            }
+            Cleanup();
+            break;
+        }
+        case ON_FAIL:
+        {
+            if (!Handles[ON_FAIL].IsEmpty())
+            {
+                v8::Local<v8::Value> args[1] = {
+                    v8::String::NewFromUtf8(Isolate, InEvent.Reason.c_str(), v8::NewStringType::kNormal, InEvent.Reason.size())
+                        .ToLocalChecked()};
+                // must not raise exception in js, recommend just push a pending msg and process later.
+                Handles[ON_FAIL].Get(Isolate)->Call(GContext.Get(Isolate), v8::Undefined(Isolate), 1, args);
+            }
+            CloseImmediately(websocketpp::close::status::abnormal_close, "");
+            break;
+        }
+        default:
+            break;
     }
-    CloseImmediately(websocketpp::close::status::abnormal_close, "");
 }
 
 }    // namespace PUERTS_NAMESPACE
@@ -470,6 +682,13 @@ void InitWebsocketPPWrap(v8::Local<v8::Context> Context)
                     ->Statue(Info);
             }));
 
+    WSTemplate->PrototypeTemplate()->Set(v8::String::NewFromUtf8(Isolate, "stats").ToLocalChecked(),
+        v8::FunctionTemplate::New(Isolate,
+            [](const v8::FunctionCallbackInfo<v8::Value>& Info) {
+                static_cast<PUERTS_NAMESPACE::V8WebSocketClientImpl*>(Info.Holder()->GetAlignedPointerFromInternalField(0))
+                    ->Stats(Info);
+            }));
+
     WSTemplate->PrototypeTemplate()->Set(v8::String::NewFromUtf8(Isolate, "poll").ToLocalChecked(),
         v8::FunctionTemplate::New(Isolate,
             [](const v8::FunctionCallbackInfo<v8::Value>& Info)
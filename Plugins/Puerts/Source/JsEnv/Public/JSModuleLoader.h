@@ -28,12 +28,24 @@ public:
     }
 };
 
+struct FModuleResolutionStats
+{
+    uint64 NumSearches = 0;
+
+    uint64 NumCacheHits = 0;
+
+    // 实际访问文件系统的次数（FileExists）
+    uint64 NumFileProbes = 0;
+
+    double SearchSeconds = 0;
+};
+
 class JSENV_API DefaultJSModuleLoader : public IJSModuleLoader
 {
 public:
-    explicit DefaultJSModuleLoader(const FString& InScriptRoot) : ScriptRoot(InScriptRoot)
-    {
-    }
+    explicit DefaultJSModuleLoader(const FString& InScriptRoot);
+
+    virtual ~DefaultJSModuleLoader();
 
     virtual bool Search(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath) override;
 
@@ -47,7 +59,46 @@ public:
 
     virtual bool SearchModuleWithExtInDir(const FString& Dir, const FString& RequiredModule, FString& Path, FString& AbsolutePath);
 
+    // 不经过缓存的查找，Search 未命中缓存时调用
+    virtual bool SearchUncached(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath);
+
+    void InvalidateResolutionCache();
+
+    // 所有 DefaultJSModuleLoader 的缓存在下一次 Search 时清空，源码目录有文件增删时由 FSourceFileWatcher 调用
+    static void InvalidateAllResolutionCaches();
+
+    // 用打包时生成的清单预先填充缓存，清单里的路径以 {Content} 代替 ProjectContentDir
+    bool LoadResolutionManifest(const FString& ManifestPath);
+
+    bool SaveResolutionManifest(const FString& ManifestPath);
+
+    FModuleResolutionStats GetResolutionStats();
+
+    void LogResolutionStats();
+
     FString ScriptRoot;
+
+    bool EnableResolutionCache = true;
+
+private:
+    struct FModuleResolution
+    {
+        bool Found = false;
+        FString Path;
+        FString AbsolutePath;
+    };
+
+    // (RequiredDir, RequiredModule) -> 查找结果，找不到的结果也缓存
+    TMap<FString, FModuleResolution> ResolutionCache;
+
+    uint32 ResolutionCacheEpoch = 0;
+
+    // ScriptRoot 可以通过 GetScriptRoot 修改，变了之后缓存要清空
+    FString ResolutionCacheScriptRoot;
+
+    FModuleResolutionStats ResolutionStats;
+
+    FCriticalSection ResolutionCacheCritical;
 };
 
 }    // namespace PUERTS_NAMESPACE
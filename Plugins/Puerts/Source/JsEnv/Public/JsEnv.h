@@ -22,6 +22,29 @@
 
 namespace PUERTS_NAMESPACE
 {
+struct FJsHeapSpaceStatistics
+{
+    FString Name;
+    uint64 SpaceSize = 0;
+    uint64 UsedSize = 0;
+    uint64 AvailableSize = 0;
+    uint64 PhysicalSize = 0;
+};
+
+struct FJsHeapStatistics
+{
+    uint64 TotalHeapSize = 0;
+    uint64 TotalPhysicalSize = 0;
+    uint64 TotalAvailableSize = 0;
+    uint64 UsedHeapSize = 0;
+    uint64 HeapSizeLimit = 0;
+    uint64 MallocedMemory = 0;
+    uint64 ExternalMemory = 0;
+    uint64 NumberOfNativeContexts = 0;
+    uint64 NumberOfDetachedContexts = 0;
+    TArray<FJsHeapSpaceStatistics> Spaces;
+};
+
 class JSENV_API IJsEnv
 {
 public:
@@ -47,12 +70,23 @@ public:
 
     virtual void ReloadSource(const FString& Path, const PString& JsSource) = 0;
 
+    // 一批文件一起重载，按数组顺序执行（被依赖的放前面），只进一次 JS
+    virtual void ReloadSources(const TArray<TPair<FString, PString>>& Sources) = 0;
+
     virtual void OnSourceLoaded(std::function<void(const FString&)> Callback) = 0;
 
     virtual FString CurrentStackTrace() = 0;
 
     virtual void InitExtensionMethodsMap() = 0;
 
+    virtual bool GetHeapStatistics(FJsHeapStatistics& OutStatistics) = 0;
+
+    virtual bool WriteHeapSnapshot(const FString& FilePath) = 0;
+
+    virtual bool StartHeapSampling(uint64 SampleInterval, int32 StackDepth) = 0;
+
+    virtual bool StopHeapSampling(const FString& FilePath) = 0;
+
     virtual ~IJsEnv()
     {
     }
@@ -88,6 +122,8 @@ public:
 
     void ReloadSource(const FString& Path, const PString& JsSource);
 
+    void ReloadSources(const TArray<TPair<FString, PString>>& Sources);
+
     void OnSourceLoaded(std::function<void(const FString&)> Callback);
 
     void RebindJs();
@@ -96,6 +132,18 @@ public:
 
     void InitExtensionMethodsMap();
 
+    // QuickJS后端不支持，返回false
+    bool GetHeapStatistics(FJsHeapStatistics& OutStatistics);
+
+    // 写出可以用Chrome DevTools打开的.heapsnapshot
+    bool WriteHeapSnapshot(const FString& FilePath);
+
+    // 开始采样堆分配，SampleInterval是平均采样间隔(字节)
+    bool StartHeapSampling(uint64 SampleInterval = 32768, int32 StackDepth = 16);
+
+    // 停止采样并写出.heapprofile(Chrome DevTools的采样格式)
+    bool StopHeapSampling(const FString& FilePath);
+
 private:
     std::unique_ptr<IJsEnv> GameScript;
 };
@@ -11,6 +11,8 @@
 #include "CoreMinimal.h"
 #include "IDirectoryWatcher.h"
 #include "Misc/SecureHash.h"
+#include "Async/Future.h"
+#include "UECompatible.h"
 #include <functional>
 #include "PuertsNamespaceDef.h"
 
@@ -19,8 +21,12 @@ namespace PUERTS_NAMESPACE
 class JSENV_API FSourceFileWatcher
 {
 public:
+    // 每个变化的文件回调一次
     FSourceFileWatcher(std::function<void(const FString&)> InOnWatchedFileChanged);
 
+    // 在 InQuietWindowSeconds 内没有新的变化后，一次性回调所有内容有变化的文件，按依赖顺序（被依赖的在前）排列
+    FSourceFileWatcher(std::function<void(const TArray<FString>&)> InOnWatchedFilesChanged, float InQuietWindowSeconds = 0.3f);
+
     ~FSourceFileWatcher();
 
     void OnSourceLoaded(const FString& InPath);
@@ -28,13 +34,31 @@ public:
     void OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
 
 private:
+    bool Tick(float DeltaTime);
+
+    void FinishHashTask();
+
     TMap<FString, FDelegateHandle> WatchedDirs;
 
     TMap<FString, TMap<FString, FMD5Hash>> WatchedFiles;
 
+    // 文件第一次加载的顺序，CommonJS 里模块先于它 require 的模块加载，所以越晚加载的越底层
+    TMap<FString, int32> LoadOrder;
+
+    // 等待安静期结束后再计算哈希的文件
+    TSet<FString> PendingFiles;
+
+    double LastChangeTime = 0;
+
+    float QuietWindowSeconds = 0.3f;
+
+    TFuture<TArray<TPair<FString, FMD5Hash>>> HashTask;
+
+    FUETickDelegateHandle TickerHandle;
+
     FCriticalSection SourceFileWatcherCritical;
 
-    std::function<void(const FString&)> OnWatchedFileChanged;
+    std::function<void(const TArray<FString>&)> OnWatchedFilesChanged;
 };
 }    // namespace PUERTS_NAMESPACE
 #endif
\ No newline at end of file
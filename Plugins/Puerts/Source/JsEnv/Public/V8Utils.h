@@ -102,7 +102,12 @@ public:
 
     FORCEINLINE static FName ToFName(v8::Isolate* Isolate, v8::Local<v8::Value> Value)
     {
+#ifdef WITH_QUICKJS
         return UTF8_TO_TCHAR(*(v8::String::Utf8Value(Isolate, Value)));
+#else
+        // 直接拷贝UTF16内容，省掉一次UTF8编解码
+        return FName(*ToFString(Isolate, Value));
+#endif
     }
 
     FORCEINLINE static v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FString& String)
@@ -111,7 +116,7 @@ public:
         return ToV8String(Isolate, *String);
     }
 
-    FORCEINLINE static v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FName& String)
+    FORCEINLINE static FString ComparisonNameToString(const FName& String)
     {
         const FNameEntry* Entry = String.GetComparisonNameEntry();
         FString Out;
@@ -128,8 +133,13 @@ public:
             Out += TEXT('_');
             Out.AppendInt(NAME_INTERNAL_TO_EXTERNAL(String.GetNumber()));
         }
+        return Out;
+    }
 
-        return ToV8String(Isolate, Out);
+    // 不走缓存，高频路径请用IObjectMapper::NameToV8String
+    FORCEINLINE static v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FName& String)
+    {
+        return ToV8String(Isolate, ComparisonNameToString(String));
     }
 
     FORCEINLINE static v8::Local<v8::String> ToV8String(v8::Isolate* Isolate, const FText& String)
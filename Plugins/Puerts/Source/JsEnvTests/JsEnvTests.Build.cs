@@ -0,0 +1,24 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 Tencent.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+using UnrealBuildTool;
+
+// 需要测试专用反射类型的自动化测试和基准测试，不会编进Shipping
+public class JsEnvTests : ModuleRules
+{
+    public JsEnvTests(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core", "CoreUObject", "Engine", "JsEnv",
+            }
+        );
+    }
+}
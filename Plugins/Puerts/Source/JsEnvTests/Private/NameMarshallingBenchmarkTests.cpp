@@ -0,0 +1,169 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "PuertsTestTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "JsEnv.h"
+#include "JSLogger.h"
+#include "JSModuleLoader.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace PUERTS_NAMESPACE
+{
+namespace NameMarshallingBenchmarkTests
+{
+    constexpr int32 NumIterations = 200000;
+    constexpr int32 NumFields = 16;
+    constexpr int32 NumDistinctNames = 64;
+
+    static const TCHAR* ModuleName = TEXT("__puerts_name_marshalling_benchmark");
+
+    static FString GetBenchmarkName(int32 Index)
+    {
+        return FString::Printf(TEXT("PuertsBenchmarkName_%d"), Index);
+    }
+
+    // 每次循环把同一个名字写进所有FName字段，再全部读回来累加长度，最后把结构体和累加结果写回UObject
+    static FString MakeModuleSource()
+    {
+        FString Writes;
+        FString Reads;
+        for (int32 Field = 0; Field < NumFields; ++Field)
+        {
+            Writes += FString::Printf(TEXT("    s.Name%d = name;\n"), Field);
+            Reads += FString::Printf(TEXT("%ss.Name%d.length"), Field == 0 ? TEXT("") : TEXT(" + "), Field);
+        }
+        return FString::Printf(TEXT("const UE = require('ue');\n"
+                                    "const target = puerts.argv.getByName('Target');\n"
+                                    "const names = [];\n"
+                                    "for (let i = 0; i < %d; ++i) names.push('PuertsBenchmarkName_' + i);\n"
+                                    "const s = new UE.PuertsNameBenchmarkStruct();\n"
+                                    "let total = 0;\n"
+                                    "for (let i = 0; i < %d; ++i) {\n"
+                                    "    const name = names[i %% %d];\n"
+                                    "%s"
+                                    "    total += %s;\n"
+                                    "}\n"
+                                    "target.Names = s;\n"
+                                    "target.Checksum = total;\n"),
+            NumDistinctNames, NumIterations, NumDistinctNames, *Writes, *Reads);
+    }
+
+    class FTestModuleLoader : public DefaultJSModuleLoader
+    {
+    public:
+        FTestModuleLoader() : DefaultJSModuleLoader(TEXT("JavaScript")), Source(MakeModuleSource())
+        {
+        }
+
+        virtual bool Search(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath) override
+        {
+            if (RequiredModule == ModuleName || RequiredModule == FString(ModuleName) + TEXT(".js"))
+            {
+                Path = FString(ModuleName) + TEXT(".js");
+                AbsolutePath = Path;
+                return true;
+            }
+            return DefaultJSModuleLoader::Search(RequiredDir, RequiredModule, Path, AbsolutePath);
+        }
+
+        virtual bool Load(const FString& Path, TArray<uint8>& Content) override
+        {
+            if (Path == FString(ModuleName) + TEXT(".js"))
+            {
+                FTCHARToUTF8 Utf8(*Source);
+                Content.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+                return true;
+            }
+            return DefaultJSModuleLoader::Load(Path, Content);
+        }
+
+    private:
+        FString Source;
+    };
+
+    static double RunModule(UObject* Target, bool bUseNameStringCache)
+    {
+        IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("puerts.NameStringCache"));
+        const bool bPrevious = CVar ? CVar->GetBool() : true;
+        if (CVar)
+        {
+            CVar->Set(bUseNameStringCache, ECVF_SetByCode);
+        }
+
+        double Seconds;
+        {
+            FJsEnv JsEnv(std::make_shared<FTestModuleLoader>(), std::make_shared<FDefaultLogger>(), -1);
+            TArray<TPair<FString, UObject*>> Arguments;
+            Arguments.Add(TPair<FString, UObject*>(TEXT("Target"), Target));
+
+            const double StartTime = FPlatformTime::Seconds();
+            JsEnv.Start(ModuleName, Arguments);
+            Seconds = FPlatformTime::Seconds() - StartTime;
+        }
+
+        if (CVar)
+        {
+            CVar->Set(bPrevious, ECVF_SetByCode);
+        }
+        return Seconds;
+    }
+}    // namespace NameMarshallingBenchmarkTests
+}    // namespace PUERTS_NAMESPACE
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsNameMarshallingBenchmark, "Puerts.JsEnv.NameMarshalling.Benchmark",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FPuertsNameMarshallingBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace PUERTS_NAMESPACE;
+    using namespace PUERTS_NAMESPACE::NameMarshallingBenchmarkTests;
+
+    TStrongObjectPtr<UPuertsBenchmarkTarget> Target(NewObject<UPuertsBenchmarkTarget>(GetTransientPackage()));
+
+    double ExpectedChecksum = 0.0;
+    for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+    {
+        ExpectedChecksum += NumFields * GetBenchmarkName(Iteration % NumDistinctNames).Len();
+    }
+    const FName ExpectedLastName(*GetBenchmarkName((NumIterations - 1) % NumDistinctNames));
+
+    // 每次循环每个字段一写一读
+    const double NumConversions = 2.0 * NumFields * NumIterations;
+    double UncachedSeconds = 0.0;
+    for (const bool bUseNameStringCache : {false, true})
+    {
+        const TCHAR* PathName = bUseNameStringCache ? TEXT("cached") : TEXT("uncached");
+
+        Target->Names = FPuertsNameBenchmarkStruct();
+        Target->Checksum = 0.0;
+        const double Seconds = RunModule(Target.Get(), bUseNameStringCache);
+
+        TestEqual(*FString::Printf(TEXT("%s: lengths read back"), PathName), Target->Checksum, ExpectedChecksum);
+        TestEqual(*FString::Printf(TEXT("%s: first field written"), PathName), Target->Names.Name0, ExpectedLastName);
+        TestEqual(*FString::Printf(TEXT("%s: last field written"), PathName), Target->Names.Name15, ExpectedLastName);
+
+        AddInfo(FString::Printf(TEXT("%s FName marshalling, %d iterations x %d fields both ways: %.1f ms (%.1f ns/conversion)%s"),
+            PathName, NumIterations, NumFields, Seconds * 1000.0, Seconds * 1e9 / NumConversions,
+            bUseNameStringCache && Seconds > 0.0 ? *FString::Printf(TEXT(", %.2fx"), UncachedSeconds / Seconds) : TEXT("")));
+        if (!bUseNameStringCache)
+        {
+            UncachedSeconds = Seconds;
+        }
+    }
+
+    return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
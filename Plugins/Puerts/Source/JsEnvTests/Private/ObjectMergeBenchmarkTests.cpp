@@ -0,0 +1,227 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "PuertsTestTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "JsEnv.h"
+#include "JSLogger.h"
+#include "JSModuleLoader.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UnrealType.h"
+
+namespace PUERTS_NAMESPACE
+{
+namespace ObjectMergeBenchmarkTests
+{
+    constexpr int32 NumObjects = 10000;
+
+    static const TCHAR* ModuleName = TEXT("__puerts_object_merge_benchmark");
+
+    // 交替传入的对象形状数：全部相同、放得进计划缓存、超过计划缓存
+    static const int32 ShapeCounts[] = {1, 8, 48};
+
+    // 字段按形状编号轮转，编号超过字段数的再倒序，每个编号得到不同的属性顺序
+    // 先构造好所有对象，只给合并的循环计时
+    static FString MakeModuleSource(int32 NumShapes)
+    {
+        FString Fields;
+        for (TFieldIterator<FProperty> It(FPuertsMergeBenchmarkStruct::StaticStruct()); It; ++It)
+        {
+            Fields += FString::Printf(TEXT("%s'%s'"), Fields.IsEmpty() ? TEXT("") : TEXT(", "), *It->GetName());
+        }
+        return FString::Printf(TEXT("const UE = require('ue');\n"
+                                    "const target = puerts.argv.getByName('Target');\n"
+                                    "const fields = [%s];\n"
+                                    "const orders = [];\n"
+                                    "for (let shape = 0; shape < %d; ++shape) {\n"
+                                    "    const order = [];\n"
+                                    "    for (let k = 0; k < fields.length; ++k) order.push(fields[(k + shape) %% fields.length]);\n"
+                                    "    orders.push(shape < fields.length ? order : order.reverse());\n"
+                                    "}\n"
+                                    "const objects = [];\n"
+                                    "for (let i = 0; i < %d; ++i) {\n"
+                                    "    const o = {};\n"
+                                    "    for (const f of orders[i %% orders.length]) {\n"
+                                    "        o[f] = f.startsWith('Int') ? i : f.startsWith('Float') ? i * 0.5 : f.startsWith('Str') ? 'S' + i : (i & 1) === 1;\n"
+                                    "    }\n"
+                                    "    objects.push(o);\n"
+                                    "}\n"
+                                    "const s = new UE.PuertsMergeBenchmarkStruct();\n"
+                                    "console.log('merge-begin');\n"
+                                    "for (let i = 0; i < objects.length; ++i) puerts.merge(s, objects[i]);\n"
+                                    "console.log('merge-end');\n"
+                                    "target.Merged = s;\n"),
+            *Fields, NumShapes, NumObjects);
+    }
+
+    // 记下脚本打出开始和结束标记的时间
+    class FTimingLogger : public FDefaultLogger
+    {
+    public:
+        void Log(const FString& Message) const override
+        {
+            if (Message == TEXT("merge-begin"))
+            {
+                BeginTime = FPlatformTime::Seconds();
+            }
+            else if (Message == TEXT("merge-end"))
+            {
+                EndTime = FPlatformTime::Seconds();
+            }
+            else
+            {
+                FDefaultLogger::Log(Message);
+            }
+        }
+
+        mutable double BeginTime = 0.0;
+
+        mutable double EndTime = 0.0;
+    };
+
+    class FTestModuleLoader : public DefaultJSModuleLoader
+    {
+    public:
+        explicit FTestModuleLoader(int32 NumShapes) : DefaultJSModuleLoader(TEXT("JavaScript")), Source(MakeModuleSource(NumShapes))
+        {
+        }
+
+        virtual bool Search(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath) override
+        {
+            if (RequiredModule == ModuleName || RequiredModule == FString(ModuleName) + TEXT(".js"))
+            {
+                Path = FString(ModuleName) + TEXT(".js");
+                AbsolutePath = Path;
+                return true;
+            }
+            return DefaultJSModuleLoader::Search(RequiredDir, RequiredModule, Path, AbsolutePath);
+        }
+
+        virtual bool Load(const FString& Path, TArray<uint8>& Content) override
+        {
+            if (Path == FString(ModuleName) + TEXT(".js"))
+            {
+                FTCHARToUTF8 Utf8(*Source);
+                Content.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+                return true;
+            }
+            return DefaultJSModuleLoader::Load(Path, Content);
+        }
+
+    private:
+        FString Source;
+    };
+
+    // 返回合并循环的耗时，脚本没有跑完返回负数
+    static double RunModule(UObject* Target, int32 NumShapes, bool bUsePlans)
+    {
+        IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("puerts.ObjectMergePlans"));
+        const bool bPrevious = CVar ? CVar->GetBool() : true;
+        if (CVar)
+        {
+            CVar->Set(bUsePlans, ECVF_SetByCode);
+        }
+
+        auto Logger = std::make_shared<FTimingLogger>();
+        {
+            FJsEnv JsEnv(std::make_shared<FTestModuleLoader>(NumShapes), Logger, -1);
+            TArray<TPair<FString, UObject*>> Arguments;
+            Arguments.Add(TPair<FString, UObject*>(TEXT("Target"), Target));
+            JsEnv.Start(ModuleName, Arguments);
+        }
+
+        if (CVar)
+        {
+            CVar->Set(bPrevious, ECVF_SetByCode);
+        }
+        return Logger->EndTime > 0.0 ? Logger->EndTime - Logger->BeginTime : -1.0;
+    }
+}    // namespace ObjectMergeBenchmarkTests
+}    // namespace PUERTS_NAMESPACE
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPuertsObjectMergeBenchmark, "Puerts.JsEnv.ObjectMerge.Benchmark",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FPuertsObjectMergeBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace PUERTS_NAMESPACE;
+    using namespace PUERTS_NAMESPACE::ObjectMergeBenchmarkTests;
+
+    TStrongObjectPtr<UPuertsBenchmarkTarget> Target(NewObject<UPuertsBenchmarkTarget>(GetTransientPackage()));
+
+    // 最后合并的对象决定最终的值
+    const int32 LastIndex = NumObjects - 1;
+    const FString ExpectedString = FString::Printf(TEXT("S%d"), LastIndex);
+    const bool bExpectedFlag = (LastIndex & 1) == 1;
+
+    int32 NumFields = 0;
+    for (TFieldIterator<FProperty> It(FPuertsMergeBenchmarkStruct::StaticStruct()); It; ++It)
+    {
+        ++NumFields;
+    }
+    TestEqual(TEXT("Benchmark struct has 30 fields"), NumFields, 30);
+
+    for (const int32 NumShapes : ShapeCounts)
+    {
+        double NamedSeconds = 0.0;
+        for (const bool bUsePlans : {false, true})
+        {
+            const FString RunName = FString::Printf(TEXT("%d shape(s), %s"), NumShapes, bUsePlans ? TEXT("plans") : TEXT("by name"));
+
+            Target->Merged = FPuertsMergeBenchmarkStruct();
+            const double Seconds = RunModule(Target.Get(), NumShapes, bUsePlans);
+            if (!TestTrue(*FString::Printf(TEXT("%s: merge loop finished"), *RunName), Seconds >= 0.0))
+            {
+                continue;
+            }
+
+            int32 NumMismatches = 0;
+            const void* Merged = &Target->Merged;
+            for (TFieldIterator<FProperty> It(FPuertsMergeBenchmarkStruct::StaticStruct()); It; ++It)
+            {
+                bool bMatch = true;
+                if (const FIntProperty* IntProperty = CastField<FIntProperty>(*It))
+                {
+                    bMatch = IntProperty->GetPropertyValue_InContainer(Merged) == LastIndex;
+                }
+                else if (const FFloatProperty* FloatProperty = CastField<FFloatProperty>(*It))
+                {
+                    bMatch = FloatProperty->GetPropertyValue_InContainer(Merged) == LastIndex * 0.5f;
+                }
+                else if (const FStrProperty* StrProperty = CastField<FStrProperty>(*It))
+                {
+                    bMatch = StrProperty->GetPropertyValue_InContainer(Merged) == ExpectedString;
+                }
+                else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(*It))
+                {
+                    bMatch = BoolProperty->GetPropertyValue_InContainer(Merged) == bExpectedFlag;
+                }
+                NumMismatches += bMatch ? 0 : 1;
+            }
+            TestEqual(*FString::Printf(TEXT("%s: every field merged"), *RunName), NumMismatches, 0);
+
+            AddInfo(FString::Printf(TEXT("%s: %d objects into %d fields in %.2f ms (%.2f us/merge)%s"), *RunName, NumObjects,
+                NumFields, Seconds * 1000.0, Seconds * 1e6 / NumObjects,
+                bUsePlans && Seconds > 0.0 ? *FString::Printf(TEXT(", %.2fx vs by name"), NamedSeconds / Seconds) : TEXT("")));
+            if (!bUsePlans)
+            {
+                NamedSeconds = Seconds;
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,184 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "PuertsTestTypes.generated.h"
+
+// FName字段很多的结构体，测试FName和js字符串之间的转换
+USTRUCT()
+struct FPuertsNameBenchmarkStruct
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    FName Name0;
+
+    UPROPERTY()
+    FName Name1;
+
+    UPROPERTY()
+    FName Name2;
+
+    UPROPERTY()
+    FName Name3;
+
+    UPROPERTY()
+    FName Name4;
+
+    UPROPERTY()
+    FName Name5;
+
+    UPROPERTY()
+    FName Name6;
+
+    UPROPERTY()
+    FName Name7;
+
+    UPROPERTY()
+    FName Name8;
+
+    UPROPERTY()
+    FName Name9;
+
+    UPROPERTY()
+    FName Name10;
+
+    UPROPERTY()
+    FName Name11;
+
+    UPROPERTY()
+    FName Name12;
+
+    UPROPERTY()
+    FName Name13;
+
+    UPROPERTY()
+    FName Name14;
+
+    UPROPERTY()
+    FName Name15;
+};
+
+// 30个字段的结构体，测试把js对象合并进结构体
+USTRUCT()
+struct FPuertsMergeBenchmarkStruct
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    int32 Int0 = 0;
+
+    UPROPERTY()
+    int32 Int1 = 0;
+
+    UPROPERTY()
+    int32 Int2 = 0;
+
+    UPROPERTY()
+    int32 Int3 = 0;
+
+    UPROPERTY()
+    int32 Int4 = 0;
+
+    UPROPERTY()
+    int32 Int5 = 0;
+
+    UPROPERTY()
+    int32 Int6 = 0;
+
+    UPROPERTY()
+    int32 Int7 = 0;
+
+    UPROPERTY()
+    int32 Int8 = 0;
+
+    UPROPERTY()
+    int32 Int9 = 0;
+
+    UPROPERTY()
+    float Float0 = 0.0f;
+
+    UPROPERTY()
+    float Float1 = 0.0f;
+
+    UPROPERTY()
+    float Float2 = 0.0f;
+
+    UPROPERTY()
+    float Float3 = 0.0f;
+
+    UPROPERTY()
+    float Float4 = 0.0f;
+
+    UPROPERTY()
+    float Float5 = 0.0f;
+
+    UPROPERTY()
+    float Float6 = 0.0f;
+
+    UPROPERTY()
+    float Float7 = 0.0f;
+
+    UPROPERTY()
+    float Float8 = 0.0f;
+
+    UPROPERTY()
+    float Float9 = 0.0f;
+
+    UPROPERTY()
+    FString Str0;
+
+    UPROPERTY()
+    FString Str1;
+
+    UPROPERTY()
+    FString Str2;
+
+    UPROPERTY()
+    FString Str3;
+
+    UPROPERTY()
+    FString Str4;
+
+    UPROPERTY()
+    bool Flag0 = false;
+
+    UPROPERTY()
+    bool Flag1 = false;
+
+    UPROPERTY()
+    bool Flag2 = false;
+
+    UPROPERTY()
+    bool Flag3 = false;
+
+    UPROPERTY()
+    bool Flag4 = false;
+};
+
+// 基准测试脚本把结果写回这里，由测试检查
+UCLASS(Transient)
+class UPuertsBenchmarkTarget : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    FPuertsNameBenchmarkStruct Names;
+
+    UPROPERTY()
+    FPuertsMergeBenchmarkStruct Merged;
+
+    UPROPERTY()
+    double Checksum = 0.0;
+};
@@ -120,19 +120,26 @@ void FPuertsEditorModule::OnPostEngineInit()
         FKismetCompilerContext::RegisterCompilerForBP(UTypeScriptBlueprint::StaticClass(), &MakeCompiler);
 
         SourceFileWatcher = MakeShared<PUERTS_NAMESPACE::FSourceFileWatcher>(
-            [this](const FString& InPath)
+            [this](const TArray<FString>& InPaths)
             {
                 if (JsEnv.IsValid())
                 {
-                    TArray<uint8> Source;
-                    if (FFileHelper::LoadFileToArray(Source, *InPath))
-                    {
-                        JsEnv->ReloadSource(InPath, puerts::PString((const char*) Source.GetData(), Source.Num()));
-                    }
-                    else
+                    // 监视器已经把一次变化的文件合并好并按依赖排序，整批交给 JS 一次重载
+                    TArray<TPair<FString, puerts::PString>> Sources;
+                    Sources.Reserve(InPaths.Num());
+                    for (const FString& InPath : InPaths)
                     {
-                        UE_LOG(Puerts, Error, TEXT("read file fail for %s"), *InPath);
+                        TArray<uint8> Source;
+                        if (FFileHelper::LoadFileToArray(Source, *InPath))
+                        {
+                            Sources.Emplace(InPath, puerts::PString((const char*) Source.GetData(), Source.Num()));
+                        }
+                        else
+                        {
+                            UE_LOG(Puerts, Error, TEXT("read file fail for %s"), *InPath);
+                        }
                     }
+                    JsEnv->ReloadSources(Sources);
                 }
             });
         JsEnv = MakeShared<PUERTS_NAMESPACE::FJsEnv>(
@@ -0,0 +1,244 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "Wasm3ExportDef.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "WasmEnv.h"
+#include "WasmModuleInstance.h"
+#include "WasmRuntime.h"
+
+namespace WasmCallTests
+{
+    // 手写的测试模块，导出两个函数：
+    // mix(a: i32, b: i32): i32 = (a * 31 + b) ^ (a >> 3)
+    // lerp(a: f64, b: f64, t: f64): f64 = a + (b - a) * t
+    static const uint8 TestModuleBytes[] = {
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        // type
+        0x01, 0x0e, 0x02, 0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x03, 0x7c, 0x7c, 0x7c, 0x01, 0x7c,
+        // function
+        0x03, 0x03, 0x02, 0x00, 0x01,
+        // export
+        0x07, 0x0e, 0x02, 0x03, 0x6d, 0x69, 0x78, 0x00, 0x00, 0x04, 0x6c, 0x65, 0x72, 0x70, 0x00, 0x01,
+        // code
+        0x0a, 0x20, 0x02,
+        0x10, 0x00, 0x20, 0x00, 0x41, 0x1f, 0x6c, 0x20, 0x01, 0x6a, 0x20, 0x00, 0x41, 0x03, 0x75, 0x73, 0x0b,
+        0x0d, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x00, 0xa1, 0x20, 0x02, 0xa2, 0xa0, 0x0b};
+
+    static int32 MixReference(int32 A, int32 B)
+    {
+        return (int32) ((uint32) A * 31u + (uint32) B) ^ (A >> 3);
+    }
+
+    static IM3Function FindExport(WasmModuleInstance* Instance, const char* Name)
+    {
+        IM3Module Module = Instance->GetModule();
+        for (uint32 i = 0; i < Module->numFunctions; ++i)
+        {
+            IM3Function Function = &Module->functions[i];
+            if (Function->export_name && FCStringAnsi::Strcmp(Function->export_name, Name) == 0)
+            {
+                return Function;
+            }
+        }
+        return nullptr;
+    }
+
+    // 原来的调用方式：参数和返回值都经过指针数组
+    static bool CallMixByPointers(IM3Function Function, int32 A, int32 B, int32& OutResult)
+    {
+        const void* Args[] = {&A, &B};
+        const void* Rets[] = {&OutResult};
+        return Export_m3_Call(Function, 2, Args) && Export_m3_GetResults(Function, 1, Rets);
+    }
+
+    // 导出函数的调用方式：参数直接写到栈上，返回值在参数前面
+    static bool CallMixPrepared(IM3Function Function, int32 A, int32 B, int32& OutResult)
+    {
+        uint64* ArgStack = nullptr;
+        if (!Export_m3_PrepareCallArgs(Function, &ArgStack))
+        {
+            return false;
+        }
+        *((int32*) (ArgStack + 0)) = A;
+        *((int32*) (ArgStack + 1)) = B;
+        if (!Export_m3_CallPreparedArgs(Function))
+        {
+            return false;
+        }
+        OutResult = *((const int32*) (ArgStack - 1));
+        return true;
+    }
+
+    static bool CallLerpByPointers(IM3Function Function, double A, double B, double T, double& OutResult)
+    {
+        const void* Args[] = {&A, &B, &T};
+        const void* Rets[] = {&OutResult};
+        return Export_m3_Call(Function, 3, Args) && Export_m3_GetResults(Function, 1, Rets);
+    }
+
+    static bool CallLerpPrepared(IM3Function Function, double A, double B, double T, double& OutResult)
+    {
+        uint64* ArgStack = nullptr;
+        if (!Export_m3_PrepareCallArgs(Function, &ArgStack))
+        {
+            return false;
+        }
+        *((double*) (ArgStack + 0)) = A;
+        *((double*) (ArgStack + 1)) = B;
+        *((double*) (ArgStack + 2)) = T;
+        if (!Export_m3_CallPreparedArgs(Function))
+        {
+            return false;
+        }
+        OutResult = *((const double*) (ArgStack - 1));
+        return true;
+    }
+
+    struct FTestModule
+    {
+        WasmEnv Env;
+        TUniquePtr<WasmRuntime> Runtime;
+        IM3Function Mix = nullptr;
+        IM3Function Lerp = nullptr;
+
+        bool Load()
+        {
+            Runtime = MakeUnique<WasmRuntime>(&Env, 1, 1);
+            TArray<uint8> Data(TestModuleBytes, UE_ARRAY_COUNT(TestModuleBytes));
+            WasmModuleInstance* Instance = new WasmModuleInstance(Data);
+            if (!Instance->ParseModule(&Env) || !Instance->LoadModule(Runtime.Get(), -1))
+            {
+                delete Instance;
+                return false;
+            }
+            Mix = FindExport(Instance, "mix");
+            Lerp = FindExport(Instance, "lerp");
+            return Mix && Lerp;
+        }
+
+        ~FTestModule()
+        {
+            // 模块实例属于 runtime，要在 WasmEnv 之前释放
+            Runtime.Reset();
+        }
+    };
+}    // namespace WasmCallTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWasmPreparedCallTest, "Puerts.WasmCore.Call.PreparedArgs",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWasmPreparedCallTest::RunTest(const FString& Parameters)
+{
+    using namespace WasmCallTests;
+
+    FTestModule Module;
+    if (!TestTrue(TEXT("Load test module"), Module.Load()))
+    {
+        return false;
+    }
+
+    // 两种调用方式对同样的输入结果必须一致，边界值单独覆盖
+    TArray<TPair<int32, int32>> IntInputs = {{0, 0}, {1, -1}, {MAX_int32, 1}, {MIN_int32, -1}, {-8, 7}, {MIN_int32, MAX_int32}};
+    FRandomStream Random(34);
+    for (int32 i = 0; i < 1000; ++i)
+    {
+        IntInputs.Emplace((int32) Random.GetUnsignedInt(), (int32) Random.GetUnsignedInt());
+    }
+    for (const TPair<int32, int32>& Input : IntInputs)
+    {
+        int32 ByPointers = 0;
+        int32 Prepared = 0;
+        if (!TestTrue(TEXT("Call mix by pointers"), CallMixByPointers(Module.Mix, Input.Key, Input.Value, ByPointers)) ||
+            !TestTrue(TEXT("Call mix prepared"), CallMixPrepared(Module.Mix, Input.Key, Input.Value, Prepared)))
+        {
+            return false;
+        }
+        if (ByPointers != Prepared || Prepared != MixReference(Input.Key, Input.Value))
+        {
+            AddError(FString::Printf(TEXT("mix(%d, %d): by pointers %d, prepared %d, expected %d"), Input.Key, Input.Value,
+                ByPointers, Prepared, MixReference(Input.Key, Input.Value)));
+        }
+    }
+
+    for (int32 i = 0; i < 1000; ++i)
+    {
+        const double A = Random.FRandRange(-1.0e6f, 1.0e6f);
+        const double B = Random.FRandRange(-1.0e6f, 1.0e6f);
+        const double T = Random.FRand();
+        double ByPointers = 0.0;
+        double Prepared = 0.0;
+        if (!TestTrue(TEXT("Call lerp by pointers"), CallLerpByPointers(Module.Lerp, A, B, T, ByPointers)) ||
+            !TestTrue(TEXT("Call lerp prepared"), CallLerpPrepared(Module.Lerp, A, B, T, Prepared)))
+        {
+            return false;
+        }
+        if (ByPointers != Prepared || Prepared != A + (B - A) * T)
+        {
+            AddError(FString::Printf(TEXT("lerp(%f, %f, %f): by pointers %f, prepared %f"), A, B, T, ByPointers, Prepared));
+        }
+    }
+
+    // 两种方式交替调用，栈上不能残留上一次的参数
+    int32 First = 0;
+    int32 Second = 0;
+    CallMixPrepared(Module.Mix, 5, 6, First);
+    CallMixByPointers(Module.Mix, 7, 8, Second);
+    CallMixPrepared(Module.Mix, 5, 6, Second);
+    TestEqual(TEXT("Repeated prepared call"), Second, First);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWasmPreparedCallBenchmark, "Puerts.WasmCore.Call.Benchmark",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FWasmPreparedCallBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace WasmCallTests;
+
+    const int32 NumCalls = 1000000;
+
+    FTestModule Module;
+    if (!TestTrue(TEXT("Load test module"), Module.Load()))
+    {
+        return false;
+    }
+
+    // 整数运算的紧密循环，每次的输入依赖上一次的结果
+    int32 ByPointersResult = 1;
+    const double ByPointersStartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        CallMixByPointers(Module.Mix, ByPointersResult, i, ByPointersResult);
+    }
+    const double ByPointersSeconds = FPlatformTime::Seconds() - ByPointersStartTime;
+
+    int32 PreparedResult = 1;
+    const double PreparedStartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        CallMixPrepared(Module.Mix, PreparedResult, i, PreparedResult);
+    }
+    const double PreparedSeconds = FPlatformTime::Seconds() - PreparedStartTime;
+
+    TestEqual(TEXT("Both paths compute the same chain"), PreparedResult, ByPointersResult);
+
+    AddInfo(FString::Printf(TEXT("%d calls: by pointers %.3f ms (%.1f ns/call), prepared %.3f ms (%.1f ns/call)"), NumCalls,
+        ByPointersSeconds * 1000.0, ByPointersSeconds * 1.0e9 / NumCalls, PreparedSeconds * 1000.0,
+        PreparedSeconds * 1.0e9 / NumCalls));
+
+    return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,317 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "WasmRuntime.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "m3_env.h"
+
+namespace WasmRuntimeTests
+{
+    static constexpr int32 PageSize = d_m3MemPageSize;
+
+    static uint32 GetNumReservedPages(const WasmRuntime& Runtime)
+    {
+        return Runtime.GetRuntime()->memory.numReservedPages;
+    }
+
+    // 新拿到的内存必须全是0，不能带着上一个使用者的数据
+    static bool IsZeroed(WasmRuntime& Runtime)
+    {
+        int Length = 0;
+        const uint8* Buffer = Runtime.GetBuffer(Length);
+        for (int i = 0; i < Length; ++i)
+        {
+            if (Buffer[i] != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void MarkPages(WasmRuntime& Runtime, uint8 Value)
+    {
+        int Length = 0;
+        uint8* Buffer = Runtime.GetBuffer(Length);
+        for (int Offset = 0; Offset < Length; Offset += PageSize)
+        {
+            Buffer[Offset] = Value;
+            Buffer[Offset + PageSize - 1] = Value;
+        }
+    }
+
+    struct FWorkerResult
+    {
+        int32 NumDirty = 0;
+        TArray<uint16> Seqs;
+    };
+
+    // 一个线程反复取出、增长、写入、乱序归还 runtime，记下拿到的序号
+    // 和每个 JsEnv 一样用自己的 WasmEnv，只共享全局的 runtime 池
+    static FWorkerResult RunPoolWorker(int32 WorkerIndex, int32 NumAcquires)
+    {
+        FWorkerResult Result;
+        WasmEnv Env;
+        FRandomStream Random(350 + WorkerIndex);
+        TArray<std::shared_ptr<WasmRuntime>> Runtimes;
+        for (int32 i = 0; i < NumAcquires; ++i)
+        {
+            std::shared_ptr<WasmRuntime> Runtime = WasmRuntime::Acquire(&Env, 32, Random.RandRange(0, 2));
+            if (!IsZeroed(*Runtime))
+            {
+                ++Result.NumDirty;
+            }
+            Result.Seqs.Add(Runtime->GetRuntimeSeq());
+            Runtime->Grow(Random.RandRange(0, 4));
+            MarkPages(*Runtime, (uint8) Random.RandRange(1, 255));
+            Runtimes.Add(MoveTemp(Runtime));
+
+            if (Runtimes.Num() >= 4 || Random.FRand() < 0.5f)
+            {
+                Runtimes.RemoveAtSwap(Random.RandHelper(Runtimes.Num()));
+            }
+        }
+        Runtimes.Empty();
+        return Result;
+    }
+}    // namespace WasmRuntimeTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWasmRuntimePoolTest, "Puerts.WasmCore.Runtime.Pool",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWasmRuntimePoolTest::RunTest(const FString& Parameters)
+{
+    using namespace WasmRuntimeTests;
+
+    const int32 NumRuntimes = 1000;
+    const int MaxPages = 16;
+    const int GrowPages = 3;
+
+    WasmEnv Env;
+
+    // 原来的做法：每次都新建和释放 runtime 和线性内存
+    const double CreateStartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumRuntimes; ++i)
+    {
+        WasmRuntime* Runtime = new WasmRuntime(&Env, MaxPages, 1);
+        Runtime->Grow(GrowPages);
+        MarkPages(*Runtime, 0xAB);
+        delete Runtime;
+    }
+    const double CreateSeconds = FPlatformTime::Seconds() - CreateStartTime;
+
+    const WasmRuntimePoolStats StatsBefore = WasmRuntime::GetPoolStats();
+    int32 NumDirty = 0;
+    const double PoolStartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumRuntimes; ++i)
+    {
+        std::shared_ptr<WasmRuntime> Runtime = WasmRuntime::Acquire(&Env, MaxPages, 1);
+        if (!IsZeroed(*Runtime))
+        {
+            ++NumDirty;
+        }
+        Runtime->Grow(GrowPages);
+        MarkPages(*Runtime, 0xAB);
+    }
+    const double PoolSeconds = FPlatformTime::Seconds() - PoolStartTime;
+    const WasmRuntimePoolStats StatsAfter = WasmRuntime::GetPoolStats();
+
+    const int32 NumCreated = StatsAfter.NumCreated - StatsBefore.NumCreated;
+    const int32 NumReused = StatsAfter.NumReused - StatsBefore.NumReused;
+    TestEqual(TEXT("Every runtime came from the pool or was created"), NumCreated + NumReused, NumRuntimes);
+    TestTrue(TEXT("At most one runtime was created"), NumCreated <= 1);
+    TestEqual(TEXT("Reused runtimes start with zeroed memory"), NumDirty, 0);
+    TestTrue(TEXT("High water pages cover the grown runtimes"), StatsAfter.HighWaterPages >= 1 + GrowPages);
+
+    // 复用的 runtime 按历史最高水位预留，之后 Grow 不再重新分配
+    {
+        std::shared_ptr<WasmRuntime> Runtime = WasmRuntime::Acquire(&Env, MaxPages, 1);
+        int Length = 0;
+        const uint8* BufferBeforeGrow = Runtime->GetBuffer(Length);
+        Runtime->Grow(GrowPages);
+        TestEqual(TEXT("Presized memory does not move on grow"), (const uint8*) Runtime->GetBuffer(Length), BufferBeforeGrow);
+        TestEqual(TEXT("Grown length"), Length, (1 + GrowPages) * PageSize);
+    }
+
+    AddInfo(FString::Printf(TEXT("%d runtimes: new/delete %.3f ms, pooled %.3f ms (%d created, %d reused, %d pooled)"), NumRuntimes,
+        CreateSeconds * 1000.0, PoolSeconds * 1000.0, NumCreated, NumReused, StatsAfter.NumPooled));
+
+    WasmRuntime::EmptyPool();
+    TestEqual(TEXT("Pool is empty"), WasmRuntime::GetPoolStats().NumPooled, 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWasmRuntimeMemoryGrowthTest, "Puerts.WasmCore.Runtime.MemoryGrowth",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWasmRuntimeMemoryGrowthTest::RunTest(const FString& Parameters)
+{
+    using namespace WasmRuntimeTests;
+
+    WasmEnv Env;
+
+    // 和 Wasm_NewMemory(0, N) 一样从0页开始
+    {
+        WasmRuntime Runtime(&Env, 4, 0);
+        int Length = -1;
+        const uint8* Buffer = Runtime.GetBuffer(Length);
+        TestNotNull(TEXT("Zero page memory has a header"), Buffer);
+        TestEqual(TEXT("Zero page length"), Length, 0);
+        TestEqual(TEXT("Grow from zero pages"), Runtime.Grow(1), 0);
+        Runtime.GetBuffer(Length);
+        TestEqual(TEXT("Length after growing from zero pages"), Length, PageSize);
+    }
+
+    // 和 Wasm_MemoryGrowth 一样逐页增长，已有的数据保留，新页是0
+    {
+        const int MaxPages = 64;
+        std::shared_ptr<WasmRuntime> Runtime = WasmRuntime::Acquire(&Env, MaxPages, 0);
+        for (int Pages = 0; Pages < MaxPages; ++Pages)
+        {
+            const uint32 ReservedBefore = GetNumReservedPages(*Runtime);
+            if (!TestEqual(TEXT("Grow returns previous pages"), Runtime->Grow(1), Pages))
+            {
+                return false;
+            }
+
+            int Length = 0;
+            const uint8* Buffer = Runtime->GetBuffer(Length);
+            TestEqual(TEXT("Length follows pages"), Length, (Pages + 1) * PageSize);
+            for (int Page = 0; Page < Pages; ++Page)
+            {
+                if (Buffer[Page * PageSize] != (uint8) (Page + 1) || Buffer[(Page + 1) * PageSize - 1] != (uint8) (Page + 1))
+                {
+                    AddError(FString::Printf(TEXT("Page %d lost its data after growing to %d pages"), Page, Pages + 1));
+                }
+            }
+            for (int Offset = Pages * PageSize; Offset < Length; ++Offset)
+            {
+                if (Buffer[Offset] != 0)
+                {
+                    AddError(FString::Printf(TEXT("New page %d is not zeroed"), Pages));
+                    break;
+                }
+            }
+            Runtime->GetBuffer(Length)[Pages * PageSize] = (uint8) (Pages + 1);
+            Runtime->GetBuffer(Length)[(Pages + 1) * PageSize - 1] = (uint8) (Pages + 1);
+
+            const uint32 ReservedAfter = GetNumReservedPages(*Runtime);
+            TestTrue(TEXT("Reservation stays within max pages"), ReservedAfter <= FMath::Max(ReservedBefore, (uint32) MaxPages));
+            TestTrue(TEXT("Reservation grows by a bounded step"),
+                ReservedAfter <= FMath::Max(ReservedBefore, (uint32) (Pages + 1 + d_m3MaxReserveGrowPages)));
+        }
+
+        TestEqual(TEXT("Grow past max pages keeps the size"), Runtime->Grow(1), MaxPages);
+        int Length = 0;
+        Runtime->GetBuffer(Length);
+        TestEqual(TEXT("Length after failed grow"), Length, MaxPages * PageSize);
+    }
+
+    // 上限很大时，一次增长不能预留到上限
+    {
+        std::shared_ptr<WasmRuntime> Runtime = WasmRuntime::Acquire(&Env, d_m3MaxLinearMemoryPages, 1);
+        const uint32 ReservedBefore = GetNumReservedPages(*Runtime);
+        Runtime->Grow(ReservedBefore);
+        const uint32 Pages = ReservedBefore + 1;
+        TestTrue(TEXT("Large max pages reservation is bounded"), GetNumReservedPages(*Runtime) <= Pages + d_m3MaxReserveGrowPages);
+    }
+
+    // 单线程里很多 runtime 同时存在，随机增长、乱序归还再取出
+    FRandomStream Random(35);
+    TArray<std::shared_ptr<WasmRuntime>> Runtimes;
+    int32 NumDirty = 0;
+    for (int32 Round = 0; Round < 10; ++Round)
+    {
+        while (Runtimes.Num() < 32)
+        {
+            std::shared_ptr<WasmRuntime> Runtime = WasmRuntime::Acquire(&Env, 32, Random.RandRange(0, 2));
+            if (!IsZeroed(*Runtime))
+            {
+                ++NumDirty;
+            }
+            Runtimes.Add(Runtime);
+        }
+        for (std::shared_ptr<WasmRuntime>& Runtime : Runtimes)
+        {
+            Runtime->Grow(Random.RandRange(0, 4));
+            MarkPages(*Runtime, (uint8) Random.RandRange(1, 255));
+        }
+        for (int32 i = Runtimes.Num() - 1; i >= 0; --i)
+        {
+            if (Random.FRand() < 0.5f)
+            {
+                Runtimes.RemoveAtSwap(i);
+            }
+        }
+    }
+    TestEqual(TEXT("Runtimes from the pool start with zeroed memory"), NumDirty, 0);
+    Runtimes.Empty();
+
+    WasmRuntime::EmptyPool();
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWasmRuntimeConcurrentPoolTest, "Puerts.WasmCore.Runtime.ConcurrentPool",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWasmRuntimeConcurrentPoolTest::RunTest(const FString& Parameters)
+{
+    using namespace WasmRuntimeTests;
+
+    const int32 NumWorkers = 8;
+    const int32 NumAcquiresPerWorker = 500;
+
+    // 每个 worker 一个独立线程，同时在池里取出和归还
+    const WasmRuntimePoolStats StatsBefore = WasmRuntime::GetPoolStats();
+    const double StartTime = FPlatformTime::Seconds();
+    TArray<TFuture<FWorkerResult>> Workers;
+    for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+    {
+        Workers.Add(Async(EAsyncExecution::Thread,
+            [WorkerIndex, NumAcquiresPerWorker]() { return RunPoolWorker(WorkerIndex, NumAcquiresPerWorker); }));
+    }
+
+    int32 NumDirty = 0;
+    TSet<uint16> Seqs;
+    int32 NumSeqs = 0;
+    for (TFuture<FWorkerResult>& Worker : Workers)
+    {
+        const FWorkerResult Result = Worker.Get();
+        NumDirty += Result.NumDirty;
+        NumSeqs += Result.Seqs.Num();
+        Seqs.Append(Result.Seqs);
+    }
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+    const WasmRuntimePoolStats StatsAfter = WasmRuntime::GetPoolStats();
+
+    const int32 NumAcquires = NumWorkers * NumAcquiresPerWorker;
+    TestEqual(TEXT("Every acquire was counted"), (StatsAfter.NumCreated - StatsBefore.NumCreated) + (StatsAfter.NumReused - StatsBefore.NumReused), NumAcquires);
+    TestEqual(TEXT("Runtimes from the pool start with zeroed memory"), NumDirty, 0);
+    // 序号是 uint16，总次数不到一圈，每次取出都应该拿到不同的序号
+    TestEqual(TEXT("Every acquired runtime got a distinct sequence number"), Seqs.Num(), NumSeqs);
+    TestFalse(TEXT("Sequence number zero is never handed out"), Seqs.Contains(0));
+    // 和 WasmRuntime.cpp 里的 MaxPooledWasmRuntimes 一致
+    TestTrue(TEXT("Pool stays within its limit"), StatsAfter.NumPooled <= 8);
+
+    AddInfo(FString::Printf(TEXT("%d threads x %d acquires in %.3f ms (%d created, %d reused)"), NumWorkers, NumAcquiresPerWorker, Seconds * 1000.0,
+        StatsAfter.NumCreated - StatsBefore.NumCreated, StatsAfter.NumReused - StatsBefore.NumReused));
+
+    WasmRuntime::EmptyPool();
+
+    return true;
+}
+
+#endif    // WITH_DEV_AUTOMATION_TESTS
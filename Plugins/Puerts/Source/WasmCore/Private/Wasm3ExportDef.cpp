@@ -30,6 +30,28 @@ WASMCORE_API bool Export_m3_Call(IM3Function i_function, uint32_t i_argc, const
     return true;
 }
 
+WASMCORE_API bool Export_m3_PrepareCallArgs(IM3Function i_function, uint64_t** o_argStack)
+{
+    M3Result err = m3_PrepareCallArgs(i_function, o_argStack);
+    if (err)
+    {
+        UE_LOG(LogTemp, Error, TEXT("m3_PrepareCallArgs error for %s: %s"), UTF8_TO_TCHAR(i_function->export_name), UTF8_TO_TCHAR(err));
+        return false;
+    }
+    return true;
+}
+
+WASMCORE_API bool Export_m3_CallPreparedArgs(IM3Function i_function)
+{
+    M3Result err = m3_CallPreparedArgs(i_function);
+    if (err)
+    {
+        UE_LOG(LogTemp, Error, TEXT("m3_Call error for %s: %s"), UTF8_TO_TCHAR(i_function->export_name), UTF8_TO_TCHAR(err));
+        return false;
+    }
+    return true;
+}
+
 WASMCORE_API bool Export_m3_LinkRawFunctionEx(IM3Module io_module, const char* const i_moduleName, const char* const i_functionName,
     const char* const i_signature, M3RawCall i_function, const void* i_userdata)
 {
@@ -55,6 +55,7 @@ void WasmCoreModule::StartupModule()
 
 void WasmCoreModule::ShutdownModule()
 {
+    WasmRuntime::EmptyPool();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -13,20 +13,24 @@
 #include "m3_exec_defs.h"
 #include "m3_env.h"
 #include "WasmModuleInstance.h"
+#include "Misc/ScopeLock.h"
 
 static TArray<WasmRuntime*> _AllWasmRuntimes;
 static uint16 WasmRuntime_Seq = 1;
 
+// 空闲的runtime，重新创建时直接复用它们已经分配好的栈和线性内存
+static constexpr int32 MaxPooledWasmRuntimes = 8;
+static FCriticalSection _PoolLock;
+static TArray<WasmRuntime*> _PooledWasmRuntimes;
+static WasmRuntimePoolStats _PoolStats;
+
 WasmRuntime::WasmRuntime(WasmEnv* Env, int MaxPage /*= 10*/, int InitPage /*= 1*/, int StackSizeInBytes /*= 5 * 1024*/)
 {
-    _RuntimeSeq = WasmRuntime_Seq;
-    WasmRuntime_Seq++;
-    if (!WasmRuntime_Seq)
-        WasmRuntime_Seq++;
-    _Env = Env;
-    _Runtime = m3_NewRuntime(_Env->GetEnv(), StackSizeInBytes, this);
-    _Runtime->memory.maxPages = MaxPage;
-    ResizeMemory(_Runtime, InitPage);
+    _StackSizeInBytes = StackSizeInBytes;
+    _Runtime = m3_NewRuntime(Env->GetEnv(), StackSizeInBytes, this);
+    Init(Env, MaxPage, InitPage);
+
+    FScopeLock Lock(&_PoolLock);
     _AllWasmRuntimes.Add(this);
 }
 
@@ -43,9 +47,122 @@ WasmRuntime::~WasmRuntime()
         _Runtime = nullptr;
     }
 
+    FScopeLock Lock(&_PoolLock);
     _AllWasmRuntimes.Remove(this);
 }
 
+void WasmRuntime::Init(WasmEnv* Env, int MaxPage, int InitPage)
+{
+    //runtime可能在多个线程上创建和归还，序号和最高水位都由_PoolLock保护
+    int32 HighWaterPages = 0;
+    {
+        FScopeLock Lock(&_PoolLock);
+        _RuntimeSeq = WasmRuntime_Seq;
+        WasmRuntime_Seq++;
+        if (!WasmRuntime_Seq)
+            WasmRuntime_Seq++;
+        HighWaterPages = _PoolStats.HighWaterPages;
+    }
+    _Env = Env;
+    _Runtime->environment = _Env->GetEnv();
+    _Runtime->memory.maxPages = MaxPage;
+    //按历史最高水位一次分配好，之后Grow不需要realloc
+    ReserveMemory(_Runtime, FMath::Min(MaxPage, HighWaterPages));
+    ResizeMemory(_Runtime, InitPage);
+}
+
+void WasmRuntime::Reset()
+{
+    for (WasmModuleInstance*& Instance : _AllModuleInstances)
+    {
+        delete Instance;
+    }
+    _AllModuleInstances.Empty();
+
+    ResetRuntime(_Runtime);
+    _Env = nullptr;
+
+    CurrentStackAllocInfo = WasmStackAllocCacheInfo();
+    BaseStackAllocInfo = WasmStackAllocCacheInfo();
+    MaxWasmStackAllocCount = 0;
+}
+
+std::shared_ptr<WasmRuntime> WasmRuntime::Acquire(WasmEnv* Env, int MaxPage /*= 10*/, int InitPage /*= 1*/, int StackSizeInBytes /*= 5 * 1024*/)
+{
+    WasmRuntime* Runtime = nullptr;
+    {
+        FScopeLock Lock(&_PoolLock);
+        for (int32 i = _PooledWasmRuntimes.Num() - 1; i >= 0; --i)
+        {
+            if (_PooledWasmRuntimes[i]->_StackSizeInBytes == StackSizeInBytes)
+            {
+                Runtime = _PooledWasmRuntimes[i];
+                _PooledWasmRuntimes.RemoveAtSwap(i);
+                break;
+            }
+        }
+        _PoolStats.NumPooled = _PooledWasmRuntimes.Num();
+        if (Runtime)
+        {
+            _PoolStats.NumReused++;
+        }
+        else
+        {
+            _PoolStats.NumCreated++;
+        }
+    }
+
+    if (Runtime)
+    {
+        Runtime->Init(Env, MaxPage, InitPage);
+    }
+    else
+    {
+        Runtime = new WasmRuntime(Env, MaxPage, InitPage, StackSizeInBytes);
+    }
+    return std::shared_ptr<WasmRuntime>(Runtime, &WasmRuntime::ReleaseToPool);
+}
+
+void WasmRuntime::ReleaseToPool(WasmRuntime* Runtime)
+{
+    //模块实例和代码页属于创建时的WasmEnv，必须在WasmEnv销毁前释放，这里只保留栈和线性内存
+    const int32 Pages = Runtime->_Runtime->memory.numPages;
+    Runtime->Reset();
+
+    {
+        FScopeLock Lock(&_PoolLock);
+        _PoolStats.HighWaterPages = FMath::Max(_PoolStats.HighWaterPages, Pages);
+        if (_PooledWasmRuntimes.Num() < MaxPooledWasmRuntimes)
+        {
+            _PooledWasmRuntimes.Add(Runtime);
+            _PoolStats.NumPooled = _PooledWasmRuntimes.Num();
+            return;
+        }
+    }
+    delete Runtime;
+}
+
+void WasmRuntime::EmptyPool()
+{
+    TArray<WasmRuntime*> Runtimes;
+    {
+        FScopeLock Lock(&_PoolLock);
+        Runtimes = MoveTemp(_PooledWasmRuntimes);
+        _PooledWasmRuntimes.Reset();
+        _PoolStats.NumPooled = 0;
+    }
+    for (WasmRuntime* Runtime : Runtimes)
+    {
+        delete Runtime;
+    }
+}
+
+WasmRuntimePoolStats WasmRuntime::GetPoolStats()
+{
+    FScopeLock Lock(&_PoolLock);
+    return _PoolStats;
+}
+
 int WasmRuntime::Grow(int number)
 {
     int Ret = _Runtime->memory.numPages;
@@ -14,5 +14,8 @@
 // true表示成功,false表示失败
 WASMCORE_API bool Export_m3_GetResults(IM3Function i_function, uint32_t i_retc, const void* o_retptrs[]);
 WASMCORE_API bool Export_m3_Call(IM3Function i_function, uint32_t i_argc, const void* i_argptrs[]);
+// 参数直接写到 Export_m3_PrepareCallArgs 返回的栈上，调用后返回值在 o_argStack - numRets 处
+WASMCORE_API bool Export_m3_PrepareCallArgs(IM3Function i_function, uint64_t** o_argStack);
+WASMCORE_API bool Export_m3_CallPreparedArgs(IM3Function i_function);
 WASMCORE_API bool Export_m3_LinkRawFunctionEx(IM3Module io_module, const char* const i_moduleName, const char* const i_functionName,
     const char* const i_signature, M3RawCall i_function, const void* i_userdata);
@@ -10,6 +10,7 @@
 #include "CoreMinimal.h"
 #include "WasmCommonIncludes.h"
 #include "WasmEnv.h"
+#include <memory>
 
 class WasmModuleInstance;
 class WasmFunction;
@@ -21,6 +22,14 @@ struct WASMCORE_API WasmStackAllocCacheInfo
     char* RealPtr = nullptr;
 };
 
+struct WASMCORE_API WasmRuntimePoolStats
+{
+    int32 NumCreated = 0;
+    int32 NumReused = 0;
+    int32 NumPooled = 0;
+    int32 HighWaterPages = 0;
+};
+
 class WASMCORE_API WasmRuntime final
 {
 private:
@@ -28,6 +37,7 @@ private:
     IM3Runtime _Runtime;
     TArray<WasmModuleInstance*> _AllModuleInstances;
     uint16 _RuntimeSeq;
+    int _StackSizeInBytes;
 
     WasmStackAllocCacheInfo CurrentStackAllocInfo;
     WasmStackAllocCacheInfo BaseStackAllocInfo;
@@ -62,6 +72,14 @@ public:
     WasmRuntime(WasmEnv* Env, int MaxPage = 10, int InitPage = 1, int StackSizeInBytes = 5 * 1024);
     ~WasmRuntime();
 
+    //从池里取一个栈大小相同的runtime复用(保留线性内存的分配)，没有就新建，shared_ptr释放时放回池里
+    static std::shared_ptr<WasmRuntime> Acquire(WasmEnv* Env, int MaxPage = 10, int InitPage = 1, int StackSizeInBytes = 5 * 1024);
+
+    //释放池里所有的runtime，模块关闭时调用
+    static void EmptyPool();
+
+    static WasmRuntimePoolStats GetPoolStats();
+
     int Grow(int number);
     uint8* GetBuffer(int& Length);
 
@@ -86,4 +104,9 @@ public:
     void* GetPlatformAddress(WASM_PTR ptr);
 
     static WasmRuntime* StaticGetWasmRuntime(IM3Runtime Runtime);
+
+private:
+    void Init(WasmEnv* Env, int MaxPage, int InitPage);
+    void Reset();
+    static void ReleaseToPool(WasmRuntime* Runtime);
 };
\ No newline at end of file
@@ -24,6 +24,10 @@
 #   define d_m3MaxLinearMemoryPages             65536
 # endif
 
+# ifndef d_m3MaxReserveGrowPages                       // puerts: upper bound on the extra pages one resize may reserve ahead
+#   define d_m3MaxReserveGrowPages              256
+# endif
+
 # ifndef d_m3MaxFunctionSlots
 #   define d_m3MaxFunctionSlots                 ((d_m3MaxFunctionStackHeight)*2)
 # endif
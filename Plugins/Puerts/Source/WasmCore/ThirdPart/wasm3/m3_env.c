@@ -380,6 +380,29 @@ M3Result  ResizeMemory  (IM3Runtime io_runtime, u32 i_numPages)
         if (io_runtime->memoryLimit) {
             numPageBytes = M3_MIN (numPageBytes, io_runtime->memoryLimit);
         }
+        // puerts: grow the reservation geometrically so that page by page growth does not realloc every time,
+        // but never reserve more than d_m3MaxReserveGrowPages beyond what was asked for
+        else if (numPagesToAlloc > memory->numReservedPages or not memory->mallocated)
+        {
+            u32 numPagesToReserve = M3_MIN (memory->maxPages, memory->numReservedPages * 2);
+            numPagesToReserve = M3_MIN (numPagesToReserve, numPagesToAlloc + d_m3MaxReserveGrowPages);
+_           (ReserveMemory (io_runtime, M3_MAX (numPagesToAlloc, numPagesToReserve)))
+        }
+
+        if (not io_runtime->memoryLimit)
+        {
+            // puerts: pages exposed again after a shrink or a reset must read as zero
+            size_t numPreviousPageBytes = memory->numPages * d_m3MemPageSize;
+            if (numPageBytes > numPreviousPageBytes) {
+                memset (m3MemData (memory->mallocated) + numPreviousPageBytes, 0x0, numPageBytes - numPreviousPageBytes);
+            }
+
+            memory->numPages = numPagesToAlloc;
+            memory->mallocated->length = numPageBytes;
+
+            m3log (runtime, "resized mem: %p; length: %zu; pages: %d; reserved: %d", memory->mallocated, memory->mallocated->length, memory->numPages, memory->numReservedPages);
+            goto _catch;
+        }
 
         size_t numBytes = numPageBytes + sizeof (M3MemoryHeader);
 
@@ -397,6 +420,7 @@ M3Result  ResizeMemory  (IM3Runtime io_runtime, u32 i_numPages)
 # endif
 
         memory->numPages = numPagesToAlloc;
+        memory->numReservedPages = numPagesToAlloc;
 
         memory->mallocated->length =  numPageBytes;
         memory->mallocated->runtime = io_runtime;
@@ -411,6 +435,62 @@ M3Result  ResizeMemory  (IM3Runtime io_runtime, u32 i_numPages)
 }
 
 
+// puerts: allocate room for i_numPages without exposing them to the module
+M3Result  ReserveMemory  (IM3Runtime io_runtime, u32 i_numPages)
+{
+    M3Result result = m3Err_none;
+
+    M3Memory * memory = & io_runtime->memory;
+
+    // puerts: the header is always allocated, even for zero pages, ResizeMemory writes through it
+    if ((i_numPages > memory->numReservedPages or not memory->mallocated) and not io_runtime->memoryLimit)
+    {
+        size_t numBytes = (size_t) i_numPages * d_m3MemPageSize + sizeof (M3MemoryHeader);
+
+        size_t numPreviousBytes = memory->mallocated ? (size_t) memory->numReservedPages * d_m3MemPageSize + sizeof (M3MemoryHeader) : 0;
+
+        void* newMem = m3_Realloc ("Wasm Linear Memory", memory->mallocated, numBytes, numPreviousBytes);
+        _throwifnull(newMem);
+
+        bool isNew = (memory->mallocated == NULL);
+        memory->mallocated = (M3MemoryHeader*)newMem;
+        memory->numReservedPages = i_numPages;
+
+        if (isNew) {
+            memory->mallocated->length = 0;
+        }
+        memory->mallocated->runtime = io_runtime;
+        memory->mallocated->maxStack = (m3slot_t *) io_runtime->stack + io_runtime->numStackSlots;
+    }
+
+    _catch: return result;
+}
+
+
+// puerts: drop the modules and code of a runtime but keep its stack and linear memory for reuse
+void  ResetRuntime  (IM3Runtime io_runtime)
+{
+    ForEachModule (io_runtime, _FreeModule, NULL);                  d_m3Assert (io_runtime->numActiveCodePages == 0);
+
+    Environment_ReleaseCodePages (io_runtime->environment, io_runtime->pagesOpen);
+    Environment_ReleaseCodePages (io_runtime->environment, io_runtime->pagesFull);
+
+    io_runtime->pagesOpen = NULL;
+    io_runtime->pagesFull = NULL;
+    io_runtime->numCodePages = 0;
+    io_runtime->numActiveCodePages = 0;
+    io_runtime->modules = NULL;
+    io_runtime->lastCalled = NULL;
+    io_runtime->environment = NULL;
+    m3_ResetErrorInfo (io_runtime);
+
+    io_runtime->memory.numPages = 0;
+    if (io_runtime->memory.mallocated) {
+        io_runtime->memory.mallocated->length = 0;
+    }
+}
+
+
 M3Result  InitGlobals  (IM3Module io_module)
 {
     M3Result result = m3Err_none;
@@ -1020,6 +1100,41 @@ _   (checkStartFunction(i_function->module))
     _catch: return result;
 }
 
+// puerts: split m3_Call in two so that callers can write arguments straight into the runtime stack
+M3Result  m3_PrepareCallArgs  (IM3Function i_function, uint64_t ** o_argStack)
+{
+    M3Result result = m3Err_none;
+
+    if (!i_function->compiled) {
+        return m3Err_missingCompiledCode;
+    }
+
+# if d_m3RecordBacktraces
+    ClearBacktrace (i_function->module->runtime);
+# endif
+
+_   (checkStartFunction(i_function->module))
+
+    * o_argStack = (uint64_t *) GetStackPointerForArgs (i_function);
+
+    _catch: return result;
+}
+
+M3Result  m3_CallPreparedArgs  (IM3Function i_function)
+{
+    IM3Runtime runtime = i_function->module->runtime;
+    M3Result result = m3Err_none;
+
+    m3StackCheckInit();
+
+    result = (M3Result) RunCode (i_function->compiled, (m3stack_t)(runtime->stack), runtime->memory.mallocated, d_m3OpDefaultArgs);
+    ReportNativeStackUsage ();
+
+    runtime->lastCalled = result ? NULL : i_function;
+
+    return result;
+}
+
 
 //u8 * AlignStackPointerTo64Bits (const u8 * i_stack)
 //{
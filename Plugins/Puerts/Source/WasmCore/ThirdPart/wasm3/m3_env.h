@@ -31,6 +31,7 @@ typedef struct M3Memory
 
     u32                     numPages;
     u32                     maxPages;
+    u32                     numReservedPages;   // puerts: pages actually allocated, numPages <= numReservedPages
 }
 M3Memory;
 
@@ -200,6 +201,8 @@ void                        InitRuntime                 (IM3Runtime io_runtime,
 void                        Runtime_Release             (IM3Runtime io_runtime);
 
 M3Result                    ResizeMemory                (IM3Runtime io_runtime, u32 i_numPages);
+M3Result                    ReserveMemory               (IM3Runtime io_runtime, u32 i_numPages);
+void                        ResetRuntime                (IM3Runtime io_runtime);
 
 typedef void *              (* ModuleVisitor)           (IM3Module i_module, void * i_info);
 void *                      ForEachModule               (IM3Runtime i_runtime, ModuleVisitor i_visitor, void * i_info);
@@ -307,6 +307,10 @@ d_m3ErrorConst  (trapStackOverflow,             "[trap] stack overflow")
     M3Result            m3_Call                     (IM3Function i_function, uint32_t i_argc, const void * i_argptrs[]);
     M3Result            m3_CallArgv                 (IM3Function i_function, uint32_t i_argc, const char * i_argv[]);
 
+    // m3_PrepareCallArgs returns where the arguments go (8 bytes per slot); results are read from the slots before it
+    M3Result            m3_PrepareCallArgs          (IM3Function i_function, uint64_t ** o_argStack);
+    M3Result            m3_CallPreparedArgs         (IM3Function i_function);
+
     M3Result            m3_GetResultsV              (IM3Function i_function, ...);
     M3Result            m3_GetResultsVL             (IM3Function i_function, va_list o_rets);
     M3Result            m3_GetResults               (IM3Function i_function, uint32_t i_retc, const void * o_retptrs[]);
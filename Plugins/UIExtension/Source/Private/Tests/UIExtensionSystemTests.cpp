@@ -0,0 +1,312 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UIExtensionSystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Blueprint/UserWidget.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+namespace UIExtensionSystemTests
+{
+	constexpr int32 NumExtensionPoints = 100;
+	constexpr int32 NumExtensions = 500;
+
+	struct FPointSpec
+	{
+		FGameplayTag Tag;
+		EUIExtensionPointMatch MatchType = EUIExtensionPointMatch::ExactMatch;
+		UObject* ContextObject = nullptr;
+		UClass* AllowedDataClass = nullptr;
+	};
+
+	struct FExtensionSpec
+	{
+		FGameplayTag Tag;
+		UObject* ContextObject = nullptr;
+		UObject* Data = nullptr;
+	};
+
+	/** 和 FUIExtensionPoint::DoesExtensionPassContract 加上按标签匹配的规则一致，逐对检查 */
+	bool DoesExtensionMatchPoint(const FPointSpec& Point, const FExtensionSpec& Extension)
+	{
+		const bool bTagMatches = Point.MatchType == EUIExtensionPointMatch::ExactMatch
+			? Extension.Tag == Point.Tag
+			: Extension.Tag.MatchesTag(Point.Tag);
+		if (!bTagMatches || Point.ContextObject != Extension.ContextObject)
+		{
+			return false;
+		}
+
+		const UClass* DataClass = Extension.Data->IsA(UClass::StaticClass()) ? Cast<UClass>(Extension.Data) : Extension.Data->GetClass();
+		return DataClass->IsChildOf(Point.AllowedDataClass);
+	}
+
+	struct FScopedBatchNotifies
+	{
+		explicit FScopedBatchNotifies(bool bBatch)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(TEXT("UIExtension.BatchExtensionNotifies")))
+		{
+			if (CVar)
+			{
+				bPrevious = CVar->GetBool();
+				CVar->Set(bBatch, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedBatchNotifies()
+		{
+			if (CVar)
+			{
+				CVar->Set(bPrevious, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* CVar = nullptr;
+		bool bPrevious = true;
+	};
+
+	struct FScopedWorld
+	{
+		FScopedWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld=*/ false, TEXT("UIExtensionTestWorld"));
+
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+		}
+
+		~FScopedWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(/*bInformEngineOfWorld=*/ false);
+		}
+
+		UWorld* World = nullptr;
+	};
+
+	/** 注册 100 个扩展点和 500 个扩展，核对每个扩展点收到的通知数并输出各阶段耗时 */
+	bool RunRegistration(FAutomationTestBase& Test, const TCHAR* Label, bool bBatch, const TArray<FPointSpec>& Points, const TArray<FExtensionSpec>& Extensions, const TArray<int32>& ExpectedCounts)
+	{
+		const FScopedBatchNotifies ScopedBatch(bBatch);
+		const FScopedWorld ScopedWorld;
+
+		UUIExtensionSubsystem* Subsystem = ScopedWorld.World->GetSubsystem<UUIExtensionSubsystem>();
+		if (!Test.TestNotNull(TEXT("UIExtensionSubsystem"), Subsystem))
+		{
+			return false;
+		}
+
+		TArray<int32> AddedCounts;
+		AddedCounts.SetNumZeroed(Points.Num());
+		TArray<int32> RemovedCounts;
+		RemovedCounts.SetNumZeroed(Points.Num());
+
+		auto RegisterPoints = [&](TArray<FUIExtensionPointHandle>& OutHandles)
+		{
+			for (int32 PointIndex = 0; PointIndex < Points.Num(); ++PointIndex)
+			{
+				const FPointSpec& Point = Points[PointIndex];
+				OutHandles.Add(Subsystem->RegisterExtensionPointForContext(Point.Tag, Point.ContextObject, Point.MatchType, { Point.AllowedDataClass },
+					FExtendExtensionPointDelegate::CreateLambda([&AddedCounts, &RemovedCounts, PointIndex](EUIExtensionAction Action, const FUIExtensionRequest&)
+					{
+						++(Action == EUIExtensionAction::Added ? AddedCounts : RemovedCounts)[PointIndex];
+					})));
+			}
+		};
+
+		// 先有扩展点，再批量注册扩展
+		TArray<FUIExtensionPointHandle> PointHandles;
+		RegisterPoints(PointHandles);
+
+		const double ExtensionsStartTime = FPlatformTime::Seconds();
+		TArray<FUIExtensionHandle> ExtensionHandles;
+		for (const FExtensionSpec& Extension : Extensions)
+		{
+			ExtensionHandles.Add(Subsystem->RegisterExtensionAsData(Extension.Tag, Extension.ContextObject, Extension.Data, -1));
+		}
+		Subsystem->FlushPendingExtensionNotifies();
+		const double ExtensionsSeconds = FPlatformTime::Seconds() - ExtensionsStartTime;
+
+		Test.TestTrue(FString::Printf(TEXT("%s: notifications after registering extensions"), Label), AddedCounts == ExpectedCounts);
+
+		// 扩展已经存在，重新注册扩展点
+		for (FUIExtensionPointHandle& Handle : PointHandles)
+		{
+			Handle.Unregister();
+		}
+		PointHandles.Reset();
+		AddedCounts.Init(0, Points.Num());
+
+		const double PointsStartTime = FPlatformTime::Seconds();
+		RegisterPoints(PointHandles);
+		const double PointsSeconds = FPlatformTime::Seconds() - PointsStartTime;
+
+		Test.TestTrue(FString::Printf(TEXT("%s: notifications after registering extension points"), Label), AddedCounts == ExpectedCounts);
+
+		const double UnregisterStartTime = FPlatformTime::Seconds();
+		for (FUIExtensionHandle& Handle : ExtensionHandles)
+		{
+			Handle.Unregister();
+		}
+		const double UnregisterSeconds = FPlatformTime::Seconds() - UnregisterStartTime;
+
+		Test.TestTrue(FString::Printf(TEXT("%s: notifications after unregistering extensions"), Label), RemovedCounts == ExpectedCounts);
+
+		for (FUIExtensionPointHandle& Handle : PointHandles)
+		{
+			Handle.Unregister();
+		}
+
+		Test.AddInfo(FString::Printf(TEXT("%s: %d extensions -> %d points %.3f ms, %d points -> %d extensions %.3f ms, unregister %.3f ms"),
+			Label, Extensions.Num(), Points.Num(), ExtensionsSeconds * 1000.0, Points.Num(), Extensions.Num(), PointsSeconds * 1000.0, UnregisterSeconds * 1000.0));
+
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUIExtensionSystemBenchmarkTest, "UIExtension.Subsystem.Benchmark", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FUIExtensionSystemBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace UIExtensionSystemTests;
+
+	// 用项目里已有的标签，带层级的标签才能覆盖部分匹配
+	FGameplayTagContainer AllTags;
+	UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, /*OnlyIncludeDictionaryTags=*/ false);
+	TArray<FGameplayTag> Tags;
+	AllTags.GetGameplayTagArray(Tags);
+	Tags.Sort([](const FGameplayTag& A, const FGameplayTag& B) { return A.GetTagName().LexicalLess(B.GetTagName()); });
+
+	if (Tags.Num() < 2)
+	{
+		AddWarning(TEXT("Not enough gameplay tags registered to run the benchmark"));
+		return true;
+	}
+
+	UObject* ContextObjects[] = { nullptr, CreatePackage(TEXT("/Temp/UIExtensionTestContext")) };
+	UClass* DataClasses[] = { UUserWidget::StaticClass(), UObject::StaticClass() };
+	// 类本身和实例都可以作为扩展的数据
+	UObject* DataObjects[] = { UUserWidget::StaticClass(), UObject::StaticClass(), GetTransientPackage() };
+
+	FRandomStream Random(0x5E1EC7);
+
+	TArray<FPointSpec> Points;
+	for (int32 PointIndex = 0; PointIndex < NumExtensionPoints; ++PointIndex)
+	{
+		FPointSpec& Point = Points.AddDefaulted_GetRef();
+		Point.Tag = Tags[Random.RandHelper(Tags.Num())];
+		Point.MatchType = (PointIndex % 2 == 0) ? EUIExtensionPointMatch::ExactMatch : EUIExtensionPointMatch::PartialMatch;
+		Point.ContextObject = ContextObjects[Random.RandHelper(UE_ARRAY_COUNT(ContextObjects))];
+		Point.AllowedDataClass = DataClasses[Random.RandHelper(UE_ARRAY_COUNT(DataClasses))];
+	}
+
+	TArray<FExtensionSpec> Extensions;
+	for (int32 ExtensionIndex = 0; ExtensionIndex < NumExtensions; ++ExtensionIndex)
+	{
+		FExtensionSpec& Extension = Extensions.AddDefaulted_GetRef();
+		// 一半的扩展落在某个扩展点的标签上，保证有足够多的命中
+		Extension.Tag = (ExtensionIndex % 2 == 0) ? Points[Random.RandHelper(Points.Num())].Tag : Tags[Random.RandHelper(Tags.Num())];
+		Extension.ContextObject = ContextObjects[Random.RandHelper(UE_ARRAY_COUNT(ContextObjects))];
+		Extension.Data = DataObjects[Random.RandHelper(UE_ARRAY_COUNT(DataObjects))];
+	}
+
+	// 逐对检查作为参照结果，也是不建索引时的开销
+	const double ReferenceStartTime = FPlatformTime::Seconds();
+	TArray<int32> ExpectedCounts;
+	ExpectedCounts.SetNumZeroed(Points.Num());
+	int32 TotalMatches = 0;
+	for (int32 PointIndex = 0; PointIndex < Points.Num(); ++PointIndex)
+	{
+		for (const FExtensionSpec& Extension : Extensions)
+		{
+			if (DoesExtensionMatchPoint(Points[PointIndex], Extension))
+			{
+				++ExpectedCounts[PointIndex];
+				++TotalMatches;
+			}
+		}
+	}
+	AddInfo(FString::Printf(TEXT("Reference pairwise scan: %d matches in %.3f ms"), TotalMatches, (FPlatformTime::Seconds() - ReferenceStartTime) * 1000.0));
+
+	TestTrue(TEXT("Corpus produces matches"), TotalMatches > 0);
+
+	RunRegistration(*this, TEXT("Batched"), /*bBatch=*/ true, Points, Extensions, ExpectedCounts);
+	RunRegistration(*this, TEXT("Immediate"), /*bBatch=*/ false, Points, Extensions, ExpectedCounts);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUIExtensionSystemDestroyedContextTest, "UIExtension.Subsystem.DestroyedContext", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FUIExtensionSystemDestroyedContextTest::RunTest(const FString& Parameters)
+{
+	using namespace UIExtensionSystemTests;
+
+	FGameplayTagContainer AllTags;
+	UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, /*OnlyIncludeDictionaryTags=*/ false);
+	if (AllTags.IsEmpty())
+	{
+		AddWarning(TEXT("No gameplay tags registered to run the test"));
+		return true;
+	}
+	const FGameplayTag Tag = AllTags.First();
+
+	const FScopedBatchNotifies ScopedBatch(/*bBatch=*/ false);
+	const FScopedWorld ScopedWorld;
+	UUIExtensionSubsystem* Subsystem = ScopedWorld.World->GetSubsystem<UUIExtensionSubsystem>();
+	if (!TestNotNull(TEXT("UIExtensionSubsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	int32 AddedCounts[2] = { 0, 0 };
+	int32 RemovedCounts[2] = { 0, 0 };
+	auto RegisterPoint = [&](int32 PointIndex)
+	{
+		return Subsystem->RegisterExtensionPoint(Tag, EUIExtensionPointMatch::ExactMatch, { UObject::StaticClass() },
+			FExtendExtensionPointDelegate::CreateLambda([&AddedCounts, &RemovedCounts, PointIndex](EUIExtensionAction Action, const FUIExtensionRequest&)
+			{
+				++(Action == EUIExtensionAction::Added ? AddedCounts : RemovedCounts)[PointIndex];
+			}));
+	};
+
+	FUIExtensionPointHandle NullContextPoint = RegisterPoint(0);
+
+	// Context 销毁后弱指针失效，不能把它的扩展当成没有 Context 的扩展
+	UObject* Context = CreatePackage(nullptr);
+	FUIExtensionHandle ContextExtension = Subsystem->RegisterExtensionAsData(Tag, Context, UObject::StaticClass(), -1);
+	Context->MarkAsGarbage();
+
+	FUIExtensionHandle NullContextExtension = Subsystem->RegisterExtensionAsData(Tag, nullptr, UObject::StaticClass(), -1);
+	TestEqual(TEXT("Existing point only sees the extension without context"), AddedCounts[0], 1);
+
+	FUIExtensionPointHandle LatePoint = RegisterPoint(1);
+	TestEqual(TEXT("Late point only sees the extension without context"), AddedCounts[1], 1);
+
+	ContextExtension.Unregister();
+	TestEqual(TEXT("Unregistering the destroyed context's extension notifies no point"), RemovedCounts[0] + RemovedCounts[1], 0);
+
+	NullContextExtension.Unregister();
+	TestEqual(TEXT("Existing point removes the extension without context"), RemovedCounts[0], 1);
+	TestEqual(TEXT("Late point removes the extension without context"), RemovedCounts[1], 1);
+
+	// 全部注销后重新注册，不能收到残留的扩展
+	NullContextPoint.Unregister();
+	LatePoint.Unregister();
+	AddedCounts[0] = 0;
+	NullContextPoint = RegisterPoint(0);
+	TestEqual(TEXT("No extensions left behind"), AddedCounts[0], 0);
+	NullContextPoint.Unregister();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
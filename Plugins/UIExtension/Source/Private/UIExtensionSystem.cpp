@@ -3,6 +3,7 @@
 #include "UIExtensionSystem.h"
 
 #include "Blueprint/UserWidget.h"
+#include "HAL/IConsoleManager.h"
 #include "LogUIExtension.h"
 #include "UObject/Stack.h"
 
@@ -10,6 +11,16 @@
 
 class FSubsystemCollectionBase;
 
+namespace UIExtensionCVars
+{
+	static bool bBatchExtensionNotifies = true;
+	static FAutoConsoleVariableRef CVarBatchExtensionNotifies(
+		TEXT("UIExtension.BatchExtensionNotifies"),
+		bBatchExtensionNotifies,
+		TEXT("Defer notifying extension points of extensions registered within a frame and handle them in one pass on the next tick."),
+		ECVF_Default);
+}
+
 //=========================================================
 
 void FUIExtensionPointHandle::Unregister()
@@ -36,28 +47,42 @@ bool FUIExtensionPoint::DoesExtensionPassContract(const FUIExtension* Extension)
 {
 	if (UObject* DataPtr = Extension->Data)
 	{
-		const bool bMatchesContext = 
-			(ContextObject.IsExplicitlyNull() && Extension->ContextObject.IsExplicitlyNull()) ||
-			ContextObject == Extension->ContextObject;
+		// Context 销毁后弱指针会和空指针相等，按注册时的 Key 比较
+		const bool bMatchesContext = ContextKey == Extension->ContextKey;
 
 		// Make sure the contexts match.
 		if (bMatchesContext)
 		{
 			// The data can either be the literal class of the data type, or a instance of the class type.
 			const UClass* DataClass = DataPtr->IsA(UClass::StaticClass()) ? Cast<UClass>(DataPtr) : DataPtr->GetClass();
-			for (const UClass* AllowedDataClass : AllowedDataClasses)
-			{
-				if (DataClass->IsChildOf(AllowedDataClass) || DataClass->ImplementsInterface(AllowedDataClass))
-				{
-					return true;
-				}
-			}
+			return DoesDataClassPassContract(DataClass);
 		}
 	}
 
 	return false;
 }
 
+bool FUIExtensionPoint::DoesDataClassPassContract(const UClass* DataClass) const
+{
+	if (const bool* CachedResult = DataClassContractCache.Find(DataClass))
+	{
+		return *CachedResult;
+	}
+
+	bool bPasses = false;
+	for (const UClass* AllowedDataClass : AllowedDataClasses)
+	{
+		if (DataClass->IsChildOf(AllowedDataClass) || DataClass->ImplementsInterface(AllowedDataClass))
+		{
+			bPasses = true;
+			break;
+		}
+	}
+
+	DataClassContractCache.Add(DataClass, bPasses);
+	return bPasses;
+}
+
 //=========================================================
 
 void UUIExtensionSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
@@ -91,6 +116,18 @@ void UUIExtensionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UUIExtensionSubsystem::Deinitialize()
 {
+	if (PendingNotifyTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingNotifyTickerHandle);
+		PendingNotifyTickerHandle.Reset();
+	}
+
+	for (const TSharedPtr<FUIExtension>& Extension : PendingAddedExtensions)
+	{
+		Extension->bPendingAddNotify = false;
+	}
+	PendingAddedExtensions.Empty();
+
 	Super::Deinitialize();
 }
 
@@ -119,11 +156,12 @@ FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPointForContext(
 		return FUIExtensionPointHandle();
 	}
 
-	FExtensionPointList& List = ExtensionPointMap.FindOrAdd(ExtensionPointTag);
+	FExtensionPointList& List = ExtensionPointMap.FindOrAdd(FUIExtensionPointKey(ExtensionPointTag, ExtensionPointTagMatchType, FObjectKey(ContextObject)));
 
 	TSharedPtr<FUIExtensionPoint>& Entry = List.Add_GetRef(MakeShared<FUIExtensionPoint>());
 	Entry->ExtensionPointTag = ExtensionPointTag;
 	Entry->ContextObject = ContextObject;
+	Entry->ContextKey = FObjectKey(ContextObject);
 	Entry->ExtensionPointTagMatchType = ExtensionPointTagMatchType;
 	Entry->AllowedDataClasses = AllowedDataClasses;
 	Entry->Callback = MoveTemp(ExtensionCallback);
@@ -159,11 +197,12 @@ FUIExtensionHandle UUIExtensionSubsystem::RegisterExtensionAsData(const FGamepla
 		return FUIExtensionHandle();
 	}
 
-	FExtensionList& List = ExtensionMap.FindOrAdd(ExtensionPointTag);
+	FExtensionList& List = ExtensionMap.FindOrAdd(FUIExtensionKey(ExtensionPointTag, FObjectKey(ContextObject)));
 
 	TSharedPtr<FUIExtension>& Entry = List.Add_GetRef(MakeShared<FUIExtension>());
 	Entry->ExtensionPointTag = ExtensionPointTag;
 	Entry->ContextObject = ContextObject;
+	Entry->ContextKey = FObjectKey(ContextObject);
 	Entry->Data = Data;
 	Entry->Priority = Priority;
 
@@ -176,7 +215,20 @@ FUIExtensionHandle UUIExtensionSubsystem::RegisterExtensionAsData(const FGamepla
 		UE_LOG(LogUIExtension, Verbose, TEXT("Extension [%s] for [%s] @ [%s] Registered"), *GetNameSafe(Data), *GetNameSafe(ContextObject), *ExtensionPointTag.ToString());
 	}
 
-	NotifyExtensionPointsOfExtension(EUIExtensionAction::Added, Entry);
+	if (UIExtensionCVars::bBatchExtensionNotifies)
+	{
+		// 一帧内经常会一次注册很多扩展（比如 GameFeature 激活时的 HUD），攒到下一次 Tick 一起通知
+		Entry->bPendingAddNotify = true;
+		PendingAddedExtensions.Add(Entry);
+		if (!PendingNotifyTickerHandle.IsValid())
+		{
+			PendingNotifyTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::HandlePendingExtensionNotifies));
+		}
+	}
+	else
+	{
+		NotifyExtensionPointsOfExtension(EUIExtensionAction::Added, Entry);
+	}
 
 	return FUIExtensionHandle(this, Entry);
 }
@@ -185,13 +237,20 @@ void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExten
 {
 	for (FGameplayTag Tag = ExtensionPoint->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
 	{
-		if (const FExtensionList* ListPtr = ExtensionMap.Find(Tag))
+		// 索引里同一个列表的 Context 都和扩展点一致，只需要再检查数据类
+		if (const FExtensionList* ListPtr = ExtensionMap.Find(FUIExtensionKey(Tag, ExtensionPoint->ContextKey)))
 		{
 			// Copy in case there are removals while handling callbacks
 			FExtensionList ExtensionArray(*ListPtr);
 
 			for (const TSharedPtr<FUIExtension>& Extension : ExtensionArray)
 			{
+				// 还在等批量通知的扩展，到时候会通知到这个扩展点
+				if (Extension->bPendingAddNotify)
+				{
+					continue;
+				}
+
 				if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
 				{
 					FUIExtensionRequest Request = CreateExtensionRequest(Extension);
@@ -212,28 +271,69 @@ void UUIExtensionSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAction
 	bool bOnInitialTag = true;
 	for (FGameplayTag Tag = Extension->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
 	{
-		if (const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Tag))
+		// 自身的 Tag 精确匹配和部分匹配的扩展点都要通知，父 Tag 只通知部分匹配的
+		if (bOnInitialTag)
 		{
-			// Copy in case there are removals while handling callbacks
-			FExtensionPointList ExtensionPointArray(*ListPtr);
-
-			for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : ExtensionPointArray)
-			{
-				if (bOnInitialTag || (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::PartialMatch))
-				{
-					if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
-					{
-						FUIExtensionRequest Request = CreateExtensionRequest(Extension);
-						auto _ = ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
-					}
-				}
-			}
+			NotifyExtensionPointList(FUIExtensionPointKey(Tag, EUIExtensionPointMatch::ExactMatch, Extension->ContextKey), Action, Extension);
 		}
+		NotifyExtensionPointList(FUIExtensionPointKey(Tag, EUIExtensionPointMatch::PartialMatch, Extension->ContextKey), Action, Extension);
 		
 		bOnInitialTag = false;
 	}
 }
 
+void UUIExtensionSubsystem::NotifyExtensionPointList(const FUIExtensionPointKey& Key, EUIExtensionAction Action, const TSharedPtr<FUIExtension>& Extension)
+{
+	const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Key);
+	if (ListPtr == nullptr || Extension->Data == nullptr)
+	{
+		return;
+	}
+
+	// Copy in case there are removals while handling callbacks
+	FExtensionPointList ExtensionPointArray(*ListPtr);
+
+	// 列表里的 Context 已经一致，数据类在这一轮里只取一次
+	UObject* DataPtr = Extension->Data;
+	const UClass* DataClass = DataPtr->IsA(UClass::StaticClass()) ? Cast<UClass>(DataPtr) : DataPtr->GetClass();
+
+	for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : ExtensionPointArray)
+	{
+		if (ExtensionPoint->DoesDataClassPassContract(DataClass))
+		{
+			FUIExtensionRequest Request = CreateExtensionRequest(Extension);
+			auto _ = ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
+		}
+	}
+}
+
+void UUIExtensionSubsystem::FlushPendingExtensionNotifies()
+{
+	// 回调里可能继续注册扩展，新注册的会进下一批
+	FExtensionList PendingExtensions = MoveTemp(PendingAddedExtensions);
+	PendingAddedExtensions.Reset();
+
+	for (TSharedPtr<FUIExtension>& Extension : PendingExtensions)
+	{
+		// 通知之前就被注销了的直接跳过
+		if (Extension->bPendingAddNotify)
+		{
+			Extension->bPendingAddNotify = false;
+			NotifyExtensionPointsOfExtension(EUIExtensionAction::Added, Extension);
+		}
+	}
+}
+
+bool UUIExtensionSubsystem::HandlePendingExtensionNotifies(float DeltaTime)
+{
+	PendingNotifyTickerHandle.Reset();
+
+	FlushPendingExtensionNotifies();
+
+	// 回调里新注册的扩展会重新添加 Ticker
+	return false;
+}
+
 void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& ExtensionHandle)
 {
 	if (ExtensionHandle.IsValid())
@@ -241,7 +341,8 @@ void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& Extens
 		checkf(ExtensionHandle.ExtensionSource == this, TEXT("Trying to unregister an extension that's not from this extension subsystem."));
 
 		TSharedPtr<FUIExtension> Extension = ExtensionHandle.DataPtr;
-		if (FExtensionList* ListPtr = ExtensionMap.Find(Extension->ExtensionPointTag))
+		const FUIExtensionKey ExtensionKey(Extension->ExtensionPointTag, Extension->ContextKey);
+		if (FExtensionList* ListPtr = ExtensionMap.Find(ExtensionKey))
 		{
 			if (Extension->ContextObject.IsExplicitlyNull())
 			{
@@ -252,13 +353,27 @@ void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& Extens
 				UE_LOG(LogUIExtension, Verbose, TEXT("Extension [%s] for [%s] @ [%s] Unregistered"), *GetNameSafe(Extension->Data), *GetNameSafe(Extension->ContextObject.Get()), *Extension->ExtensionPointTag.ToString());
 			}
 
-			NotifyExtensionPointsOfExtension(EUIExtensionAction::Removed, Extension);
+			if (Extension->bPendingAddNotify)
+			{
+				// 扩展点还不知道这个扩展，不需要发 Removed
+				Extension->bPendingAddNotify = false;
+				PendingAddedExtensions.RemoveSingleSwap(Extension);
+			}
+			else
+			{
+				NotifyExtensionPointsOfExtension(EUIExtensionAction::Removed, Extension);
+			}
 
-			ListPtr->RemoveSwap(Extension);
-			
-			if (ListPtr->Num() == 0)
+			// 回调里可能改了索引，重新取一次列表
+			ListPtr = ExtensionMap.Find(ExtensionKey);
+			if (ListPtr)
 			{
-				ExtensionMap.Remove(Extension->ExtensionPointTag);
+				ListPtr->RemoveSwap(Extension);
+				
+				if (ListPtr->Num() == 0)
+				{
+					ExtensionMap.Remove(ExtensionKey);
+				}
 			}
 		}
 	}
@@ -275,14 +390,15 @@ void UUIExtensionSubsystem::UnregisterExtensionPoint(const FUIExtensionPointHand
 		check(ExtensionPointHandle.ExtensionSource == this);
 
 		const TSharedPtr<FUIExtensionPoint> ExtensionPoint = ExtensionPointHandle.DataPtr;
-		if (FExtensionPointList* ListPtr = ExtensionPointMap.Find(ExtensionPoint->ExtensionPointTag))
+		const FUIExtensionPointKey ExtensionPointKey(ExtensionPoint->ExtensionPointTag, ExtensionPoint->ExtensionPointTagMatchType, ExtensionPoint->ContextKey);
+		if (FExtensionPointList* ListPtr = ExtensionPointMap.Find(ExtensionPointKey))
 		{
 			UE_LOG(LogUIExtension, Verbose, TEXT("Extension Point [%s] Unregistered"), *ExtensionPoint->ExtensionPointTag.ToString());
 
 			ListPtr->RemoveSwap(ExtensionPoint);
 			if (ListPtr->Num() == 0)
 			{
-				ExtensionPointMap.Remove(ExtensionPoint->ExtensionPointTag);
+				ExtensionPointMap.Remove(ExtensionPointKey);
 			}
 		}
 	}
@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "GameplayTagContainer.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 
 #include "UIExtensionSystem.generated.h"
 
@@ -51,8 +53,12 @@ public:
 	FGameplayTag ExtensionPointTag;
 	int32 Priority = INDEX_NONE;
 	TWeakObjectPtr<UObject> ContextObject;
+	// 注册时的 Context，Context 销毁后仍能找回索引里的列表
+	FObjectKey ContextKey;
 	//Kept alive by UUIExtensionSubsystem::AddReferencedObjects
 	TObjectPtr<UObject> Data = nullptr;
+	// 已注册但还没通知给扩展点，等本帧的批量通知
+	bool bPendingAddNotify = false;
 };
 
 /**
@@ -63,6 +69,8 @@ struct FUIExtensionPoint : TSharedFromThis<FUIExtensionPoint>
 public:
 	FGameplayTag ExtensionPointTag;
 	TWeakObjectPtr<UObject> ContextObject;
+	// 注册时的 Context，Context 销毁后仍能找回索引里的列表
+	FObjectKey ContextKey;
 	EUIExtensionPointMatch ExtensionPointTagMatchType = EUIExtensionPointMatch::ExactMatch;
 	TArray<TObjectPtr<UClass>> AllowedDataClasses;
 	FExtendExtensionPointDelegate Callback;
@@ -70,6 +78,13 @@ public:
 	// Tests if the extension and the extension point match up, if they do then this extension point should learn
 	// about this extension.
 	bool DoesExtensionPassContract(const FUIExtension* Extension) const;
+
+	// Tests only the data class half of the contract, the result is cached per data class.
+	bool DoesDataClassPassContract(const UClass* DataClass) const;
+
+private:
+	// 数据类 -> 是否满足 AllowedDataClasses，同一个扩展点对同一个类只算一次
+	mutable TMap<TObjectKey<UClass>, bool> DataClassContractCache;
 };
 
 /**
@@ -183,6 +198,55 @@ public:
 	TObjectPtr<UObject> ContextObject = nullptr;
 };
 
+/*
+ * 扩展点索引的 Key，只有 Tag、匹配方式、Context 都相同的扩展点才会放在同一个列表里
+ * 通知时按 Key 直接取候选列表，不用遍历同一个 Tag 下的所有扩展点再逐个比较 Context
+ * Context 用 FObjectKey 而不是弱指针：弱指针失效后和空指针相等，哈希却还是原来的对象，会破坏 TMap 的查找
+ */
+struct FUIExtensionPointKey
+{
+	FGameplayTag Tag;
+	EUIExtensionPointMatch MatchType = EUIExtensionPointMatch::ExactMatch;
+	FObjectKey ContextKey;
+
+	FUIExtensionPointKey() {}
+	FUIExtensionPointKey(const FGameplayTag& InTag, EUIExtensionPointMatch InMatchType, const FObjectKey& InContextKey)
+		: Tag(InTag), MatchType(InMatchType), ContextKey(InContextKey) {}
+
+	bool operator==(const FUIExtensionPointKey& Other) const
+	{
+		return Tag == Other.Tag && MatchType == Other.MatchType && ContextKey == Other.ContextKey;
+	}
+
+	friend uint32 GetTypeHash(const FUIExtensionPointKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.Tag), GetTypeHash(static_cast<uint8>(Key.MatchType))), GetTypeHash(Key.ContextKey));
+	}
+};
+
+/*
+ * 扩展索引的 Key，Tag + Context
+ */
+struct FUIExtensionKey
+{
+	FGameplayTag Tag;
+	FObjectKey ContextKey;
+
+	FUIExtensionKey() {}
+	FUIExtensionKey(const FGameplayTag& InTag, const FObjectKey& InContextKey)
+		: Tag(InTag), ContextKey(InContextKey) {}
+
+	bool operator==(const FUIExtensionKey& Other) const
+	{
+		return Tag == Other.Tag && ContextKey == Other.ContextKey;
+	}
+
+	friend uint32 GetTypeHash(const FUIExtensionKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.Tag), GetTypeHash(Key.ContextKey));
+	}
+};
+
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FExtendExtensionPointDynamicDelegate, EUIExtensionAction, Action, const FUIExtensionRequest&, ExtensionRequest);
 
 /**
@@ -207,6 +271,9 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI Extension")
 	UE_API void UnregisterExtensionPoint(const FUIExtensionPointHandle& ExtensionPointHandle);
 
+	/** Immediately notifies extension points of extensions registered this frame instead of waiting for the batched pass. */
+	UE_API void FlushPendingExtensionNotifies();
+
 	static UE_API void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 
 protected:
@@ -244,6 +311,10 @@ protected:
 	UE_API FUIExtensionRequest CreateExtensionRequest(const TSharedPtr<FUIExtension>& Extension);
 
 private:
+	bool HandlePendingExtensionNotifies(float DeltaTime);
+
+	void NotifyExtensionPointList(const FUIExtensionPointKey& Key, EUIExtensionAction Action, const TSharedPtr<FUIExtension>& Extension);
+
 	/*
 	 * UMG上的扩展点说：我这里有个插槽，Tag=X，接受 UUserWidget 子类
 	 * 通过：
@@ -251,14 +322,18 @@ private:
 	 * ExtensionSubsystem->RegisterExtensionPointForContext
 	 */
 	typedef TArray<TSharedPtr<FUIExtensionPoint>> FExtensionPointList;
-	TMap<FGameplayTag, FExtensionPointList> ExtensionPointMap;
+	TMap<FUIExtensionPointKey, FExtensionPointList> ExtensionPointMap;
 
 	/*
 	 * GameFeatureFeature或者技能说: 我有个 Widget 类，要挂到 Tag=X 的插槽上
 	 * 通过 ExtensionSubsystem->RegisterExtensionAsWidgetForContext
 	 */
 	typedef TArray<TSharedPtr<FUIExtension>> FExtensionList;
-	TMap<FGameplayTag, FExtensionList> ExtensionMap;
+	TMap<FUIExtensionKey, FExtensionList> ExtensionMap;
+
+	// 本帧注册、还没通知的扩展，下一次 Ticker 时一起通知
+	FExtensionList PendingAddedExtensions;
+	FTSTicker::FDelegateHandle PendingNotifyTickerHandle;
 };
 
 
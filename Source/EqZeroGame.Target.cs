@@ -31,6 +31,13 @@ public class EqZeroGameTarget : TargetRules
 		bool bIsTest = Target.Configuration == UnrealTargetConfiguration.Test;
 		bool bIsShipping = Target.Configuration == UnrealTargetConfiguration.Shipping;
 		bool bIsDedicatedServer = Target.Type == TargetType.Server;
+
+		// 自动化测试和测试用的 UCLASS 放在单独的模块里，不进 Shipping
+		if (!bIsShipping)
+		{
+			Target.ExtraModuleNames.Add("EqZeroGameTests");
+		}
+
 		if (Target.BuildEnvironment == TargetBuildEnvironment.Unique)
 		{
 			Target.CppCompileWarningSettings.ShadowVariableWarningLevel = WarningLevel.Error;
@@ -16,7 +16,7 @@ struct FFrame;
  *
  * 定义施加伤害或治疗所需属性的类。属性示例包括：伤害、治疗量、攻击力和破盾值。
  */
-UCLASS(BlueprintType)
+UCLASS(MinimalAPI, BlueprintType)
 class UEqZeroCombatSet : public UEqZeroAttributeSet
 {
 	GENERATED_BODY()
@@ -0,0 +1,314 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqZeroGameplayCueManager.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "EqZeroLogChannels.h"
+#include "GameFeatureData.h"
+#include "GameFeaturesSubsystem.h"
+#include "GameFeatures/GameFeatureAction_AddGameplayCuePath.h"
+#include "GameModes/EqZeroExperienceActionSet.h"
+#include "GameModes/EqZeroExperienceDefinition.h"
+#include "GameplayCueSet.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroGameplayCueManager)
+
+namespace EqZeroGameplayCueManagerCVars
+{
+	static bool bPreloadExperienceCues = true;
+	static FAutoConsoleVariableRef CVarPreloadExperienceCues(
+		TEXT("EqZero.GameplayCues.PreloadExperienceCues"),
+		bPreloadExperienceCues,
+		TEXT("Asynchronously preload the gameplay cue notifies of an experience when it finishes loading."),
+		ECVF_Default);
+
+	static bool bCoalesceCuesPerFrame = true;
+	static FAutoConsoleVariableRef CVarCoalesceCuesPerFrame(
+		TEXT("EqZero.GameplayCues.CoalescePerFrame"),
+		bCoalesceCuesPerFrame,
+		TEXT("Batch gameplay cue executions raised within a frame into one flush, sending executions with identical parameters only once."),
+		ECVF_Default);
+}
+
+UEqZeroGameplayCueManager::UEqZeroGameplayCueManager(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+UEqZeroGameplayCueManager* UEqZeroGameplayCueManager::Get()
+{
+	return Cast<UEqZeroGameplayCueManager>(UAbilitySystemGlobals::Get().GetGameplayCueManager());
+}
+
+void UEqZeroGameplayCueManager::OnCreated()
+{
+	Super::OnCreated();
+
+	FWorldDelegates::OnWorldTickStart.AddUObject(this, &ThisClass::HandleWorldTickStart);
+	FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandleWorldPostActorTick);
+	FWorldDelegates::OnWorldCleanup.AddUObject(this, &ThisClass::HandleWorldCleanup);
+}
+
+bool UEqZeroGameplayCueManager::ShouldSyncLoadMissingGameplayCueNotifies() const
+{
+#if WITH_EDITOR
+	if (GIsEditor)
+	{
+		return true;
+	}
+#endif
+
+	// 预加载之外的 Cue 走异步加载，加载完成后再播放，不会卡住游戏线程
+	return !EqZeroGameplayCueManagerCVars::bPreloadExperienceCues;
+}
+
+void UEqZeroGameplayCueManager::PreloadGameplayCuesForExperience(const UEqZeroExperienceDefinition* Experience)
+{
+	if (Experience == nullptr)
+	{
+		return;
+	}
+
+	TArray<FString> CuePaths;
+
+	auto CollectCuePathsFromActions = [&CuePaths](const TArray<TObjectPtr<UGameFeatureAction>>& Actions, const FString& PluginRootPath)
+	{
+		for (const UGameFeatureAction* Action : Actions)
+		{
+			if (const UGameFeatureAction_AddGameplayCuePath* AddGameplayCueGFA = Cast<UGameFeatureAction_AddGameplayCuePath>(Action))
+			{
+				for (const FDirectoryPath& Directory : AddGameplayCueGFA->GetDirectoryPathsToAdd())
+				{
+					FString MutablePath = Directory.Path;
+					if (!PluginRootPath.IsEmpty())
+					{
+						UGameFeaturesSubsystem::FixPluginPackagePath(MutablePath, PluginRootPath, false);
+					}
+					CuePaths.AddUnique(MutablePath);
+				}
+			}
+		}
+	};
+
+	auto CollectCuePathsFromGameFeatures = [&CollectCuePathsFromActions](const TArray<FString>& FeaturePluginList)
+	{
+		for (const FString& PluginName : FeaturePluginList)
+		{
+			FString PluginURL;
+			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
+			{
+				if (const UGameFeatureData* GameFeatureData = UGameFeaturesSubsystem::Get().GetGameFeatureDataForActivePluginByURL(PluginURL))
+				{
+					CollectCuePathsFromActions(GameFeatureData->GetActions(), TEXT("/") + PluginName);
+				}
+			}
+		}
+	};
+
+	CollectCuePathsFromActions(Experience->Actions, FString());
+	CollectCuePathsFromGameFeatures(Experience->GameFeaturesToEnable);
+	for (const TObjectPtr<UEqZeroExperienceActionSet>& ActionSet : Experience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			CollectCuePathsFromActions(ActionSet->Actions, FString());
+			CollectCuePathsFromGameFeatures(ActionSet->GameFeaturesToEnable);
+		}
+	}
+
+	PreloadGameplayCuesInPaths(CuePaths);
+}
+
+TSharedPtr<FStreamableHandle> UEqZeroGameplayCueManager::PreloadGameplayCuesInPaths(const TArray<FString>& Paths)
+{
+	// Cue 只有表现，专用服务器不需要
+	if (!EqZeroGameplayCueManagerCVars::bPreloadExperienceCues || IsRunningDedicatedServer() || Paths.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	UGameplayCueSet* RuntimeCueSet = GetRuntimeCueSet();
+	if (RuntimeCueSet == nullptr)
+	{
+		return nullptr;
+	}
+
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const FGameplayCueNotifyData& CueData : RuntimeCueSet->GameplayCueData)
+	{
+		if ((CueData.LoadedGameplayCueClass != nullptr) || !CueData.GameplayCueNotifyObj.IsValid() || CuesBeingPreloaded.Contains(CueData.GameplayCueNotifyObj))
+		{
+			continue;
+		}
+
+		const FString CuePath = CueData.GameplayCueNotifyObj.ToString();
+		for (const FString& Path : Paths)
+		{
+			if (CuePath.StartsWith(Path))
+			{
+				AssetsToLoad.Add(CueData.GameplayCueNotifyObj);
+				break;
+			}
+		}
+	}
+
+	if (AssetsToLoad.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	UE_LOG(LogEqZero, Log, TEXT("Preloading %d gameplay cue notifies from %d paths"), AssetsToLoad.Num(), Paths.Num());
+
+	CuesBeingPreloaded.Append(AssetsToLoad);
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnGameplayCuePreloadComplete, AssetsToLoad, FPlatformTime::Seconds(), PreloadGeneration),
+		FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("PreloadGameplayCues"));
+}
+
+void UEqZeroGameplayCueManager::ReleasePreloadedGameplayCues()
+{
+	if (PreloadedCueClasses.IsEmpty() && CuesBeingPreloaded.IsEmpty())
+	{
+		return;
+	}
+
+	UE_LOG(LogEqZero, Log, TEXT("Releasing %d preloaded gameplay cue notifies"), PreloadedCueClasses.Num());
+
+	PreloadedCueClasses.Reset();
+	CuesBeingPreloaded.Reset();
+	++PreloadGeneration;
+}
+
+void UEqZeroGameplayCueManager::OnGameplayCuePreloadComplete(TArray<FSoftObjectPath> PreloadedAssets, double StartTime, uint32 RequestGeneration)
+{
+	// 请求发出之后体验已经卸载了
+	if (RequestGeneration != PreloadGeneration)
+	{
+		return;
+	}
+
+	int32 NumLoaded = 0;
+	for (const FSoftObjectPath& AssetPath : PreloadedAssets)
+	{
+		CuesBeingPreloaded.Remove(AssetPath);
+
+		// GameplayCueSet 在执行时会通过 FindObject 找到已经加载的类，这里只需要保持引用
+		if (UClass* CueClass = Cast<UClass>(AssetPath.ResolveObject()))
+		{
+			PreloadedCueClasses.Add(CueClass);
+			++NumLoaded;
+		}
+	}
+
+	UE_LOG(LogEqZero, Log, TEXT("Preloaded %d/%d gameplay cue notifies in %.2f seconds"), NumLoaded, PreloadedAssets.Num(), FPlatformTime::Seconds() - StartTime);
+}
+
+void UEqZeroGameplayCueManager::FlushPendingCues()
+{
+	SentCueExecutes.Reset();
+
+	Super::FlushPendingCues();
+
+	SentCueExecutes.Reset();
+}
+
+bool UEqZeroGameplayCueManager::ProcessPendingCueExecute(FGameplayCuePendingExecute& PendingCue)
+{
+	if (!Super::ProcessPendingCueExecute(PendingCue))
+	{
+		return false;
+	}
+
+	if (!EqZeroGameplayCueManagerCVars::bCoalesceCuesPerFrame)
+	{
+		return true;
+	}
+
+	// 哈希只用来分桶，真正判断重复要比较全部参数，不同的 EffectContext、位置、强度等都会照常发送
+	const uint32 CueHash = GetCueExecuteHash(PendingCue);
+
+	TArray<const FGameplayCuePendingExecute*, TInlineAllocator<4>> SameHashCues;
+	SentCueExecutes.MultiFind(CueHash, SameHashCues);
+	for (const FGameplayCuePendingExecute* SentCue : SameHashCues)
+	{
+		if (IsSameCueExecute(*SentCue, PendingCue))
+		{
+			return false;
+		}
+	}
+
+	SentCueExecutes.Add(CueHash, &PendingCue);
+	return true;
+}
+
+uint32 UEqZeroGameplayCueManager::GetCueExecuteHash(const FGameplayCuePendingExecute& PendingCue)
+{
+	uint32 CueHash = HashCombine(GetTypeHash(PendingCue.OwningComponent), GetTypeHash(static_cast<uint8>(PendingCue.PayloadType)));
+	CueHash = HashCombine(CueHash, GetTypeHash(PendingCue.PredictionKey.Current));
+	if (PendingCue.PayloadType == EGameplayCuePayloadType::FromSpec)
+	{
+		CueHash = HashCombine(CueHash, GetTypeHash(PendingCue.FromSpec.Def.Get()));
+		CueHash = HashCombine(CueHash, GetTypeHash(PendingCue.FromSpec.EffectContext.Get()));
+	}
+	else
+	{
+		CueHash = HashCombine(CueHash, GetTypeHash(PendingCue.CueParameters.EffectContext.Get()));
+	}
+	for (const FGameplayTag& CueTag : PendingCue.GameplayCueTags)
+	{
+		CueHash = HashCombine(CueHash, GetTypeHash(CueTag));
+	}
+	return CueHash;
+}
+
+bool UEqZeroGameplayCueManager::IsSameCueExecute(const FGameplayCuePendingExecute& A, const FGameplayCuePendingExecute& B)
+{
+	if ((A.OwningComponent != B.OwningComponent) || (A.PayloadType != B.PayloadType) || !(A.PredictionKey == B.PredictionKey) || (A.GameplayCueTags != B.GameplayCueTags))
+	{
+		return false;
+	}
+
+	// 逐个属性比较，EffectContextHandle 按指向的 Context 比较，不同次的应用不会被当成重复
+	if (A.PayloadType == EGameplayCuePayloadType::FromSpec)
+	{
+		return FGameplayEffectSpecForRPC::StaticStruct()->CompareScriptStruct(&A.FromSpec, &B.FromSpec, PPF_None);
+	}
+
+	return FGameplayCueParameters::StaticStruct()->CompareScriptStruct(&A.CueParameters, &B.CueParameters, PPF_None);
+}
+
+void UEqZeroGameplayCueManager::HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (!EqZeroGameplayCueManagerCVars::bCoalesceCuesPerFrame || (World == nullptr) || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	// 上一帧的没有正常关闭（比如世界没有执行 Actor Tick），先发出去
+	CloseFrameSendContext(World);
+
+	// 整帧打开一个 SendContext，这一帧内的 Cue 执行都会先挂起，Actor Tick 结束后一起发送
+	WorldsWithFrameSendContext.Add(FObjectKey(World));
+	StartGameplayCueSendContext();
+}
+
+void UEqZeroGameplayCueManager::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	CloseFrameSendContext(World);
+}
+
+void UEqZeroGameplayCueManager::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	CloseFrameSendContext(World);
+}
+
+void UEqZeroGameplayCueManager::CloseFrameSendContext(UWorld* World)
+{
+	if (WorldsWithFrameSendContext.Remove(FObjectKey(World)) > 0)
+	{
+		EndGameplayCueSendContext();
+	}
+}
@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameplayCueManager.h"
+#include "UObject/ObjectKey.h"
+
+#include "EqZeroGameplayCueManager.generated.h"
+
+class UEqZeroExperienceDefinition;
+class UWorld;
+struct FSoftObjectPath;
+struct FStreamableHandle;
+
+/**
+ * UEqZeroGameplayCueManager
+ *
+ *	游戏用的 GameplayCueManager
+ *	1. 体验加载完成后，收集体验和 GameFeature 里 AddGameplayCuePath 配置的目录，异步预加载其中的 Cue，
+ *	   避免第一次播放命中特效时同步加载导致卡顿
+ *	2. 一帧内发出的 Cue 执行合并到一次发送里，参数完全相同的重复执行只发一次
+ */
+UCLASS()
+class EQZEROGAME_API UEqZeroGameplayCueManager : public UGameplayCueManager
+{
+	GENERATED_BODY()
+
+	friend struct FEqZeroGameplayCueManagerTestAccess;
+
+public:
+	UEqZeroGameplayCueManager(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	static UEqZeroGameplayCueManager* Get();
+
+	//~UGameplayCueManager interface
+	virtual void OnCreated() override;
+	virtual bool ShouldSyncLoadMissingGameplayCueNotifies() const override;
+	virtual void FlushPendingCues() override;
+	virtual bool ProcessPendingCueExecute(FGameplayCuePendingExecute& PendingCue) override;
+	//~End of UGameplayCueManager interface
+
+	// 收集体验（以及它的 ActionSet 和要开启的 GameFeature）里配置的 Cue 目录，并异步预加载
+	void PreloadGameplayCuesForExperience(const UEqZeroExperienceDefinition* Experience);
+
+	// 异步预加载这些目录下所有还没加载的 Cue，没有要加载的 Cue 时返回空
+	TSharedPtr<FStreamableHandle> PreloadGameplayCuesInPaths(const TArray<FString>& Paths);
+
+	// 体验卸载时释放预加载的 Cue，还在加载中的完成后也不再保留
+	void ReleasePreloadedGameplayCues();
+
+private:
+	void OnGameplayCuePreloadComplete(TArray<FSoftObjectPath> PreloadedAssets, double StartTime, uint32 RequestGeneration);
+
+	// 两次执行的目标、Cue 和全部参数（包括 EffectContext）都一致才算重复
+	static bool IsSameCueExecute(const FGameplayCuePendingExecute& A, const FGameplayCuePendingExecute& B);
+	static uint32 GetCueExecuteHash(const FGameplayCuePendingExecute& PendingCue);
+
+	void HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void CloseFrameSendContext(UWorld* World);
+
+private:
+	// 预加载的 Cue 类，保持引用防止被 GC
+	UPROPERTY(Transient)
+	TSet<TObjectPtr<UClass>> PreloadedCueClasses;
+
+	// 正在预加载的 Cue，避免重复请求
+	TSet<FSoftObjectPath> CuesBeingPreloaded;
+
+	// 每次释放预加载的 Cue 时递增，之前发出的加载请求完成后不再保留
+	uint32 PreloadGeneration = 0;
+
+	// 这次发送中已经保留的 Cue 执行，按哈希分桶，哈希相同时再做完整比较
+	// 指针指向父类 FlushPendingCues 里的本地数组，只在一次发送内有效
+	TMultiMap<uint32, const FGameplayCuePendingExecute*> SentCueExecutes;
+
+	// 打开了整帧 SendContext 的世界
+	TSet<FObjectKey> WorldsWithFrameSendContext;
+};
@@ -4,9 +4,83 @@
 #include "EqZeroGlobalAbilitySystem.h"
 
 #include "AbilitySystem/EqZeroAbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayEffectComponents/AdditionalEffectsGameplayEffectComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroGlobalAbilitySystem)
 
+namespace EqZeroGlobalAbilitySystem
+{
+	static int32 MaxApplicationsPerFrame = 16;
+	static FAutoConsoleVariableRef CVarMaxApplicationsPerFrame(
+		TEXT("EqZero.GlobalAbilitySystem.MaxApplicationsPerFrame"),
+		MaxApplicationsPerFrame,
+		TEXT("Maximum number of global ability grants / effect applications per frame. <= 0 applies everything synchronously."),
+		ECVF_Default);
+
+	static float FrameBudgetMs = 1.0f;
+	static FAutoConsoleVariableRef CVarFrameBudgetMs(
+		TEXT("EqZero.GlobalAbilitySystem.FrameBudgetMs"),
+		FrameBudgetMs,
+		TEXT("Time budget in milliseconds for global ability / effect applications per frame. <= 0 disables the time limit."),
+		ECVF_Default);
+
+	// 默认关闭：属性集的 PostGameplayEffectExecute 可能读 Spec 上下文里的 Instigator（比如 HealthSet 的伤害消息），从效果本身看不出来
+	static bool bShareEffectSpecs = false;
+	static FAutoConsoleVariableRef CVarShareEffectSpecs(
+		TEXT("EqZero.GlobalAbilitySystem.ShareEffectSpecs"),
+		bShareEffectSpecs,
+		TEXT("Build one effect spec per global effect and apply it to every target, for effects that don't depend on the instigator context. ")
+		TEXT("Only enable it when no attribute set reads the effect context in PostGameplayEffectExecute."),
+		ECVF_Default);
+
+	/**
+	 * 共用的 Spec 没有 Instigator、Causer 和 Source ASC，只有完全不看这些的效果才能共用
+	 * 执行计算、GameplayCue、附加效果都可能读上下文，修饰符不能捕获 Source 属性或者要求 Source 标签
+	 * 数值只能是固定值或者基于 Target 属性：自定义计算类可能读上下文，SetByCaller 每次应用由调用方设置，共用的 Spec 上没有
+	 */
+	static bool CanShareEffectSpec(const UGameplayEffect* GameplayEffectCDO)
+	{
+		if ((GameplayEffectCDO->Executions.Num() > 0) || (GameplayEffectCDO->GameplayCues.Num() > 0) || GameplayEffectCDO->FindComponent<UAdditionalEffectsGameplayEffectComponent>())
+		{
+			return false;
+		}
+
+		auto DependsOnContext = [](const FGameplayEffectModifierMagnitude& Magnitude)
+		{
+			const EGameplayEffectMagnitudeCalculation CalculationType = Magnitude.GetMagnitudeCalculationType();
+			if ((CalculationType == EGameplayEffectMagnitudeCalculation::CustomCalculationClass) || (CalculationType == EGameplayEffectMagnitudeCalculation::SetByCaller))
+			{
+				return true;
+			}
+
+			TArray<FGameplayEffectAttributeCaptureDefinition> CaptureDefinitions;
+			Magnitude.GetAttributeCaptureDefinitions(CaptureDefinitions);
+			return CaptureDefinitions.ContainsByPredicate([](const FGameplayEffectAttributeCaptureDefinition& Definition)
+				{
+					return Definition.AttributeSource == EGameplayEffectAttributeCaptureSource::Source;
+				});
+		};
+
+		if (DependsOnContext(GameplayEffectCDO->DurationMagnitude))
+		{
+			return false;
+		}
+
+		for (const FGameplayModifierInfo& Modifier : GameplayEffectCDO->Modifiers)
+		{
+			if (!Modifier.SourceTags.IsEmpty() || DependsOnContext(Modifier.ModifierMagnitude))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
 void FGlobalAppliedAbilityList::AddToASC(TSubclassOf<UGameplayAbility> Ability, UEqZeroAbilitySystemComponent* ASC)
 {
 	if (FGameplayAbilitySpecHandle* SpecHandle = Handles.Find(ASC))
@@ -51,7 +125,22 @@ void FGlobalAppliedEffectList::AddToASC(TSubclassOf<UGameplayEffect> Effect, UEq
 	}
 
 	const UGameplayEffect* GameplayEffectCDO = Effect->GetDefaultObject<UGameplayEffect>();
-	const FActiveGameplayEffectHandle GameplayEffectHandle = ASC->ApplyGameplayEffectToSelf(GameplayEffectCDO, /*Level=*/ 1, ASC->MakeEffectContext());
+
+	if (!bCheckedSharedSpec)
+	{
+		bCheckedSharedSpec = true;
+
+		if (EqZeroGlobalAbilitySystem::bShareEffectSpecs && EqZeroGlobalAbilitySystem::CanShareEffectSpec(GameplayEffectCDO))
+		{
+			SharedSpec = FGameplayEffectSpec(GameplayEffectCDO, FGameplayEffectContextHandle(UAbilitySystemGlobals::Get().AllocGameplayEffectContext()), /*Level=*/ 1);
+			bHasSharedSpec = true;
+		}
+	}
+
+	// 默认和原来一样每个目标用自己的上下文，Source 捕获和伤害执行都要用到
+	const FActiveGameplayEffectHandle GameplayEffectHandle = bHasSharedSpec
+		? ASC->ApplyGameplayEffectSpecToSelf(SharedSpec)
+		: ASC->ApplyGameplayEffectToSelf(GameplayEffectCDO, /*Level=*/ 1, ASC->MakeEffectContext());
 	Handles.Add(ASC, GameplayEffectHandle);
 }
 
@@ -80,15 +169,36 @@ UEqZeroGlobalAbilitySystem::UEqZeroGlobalAbilitySystem()
 {
 }
 
+void UEqZeroGlobalAbilitySystem::Deinitialize()
+{
+	if (PendingApplicationsTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingApplicationsTickHandle);
+		PendingApplicationsTickHandle.Reset();
+	}
+
+	PendingCatchUps.Reset();
+	PendingApplications.Reset();
+
+	Super::Deinitialize();
+}
+
 void UEqZeroGlobalAbilitySystem::ApplyAbilityToAll(TSubclassOf<UGameplayAbility> Ability)
 {
 	if ((Ability.Get() != nullptr) && (!AppliedAbilities.Contains(Ability)))
 	{
-		FGlobalAppliedAbilityList& Entry = AppliedAbilities.Add(Ability);
+		AppliedAbilities.Add(Ability);
+
+		// 只排队，具体授予在 ProcessPendingApplications 里分帧做
+		PendingApplications.Reserve(PendingApplications.Num() + RegisteredASCs.Num());
 		for (UEqZeroAbilitySystemComponent* ASC : RegisteredASCs)
 		{
-			Entry.AddToASC(Ability, ASC);
+			FPendingApplication& Pending = PendingApplications.AddDefaulted_GetRef();
+			Pending.ASC = ASC;
+			Pending.Ability = Ability;
 		}
+
+		SchedulePendingApplications();
 	}
 }
 
@@ -96,11 +206,17 @@ void UEqZeroGlobalAbilitySystem::ApplyEffectToAll(TSubclassOf<UGameplayEffect> E
 {
 	if ((Effect.Get() != nullptr) && (!AppliedEffects.Contains(Effect)))
 	{
-		FGlobalAppliedEffectList& Entry = AppliedEffects.Add(Effect);
+		AppliedEffects.Add(Effect);
+
+		PendingApplications.Reserve(PendingApplications.Num() + RegisteredASCs.Num());
 		for (UEqZeroAbilitySystemComponent* ASC : RegisteredASCs)
 		{
-			Entry.AddToASC(Effect, ASC);
+			FPendingApplication& Pending = PendingApplications.AddDefaulted_GetRef();
+			Pending.ASC = ASC;
+			Pending.Effect = Effect;
 		}
+
+		SchedulePendingApplications();
 	}
 }
 
@@ -108,6 +224,9 @@ void UEqZeroGlobalAbilitySystem::RemoveAbilityFromAll(TSubclassOf<UGameplayAbili
 {
 	if ((Ability.Get() != nullptr) && AppliedAbilities.Contains(Ability))
 	{
+		// 移除是立即生效的，还没轮到的目标直接丢掉
+		PendingApplications.RemoveAll([Ability](const FPendingApplication& Pending) { return Pending.Ability == Ability; });
+
 		FGlobalAppliedAbilityList& Entry = AppliedAbilities[Ability];
 		Entry.RemoveFromAll();
 		AppliedAbilities.Remove(Ability);
@@ -118,6 +237,8 @@ void UEqZeroGlobalAbilitySystem::RemoveEffectFromAll(TSubclassOf<UGameplayEffect
 {
 	if ((Effect.Get() != nullptr) && AppliedEffects.Contains(Effect))
 	{
+		PendingApplications.RemoveAll([Effect](const FPendingApplication& Pending) { return Pending.Effect == Effect; });
+
 		FGlobalAppliedEffectList& Entry = AppliedEffects[Effect];
 		Entry.RemoveFromAll();
 		AppliedEffects.Remove(Effect);
@@ -128,29 +249,167 @@ void UEqZeroGlobalAbilitySystem::RegisterASC(UEqZeroAbilitySystemComponent* ASC)
 {
 	check(ASC);
 
+	// 换 Avatar 时会重复注册，和之前一样重新应用一遍，但合并成一次补齐
+	PendingCatchUps.AddUnique(ASC);
+	RegisteredASCs.AddUnique(ASC);
+
+	SchedulePendingApplications();
+}
+
+void UEqZeroGlobalAbilitySystem::UnregisterASC(UEqZeroAbilitySystemComponent* ASC)
+{
+	check(ASC);
+
+	PendingCatchUps.Remove(ASC);
+	PendingApplications.RemoveAll([ASC](const FPendingApplication& Pending) { return Pending.ASC == ASC; });
+
 	for (auto& Entry : AppliedAbilities)
 	{
-		Entry.Value.AddToASC(Entry.Key, ASC);
+		Entry.Value.RemoveFromASC(ASC);
 	}
 	for (auto& Entry : AppliedEffects)
 	{
-		Entry.Value.AddToASC(Entry.Key, ASC);
+		Entry.Value.RemoveFromASC(ASC);
 	}
 
-	RegisteredASCs.AddUnique(ASC);
+	RegisteredASCs.Remove(ASC);
 }
 
-void UEqZeroGlobalAbilitySystem::UnregisterASC(UEqZeroAbilitySystemComponent* ASC)
+void UEqZeroGlobalAbilitySystem::FlushPendingApplications()
 {
-	check(ASC);
+	ProcessPendingApplications(/*MaxApplications=*/ 0, /*MaxSeconds=*/ 0.0);
+}
+
+int32 UEqZeroGlobalAbilitySystem::CatchUpASC(UEqZeroAbilitySystemComponent* ASC)
+{
+	int32 NumApplied = 0;
+
 	for (auto& Entry : AppliedAbilities)
 	{
-		Entry.Value.RemoveFromASC(ASC);
+		Entry.Value.AddToASC(Entry.Key, ASC);
+		++NumApplied;
 	}
 	for (auto& Entry : AppliedEffects)
 	{
-		Entry.Value.RemoveFromASC(ASC);
+		Entry.Value.AddToASC(Entry.Key, ASC);
+		++NumApplied;
 	}
 
-	RegisteredASCs.Remove(ASC);
+	return NumApplied;
+}
+
+void UEqZeroGlobalAbilitySystem::ProcessPendingApplications(int32 MaxApplications, double MaxSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumApplied = 0;
+
+	auto IsOverBudget = [&]()
+	{
+		return ((MaxApplications > 0) && (NumApplied >= MaxApplications))
+			|| ((MaxSeconds > 0.0) && ((FPlatformTime::Seconds() - StartTime) >= MaxSeconds));
+	};
+
+	// 应用时的回调可能注册、注销 ASC 或者往队列里加东西，先把队列换出来再处理，没处理完的放回队首
+	// 回调里注销的 ASC 不在 RegisteredASCs 里了，直接跳过
+
+	// 补齐优先，新出生的角色要尽快拿到全局效果
+	TArray<TWeakObjectPtr<UEqZeroAbilitySystemComponent>> CatchUps = MoveTemp(PendingCatchUps);
+	PendingCatchUps.Reset();
+
+	int32 NumCatchUpsProcessed = 0;
+	while ((NumCatchUpsProcessed < CatchUps.Num()) && !IsOverBudget())
+	{
+		UEqZeroAbilitySystemComponent* ASC = CatchUps[NumCatchUpsProcessed].Get();
+		++NumCatchUpsProcessed;
+
+		if (ASC && RegisteredASCs.Contains(ASC))
+		{
+			NumApplied += CatchUpASC(ASC);
+		}
+	}
+
+	if (NumCatchUpsProcessed < CatchUps.Num())
+	{
+		CatchUps.RemoveAt(0, NumCatchUpsProcessed, EAllowShrinking::No);
+		for (const TWeakObjectPtr<UEqZeroAbilitySystemComponent>& AddedCatchUp : PendingCatchUps)
+		{
+			CatchUps.AddUnique(AddedCatchUp);
+		}
+		PendingCatchUps = MoveTemp(CatchUps);
+	}
+
+	TArray<FPendingApplication> Applications = MoveTemp(PendingApplications);
+	PendingApplications.Reset();
+
+	int32 NumPendingProcessed = 0;
+	while ((NumPendingProcessed < Applications.Num()) && !IsOverBudget())
+	{
+		const FPendingApplication& Pending = Applications[NumPendingProcessed];
+		++NumPendingProcessed;
+
+		UEqZeroAbilitySystemComponent* ASC = Pending.ASC.Get();
+		if ((ASC == nullptr) || !RegisteredASCs.Contains(ASC))
+		{
+			continue;
+		}
+
+		// 已经通过补齐拿到的就跳过，避免效果被重新应用一次
+		// 回调里移除了的全局技能和效果在 Applied* 里找不到，也会跳过
+		if (Pending.Ability != nullptr)
+		{
+			if (FGlobalAppliedAbilityList* Entry = AppliedAbilities.Find(Pending.Ability))
+			{
+				if (!Entry->Handles.Contains(ASC))
+				{
+					Entry->AddToASC(Pending.Ability, ASC);
+					++NumApplied;
+				}
+			}
+		}
+		else if (Pending.Effect != nullptr)
+		{
+			if (FGlobalAppliedEffectList* Entry = AppliedEffects.Find(Pending.Effect))
+			{
+				if (!Entry->Handles.Contains(ASC))
+				{
+					Entry->AddToASC(Pending.Effect, ASC);
+					++NumApplied;
+				}
+			}
+		}
+	}
+
+	if (NumPendingProcessed < Applications.Num())
+	{
+		Applications.RemoveAt(0, NumPendingProcessed, EAllowShrinking::No);
+		Applications.Append(MoveTemp(PendingApplications));
+		PendingApplications = MoveTemp(Applications);
+	}
+}
+
+void UEqZeroGlobalAbilitySystem::SchedulePendingApplications()
+{
+	if (EqZeroGlobalAbilitySystem::MaxApplicationsPerFrame <= 0)
+	{
+		FlushPendingApplications();
+		return;
+	}
+
+	if (!PendingApplicationsTickHandle.IsValid())
+	{
+		PendingApplicationsTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::HandlePendingApplicationsTick), 0.0f);
+	}
+}
+
+bool UEqZeroGlobalAbilitySystem::HandlePendingApplicationsTick(float DeltaTime)
+{
+	ProcessPendingApplications(EqZeroGlobalAbilitySystem::MaxApplicationsPerFrame, EqZeroGlobalAbilitySystem::FrameBudgetMs / 1000.0);
+
+	if (GetNumPendingApplications() > 0)
+	{
+		return true;
+	}
+
+	PendingApplicationsTickHandle.Reset();
+	return false;
 }
@@ -6,6 +6,8 @@
 #pragma once
 
 #include "ActiveGameplayEffectHandle.h"
+#include "Containers/Ticker.h"
+#include "GameplayEffect.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "GameplayAbilitySpecHandle.h"
 #include "Templates/SubclassOf.h"
@@ -41,22 +43,46 @@ struct FGlobalAppliedEffectList
 	UPROPERTY()
 	TMap<TObjectPtr<UEqZeroAbilitySystemComponent>, FActiveGameplayEffectHandle> Handles;
 
+	// 效果不依赖施加者上下文时所有目标共用一份 Spec，第一次应用时构建
+	FGameplayEffectSpec SharedSpec;
+	bool bHasSharedSpec = false;
+	bool bCheckedSharedSpec = false;
+
 	void AddToASC(TSubclassOf<UGameplayEffect> Effect, UEqZeroAbilitySystemComponent* ASC);
 	void RemoveFromASC(UEqZeroAbilitySystemComponent* ASC);
 	void RemoveFromAll();
 };
 
+/**
+ * 全局技能/效果系统
+ * 应用到所有 ASC 是分帧做的，每帧有数量和时间预算，避免人多的时候开一个全局效果就卡一下
+ * 新注册的 ASC 排一次补齐，优先于普通的分帧任务处理
+ */
 UCLASS()
-class UEqZeroGlobalAbilitySystem : public UWorldSubsystem
+class EQZEROGAME_API UEqZeroGlobalAbilitySystem : public UWorldSubsystem
 {
 	GENERATED_BODY()
 
+	friend struct FEqZeroGlobalAbilitySystemTestAccess;
+
 public:
 	UEqZeroGlobalAbilitySystem();
 
+	//~UWorldSubsystem interface
+	virtual void Deinitialize() override;
+	//~End of UWorldSubsystem interface
+
+	/**
+	 * 授予所有已注册的 ASC，只是排队，在之后几帧里按预算授予
+	 * 调用之后马上需要结果（比如紧接着激活技能）的话先调用 FlushPendingApplications
+	 */
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="EqZero")
 	void ApplyAbilityToAll(TSubclassOf<UGameplayAbility> Ability);
 
+	/**
+	 * 应用到所有已注册的 ASC，只是排队，在之后几帧里按预算应用
+	 * 调用之后马上需要结果（比如读属性或者检查标签）的话先调用 FlushPendingApplications
+	 */
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="EqZero")
 	void ApplyEffectToAll(TSubclassOf<UGameplayEffect> Effect);
 
@@ -72,6 +98,31 @@ public:
 	/** Removes an ASC from the global system, along with any active global effects/abilities. */
 	void UnregisterASC(UEqZeroAbilitySystemComponent* ASC);
 
+	/** 立即处理完所有排队中的应用，不受每帧预算限制 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "EqZero")
+	void FlushPendingApplications();
+
+	int32 GetNumPendingApplications() const { return PendingCatchUps.Num() + PendingApplications.Num(); }
+
+private:
+	struct FPendingApplication
+	{
+		TWeakObjectPtr<UEqZeroAbilitySystemComponent> ASC;
+
+		// 两者只有一个有值
+		TSubclassOf<UGameplayAbility> Ability;
+		TSubclassOf<UGameplayEffect> Effect;
+	};
+
+	/** 在预算内处理排队的应用，预算 <= 0 表示不限 */
+	void ProcessPendingApplications(int32 MaxApplications, double MaxSeconds);
+
+	/** 把当前所有生效的全局技能和效果补到这个 ASC 上 */
+	int32 CatchUpASC(UEqZeroAbilitySystemComponent* ASC);
+
+	void SchedulePendingApplications();
+	bool HandlePendingApplicationsTick(float DeltaTime);
+
 private:
 	UPROPERTY()
 	TMap<TSubclassOf<UGameplayAbility>, FGlobalAppliedAbilityList> AppliedAbilities;
@@ -81,4 +132,12 @@ private:
 
 	UPROPERTY()
 	TArray<TObjectPtr<UEqZeroAbilitySystemComponent>> RegisteredASCs;
+
+	// 新注册等待补齐的 ASC
+	TArray<TWeakObjectPtr<UEqZeroAbilitySystemComponent>> PendingCatchUps;
+
+	// ApplyAbilityToAll / ApplyEffectToAll 排队的单个目标
+	TArray<FPendingApplication> PendingApplications;
+
+	FTSTicker::FDelegateHandle PendingApplicationsTickHandle;
 };
@@ -33,8 +33,14 @@ public:
 #endif
 	//~End of UObject interface
 
+	bool AllowsCharacterPartPooling() const { return bAllowCharacterPartPooling; }
+
 protected:
     // 描述角色特征的 tag
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Actor)
 	FGameplayTagContainer StaticGameplayTags;
+
+	// 作为装扮部件时从 Actor 池取，移除时回收复用；复用的部件不会再走 BeginPlay，也没有 ParentActor，依赖这些的部件不要打开
+	UPROPERTY(EditDefaultsOnly, Category=Actor)
+	bool bAllowCharacterPartPooling = false;
 };
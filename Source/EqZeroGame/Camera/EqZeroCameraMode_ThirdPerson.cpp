@@ -265,115 +265,115 @@ void UEqZeroCameraMode_ThirdPerson::PreventCameraPenetration(
 	FCollisionShape SphereShape = FCollisionShape::MakeSphere(0.f);
 	UWorld* World = GetWorld();
 
-    // 进行这么多次射线检测
-	for (int32 RayIdx = 0; RayIdx < NumRaysToShoot; ++RayIdx)
+	// 异步模式：射线在本帧提交，下一帧取回结果。刚切换模式时没有上一帧的结果，本帧走同步路径。
+	const bool bUseAsyncTraces = bUseAsyncPenetrationTraces && !bResetInterpolation;
+	if (!bUseAsyncTraces)
 	{
-		FEqZeroPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
-		if (Feeler.FramesUntilNextTrace <= 0) // 到了检测的帧数，不同的射线有不同的检测频率配置
-		{
-			// 计算射线终点
-			FVector RayTarget;
-			{
-				// BaseRay 是 安全点 -> 摄像机
-				// 绕射线的上，旋转Yaw度，左右偏转。
-				// 绕射线的 右，旋转Pitch度，上下偏转。
-				FVector RotatedRay = BaseRay.RotateAngleAxis(Feeler.AdjustmentRot.Yaw, BaseRayLocalUp);
-				RotatedRay = RotatedRay.RotateAngleAxis(Feeler.AdjustmentRot.Pitch, BaseRayLocalRight);
-				RayTarget = SafeLoc + RotatedRay;
-			}
+		ResetPendingPenetrationTraces();
+	}
+	PendingFeelerTraces.SetNum(PenetrationAvoidanceFeelers.Num());
 
-			// cast for world and pawn hits separately.  this is so we can safely ignore the 
-			// camera's target pawn
-			SphereShape.Sphere.Radius = Feeler.Extent;
-			ECollisionChannel TraceChannel = ECC_Camera;		//(Feeler.PawnWeight > 0.f) ? ECC_Pawn : ECC_Camera;
+	// 计算射线终点
+	// BaseRay 是 安全点 -> 摄像机
+	// 绕射线的上，旋转Yaw度，左右偏转。
+	// 绕射线的 右，旋转Pitch度，上下偏转。
+	auto ComputeRayTarget = [&](const FEqZeroPenetrationAvoidanceFeeler& Feeler)
+	{
+		FVector RotatedRay = BaseRay.RotateAngleAxis(Feeler.AdjustmentRot.Yaw, BaseRayLocalUp);
+		RotatedRay = RotatedRay.RotateAngleAxis(Feeler.AdjustmentRot.Pitch, BaseRayLocalRight);
+		return SafeLoc + RotatedRay;
+	};
 
-			// do multi-line check to make sure the hits we throw out aren't
-			// masking real hits behind (these are important rays).
+	// cast for world and pawn hits separately.  this is so we can safely ignore the 
+	// camera's target pawn
+	ECollisionChannel const TraceChannel = ECC_Camera;		//(Feeler.PawnWeight > 0.f) ? ECC_Pawn : ECC_Camera;
 
-			// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
+	// 同步检测一条射线并立即处理结果
+	auto TraceFeelerNow = [&](FEqZeroPenetrationAvoidanceFeeler& Feeler)
+	{
+		const FVector RayTarget = ComputeRayTarget(Feeler);
+		SphereShape.Sphere.Radius = Feeler.Extent;
 
-            // 球形扫描
-			// 从 SafeLoc → RayTarget 一个球滑过去做碰撞，半径0的时候是细线检测
-			FHitResult Hit;
-			const bool bHit = World->SweepSingleByChannel(Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+		// do multi-line check to make sure the hits we throw out aren't
+		// masking real hits behind (these are important rays).
 
-            // DEBUG指令，DEBUG SHOWCAMERA
-#if ENABLE_DRAW_DEBUG
-			if (World->TimeSince(LastDrawDebugTime) < 1.f)
-			{
-				const float DebugLifeTime = 2.f;
-				DrawDebugSphere(World, SafeLoc, SphereShape.Sphere.Radius, 8, FColor::Red, false, DebugLifeTime);
-				DrawDebugSphere(World, bHit ? Hit.Location : RayTarget, SphereShape.Sphere.Radius, 8, FColor::Blue, false, DebugLifeTime);
-				// UE_LOG(LogTemp, Error, TEXT("Camera Penetration Sweep: RayIdx %d, Hit %s, HitActor %s"), RayIdx, bHit ? TEXT("True") : TEXT("False"), bHit ? *Hit.GetActor()->GetName() : TEXT("None"));
-				DrawDebugLine(World, SafeLoc, bHit ? Hit.Location : RayTarget, FColor::Yellow, false, DebugLifeTime);
-			}
-#endif // ENABLE_DRAW_DEBUG
+		// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
 
-			Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
+		// 球形扫描
+		// 从 SafeLoc → RayTarget 一个球滑过去做碰撞，半径0的时候是细线检测
+		FHitResult Hit;
+		const bool bHit = World->SweepSingleByChannel(Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
 
-			const AActor* HitActor = Hit.GetActor();
+		Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
+		ApplyPenetrationFeelerHit(ViewTarget, Feeler, bHit ? &Hit : nullptr, SafeLoc, RayTarget, SphereParams, DistBlockedPctThisFrame);
+	};
 
-			// 射线检测到了
-			if (bHit && HitActor)
-			{
-				bool bIgnoreHit = false;
+	auto UpdateBlockedPct = [&](int32 RayIdx)
+	{
+		if (RayIdx == 0) // 规定，0号射线是主射线，权重最高的那条
+		{
+			// 不要向这个方向插值，直接吸附到它上面
+			HardBlockedPct = DistBlockedPctThisFrame;
+		}
+		else
+		{
+			SoftBlockedPct = DistBlockedPctThisFrame;
+		}
+	};
 
-				if (HitActor->ActorHasTag(EqZeroCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
-				{
-					bIgnoreHit = true;
-					SphereParams.AddIgnoredActor(HitActor);
-				}
+	// 先取回上一帧提交的异步结果，被忽略的 Actor 会加进 SphereParams，本帧提交的新射线也会忽略它们
+	if (bUseAsyncTraces)
+	{
+		for (int32 RayIdx = 0; RayIdx < NumRaysToShoot; ++RayIdx)
+		{
+			FTraceHandle& PendingTrace = PendingFeelerTraces[RayIdx];
+			if (!PendingTrace.IsValid())
+			{
+				continue;
+			}
 
-				// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
-				if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
+			FEqZeroPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
+			FTraceDatum TraceData;
+			if (World->QueryTraceData(PendingTrace, TraceData))
+			{
+				const FHitResult* Hit = nullptr;
+				for (const FHitResult& TraceHit : TraceData.OutHits)
 				{
-					const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
-					const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
-					const FVector HitOffset = Hit.Location - ViewTargetLocation;
-					const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
-					const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
-					if (DotHitDirection > 0.0f)
+					if (TraceHit.bBlockingHit)
 					{
-						bIgnoreHit = true;
-						// Ignore this CameraBlockingVolume on the remaining sweeps.
-						SphereParams.AddIgnoredActor(HitActor);
+						Hit = &TraceHit;
+						break;
 					}
-					else
-					{
-#if ENABLE_DRAW_DEBUG
-						DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
-					}
-				}
-
-				// 确定射线打中一个有效的东西了
-				if (!bIgnoreHit)
-				{
-					float const Weight = Cast<APawn>(Hit.GetActor()) ? Feeler.PawnWeight : Feeler.WorldWeight;
-					float NewBlockPct = Hit.Time;
-					NewBlockPct += (1.f - NewBlockPct) * (1.f - Weight);
-
-					// 重新计算受阻百分比，将推出距离纳入考量。
-					NewBlockPct = ((Hit.Location - SafeLoc).Size() - CollisionPushOutDistance) / (RayTarget - SafeLoc).Size();
-					DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
-
-					// 这个射线有了反应，所以下一帧再进行一次追踪
-					Feeler.FramesUntilNextTrace = 0;
-
-#if ENABLE_DRAW_DEBUG
-					DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
 				}
+				ApplyPenetrationFeelerHit(ViewTarget, Feeler, Hit, TraceData.Start, TraceData.End, SphereParams, DistBlockedPctThisFrame);
 			}
+			else
+			{
+				// 结果已经过期（比如中间有帧没更新这个模式），退回同步检测
+				TraceFeelerNow(Feeler);
+			}
+
+			PendingTrace.Invalidate();
+			UpdateBlockedPct(RayIdx);
+		}
+	}
 
-			if (RayIdx == 0) // 规定，0号射线是主射线，权重最高的那条
+    // 进行这么多次射线检测
+	for (int32 RayIdx = 0; RayIdx < NumRaysToShoot; ++RayIdx)
+	{
+		FEqZeroPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
+		if (Feeler.FramesUntilNextTrace <= 0) // 到了检测的帧数，不同的射线有不同的检测频率配置
+		{
+			if (bUseAsyncTraces)
 			{
-				// 不要向这个方向插值，直接吸附到它上面
-				HardBlockedPct = DistBlockedPctThisFrame;
+				SphereShape.Sphere.Radius = Feeler.Extent;
+				PendingFeelerTraces[RayIdx] = World->AsyncSweepByChannel(EAsyncTraceType::Single, SafeLoc, ComputeRayTarget(Feeler), FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+				Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
 			}
 			else
 			{
-				SoftBlockedPct = DistBlockedPctThisFrame;
+				TraceFeelerNow(Feeler);
+				UpdateBlockedPct(RayIdx);
 			}
 		}
 		else
@@ -432,6 +432,85 @@ void UEqZeroCameraMode_ThirdPerson::PreventCameraPenetration(
 	}
 }
 
+void UEqZeroCameraMode_ThirdPerson::ApplyPenetrationFeelerHit(
+	class AActor const& ViewTarget, FEqZeroPenetrationAvoidanceFeeler& Feeler, const FHitResult* Hit, FVector const& RayStart, FVector const& RayTarget, FCollisionQueryParams& SphereParams, float& DistBlockedPctThisFrame)
+{
+    // DEBUG指令，DEBUG SHOWCAMERA
+#if ENABLE_DRAW_DEBUG
+	UWorld* World = GetWorld();
+	if (World->TimeSince(LastDrawDebugTime) < 1.f)
+	{
+		const float DebugLifeTime = 2.f;
+		DrawDebugSphere(World, RayStart, Feeler.Extent, 8, FColor::Red, false, DebugLifeTime);
+		DrawDebugSphere(World, Hit ? Hit->Location : RayTarget, Feeler.Extent, 8, FColor::Blue, false, DebugLifeTime);
+		DrawDebugLine(World, RayStart, Hit ? Hit->Location : RayTarget, FColor::Yellow, false, DebugLifeTime);
+	}
+#endif // ENABLE_DRAW_DEBUG
+
+	const AActor* HitActor = Hit ? Hit->GetActor() : nullptr;
+
+	// 射线检测到了
+	if (HitActor)
+	{
+		bool bIgnoreHit = false;
+
+		if (HitActor->ActorHasTag(EqZeroCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
+		{
+			bIgnoreHit = true;
+			SphereParams.AddIgnoredActor(HitActor);
+		}
+
+		// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
+		if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
+		{
+			const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
+			const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
+			const FVector HitOffset = Hit->Location - ViewTargetLocation;
+			const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
+			const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
+			if (DotHitDirection > 0.0f)
+			{
+				bIgnoreHit = true;
+				// Ignore this CameraBlockingVolume on the remaining sweeps.
+				SphereParams.AddIgnoredActor(HitActor);
+			}
+			else
+			{
+#if ENABLE_DRAW_DEBUG
+				DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+#endif
+			}
+		}
+
+		// 确定射线打中一个有效的东西了
+		if (!bIgnoreHit)
+		{
+			float const Weight = Cast<APawn>(HitActor) ? Feeler.PawnWeight : Feeler.WorldWeight;
+			float NewBlockPct = Hit->Time;
+			NewBlockPct += (1.f - NewBlockPct) * (1.f - Weight);
+
+			// 重新计算受阻百分比，将推出距离纳入考量。
+			NewBlockPct = ((Hit->Location - RayStart).Size() - CollisionPushOutDistance) / (RayTarget - RayStart).Size();
+			DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
+
+			// 这个射线有了反应，所以下一帧再进行一次追踪
+			Feeler.FramesUntilNextTrace = 0;
+
+#if ENABLE_DRAW_DEBUG
+			DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+#endif
+		}
+	}
+}
+
+void UEqZeroCameraMode_ThirdPerson::ResetPendingPenetrationTraces()
+{
+	for (FTraceHandle& PendingTrace : PendingFeelerTraces)
+	{
+		PendingTrace.Invalidate();
+	}
+}
+
 void UEqZeroCameraMode_ThirdPerson::SetTargetCrouchOffset(FVector NewTargetOffset)
 {
 	CrouchOffsetBlendPct = 0.0f;
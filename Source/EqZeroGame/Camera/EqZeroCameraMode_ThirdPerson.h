@@ -6,8 +6,11 @@
 #include "Curves/CurveFloat.h"
 #include "EqZeroPenetrationAvoidanceFeeler.h"
 #include "DrawDebugHelpers.h"
+#include "WorldCollision.h"
 #include "EqZeroCameraMode_ThirdPerson.generated.h"
 
+#define UE_API EQZEROGAME_API
+
 class UCurveVector;
 
 /**
@@ -15,24 +18,30 @@ class UCurveVector;
  *
  *	A basic third person camera mode.
  */
-UCLASS(Abstract, Blueprintable)
+UCLASS(MinimalAPI, Abstract, Blueprintable)
 class UEqZeroCameraMode_ThirdPerson : public UEqZeroCameraMode
 {
 	GENERATED_BODY()
 
 public:
 
-	UEqZeroCameraMode_ThirdPerson();
+	UE_API UEqZeroCameraMode_ThirdPerson();
 
 protected:
 
-	virtual void UpdateView(float DeltaTime) override;
+	UE_API virtual void UpdateView(float DeltaTime) override;
 
 	void UpdateForTarget(float DeltaTime);
 	void UpdatePreventPenetration(float DeltaTime);
-	void PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc, FVector& CameraLoc, float const& DeltaTime, float& DistBlockedPct, bool bSingleRayOnly);
+	UE_API void PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc, FVector& CameraLoc, float const& DeltaTime, float& DistBlockedPct, bool bSingleRayOnly);
+
+	// 处理单条射线的检测结果，同步和异步两条路径共用，保证混合结果一致
+	void ApplyPenetrationFeelerHit(class AActor const& ViewTarget, FEqZeroPenetrationAvoidanceFeeler& Feeler, const FHitResult* Hit, FVector const& RayStart, FVector const& RayTarget, FCollisionQueryParams& SphereParams, float& DistBlockedPctThisFrame);
+
+	// 丢弃所有还没取回结果的异步射线
+	void ResetPendingPenetrationTraces();
 
-	virtual void DrawDebug(UCanvas* Canvas) const override;
+	UE_API virtual void DrawDebug(UCanvas* Canvas) const override;
 
 protected:
 
@@ -94,12 +103,22 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Collision")
 	TArray<FEqZeroPenetrationAvoidanceFeeler> PenetrationAvoidanceFeelers;
 
+	/**
+	 * 如果为 true，射线检测批量提交为异步 Sweep，结果在下一帧取回，减少游戏线程的碰撞开销（分屏时尤其明显）。
+	 * 刚切换模式或结果丢失时，会退回到同步检测。
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
+	bool bUseAsyncPenetrationTraces = false;
+
 	UPROPERTY(Transient)
 	float AimLineToDesiredPosBlockedPct;
 
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<const AActor>> DebugActorsHitDuringCameraPenetration;
 
+	// 每条射线上一帧提交的异步检测，下标和 PenetrationAvoidanceFeelers 对应
+	TArray<FTraceHandle> PendingFeelerTraces;
+
 #if ENABLE_DRAW_DEBUG
 	mutable float LastDrawDebugTime = -MAX_FLT;
 #endif
@@ -115,3 +134,5 @@ protected:
 	FVector CurrentCrouchOffset = FVector::ZeroVector;
 	
 };
+
+#undef UE_API
@@ -13,6 +13,8 @@
 #include "Player/EqZeroPlayerController.h"
 #include "Player/EqZeroPlayerState.h"
 #include "TimerManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "UObject/CoreNet.h"
 
 #include "Camera/EqZeroCameraComponent.h"
 #include "Character/EqZeroHealthComponent.h"
@@ -31,6 +33,118 @@ class UInputComponent;
 static FName NAME_EqZeroCharacterCollisionProfile_Capsule(TEXT("EqZeroPawnCapsule"));
 static FName NAME_EqZeroCharacterCollisionProfile_Mesh(TEXT("EqZeroPawnMesh"));
 
+CSV_DEFINE_CATEGORY(EqZeroNet, true);
+
+namespace EqZeroCharacter
+{
+	static bool bSharedRepBandwidthStats = false;
+	static FAutoConsoleVariableRef CVarSharedRepBandwidthStats(
+		TEXT("EqZero.Character.SharedRepBandwidthStats"),
+		bSharedRepBandwidthStats,
+		TEXT("Measure the bits sent per character per second through FastSharedReplication."),
+		ECVF_Default);
+
+	// 差量超过这个范围就发关键帧
+	static constexpr int32 MaxSharedRepDelta = 1 << 20;
+
+	static double GetVectorQuantizationScale(EVectorQuantization Level)
+	{
+		switch (Level)
+		{
+		case EVectorQuantization::RoundOneDecimal:
+			return 10.0;
+		case EVectorQuantization::RoundTwoDecimals:
+			return 100.0;
+		case EVectorQuantization::RoundWholeNumber:
+		default:
+			return 1.0;
+		}
+	}
+
+	static FIntVector QuantizeVector(const FVector& Value, double Scale)
+	{
+		return FIntVector(
+			FMath::RoundToInt32(Value.X * Scale),
+			FMath::RoundToInt32(Value.Y * Scale),
+			FMath::RoundToInt32(Value.Z * Scale));
+	}
+
+	static FIntVector CompressRotation(const FRotator& Rotation, ERotatorQuantization Level)
+	{
+		if (Level == ERotatorQuantization::ShortComponents)
+		{
+			return FIntVector(FRotator::CompressAxisToShort(Rotation.Pitch), FRotator::CompressAxisToShort(Rotation.Yaw), FRotator::CompressAxisToShort(Rotation.Roll));
+		}
+		return FIntVector(FRotator::CompressAxisToByte(Rotation.Pitch), FRotator::CompressAxisToByte(Rotation.Yaw), FRotator::CompressAxisToByte(Rotation.Roll));
+	}
+
+	static FRotator DecompressRotation(const FIntVector& Compressed, ERotatorQuantization Level)
+	{
+		if (Level == ERotatorQuantization::ShortComponents)
+		{
+			return FRotator(
+				FRotator::DecompressAxisFromShort(static_cast<uint16>(Compressed.X)),
+				FRotator::DecompressAxisFromShort(static_cast<uint16>(Compressed.Y)),
+				FRotator::DecompressAxisFromShort(static_cast<uint16>(Compressed.Z)));
+		}
+		return FRotator(
+			FRotator::DecompressAxisFromByte(static_cast<uint8>(Compressed.X)),
+			FRotator::DecompressAxisFromByte(static_cast<uint8>(Compressed.Y)),
+			FRotator::DecompressAxisFromByte(static_cast<uint8>(Compressed.Z)));
+	}
+
+	static int32 WrapRotationDelta(int32 Delta, ERotatorQuantization Level)
+	{
+		return (Level == ERotatorQuantization::ShortComponents) ? static_cast<int16>(Delta) : static_cast<int8>(Delta);
+	}
+
+	static bool IsDeltaInRange(const FIntVector& Delta)
+	{
+		return FMath::Abs(Delta.X) < MaxSharedRepDelta && FMath::Abs(Delta.Y) < MaxSharedRepDelta && FMath::Abs(Delta.Z) < MaxSharedRepDelta;
+	}
+
+	/**
+	 * 差量用 ZigZag 编码，先写 3 比特标记哪些分量不为 0，有非 0 分量时再写 5 比特的位宽，然后按位宽只写非 0 的分量
+	 * 地面移动时 Z 和匀速时的速度差量都是 0，只占标记位
+	 */
+	static void SerializeDeltaVector(FArchive& Ar, FIntVector& Delta)
+	{
+		uint32 ZigZag[3] = { 0, 0, 0 };
+		uint32 NonZeroMask = 0;
+		uint32 NumBits = 0;
+		if (Ar.IsSaving())
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				ZigZag[Axis] = (static_cast<uint32>(Delta[Axis]) << 1) ^ static_cast<uint32>(Delta[Axis] >> 31);
+				NonZeroMask |= (ZigZag[Axis] != 0) ? (1u << Axis) : 0u;
+				NumBits = FMath::Max(NumBits, 32 - FMath::CountLeadingZeros(ZigZag[Axis]));
+			}
+		}
+
+		Ar.SerializeBits(&NonZeroMask, 3);
+		if (NonZeroMask != 0)
+		{
+			Ar.SerializeBits(&NumBits, 5);
+		}
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if ((NonZeroMask & (1u << Axis)) != 0)
+			{
+				Ar.SerializeBits(&ZigZag[Axis], NumBits);
+			}
+		}
+
+		if (Ar.IsLoading())
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Delta[Axis] = static_cast<int32>((ZigZag[Axis] >> 1) ^ (0u - (ZigZag[Axis] & 1u)));
+			}
+		}
+	}
+}
+
 AEqZeroCharacter::AEqZeroCharacter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UEqZeroCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
@@ -486,18 +600,41 @@ bool AEqZeroCharacter::UpdateSharedReplication()
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		FSharedRepMovement SharedMovement;
+		SharedMovement.RepMovement.LocationQuantizationLevel = SharedRepLocationQuantization;
+		SharedMovement.RepMovement.RotationQuantizationLevel = SharedRepRotationQuantization;
+		SharedMovement.RepMovement.VelocityQuantizationLevel = SharedRepVelocityQuantization;
+
 		if (SharedMovement.FillForCharacter(this))
 		{
+			// 先量化，变化比较的是客户端实际能看到的值
+			SharedMovement.Quantize();
+
+			const double CurrentTime = GetWorld()->GetTimeSeconds();
+			const bool bKeyframeDue = !bHasSharedRepKeyframe || (CurrentTime >= NextSharedRepKeyframeTime);
+
 			// Only call FastSharedReplication if data has changed since the last frame.
 			// Skipping this call will cause replication to reuse the same bunch that we previously
 			// produced, but not send it to clients that already received. (But a new client who has not received
 			// it, will get it this frame)
-			if (!SharedMovement.Equals(LastSharedReplication, this))
+			// 停着不动的时候，如果上次发的是差量，到时间了也要补发一个关键帧，新加入的客户端才能解出来
+			const bool bChanged = !SharedMovement.Equals(LastSharedReplication, this);
+			if (bChanged || (bKeyframeDue && !LastSharedReplication.bIsKeyframe))
 			{
+				if (bKeyframeDue || !SharedMovement.EncodeDelta(SharedRepKeyframe))
+				{
+					SharedMovement.bIsKeyframe = true;
+					SharedMovement.KeyframeId = bHasSharedRepKeyframe ? static_cast<uint8>(SharedRepKeyframe.KeyframeId + 1) : 0;
+
+					SharedRepKeyframe = SharedMovement;
+					bHasSharedRepKeyframe = true;
+					NextSharedRepKeyframeTime = CurrentTime + SharedRepKeyframeInterval;
+				}
+
 				LastSharedReplication = SharedMovement;
 				SetReplicatedMovementMode(SharedMovement.RepMovementMode);
 
 				FastSharedReplication(SharedMovement);
+				RecordSharedReplicationBandwidth(SharedMovement);
 			}
 			return true;
 		}
@@ -507,6 +644,33 @@ bool AEqZeroCharacter::UpdateSharedReplication()
 	return false;
 }
 
+void AEqZeroCharacter::RecordSharedReplicationBandwidth(const FSharedRepMovement& SharedMovement)
+{
+	if (!EqZeroCharacter::bSharedRepBandwidthStats)
+	{
+		return;
+	}
+
+	// 单独序列化一次统计比特数，只在开启统计时才做
+	FNetBitWriter BitWriter(nullptr, 1024);
+	FSharedRepMovement MovementCopy = SharedMovement;
+	bool bSuccess = true;
+	MovementCopy.NetSerialize(BitWriter, nullptr, bSuccess);
+	SharedRepBitsThisWindow += BitWriter.GetNumBits();
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const double WindowDuration = CurrentTime - SharedRepStatWindowStartTime;
+	if (WindowDuration >= 1.0)
+	{
+		SharedRepBitsPerSecond = static_cast<float>(SharedRepBitsThisWindow / WindowDuration);
+		SharedRepBitsThisWindow = 0;
+		SharedRepStatWindowStartTime = CurrentTime;
+
+		CSV_CUSTOM_STAT(EqZeroNet, SharedRepBitsPerCharacterPerSecond, SharedRepBitsPerSecond, ECsvCustomStatOp::Max);
+		UE_LOG(LogEqZero, Verbose, TEXT("%s: FastSharedReplication %.0f bits/s"), *GetName(), SharedRepBitsPerSecond);
+	}
+}
+
 void AEqZeroCharacter::FastSharedReplication_Implementation(const FSharedRepMovement& SharedRepMovement)
 {
 	if (GetWorld()->IsPlayingReplay())
@@ -517,31 +681,43 @@ void AEqZeroCharacter::FastSharedReplication_Implementation(const FSharedRepMove
 	// Timestamp is checked to reject old moves.
 	if (GetLocalRole() == ROLE_SimulatedProxy)
 	{
+		// 差量需要对应的关键帧才能还原，没收到关键帧的话丢弃，等下一个关键帧
+		FSharedRepMovement ResolvedMovement = SharedRepMovement;
+		if (ResolvedMovement.bIsKeyframe)
+		{
+			LastReceivedSharedKeyframe = ResolvedMovement;
+			bHasReceivedSharedKeyframe = true;
+		}
+		else if (!bHasReceivedSharedKeyframe || !ResolvedMovement.ResolveDelta(LastReceivedSharedKeyframe))
+		{
+			return;
+		}
+
 		// Timestamp
-		SetReplicatedServerLastTransformUpdateTimeStamp(SharedRepMovement.RepTimeStamp);
+		SetReplicatedServerLastTransformUpdateTimeStamp(ResolvedMovement.RepTimeStamp);
 
 		// Movement mode
-		if (GetReplicatedMovementMode() != SharedRepMovement.RepMovementMode)
+		if (GetReplicatedMovementMode() != ResolvedMovement.RepMovementMode)
 		{
-			SetReplicatedMovementMode(SharedRepMovement.RepMovementMode);
+			SetReplicatedMovementMode(ResolvedMovement.RepMovementMode);
 			GetCharacterMovement()->bNetworkMovementModeChanged = true;
 			GetCharacterMovement()->bNetworkUpdateReceived = true;
 		}
 
 		// Location, Rotation, Velocity, etc.
 		FRepMovement& MutableRepMovement = GetReplicatedMovement_Mutable();
-		MutableRepMovement = SharedRepMovement.RepMovement;
+		MutableRepMovement = ResolvedMovement.RepMovement;
 
 		// This also sets LastRepMovement
 		OnRep_ReplicatedMovement();
 
 		// Jump force
-		SetProxyIsJumpForceApplied(SharedRepMovement.bProxyIsJumpForceApplied);
+		SetProxyIsJumpForceApplied(ResolvedMovement.bProxyIsJumpForceApplied);
 
 		// Crouch
-		if (IsCrouched() != SharedRepMovement.bIsCrouched)
+		if (IsCrouched() != ResolvedMovement.bIsCrouched)
 		{
-			SetIsCrouched(SharedRepMovement.bIsCrouched);
+			SetIsCrouched(ResolvedMovement.bIsCrouched);
 			OnRep_IsCrouched();
 		}
 	}
@@ -615,10 +791,121 @@ bool FSharedRepMovement::Equals(const FSharedRepMovement& Other, ACharacter* Cha
 	return true;
 }
 
+void FSharedRepMovement::Quantize()
+{
+	using namespace EqZeroCharacter;
+
+	const double LocationScale = GetVectorQuantizationScale(RepMovement.LocationQuantizationLevel);
+	RepMovement.Location = FVector(QuantizeVector(RepMovement.Location, LocationScale)) / LocationScale;
+
+	const double VelocityScale = GetVectorQuantizationScale(RepMovement.VelocityQuantizationLevel);
+	RepMovement.LinearVelocity = FVector(QuantizeVector(RepMovement.LinearVelocity, VelocityScale)) / VelocityScale;
+
+	const FIntVector CompressedRotation = CompressRotation(RepMovement.Rotation, RepMovement.RotationQuantizationLevel);
+	RepMovement.Rotation = DecompressRotation(CompressedRotation, RepMovement.RotationQuantizationLevel);
+}
+
+bool FSharedRepMovement::EncodeDelta(const FSharedRepMovement& Keyframe)
+{
+	using namespace EqZeroCharacter;
+
+	const FRepMovement& KeyMovement = Keyframe.RepMovement;
+	if ((RepMovement.LocationQuantizationLevel != KeyMovement.LocationQuantizationLevel) ||
+		(RepMovement.RotationQuantizationLevel != KeyMovement.RotationQuantizationLevel) ||
+		(RepMovement.VelocityQuantizationLevel != KeyMovement.VelocityQuantizationLevel))
+	{
+		return false;
+	}
+
+	const double LocationScale = GetVectorQuantizationScale(RepMovement.LocationQuantizationLevel);
+	LocationDelta = QuantizeVector(RepMovement.Location, LocationScale) - QuantizeVector(KeyMovement.Location, LocationScale);
+
+	const double VelocityScale = GetVectorQuantizationScale(RepMovement.VelocityQuantizationLevel);
+	VelocityDelta = QuantizeVector(RepMovement.LinearVelocity, VelocityScale) - QuantizeVector(KeyMovement.LinearVelocity, VelocityScale);
+
+	// 旋转的差量在压缩后的整数上取，跨越 0/360 时按环绕处理
+	const FIntVector CompressedRotation = CompressRotation(RepMovement.Rotation, RepMovement.RotationQuantizationLevel);
+	const FIntVector CompressedKeyRotation = CompressRotation(KeyMovement.Rotation, RepMovement.RotationQuantizationLevel);
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		RotationDelta[Axis] = WrapRotationDelta(CompressedRotation[Axis] - CompressedKeyRotation[Axis], RepMovement.RotationQuantizationLevel);
+	}
+
+	if (!IsDeltaInRange(LocationDelta) || !IsDeltaInRange(VelocityDelta))
+	{
+		return false;
+	}
+
+	bIsKeyframe = false;
+	KeyframeId = Keyframe.KeyframeId;
+
+	// 客户端还原出来的就是量化后的值，这里保持一致
+	Quantize();
+	return true;
+}
+
+bool FSharedRepMovement::ResolveDelta(const FSharedRepMovement& Keyframe)
+{
+	using namespace EqZeroCharacter;
+
+	if (bIsKeyframe || (KeyframeId != Keyframe.KeyframeId))
+	{
+		return false;
+	}
+
+	const FRepMovement& KeyMovement = Keyframe.RepMovement;
+	RepMovement.LocationQuantizationLevel = KeyMovement.LocationQuantizationLevel;
+	RepMovement.RotationQuantizationLevel = KeyMovement.RotationQuantizationLevel;
+	RepMovement.VelocityQuantizationLevel = KeyMovement.VelocityQuantizationLevel;
+
+	const double LocationScale = GetVectorQuantizationScale(RepMovement.LocationQuantizationLevel);
+	RepMovement.Location = FVector(QuantizeVector(KeyMovement.Location, LocationScale) + LocationDelta) / LocationScale;
+
+	const double VelocityScale = GetVectorQuantizationScale(RepMovement.VelocityQuantizationLevel);
+	RepMovement.LinearVelocity = FVector(QuantizeVector(KeyMovement.LinearVelocity, VelocityScale) + VelocityDelta) / VelocityScale;
+
+	const FIntVector CompressedKeyRotation = CompressRotation(KeyMovement.Rotation, RepMovement.RotationQuantizationLevel);
+	RepMovement.Rotation = DecompressRotation(CompressedKeyRotation + RotationDelta, RepMovement.RotationQuantizationLevel);
+
+	return true;
+}
+
 bool FSharedRepMovement::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
 	bOutSuccess = true;
-	RepMovement.NetSerialize(Ar, Map, bOutSuccess);
+
+	uint8 bKeyframeBit = bIsKeyframe;
+	Ar.SerializeBits(&bKeyframeBit, 1);
+	bIsKeyframe = (bKeyframeBit != 0);
+	Ar << KeyframeId;
+
+	if (bIsKeyframe)
+	{
+		// 量化精度只跟着关键帧发送，差量沿用关键帧的精度
+		uint8 QuantizationLevels = 0;
+		if (Ar.IsSaving())
+		{
+			QuantizationLevels = static_cast<uint8>(RepMovement.LocationQuantizationLevel)
+				| (static_cast<uint8>(RepMovement.RotationQuantizationLevel) << 2)
+				| (static_cast<uint8>(RepMovement.VelocityQuantizationLevel) << 3);
+		}
+		Ar.SerializeBits(&QuantizationLevels, 5);
+		if (Ar.IsLoading())
+		{
+			RepMovement.LocationQuantizationLevel = static_cast<EVectorQuantization>(QuantizationLevels & 0x3);
+			RepMovement.RotationQuantizationLevel = static_cast<ERotatorQuantization>((QuantizationLevels >> 2) & 0x1);
+			RepMovement.VelocityQuantizationLevel = static_cast<EVectorQuantization>((QuantizationLevels >> 3) & 0x3);
+		}
+
+		RepMovement.NetSerialize(Ar, Map, bOutSuccess);
+	}
+	else
+	{
+		EqZeroCharacter::SerializeDeltaVector(Ar, LocationDelta);
+		EqZeroCharacter::SerializeDeltaVector(Ar, RotationDelta);
+		EqZeroCharacter::SerializeDeltaVector(Ar, VelocityDelta);
+	}
+
 	Ar << RepMovementMode;
 	Ar << bProxyIsJumpForceApplied;
 	Ar << bIsCrouched;
@@ -49,18 +49,32 @@ struct FEqZeroReplicatedAcceleration
 	int8 AccelZ = 0;	// Raw Z accel rate component, quantized to represent [-MaxAcceleration, MaxAcceleration]
 };
 
-/** 用于优化网络传输的一个移动数据结构 */
+/**
+ * 用于优化网络传输的一个移动数据结构
+ * 定期发送完整的关键帧，其余时候只发送相对于最近一个关键帧的量化差量。
+ * 这是一个共享序列化的不可靠多播，拿不到每个连接的确认，所以差量的基准是最近的关键帧而不是确认过的状态：
+ * 丢了差量不影响后续差量，丢了关键帧的客户端会丢弃差量直到收到下一个关键帧。
+ */
 USTRUCT()
 struct FSharedRepMovement
 {
 	GENERATED_BODY()
 
-	FSharedRepMovement();
+	UE_API FSharedRepMovement();
+
+	UE_API bool FillForCharacter(ACharacter* Character);
+	UE_API bool Equals(const FSharedRepMovement& Other, ACharacter* Character) const;
+
+	UE_API bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	/** 把位置/旋转/速度对齐到量化精度上，服务器保存的关键帧和客户端解出来的一致 */
+	UE_API void Quantize();
 
-	bool FillForCharacter(ACharacter* Character);
-	bool Equals(const FSharedRepMovement& Other, ACharacter* Character) const;
+	/** 服务器：编码为相对 Keyframe 的差量，差量太大或量化精度不一致时返回 false，需要发关键帧 */
+	UE_API bool EncodeDelta(const FSharedRepMovement& Keyframe);
 
-	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	/** 客户端：用收到的 Keyframe 还原差量，关键帧对不上时返回 false */
+	UE_API bool ResolveDelta(const FSharedRepMovement& Keyframe);
 
 	UPROPERTY(Transient)
 	FRepMovement RepMovement;
@@ -76,6 +90,19 @@ struct FSharedRepMovement
 
 	UPROPERTY(Transient)
 	bool bIsCrouched = false;
+
+	/** 是否是完整的关键帧 */
+	UPROPERTY(Transient)
+	bool bIsKeyframe = true;
+
+	/** 关键帧序号，差量用它找到自己的基准 */
+	UPROPERTY(Transient)
+	uint8 KeyframeId = 0;
+
+	/** 差量，单位是量化精度（位置/速度是 1/Scale 厘米，旋转是压缩后的 Byte/Short） */
+	FIntVector LocationDelta = FIntVector::ZeroValue;
+	FIntVector RotationDelta = FIntVector::ZeroValue;
+	FIntVector VelocityDelta = FIntVector::ZeroValue;
 };
 
 template<>
@@ -156,6 +183,40 @@ public:
 
 	UE_API virtual bool UpdateSharedReplication();
 
+	/** 最近一秒 FastSharedReplication 发送的比特数，需要开启 EqZero.Character.SharedRepBandwidthStats */
+	float GetSharedRepBitsPerSecond() const { return SharedRepBitsPerSecond; }
+
+	/** FastSharedReplication 的量化精度 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "EqZero|Replication")
+	EVectorQuantization SharedRepLocationQuantization = EVectorQuantization::RoundTwoDecimals;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "EqZero|Replication")
+	ERotatorQuantization SharedRepRotationQuantization = ERotatorQuantization::ByteComponents;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "EqZero|Replication")
+	EVectorQuantization SharedRepVelocityQuantization = EVectorQuantization::RoundWholeNumber;
+
+	/** 多久强制发送一次完整的关键帧（秒），0 表示每次都发关键帧 */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "EqZero|Replication", meta = (ClampMin = 0.0))
+	float SharedRepKeyframeInterval = 1.0f;
+
+private:
+	void RecordSharedReplicationBandwidth(const FSharedRepMovement& SharedMovement);
+
+	// Server: 最近一次发送的关键帧，差量都相对于它
+	FSharedRepMovement SharedRepKeyframe;
+	double NextSharedRepKeyframeTime = 0.0;
+	bool bHasSharedRepKeyframe = false;
+
+	// Client: 最近一次收到的关键帧
+	FSharedRepMovement LastReceivedSharedKeyframe;
+	bool bHasReceivedSharedKeyframe = false;
+
+	// Bandwidth stat
+	int64 SharedRepBitsThisWindow = 0;
+	double SharedRepStatWindowStartTime = 0.0;
+	float SharedRepBitsPerSecond = 0.0f;
+
 protected:
 
 	UE_API virtual void OnAbilitySystemInitialized();
@@ -4,31 +4,189 @@
 
 #include "Animation/AnimInstance.h"
 #include "Engine/SkeletalMesh.h"
+#include "HAL/IConsoleManager.h"
+
+#if WITH_EDITOR
+#include "UObject/UObjectGlobals.h"
+#endif
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroCosmeticAnimationTypes)
 
-TSubclassOf<UAnimInstance> FEqZeroAnimLayerSelectionSet::SelectBestLayer(const FGameplayTagContainer& CosmeticTags) const
+namespace EqZeroCosmeticSelection
 {
-	for (const FEqZeroAnimLayerSelectionEntry& Rule : LayerRules)
+	static bool bCacheSelection = true;
+	static FAutoConsoleVariableRef CVarCacheSelection(
+		TEXT("EqZero.Cosmetics.CacheSelection"),
+		bCacheSelection,
+		TEXT("Memoize anim layer / body style selection results per cosmetic tag container."),
+		ECVF_Default);
+
+	// 一个规则集里不同的 tag 组合通常只有几种，超过这个数量就清空重来
+	static constexpr int32 MaxCachedResults = 64;
+
+	static int32 GlobalGeneration = 0;
+
+	static uint32 HashCosmeticTags(const FGameplayTagContainer& CosmeticTags)
 	{
-		if ((Rule.Layer != nullptr) && CosmeticTags.HasAll(Rule.RequiredTags))
+		// HasAll 与标签顺序无关，哈希也要与顺序无关
+		uint32 Hash = 0;
+		for (const FGameplayTag& Tag : CosmeticTags)
 		{
-			return Rule.Layer;
+			Hash += MurmurFinalize32(GetTypeHash(Tag));
 		}
+		return HashCombineFast(Hash, static_cast<uint32>(CosmeticTags.Num()));
 	}
 
-	return DefaultLayer;
-}
+#if WITH_EDITOR
+	static void RegisterEditorInvalidation()
+	{
+		static bool bRegistered = false;
+		if (!bRegistered)
+		{
+			bRegistered = true;
 
-USkeletalMesh* FEqZeroAnimBodyStyleSelectionSet::SelectBestBodyStyle(const FGameplayTagContainer& CosmeticTags) const
-{
-	for (const FEqZeroAnimBodyStyleSelectionEntry& Rule : MeshRules)
+			// 规则配在武器、角色组件等各种对象上，改了任何属性或者重编蓝图都让缓存失效
+			FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject*, FPropertyChangedEvent&)
+				{
+					FEqZeroCosmeticSelectionCache::BumpGlobalGeneration();
+				});
+			FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>&)
+				{
+					FEqZeroCosmeticSelectionCache::BumpGlobalGeneration();
+				});
+		}
+	}
+#endif
+
+	template <typename RuleType, typename IsRuleUsableFunc>
+	static int32 FindBestRuleUncached(const TArray<RuleType>& Rules, const FGameplayTagContainer& CosmeticTags, IsRuleUsableFunc IsRuleUsable)
+	{
+		for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+		{
+			const RuleType& Rule = Rules[RuleIndex];
+			if (IsRuleUsable(Rule) && CosmeticTags.HasAll(Rule.RequiredTags))
+			{
+				return RuleIndex;
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	template <typename RuleType, typename IsRuleUsableFunc>
+	static int32 FindBestRuleCached(FEqZeroCosmeticSelectionCache& Cache, const TArray<RuleType>& Rules, const FGameplayTagContainer& CosmeticTags, IsRuleUsableFunc IsRuleUsable)
 	{
-		if ((Rule.Mesh != nullptr) && CosmeticTags.HasAll(Rule.RequiredTags))
+		// 缓存不加锁，只在游戏线程上使用
+		if (!bCacheSelection || !IsInGameThread())
+		{
+			return FindBestRuleUncached(Rules, CosmeticTags, IsRuleUsable);
+		}
+
+#if WITH_EDITOR
+		RegisterEditorInvalidation();
+#endif
+
+		if (Cache.IsStale(Rules.GetData(), Rules.Num()))
+		{
+			Cache.Reset();
+			Cache.Generation = FEqZeroCosmeticSelectionCache::GetGlobalGeneration();
+			Cache.NumRules = Rules.Num();
+			Cache.RulesData = Rules.GetData();
+
+			for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+			{
+				if (IsRuleUsable(Rules[RuleIndex]))
+				{
+					Cache.CandidateRuleIndices.Add(RuleIndex);
+				}
+			}
+		}
+
+		const uint32 Hash = HashCosmeticTags(CosmeticTags);
+		if (const FEqZeroCosmeticSelectionCache::FResult* CachedResult = Cache.Results.Find(Hash))
+		{
+			if (CachedResult->CosmeticTags == CosmeticTags)
+			{
+				return CachedResult->RuleIndex;
+			}
+		}
+
+		int32 BestRuleIndex = INDEX_NONE;
+		for (int32 RuleIndex : Cache.CandidateRuleIndices)
+		{
+			if (CosmeticTags.HasAll(Rules[RuleIndex].RequiredTags))
+			{
+				BestRuleIndex = RuleIndex;
+				break;
+			}
+		}
+
+		if (Cache.Results.Num() >= MaxCachedResults)
 		{
-			return Rule.Mesh;
+			Cache.Results.Reset();
 		}
+
+		// 哈希冲突时直接覆盖，下次再冲突就重新算一遍
+		FEqZeroCosmeticSelectionCache::FResult& NewResult = Cache.Results.Add(Hash);
+		NewResult.CosmeticTags = CosmeticTags;
+		NewResult.RuleIndex = BestRuleIndex;
+
+		return BestRuleIndex;
 	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void FEqZeroCosmeticSelectionCache::Reset()
+{
+	CandidateRuleIndices.Reset();
+	Results.Reset();
+	Generation = INDEX_NONE;
+	NumRules = INDEX_NONE;
+	RulesData = nullptr;
+}
+
+bool FEqZeroCosmeticSelectionCache::IsStale(const void* InRulesData, int32 InNumRules) const
+{
+	return (Generation != GetGlobalGeneration()) || (NumRules != InNumRules) || (RulesData != InRulesData);
+}
+
+void FEqZeroCosmeticSelectionCache::BumpGlobalGeneration()
+{
+	++EqZeroCosmeticSelection::GlobalGeneration;
+}
+
+int32 FEqZeroCosmeticSelectionCache::GetGlobalGeneration()
+{
+	return EqZeroCosmeticSelection::GlobalGeneration;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TSubclassOf<UAnimInstance> FEqZeroAnimLayerSelectionSet::SelectBestLayer(const FGameplayTagContainer& CosmeticTags) const
+{
+	const int32 RuleIndex = FindBestLayerRule(CosmeticTags);
+	return LayerRules.IsValidIndex(RuleIndex) ? LayerRules[RuleIndex].Layer : DefaultLayer;
+}
+
+int32 FEqZeroAnimLayerSelectionSet::FindBestLayerRule(const FGameplayTagContainer& CosmeticTags) const
+{
+	return EqZeroCosmeticSelection::FindBestRuleCached(SelectionCache, LayerRules, CosmeticTags, [](const FEqZeroAnimLayerSelectionEntry& Rule)
+		{
+			return Rule.Layer != nullptr;
+		});
+}
+
+USkeletalMesh* FEqZeroAnimBodyStyleSelectionSet::SelectBestBodyStyle(const FGameplayTagContainer& CosmeticTags) const
+{
+	const int32 RuleIndex = FindBestBodyStyleRule(CosmeticTags);
+	return MeshRules.IsValidIndex(RuleIndex) ? MeshRules[RuleIndex].Mesh.Get() : DefaultMesh.Get();
+}
 
-	return DefaultMesh;
+int32 FEqZeroAnimBodyStyleSelectionSet::FindBestBodyStyleRule(const FGameplayTagContainer& CosmeticTags) const
+{
+	return EqZeroCosmeticSelection::FindBestRuleCached(SelectionCache, MeshRules, CosmeticTags, [](const FEqZeroAnimBodyStyleSelectionEntry& Rule)
+		{
+			return Rule.Mesh != nullptr;
+		});
 }
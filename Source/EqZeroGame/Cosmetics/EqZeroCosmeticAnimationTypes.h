@@ -13,6 +13,42 @@ class USkeletalMesh;
 
 //////////////////////////////////////////////////////////////////////
 
+/**
+ * 选择规则的结果缓存，不参与反射和序列化
+ * 按 Cosmetic tags 的哈希记下命中的规则下标，规则数组或者全局版本号变了就整个重建
+ * 运行时改了规则内容（数量和数组都没变）需要手动调 InvalidateSelectionCache
+ */
+struct EQZEROGAME_API FEqZeroCosmeticSelectionCache
+{
+	struct FResult
+	{
+		FGameplayTagContainer CosmeticTags;
+
+		// 命中的规则下标，INDEX_NONE 表示使用默认值
+		int32 RuleIndex = INDEX_NONE;
+	};
+
+	// 预处理后的规则：结果为空的规则不可能被选中，直接剔除
+	TArray<int32> CandidateRuleIndices;
+
+	TMap<uint32, FResult> Results;
+
+	int32 Generation = INDEX_NONE;
+	int32 NumRules = INDEX_NONE;
+	const void* RulesData = nullptr;
+
+	void Reset();
+
+	/** 规则数组或者全局版本号变了就返回 true，调用方需要重新预处理 */
+	bool IsStale(const void* InRulesData, int32 InNumRules) const;
+
+	/** 编辑器里改了规则所在的资产时调用，让所有缓存失效 */
+	static void BumpGlobalGeneration();
+	static int32 GetGlobalGeneration();
+};
+
+//////////////////////////////////////////////////////////////////////
+
 USTRUCT(BlueprintType)
 struct FEqZeroAnimLayerSelectionEntry
 {
@@ -45,7 +81,15 @@ struct FEqZeroAnimLayerSelectionSet
 	TSubclassOf<UAnimInstance> DefaultLayer;
 
 	// 根据规则选择最合适的动画层
-	TSubclassOf<UAnimInstance> SelectBestLayer(const FGameplayTagContainer& CosmeticTags) const;
+	EQZEROGAME_API TSubclassOf<UAnimInstance> SelectBestLayer(const FGameplayTagContainer& CosmeticTags) const;
+
+	// 运行时修改了 LayerRules 的内容后调用
+	void InvalidateSelectionCache() { SelectionCache.Reset(); }
+
+private:
+	int32 FindBestLayerRule(const FGameplayTagContainer& CosmeticTags) const;
+
+	mutable FEqZeroCosmeticSelectionCache SelectionCache;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -80,5 +124,13 @@ struct FEqZeroAnimBodyStyleSelectionSet
 	UPROPERTY(EditAnywhere)
 	TObjectPtr<UPhysicsAsset> ForcedPhysicsAsset = nullptr;
 
-	USkeletalMesh* SelectBestBodyStyle(const FGameplayTagContainer& CosmeticTags) const;
+	EQZEROGAME_API USkeletalMesh* SelectBestBodyStyle(const FGameplayTagContainer& CosmeticTags) const;
+
+	// 运行时修改了 MeshRules 的内容后调用
+	void InvalidateSelectionCache() { SelectionCache.Reset(); }
+
+private:
+	int32 FindBestBodyStyleRule(const FGameplayTagContainer& CosmeticTags) const;
+
+	mutable FEqZeroCosmeticSelectionCache SelectionCache;
 };
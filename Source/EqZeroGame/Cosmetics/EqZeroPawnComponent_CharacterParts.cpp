@@ -2,11 +2,14 @@
 
 #include "Cosmetics/EqZeroPawnComponent_CharacterParts.h"
 
+#include "AbilitySystem/EqZeroTaggedActor.h"
+#include "Components/ChildActorComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Cosmetics/EqZeroCharacterPartTypes.h"
 #include "GameFramework/Character.h"
 #include "GameplayTagAssetInterface.h"
 #include "Net/UnrealNetwork.h"
+#include "System/EqZeroActorPoolSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroPawnComponent_CharacterParts)
 
@@ -19,57 +22,66 @@ class UWorld;
 
 FString FEqZeroAppliedCharacterPartEntry::GetDebugString() const
 {
-	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), *GetPathNameSafe(SpawnedComponent));
+	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), *GetPathNameSafe(GetPartActor()));
+}
+
+AActor* FEqZeroAppliedCharacterPartEntry::GetPartActor() const
+{
+	if (SpawnedComponent != nullptr)
+	{
+		return SpawnedComponent->GetChildActor();
+	}
+
+	return PooledActor;
 }
 
 //////////////////////////////////////////////////////////////////////
 
 void FEqZeroCharacterPartList::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
-	bool bDestroyedAnyActors = false;
 	for (int32 Index : RemovedIndices)
 	{
 		FEqZeroAppliedCharacterPartEntry& Entry = Entries[Index];
-		bDestroyedAnyActors |= DestroyActorForEntry(Entry);
-	}
-
-	if (bDestroyedAnyActors && ensure(OwnerComponent))
-	{
-		OwnerComponent->BroadcastChanged();
+		bPendingBroadcastChanged |= DestroyActorForEntry(Entry);
 	}
 }
 
 void FEqZeroCharacterPartList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
-	bool bCreatedAnyActors = false;
 	for (int32 Index : AddedIndices)
 	{
 		FEqZeroAppliedCharacterPartEntry& Entry = Entries[Index];
-		bCreatedAnyActors |= SpawnActorForEntry(Entry);
-	}
-
-	if (bCreatedAnyActors && ensure(OwnerComponent))
-	{
-		OwnerComponent->BroadcastChanged();
+		bPendingBroadcastChanged |= SpawnActorForEntry(Entry);
 	}
 }
 
 void FEqZeroCharacterPartList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
 {
-	bool bChangedAnyActors = false;
-
-	// We don't support dealing with propagating changes, just destroy and recreate
 	for (int32 Index : ChangedIndices)
 	{
 		FEqZeroAppliedCharacterPartEntry& Entry = Entries[Index];
 
-		bChangedAnyActors |= DestroyActorForEntry(Entry);
-		bChangedAnyActors |= SpawnActorForEntry(Entry);
+		// 池化的部件类没变就原地复用，否则销毁（回收）后重新生成
+		if (!RefreshActorForEntry(Entry))
+		{
+			DestroyActorForEntry(Entry);
+			SpawnActorForEntry(Entry);
+		}
+		bPendingBroadcastChanged = true;
 	}
+}
 
-	if (bChangedAnyActors && ensure(OwnerComponent))
+void FEqZeroCharacterPartList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	// 删、加、改可能在同一批里一起到，身体网格只需要重新选一次
+	if (bPendingBroadcastChanged)
 	{
-		OwnerComponent->BroadcastChanged();
+		bPendingBroadcastChanged = false;
+
+		if (ensure(OwnerComponent))
+		{
+			OwnerComponent->BroadcastChanged();
+		}
 	}
 }
 
@@ -143,18 +155,27 @@ FGameplayTagContainer FEqZeroCharacterPartList::CollectCombinedTags() const
 
 	for (const FEqZeroAppliedCharacterPartEntry& Entry : Entries)
 	{
-		if (Entry.SpawnedComponent != nullptr)
+		if (IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Entry.GetPartActor()))
 		{
-			if (IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Entry.SpawnedComponent->GetChildActor()))
-			{
-				TagInterface->GetOwnedGameplayTags(/*inout*/ Result);
-			}
+			TagInterface->GetOwnedGameplayTags(/*inout*/ Result);
 		}
 	}
 
 	return Result;
 }
 
+UEqZeroActorPoolSubsystem* FEqZeroCharacterPartList::GetActorPoolForPart(const FEqZeroCharacterPart& Part) const
+{
+	const AEqZeroTaggedActor* PartCDO = Part.PartClass ? Cast<AEqZeroTaggedActor>(Part.PartClass->GetDefaultObject()) : nullptr;
+	if ((PartCDO == nullptr) || !PartCDO->AllowsCharacterPartPooling())
+	{
+		return nullptr;
+	}
+
+	// 编辑器预览之类不支持池的世界返回空，退回 ChildActorComponent
+	return UEqZeroActorPoolSubsystem::Get(OwnerComponent);
+}
+
 bool FEqZeroCharacterPartList::SpawnActorForEntry(FEqZeroAppliedCharacterPartEntry& Entry)
 {
 	bool bCreatedAnyActors = false;
@@ -163,40 +184,51 @@ bool FEqZeroCharacterPartList::SpawnActorForEntry(FEqZeroAppliedCharacterPartEnt
 	{
 		if (Entry.Part.PartClass != nullptr)
 		{
-			UWorld* World = OwnerComponent->GetWorld();
-
 			// 找一个地方附加这个部件，通常是角色的 Mesh 组件
 			if (USceneComponent* ComponentToAttachTo = OwnerComponent->GetSceneComponentToAttachTo())
 			{
-				const FTransform SpawnTransform = ComponentToAttachTo->GetSocketTransform(Entry.Part.SocketName);
-				UChildActorComponent* PartComponent = NewObject<UChildActorComponent>(OwnerComponent->GetOwner());
-				PartComponent->SetupAttachment(ComponentToAttachTo, Entry.Part.SocketName);
-				PartComponent->SetChildActorClass(Entry.Part.PartClass);
-				PartComponent->RegisterComponent(); // 这里会触发生成 actor
-
-				if (AActor* SpawnedActor = PartComponent->GetChildActor())
+				if (UEqZeroActorPoolSubsystem* ActorPool = GetActorPoolForPart(Entry.Part))
 				{
-					switch (Entry.Part.CollisionMode)
+					// 从池里拿，没有的话池会生成一个新的
+					if (AActor* PartActor = ActorPool->AcquireActor(Entry.Part.PartClass, OwnerComponent->GetOwner(), OwnerComponent->GetPawn<APawn>()))
 					{
-					case ECharacterCustomizationCollisionMode::UseCollisionFromCharacterPart:
-						// Do nothing
-						break;
+						ApplyPartSettingsToActor(Entry, PartActor, ComponentToAttachTo);
 
-					case ECharacterCustomizationCollisionMode::NoCollision:
-						SpawnedActor->SetActorEnableCollision(false);
-						break;
+						Entry.PooledActor = PartActor;
+						bCreatedAnyActors = true;
 					}
+				}
+				else
+				{
+					UChildActorComponent* PartComponent = NewObject<UChildActorComponent>(OwnerComponent->GetOwner());
+					PartComponent->SetupAttachment(ComponentToAttachTo, Entry.Part.SocketName);
+					PartComponent->SetChildActorClass(Entry.Part.PartClass);
+					PartComponent->RegisterComponent(); // 这里会触发生成 actor
 
-					// Set up a direct tick dependency to work around the child actor component not providing one
-					// 解决动画抖动问题, 如果是饰品，必须保证饰品在身体之后更新（Tick），
-					if (USceneComponent* SpawnedRootComponent = SpawnedActor->GetRootComponent())
+					if (AActor* SpawnedActor = PartComponent->GetChildActor())
 					{
-						SpawnedRootComponent->AddTickPrerequisiteComponent(ComponentToAttachTo);
+						switch (Entry.Part.CollisionMode)
+						{
+						case ECharacterCustomizationCollisionMode::UseCollisionFromCharacterPart:
+							// Do nothing
+							break;
+
+						case ECharacterCustomizationCollisionMode::NoCollision:
+							SpawnedActor->SetActorEnableCollision(false);
+							break;
+						}
+
+						// Set up a direct tick dependency to work around the child actor component not providing one
+						// 解决动画抖动问题, 如果是饰品，必须保证饰品在身体之后更新（Tick），
+						if (USceneComponent* SpawnedRootComponent = SpawnedActor->GetRootComponent())
+						{
+							SpawnedRootComponent->AddTickPrerequisiteComponent(ComponentToAttachTo);
+						}
 					}
-				}
 
-				Entry.SpawnedComponent = PartComponent;
-				bCreatedAnyActors = true;
+					Entry.SpawnedComponent = PartComponent;
+					bCreatedAnyActors = true;
+				}
 			}
 		}
 	}
@@ -215,9 +247,86 @@ bool FEqZeroCharacterPartList::DestroyActorForEntry(FEqZeroAppliedCharacterPartE
 		bDestroyedAnyActors = true;
 	}
 
+	if (Entry.PooledActor != nullptr)
+	{
+		AActor* PartActor = Entry.PooledActor;
+		Entry.PooledActor = nullptr;
+		bDestroyedAnyActors = true;
+
+		if (IsValid(PartActor))
+		{
+			// 进池之前先拆掉对身体的 Tick 依赖，不然下次复用会挂到别的角色上
+			if (USceneComponent* PartRootComponent = PartActor->GetRootComponent())
+			{
+				if (USceneComponent* AttachParent = PartRootComponent->GetAttachParent())
+				{
+					PartRootComponent->RemoveTickPrerequisiteComponent(AttachParent);
+				}
+			}
+
+			if (UEqZeroActorPoolSubsystem* ActorPool = UEqZeroActorPoolSubsystem::Get(PartActor))
+			{
+				ActorPool->ReleaseActor(PartActor);
+			}
+			else
+			{
+				PartActor->Destroy();
+			}
+		}
+	}
+
 	return bDestroyedAnyActors;
 }
 
+bool FEqZeroCharacterPartList::RefreshActorForEntry(FEqZeroAppliedCharacterPartEntry& Entry)
+{
+	// ChildActorComponent 生成的部件照旧销毁重建
+	AActor* PartActor = Entry.PooledActor;
+	if (!IsValid(PartActor) || (Entry.Part.PartClass == nullptr) || (PartActor->GetClass() != Entry.Part.PartClass) || (GetActorPoolForPart(Entry.Part) == nullptr))
+	{
+		return false;
+	}
+
+	USceneComponent* ComponentToAttachTo = OwnerComponent ? OwnerComponent->GetSceneComponentToAttachTo() : nullptr;
+	if (ComponentToAttachTo == nullptr)
+	{
+		return false;
+	}
+
+	ApplyPartSettingsToActor(Entry, PartActor, ComponentToAttachTo);
+	return true;
+}
+
+void FEqZeroCharacterPartList::ApplyPartSettingsToActor(const FEqZeroAppliedCharacterPartEntry& Entry, AActor* PartActor, USceneComponent* ComponentToAttachTo) const
+{
+	USceneComponent* PartRootComponent = PartActor->GetRootComponent();
+	if (PartRootComponent && PartRootComponent->GetAttachParent() && (PartRootComponent->GetAttachParent() != ComponentToAttachTo))
+	{
+		PartRootComponent->RemoveTickPrerequisiteComponent(PartRootComponent->GetAttachParent());
+	}
+
+	PartActor->AttachToComponent(ComponentToAttachTo, FAttachmentTransformRules::SnapToTargetIncludingScale, Entry.Part.SocketName);
+
+	switch (Entry.Part.CollisionMode)
+	{
+	case ECharacterCustomizationCollisionMode::UseCollisionFromCharacterPart:
+		// 原地复用时模式可能从 NoCollision 切回来，按类默认值恢复
+		PartActor->SetActorEnableCollision(PartActor->GetClass()->GetDefaultObject<AActor>()->GetActorEnableCollision());
+		break;
+
+	case ECharacterCustomizationCollisionMode::NoCollision:
+		PartActor->SetActorEnableCollision(false);
+		break;
+	}
+
+	// Set up a direct tick dependency so the part ticks after the body it is attached to
+	// 解决动画抖动问题, 如果是饰品，必须保证饰品在身体之后更新（Tick），
+	if (PartRootComponent)
+	{
+		PartRootComponent->AddTickPrerequisiteComponent(ComponentToAttachTo);
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 
 UEqZeroPawnComponent_CharacterParts::UEqZeroPawnComponent_CharacterParts(const FObjectInitializer& ObjectInitializer)
@@ -277,12 +386,9 @@ TArray<AActor*> UEqZeroPawnComponent_CharacterParts::GetCharacterPartActors() co
 
 	for (const FEqZeroAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
 	{
-		if (UChildActorComponent* PartComponent = Entry.SpawnedComponent)
+		if (AActor* PartActor = Entry.GetPartActor())
 		{
-			if (AActor* SpawnedActor = PartComponent->GetChildActor())
-			{
-				Result.Add(SpawnedActor);
-			}
+			Result.Add(PartActor);
 		}
 	}
 
@@ -9,6 +9,7 @@
 
 #include "EqZeroPawnComponent_CharacterParts.generated.h"
 
+class UEqZeroActorPoolSubsystem;
 class UEqZeroPawnComponent_CharacterParts;
 namespace EEndPlayReason { enum Type : int; }
 struct FGameplayTag;
@@ -53,6 +54,12 @@ private:
 	// The spawned actor instance (client only)
 	UPROPERTY(NotReplicated)
 	TObjectPtr<UChildActorComponent> SpawnedComponent = nullptr;
+
+	// 允许回收的部件类不走 ChildActorComponent，直接从 UEqZeroActorPoolSubsystem 取 Actor (client only)
+	UPROPERTY(NotReplicated)
+	TObjectPtr<AActor> PooledActor = nullptr;
+
+	AActor* GetPartActor() const;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -74,6 +81,7 @@ public:
 	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
 	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
 	//~End of FFastArraySerializer contract
 
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
@@ -98,6 +106,14 @@ private:
 	bool SpawnActorForEntry(FEqZeroAppliedCharacterPartEntry& Entry);
 	bool DestroyActorForEntry(FEqZeroAppliedCharacterPartEntry& Entry);
 
+	// 同类的池化部件只是换了插槽之类的数据时，直接把已有的 Actor 挪过去
+	bool RefreshActorForEntry(FEqZeroAppliedCharacterPartEntry& Entry);
+
+	// 部件类在 AEqZeroTaggedActor 上打开了 bAllowCharacterPartPooling，并且这个世界有 Actor 池
+	UEqZeroActorPoolSubsystem* GetActorPoolForPart(const FEqZeroCharacterPart& Part) const;
+
+	void ApplyPartSettingsToActor(const FEqZeroAppliedCharacterPartEntry& Entry, AActor* PartActor, USceneComponent* ComponentToAttachTo) const;
+
 private:
 	UPROPERTY()
 	TArray<FEqZeroAppliedCharacterPartEntry> Entries;
@@ -106,6 +122,9 @@ private:
 	TObjectPtr<UEqZeroPawnComponent_CharacterParts> OwnerComponent;
 
 	int32 PartHandleCounter = 0;
+
+	// 一批复制回调里只在 PostReplicatedReceive 广播一次变化
+	bool bPendingBroadcastChanged = false;
 };
 
 template<>
@@ -118,7 +137,7 @@ struct TStructOpsTypeTraits<FEqZeroCharacterPartList> : public TStructOpsTypeTra
 
 // A component that handles spawning cosmetic actors attached to the owner pawn on all clients
 UCLASS(meta=(BlueprintSpawnableComponent))
-class UEqZeroPawnComponent_CharacterParts : public UPawnComponent
+class EQZEROGAME_API UEqZeroPawnComponent_CharacterParts : public UPawnComponent
 {
 	GENERATED_BODY()
 
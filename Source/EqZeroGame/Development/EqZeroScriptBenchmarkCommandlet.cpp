@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqZeroScriptBenchmarkCommandlet.h"
+
+#include "Containers/Ticker.h"
+#include "EqZeroLogChannels.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "JsEnv.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroScriptBenchmarkCommandlet)
+
+//////////////////////////////////////////////////////////////////////
+// UEqZeroScriptBenchmarkTarget
+
+int32 UEqZeroScriptBenchmarkTarget::MixinTarget_Implementation(int32 Value)
+{
+	return Value;
+}
+
+int32 UEqZeroScriptBenchmarkTarget::CallMixinTarget(int32 Count)
+{
+	int32 Sum = 0;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Sum += MixinTarget(i);
+	}
+	return Sum;
+}
+
+void UEqZeroScriptBenchmarkTarget::BroadcastEvent(int32 Count)
+{
+	for (int32 i = 0; i < Count; ++i)
+	{
+		OnBenchmarkEvent.Broadcast(i);
+	}
+}
+
+void UEqZeroScriptBenchmarkTarget::ReportResults(const FString& ResultsJson)
+{
+	Results = ResultsJson;
+	bFinished = true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// UEqZeroScriptBenchmarkCommandlet
+
+UEqZeroScriptBenchmarkCommandlet::UEqZeroScriptBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UEqZeroScriptBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 Iterations = 100000;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+
+	double TimeoutSeconds = 120.0;
+	FParse::Value(*Params, TEXT("Timeout="), TimeoutSeconds);
+
+	FString OutputPath;
+	if (!FParse::Value(*Params, TEXT("Output="), OutputPath))
+	{
+		OutputPath = GetDefaultOutputPath();
+	}
+
+	FString Results;
+	if (!RunBenchmarks(Iterations, TimeoutSeconds, Results))
+	{
+		UE_LOG(LogEqZero, Error, TEXT("Script benchmark did not finish within %.0f seconds"), TimeoutSeconds);
+		return 1;
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPath), true);
+	if (!FFileHelper::SaveStringToFile(Results, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogEqZero, Error, TEXT("Failed to write script benchmark results to %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogEqZero, Display, TEXT("Wrote script benchmark results to %s"), *OutputPath);
+	return 0;
+}
+
+bool UEqZeroScriptBenchmarkCommandlet::RunBenchmarks(int32 Iterations, double TimeoutSeconds, FString& OutResults)
+{
+	UEqZeroScriptBenchmarkTarget* Target = NewObject<UEqZeroScriptBenchmarkTarget>(GetTransientPackage());
+	Target->AddToRoot();
+	Target->Iterations = FMath::Max(Iterations, 1);
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		Target->IntArray.Add(i);
+		Target->NameMap.Add(FName(TEXT("Key"), i), i);
+	}
+
+	{
+		puerts::FJsEnv GameScript;
+
+		TArray<TPair<FString, UObject*>> Arguments;
+		Arguments.Add(TPair<FString, UObject*>(TEXT("Target"), Target));
+		GameScript.Start(TEXT("Benchmark/BenchmarkMain"), Arguments);
+
+		// 计时器类的用例依赖 Ticker，这里手动驱动直到脚本报告结果
+		const double StartTime = FPlatformTime::Seconds();
+		double LastTickTime = StartTime;
+		while (!Target->IsFinished() && (FPlatformTime::Seconds() - StartTime) < TimeoutSeconds)
+		{
+			const double Now = FPlatformTime::Seconds();
+			FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTickTime));
+			LastTickTime = Now;
+			FPlatformProcess::Sleep(0.0f);
+		}
+	}
+
+	const bool bFinished = Target->IsFinished();
+	OutResults = Target->GetResults();
+	Target->RemoveFromRoot();
+	return bFinished;
+}
+
+FString UEqZeroScriptBenchmarkCommandlet::GetDefaultOutputPath()
+{
+	return FPaths::ProfilingDir() / TEXT("ScriptBenchmark") / FString::Printf(TEXT("ScriptBenchmark_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+}
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "HAL/PlatformTime.h"
+#include "EqZeroScriptBenchmarkCommandlet.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEqZeroScriptBenchmarkEvent, int32, Value);
+
+/**
+ * UEqZeroScriptBenchmarkTarget
+ *
+ *	脚本基准测试里被 TypeScript 调用的对象，覆盖常见的跨语言访问方式：
+ *	UFUNCTION 调用、属性读写、结构体、容器、委托、Mixin
+ *	用例在 TypeScript/Benchmark 下，跑完后通过 ReportResults 把 JSON 结果交回 C++
+ */
+UCLASS(Blueprintable, BlueprintType, MinimalAPI)
+class UEqZeroScriptBenchmarkTarget : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	int32 Add(int32 A, int32 B) const { return A + B; }
+
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	FVector ScaleVector(const FVector& Value, float Scale) const { return Value * Scale; }
+
+	/** 由 TypeScript Mixin 实现 */
+	UFUNCTION(BlueprintNativeEvent, Category = "Benchmark")
+	int32 MixinTarget(int32 Value);
+
+	/** 在 C++ 里连续调用 Count 次 MixinTarget，测 C++ -> Mixin 的调用开销 */
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	int32 CallMixinTarget(int32 Count);
+
+	/** 广播 Count 次 OnBenchmarkEvent */
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	void BroadcastEvent(int32 Count);
+
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	void ReportResults(const FString& ResultsJson);
+
+	/** 高精度时钟(秒)，Date.now() 只有毫秒精度，不够算 ns/op */
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	static double GetPlatformSeconds() { return FPlatformTime::Seconds(); }
+
+	bool IsFinished() const { return bFinished; }
+	const FString& GetResults() const { return Results; }
+
+public:
+	/** 每个用例的迭代次数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+	int32 Iterations = 100000;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	int32 IntValue = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FVector VectorValue = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	TArray<int32> IntArray;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	TMap<FName, int32> NameMap;
+
+	UPROPERTY(BlueprintAssignable, Category = "Benchmark")
+	FEqZeroScriptBenchmarkEvent OnBenchmarkEvent;
+
+private:
+	bool bFinished = false;
+	FString Results;
+};
+
+/**
+ * UEqZeroScriptBenchmarkCommandlet
+ *
+ *	无头运行脚本基准测试，结果写成 JSON，方便不同版本之间对比：
+ *	UnrealEditor-Cmd EqZero.uproject -run=EqZeroScriptBenchmark -nullrhi [-Iterations=100000] [-Output=Path.json] [-Timeout=120]
+ *	默认输出到 Saved/Profiling/ScriptBenchmark 下
+ *	自动化测试 EqZero.Script.Benchmark 也通过 RunBenchmarks 跑同一套用例
+ */
+UCLASS(MinimalAPI)
+class UEqZeroScriptBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UEqZeroScriptBenchmarkCommandlet();
+
+	//~UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~End of UCommandlet interface
+
+	/** 启动一个 FJsEnv 跑完所有用例，超时返回 false */
+	EQZEROGAME_API static bool RunBenchmarks(int32 Iterations, double TimeoutSeconds, FString& OutResults);
+
+	/** 写到 Saved/Profiling/ScriptBenchmark 下带时间戳的文件 */
+	EQZEROGAME_API static FString GetDefaultOutputPath();
+};
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqZeroStartupTimingCommandlet.h"
+
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "EqZeroLogChannels.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "System/EqZeroAssetManager.h"
+#include "UObject/UObjectGlobals.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroStartupTimingCommandlet)
+
+UEqZeroStartupTimingCommandlet::UEqZeroStartupTimingCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UEqZeroStartupTimingCommandlet::Main(const FString& Params)
+{
+	double TimeoutSeconds = 120.0;
+	FParse::Value(*Params, TEXT("Timeout="), TimeoutSeconds);
+
+	FString OutputPath;
+	if (!FParse::Value(*Params, TEXT("Output="), OutputPath))
+	{
+		OutputPath = FPaths::ProfilingDir() / TEXT("StartupTiming") / FString::Printf(TEXT("StartupTiming_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	}
+
+	// GIsEditor 由构造函数里的 IsEditor 决定，在引擎初始化之前就设好了，所以 UnrealEditor-Cmd 下 GameData 也走异步加载。
+	// 万一被改回编辑器模式，GameData 会同步加载，测出来的数据没有意义
+	if (GIsEditor)
+	{
+		UE_LOG(LogEqZero, Error, TEXT("GIsEditor is set, so GameData loads synchronously and the startup timings would not reflect the async path"));
+		return 1;
+	}
+
+	UEqZeroAssetManager& AssetManager = UEqZeroAssetManager::Get();
+
+	// 启动任务在引擎初始化时就开始了，这里驱动异步加载和 Ticker 直到全部完成
+	const double StartTime = FPlatformTime::Seconds();
+	double LastTickTime = StartTime;
+	while (!AssetManager.AreStartupJobsComplete() && (FPlatformTime::Seconds() - StartTime) < TimeoutSeconds)
+	{
+		ProcessAsyncLoading(/*bUseTimeLimit=*/ true, /*bUseFullTimeLimit=*/ false, /*TimeLimit=*/ 0.01);
+
+		const double Now = FPlatformTime::Seconds();
+		FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTickTime));
+		LastTickTime = Now;
+		FPlatformProcess::Sleep(0.0f);
+	}
+
+	if (!AssetManager.AreStartupJobsComplete())
+	{
+		UE_LOG(LogEqZero, Error, TEXT("Asset manager startup jobs did not finish within %.0f seconds"), TimeoutSeconds);
+		return 1;
+	}
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetNumberField(TEXT("TotalSeconds"), AssetManager.GetStartupJobsDuration());
+
+	TArray<TSharedPtr<FJsonValue>> JobValues;
+	for (const FEqZeroAssetManagerStartupJobTiming& Timing : AssetManager.GetStartupJobTimings())
+	{
+		UE_LOG(LogEqZero, Display, TEXT("Startup job \"%s\": started at +%.3fs, took %.3fs"), *Timing.JobName, Timing.StartOffset, Timing.Duration);
+
+		TSharedRef<FJsonObject> JobObject = MakeShared<FJsonObject>();
+		JobObject->SetStringField(TEXT("Name"), Timing.JobName);
+		JobObject->SetNumberField(TEXT("StartOffsetSeconds"), Timing.StartOffset);
+		JobObject->SetNumberField(TEXT("DurationSeconds"), Timing.Duration);
+		JobValues.Add(MakeShared<FJsonValueObject>(JobObject));
+	}
+	RootObject->SetArrayField(TEXT("Jobs"), JobValues);
+
+	UE_LOG(LogEqZero, Display, TEXT("All startup jobs took %.3f seconds"), AssetManager.GetStartupJobsDuration());
+
+	FString Results;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Results);
+	FJsonSerializer::Serialize(RootObject, Writer);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPath), true);
+	if (!FFileHelper::SaveStringToFile(Results, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogEqZero, Error, TEXT("Failed to write startup timing results to %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogEqZero, Display, TEXT("Wrote startup timing results to %s"), *OutputPath);
+	return 0;
+}
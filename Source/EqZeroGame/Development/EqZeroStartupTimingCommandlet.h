@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "EqZeroStartupTimingCommandlet.generated.h"
+
+/**
+ * UEqZeroStartupTimingCommandlet
+ *
+ *	等资源管理器的启动任务全部跑完，输出每个任务的开始时间、耗时和总耗时：
+ *	UnrealEditor-Cmd EqZero.uproject -run=EqZeroStartupTiming -nullrhi [-Output=Path.json] [-Timeout=120]
+ *	默认输出到 Saved/Profiling/StartupTiming 下
+ *	IsEditor 为 false，GIsEditor 不会被打开，GameData 和正式游戏一样异步加载
+ */
+UCLASS()
+class UEqZeroStartupTimingCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UEqZeroStartupTimingCommandlet();
+
+	//~UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~End of UCommandlet interface
+};
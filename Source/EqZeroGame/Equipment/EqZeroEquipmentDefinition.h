@@ -6,6 +6,8 @@
 
 #include "EqZeroEquipmentDefinition.generated.h"
 
+#define UE_API EQZEROGAME_API
+
 class AActor;
 class UEqZeroAbilitySet;
 class UEqZeroEquipmentInstance;
@@ -33,6 +35,10 @@ struct FEqZeroEquipmentActorToSpawn
 	// 挂载后的相对变换（位置/旋转/缩放）
 	UPROPERTY(EditAnywhere, Category=Equipment)
 	FTransform AttachTransform;
+
+	// 卸下时回收到 Actor 池，下次装备直接复用；复用的 Actor 不会再走 BeginPlay 和构造脚本，确认没有依赖上一个持有者的状态再打开
+	UPROPERTY(EditAnywhere, Category=Equipment)
+	bool bAllowPooling = false;
 };
 
 
@@ -43,13 +49,13 @@ struct FEqZeroEquipmentActorToSpawn
  * 包含：要生成的装备实例类型、授予的技能集、需要生成的挂载Actor。
  * 作为DataAsset在编辑器中配置，运行时由 EquipmentManagerComponent 读取。
  */
-UCLASS(Blueprintable, Const, Abstract, BlueprintType)
+UCLASS(MinimalAPI, Blueprintable, Const, Abstract, BlueprintType)
 class UEqZeroEquipmentDefinition : public UObject
 {
 	GENERATED_BODY()
 
 public:
-	UEqZeroEquipmentDefinition(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+	UE_API UEqZeroEquipmentDefinition(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	// 装备实例的类，装备时会创建该类的对象
 	UPROPERTY(EditDefaultsOnly, Category=Equipment)
@@ -63,3 +69,5 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category=Equipment)
 	TArray<FEqZeroEquipmentActorToSpawn> ActorsToSpawn;
 };
+
+#undef UE_API
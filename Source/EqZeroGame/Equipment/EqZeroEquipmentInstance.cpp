@@ -5,7 +5,9 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Character.h"
 #include "EqZeroEquipmentDefinition.h"
+#include "HAL/IConsoleManager.h"
 #include "Net/UnrealNetwork.h"
+#include "System/EqZeroActorPoolSubsystem.h"
 
 #if UE_WITH_IRIS
 #include "Iris/ReplicationSystem/ReplicationFragmentUtil.h"
@@ -17,6 +19,16 @@ class FLifetimeProperty;
 class UClass;
 class USceneComponent;
 
+namespace EqZeroEquipment
+{
+	static bool bPoolEquipmentActors = true;
+	static FAutoConsoleVariableRef CVarPoolEquipmentActors(
+		TEXT("EqZero.Equipment.PoolActors"),
+		bPoolEquipmentActors,
+		TEXT("Park equipment actors that set bAllowPooling in the world actor pool on unequip and reuse them on the next equip."),
+		ECVF_Default);
+}
+
 UEqZeroEquipmentInstance::UEqZeroEquipmentInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -82,28 +94,65 @@ void UEqZeroEquipmentInstance::SpawnEquipmentActors(const TArray<FEqZeroEquipmen
 			AttachTarget = Char->GetMesh();
 		}
 
+		UEqZeroActorPoolSubsystem* ActorPool = EqZeroEquipment::bPoolEquipmentActors ? UEqZeroActorPoolSubsystem::Get(OwningPawn) : nullptr;
+
 		for (const FEqZeroEquipmentActorToSpawn& SpawnInfo : ActorsToSpawn)
 		{
-			// 延迟生成 -> 设置变换 -> 挂载到目标插槽
-			AActor* NewActor = GetWorld()->SpawnActorDeferred<AActor>(SpawnInfo.ActorToSpawn, FTransform::Identity, OwningPawn);
-			NewActor->FinishSpawning(FTransform::Identity, /*bIsDefaultTransform=*/ true);
+			const bool bPoolable = (ActorPool != nullptr) && SpawnInfo.bAllowPooling;
+
+			AActor* NewActor = nullptr;
+			if (bPoolable)
+			{
+				// 优先复用池里卸下的同类 Actor，没有的话池会生成一个
+				NewActor = ActorPool->AcquireActor(SpawnInfo.ActorToSpawn, OwningPawn, nullptr);
+			}
+			else
+			{
+				// 延迟生成 -> 设置变换 -> 挂载到目标插槽
+				NewActor = GetWorld()->SpawnActorDeferred<AActor>(SpawnInfo.ActorToSpawn, FTransform::Identity, OwningPawn);
+				if (NewActor)
+				{
+					NewActor->FinishSpawning(FTransform::Identity, /*bIsDefaultTransform=*/ true);
+				}
+			}
+
+			if (NewActor == nullptr)
+			{
+				continue;
+			}
+
 			NewActor->SetActorRelativeTransform(SpawnInfo.AttachTransform);
 			NewActor->AttachToComponent(AttachTarget, FAttachmentTransformRules::KeepRelativeTransform, SpawnInfo.AttachSocket);
 
 			SpawnedActors.Add(NewActor);
+			SpawnedActorsPoolable.Add(bPoolable);
 		}
 	}
 }
 
 void UEqZeroEquipmentInstance::DestroyEquipmentActors()
 {
-	for (AActor* Actor : SpawnedActors)
+	UEqZeroActorPoolSubsystem* ActorPool = UEqZeroActorPoolSubsystem::Get(GetPawn());
+
+	for (int32 ActorIndex = 0; ActorIndex < SpawnedActors.Num(); ++ActorIndex)
 	{
-		if (Actor)
+		if (AActor* Actor = SpawnedActors[ActorIndex])
 		{
-			Actor->Destroy();
+			const bool bPoolable = SpawnedActorsPoolable.IsValidIndex(ActorIndex) && SpawnedActorsPoolable[ActorIndex];
+			if (bPoolable && ActorPool)
+			{
+				ActorPool->ReleaseActor(Actor);
+			}
+			else
+			{
+				Actor->Destroy();
+			}
 		}
 	}
+
+	// 回收的 Actor 之后可能被别的装备复用，这里不能再引用
+	SpawnedActors.Reset();
+	SpawnedActorsPoolable.Reset();
 }
 
 void UEqZeroEquipmentInstance::OnEquipped()
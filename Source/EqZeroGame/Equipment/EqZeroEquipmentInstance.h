@@ -90,4 +90,7 @@ private:
 	// 装备生成的Actor列表，网络复制
 	UPROPERTY(Replicated)
 	TArray<TObjectPtr<AActor>> SpawnedActors;
+
+	// 和 SpawnedActors 一一对应，记录卸下时能否回收到 Actor 池（仅服务器）
+	TBitArray<> SpawnedActorsPoolable;
 };
@@ -124,7 +124,7 @@ struct TStructOpsTypeTraits<FEqZeroEquipmentList> : public TStructOpsTypeTraitsB
  * 使用 FastArraySerializer 实现装备列表的增量网络复制，
  * 并通过 SubObject 机制复制装备实例对象本身。
  */
-UCLASS(BlueprintType, Const)
+UCLASS(MinimalAPI, BlueprintType, Const)
 class UEqZeroEquipmentManagerComponent : public UPawnComponent
 {
 	GENERATED_BODY()
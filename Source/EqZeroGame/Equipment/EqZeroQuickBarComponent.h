@@ -7,6 +7,8 @@
 
 #include "EqZeroQuickBarComponent.generated.h"
 
+#define UE_API EQZEROGAME_API
+
 class AActor;
 class UEqZeroEquipmentInstance;
 class UEqZeroEquipmentManagerComponent;
@@ -25,22 +27,22 @@ struct FFrame;
  *   - 切换槽位通过 Server RPC 保证 Authority 端执行
  *   - OnRep 回调中通过 GameplayMessage 广播变更通知UI更新
  */
-UCLASS(Blueprintable, meta=(BlueprintSpawnableComponent))
+UCLASS(MinimalAPI, Blueprintable, meta=(BlueprintSpawnableComponent))
 class UEqZeroQuickBarComponent : public UControllerComponent
 {
 	GENERATED_BODY()
 
 public:
-	UEqZeroQuickBarComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+	UE_API UEqZeroQuickBarComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	UFUNCTION(BlueprintCallable, Category="EqZero")
-	void CycleActiveSlotForward();
+	UE_API void CycleActiveSlotForward();
 
 	UFUNCTION(BlueprintCallable, Category="EqZero")
-	void CycleActiveSlotBackward();
+	UE_API void CycleActiveSlotBackward();
 
 	UFUNCTION(Server, Reliable, BlueprintCallable, Category="EqZero")
-	void SetActiveSlotIndex(int32 NewIndex);
+	UE_API void SetActiveSlotIndex(int32 NewIndex);
 
 	UFUNCTION(BlueprintCallable, BlueprintPure=false)
 	TArray<UEqZeroInventoryItemInstance*> GetSlots() const
@@ -52,18 +54,18 @@ public:
 	int32 GetActiveSlotIndex() const { return ActiveSlotIndex; }
 
 	UFUNCTION(BlueprintCallable, BlueprintPure = false)
-	UEqZeroInventoryItemInstance* GetActiveSlotItem() const;
+	UE_API UEqZeroInventoryItemInstance* GetActiveSlotItem() const;
 
 	UFUNCTION(BlueprintCallable, BlueprintPure=false)
-	int32 GetNextFreeItemSlot() const;
+	UE_API int32 GetNextFreeItemSlot() const;
 
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
-	void AddItemToSlot(int32 SlotIndex, UEqZeroInventoryItemInstance* Item);
+	UE_API void AddItemToSlot(int32 SlotIndex, UEqZeroInventoryItemInstance* Item);
 	
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
-	UEqZeroInventoryItemInstance* RemoveItemFromSlot(int32 SlotIndex);
+	UE_API UEqZeroInventoryItemInstance* RemoveItemFromSlot(int32 SlotIndex);
 
-	virtual void BeginPlay() override;
+	UE_API virtual void BeginPlay() override;
 
 private:
 	void UnEquipItemInSlot();
@@ -123,3 +125,5 @@ struct FEqZeroQuickBarActiveIndexChangedMessage
 	UPROPERTY(BlueprintReadOnly, Category=Inventory)
 	int32 ActiveIndex = 0;
 };
+
+#undef UE_API
@@ -11,7 +11,7 @@ class UObject;
 class UStaticMesh;
 
 UCLASS()
-class UEqDamagePopStyle : public UDataAsset
+class EQZEROGAME_API UEqDamagePopStyle : public UDataAsset
 {
 	GENERATED_BODY()
 
@@ -43,7 +43,7 @@ struct FEqNumberPopRequest
 
 
 UCLASS(Abstract)
-class UEqNumberPopComponent : public UControllerComponent
+class EQZEROGAME_API UEqNumberPopComponent : public UControllerComponent
 {
 	GENERATED_BODY()
 
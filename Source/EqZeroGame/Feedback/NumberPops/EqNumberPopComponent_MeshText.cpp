@@ -9,8 +9,6 @@
 #include "Feedback/NumberPops/EqNumberPopComponent.h"
 #include "EqDamagePopStyle.h"
 #include "Materials/MaterialInstanceDynamic.h"
-#include "TimerManager.h"
-#include "UObject/Package.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EqNumberPopComponent_MeshText)
 
@@ -19,7 +17,11 @@ class UStaticMesh;
 UEqNumberPopComponent_MeshText::UEqNumberPopComponent_MeshText(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
 	ComponentLifespan = 1.f;
+	MaxLivePopsPerMesh = 64;
 
 	SignDigitParameterName = FName(TEXT("+Or-"));
 	ColorParameterName = FName(TEXT("Color"));
@@ -56,30 +58,27 @@ void UEqNumberPopComponent_MeshText::AddNumberPop(const FEqNumberPopRequest& New
 	FTempNumberPopInfo PreparedNumberInfo;
 
 	// Prepare the DamageNumberArray with the digits from the damage.
+	// Digits are written in place from the back, slot 0 is reserved for + or - (used by the blueprint)
 	{
 		int32 LocalDamage = NewRequest.NumberToDisplay;
-		PreparedNumberInfo.DamageNumberArray.Empty();
 
-		if (LocalDamage == 0)
+		// We want to just show a zero for 0, negative numbers only get the sign slot
+		int32 NumDigits = (LocalDamage >= 0) ? 1 : 0;
+		for (int32 Remaining = LocalDamage / 10; Remaining > 0; Remaining /= 10)
 		{
-			// We want to just show a zero
-			PreparedNumberInfo.DamageNumberArray.Insert(0, 0);
+			++NumDigits;
 		}
-		else
+
+		PreparedNumberInfo.DamageNumberArray.SetNumUninitialized(1 + NumDigits);
+		PreparedNumberInfo.DamageNumberArray[0] = 0;
+		for (int32 DigitIndex = NumDigits; DigitIndex >= 1; --DigitIndex)
 		{
-			// Parse the base10 number into an array
-			while (LocalDamage > 0)
-			{
-				PreparedNumberInfo.DamageNumberArray.Insert(LocalDamage % 10, 0);
-				LocalDamage /= 10;
-			}
+			PreparedNumberInfo.DamageNumberArray[DigitIndex] = LocalDamage % 10;
+			LocalDamage /= 10;
 		}
-
-		// Insert a zero to reserve space for + or -. Used by the blueprint
-		PreparedNumberInfo.DamageNumberArray.Insert(0, 0);
 	}
 
-	// Grab a component from the pool for this number or create one
+	// Grab the next component from the ring for this mesh
 	{
 		UStaticMesh* MeshToUse = DetermineStaticMesh(NewRequest);
 		if (MeshToUse == nullptr)
@@ -87,43 +86,11 @@ void UEqNumberPopComponent_MeshText::AddNumberPop(const FEqNumberPopRequest& New
 			return;
 		}
 
-		FPooledNumberPopComponentList& ComponentPool = PooledComponentMap.FindOrAdd(MeshToUse);
-
-		UStaticMeshComponent* ComponentToUse = nullptr;
-		if (ComponentPool.Components.Num() > 0)
-		{
-			ComponentToUse = ComponentPool.Components.Pop();
-		}
-		else
-		{
-			ComponentToUse = NewObject<UStaticMeshComponent>(GetOwner());
-			ComponentToUse->SetupAttachment(nullptr);
-			ComponentToUse->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
-			ComponentToUse->SetStaticMesh(MeshToUse);
-
-			// Used to allow post-processes to opt out of affecting the number pop digits
-			ComponentToUse->SetRenderCustomDepth(true);
-			ComponentToUse->SetCustomDepthStencilValue(123);
-
-			// The digits travel a great distance from their original bounds due to
-			// world position offset (WPO) animation in the material, so expand bounds
-			ComponentToUse->SetBoundsScale(2000.0f);
-
-			// We'll be overriding values like the desired color and digits to use, so we need MIDs
-			for (int32 MatIdx = 0; MatIdx < ComponentToUse->GetNumMaterials(); ++MatIdx)
-			{
-				ComponentToUse->CreateDynamicMaterialInstance(MatIdx);
-			}
-		}
-
-		// Register
-		check(ComponentToUse);
-		ComponentToUse->RegisterComponent();
-
-		// Add to the "live" list
 		UWorld* LocalWorld = GetWorld();
 		check(LocalWorld);
-		LiveComponents.Emplace(ComponentToUse, &ComponentPool, LocalWorld->GetTimeSeconds() + ComponentLifespan);
+
+		UStaticMeshComponent* ComponentToUse = AcquireComponent(MeshToUse, LocalWorld->GetTimeSeconds() + ComponentLifespan);
+		check(ComponentToUse);
 
 		// Assign struct pointers
 		PreparedNumberInfo.StaticMeshComponent = ComponentToUse;
@@ -133,10 +100,10 @@ void UEqNumberPopComponent_MeshText::AddNumberPop(const FEqNumberPopRequest& New
 			PreparedNumberInfo.MeshMIDs.Add(NewMID);
 		}
 
-		// Start the timer if it wasn't already running
-		if (!LocalWorld->GetTimerManager().IsTimerActive(ReleaseTimerHandle))
+		// Start sweeping expired pops if we weren't already
+		if (!IsComponentTickEnabled())
 		{
-			LocalWorld->GetTimerManager().SetTimer(ReleaseTimerHandle, this, &ThisClass::ReleaseNextComponents, ComponentLifespan);
+			SetComponentTickEnabled(true);
 		}
 	}
 
@@ -163,51 +130,136 @@ void UEqNumberPopComponent_MeshText::AddNumberPop(const FEqNumberPopRequest& New
 	SetMaterialParameters(NewRequest, PreparedNumberInfo, CameraTransform, NumberLocation);
 }
 
-void UEqNumberPopComponent_MeshText::ReleaseNextComponents()
+void UEqNumberPopComponent_MeshText::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
 	UWorld* LocalWorld = GetWorld();
 	check(LocalWorld);
 
-	const float CurrentTime = LocalWorld->GetTimeSeconds();
+	ReleaseExpiredComponents(LocalWorld->GetTimeSeconds());
 
-	int32 NumReleased = 0;
-	for (const FLiveNumberPopEntry& LiveComp : LiveComponents)
+	// Nothing left animating, stop ticking until the next pop
+	if (NumLivePops == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UEqNumberPopComponent_MeshText::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (TPair<TObjectPtr<UStaticMesh>, FNumberPopMeshRing>& MeshRingPair : MeshRings)
 	{
-		if (CurrentTime >= LiveComp.ReleaseTime)
+		for (UStaticMeshComponent* Component : MeshRingPair.Value.Components)
 		{
-			NumReleased++;
-			if (ensure(LiveComp.Component))
+			if (Component)
 			{
-				LiveComp.Component->UnregisterComponent();
-
-				if (ensure(LiveComp.Pool))
-				{
-					// Return this component to the pool
-					LiveComp.Pool->Components.Push(LiveComp.Component);
-				}
-				else
-				{
-					// No pool. Just remove it.
-					LiveComp.Component->SetFlags(RF_Transient);
-					LiveComp.Component->Rename(nullptr, GetTransientPackage(), RF_NoFlags);
-				}
+				Component->DestroyComponent();
 			}
 		}
-		else
-		{
-			// These are in chronological order so none of the other elements will be deleted
-			break;
-		}
+	}
+	MeshRings.Reset();
+	NumLivePops = 0;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UStaticMeshComponent* UEqNumberPopComponent_MeshText::AcquireComponent(UStaticMesh* Mesh, float ReleaseTime)
+{
+	FNumberPopMeshRing& Ring = MeshRings.FindOrAdd(Mesh);
+
+	// The slot at NextIndex is always the oldest one. If it is still showing a number and the ring
+	// has not reached its capacity yet, grow the ring by inserting the new slot in front of it so the
+	// chronological order is preserved. Otherwise reuse it (recycling the oldest pop if it is still live).
+	const int32 Capacity = FMath::Max(1, MaxLivePopsPerMesh);
+	const bool bOldestIsLive = Ring.ReleaseTimes.IsValidIndex(Ring.NextIndex) && (Ring.ReleaseTimes[Ring.NextIndex] > 0.0f);
+	const bool bGrow = (Ring.Components.Num() == 0) || (bOldestIsLive && (Ring.Components.Num() < Capacity));
+
+	const int32 SlotIndex = Ring.NextIndex;
+	if (bGrow)
+	{
+		Ring.Components.Insert(CreatePopComponent(Mesh), SlotIndex);
+		Ring.ReleaseTimes.Insert(0.0f, SlotIndex);
+	}
+
+	if (Ring.ReleaseTimes[SlotIndex] <= 0.0f)
+	{
+		++Ring.NumLive;
+		++NumLivePops;
+	}
+
+	Ring.ReleaseTimes[SlotIndex] = ReleaseTime;
+	Ring.NextIndex = (SlotIndex + 1) % Ring.Components.Num();
+
+	UStaticMeshComponent* Component = Ring.Components[SlotIndex];
+	Component->SetHiddenInGame(false);
+	return Component;
+}
+
+UStaticMeshComponent* UEqNumberPopComponent_MeshText::CreatePopComponent(UStaticMesh* Mesh)
+{
+	UStaticMeshComponent* NewComponent = NewObject<UStaticMeshComponent>(GetOwner());
+	NewComponent->SetupAttachment(nullptr);
+	NewComponent->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	NewComponent->SetStaticMesh(Mesh);
+
+	// Used to allow post-processes to opt out of affecting the number pop digits
+	NewComponent->SetRenderCustomDepth(true);
+	NewComponent->SetCustomDepthStencilValue(123);
+
+	// The digits travel a great distance from their original bounds due to
+	// world position offset (WPO) animation in the material, so expand bounds
+	NewComponent->SetBoundsScale(2000.0f);
+
+	// We'll be overriding values like the desired color and digits to use, so we need MIDs.
+	// They are created once here and reused every time this slot shows a new number.
+	for (int32 MatIdx = 0; MatIdx < NewComponent->GetNumMaterials(); ++MatIdx)
+	{
+		NewComponent->CreateDynamicMaterialInstance(MatIdx);
 	}
 
-	// Actually remove it from the live components array
-	LiveComponents.RemoveAt(0, NumReleased);
+	// The component stays registered for the lifetime of the ring, expired pops are only hidden
+	NewComponent->SetHiddenInGame(true);
+	NewComponent->RegisterComponent();
 
-	// If we still have live components animating, set the timer to remove the next one
-	if (LiveComponents.Num() > 0)
+	return NewComponent;
+}
+
+void UEqNumberPopComponent_MeshText::ReleaseExpiredComponents(float CurrentTime)
+{
+	for (TPair<TObjectPtr<UStaticMesh>, FNumberPopMeshRing>& MeshRingPair : MeshRings)
 	{
-		const float TimeUntilNextRelease = LiveComponents[0].ReleaseTime - CurrentTime;
-		LocalWorld->GetTimerManager().SetTimer(ReleaseTimerHandle, this, &ThisClass::ReleaseNextComponents, TimeUntilNextRelease);
+		FNumberPopMeshRing& Ring = MeshRingPair.Value;
+		if (Ring.NumLive == 0)
+		{
+			continue;
+		}
+
+		// Walk from the oldest slot; slots are in chronological order so we can stop at the first one still alive
+		const int32 NumSlots = Ring.Components.Num();
+		for (int32 Offset = 0; Offset < NumSlots; ++Offset)
+		{
+			const int32 SlotIndex = (Ring.NextIndex + Offset) % NumSlots;
+			const float ReleaseTime = Ring.ReleaseTimes[SlotIndex];
+			if (ReleaseTime <= 0.0f)
+			{
+				continue;
+			}
+
+			if (CurrentTime < ReleaseTime)
+			{
+				break;
+			}
+
+			Ring.ReleaseTimes[SlotIndex] = 0.0f;
+			--Ring.NumLive;
+			--NumLivePops;
+
+			if (ensure(Ring.Components[SlotIndex]))
+			{
+				Ring.Components[SlotIndex]->SetHiddenInGame(true);
+			}
+		}
 	}
 }
 
@@ -12,51 +12,46 @@ class UObject;
 class UStaticMesh;
 class UStaticMeshComponent;
 
+/**
+ * Fixed-capacity ring of number pop components for a single mesh.
+ * Components stay registered for the lifetime of the ring and are hidden when their pop expires,
+ * so once the ring has warmed up showing a number pop does not allocate.
+ */
 USTRUCT()
-struct FPooledNumberPopComponentList
+struct FNumberPopMeshRing
 {
 	GENERATED_BODY()
 
+	/** Components in chronological order starting at NextIndex (the oldest slot) */
 	UPROPERTY(transient)
 	TArray<TObjectPtr<UStaticMeshComponent>> Components;
-};
-
-USTRUCT()
-struct FLiveNumberPopEntry
-{
-	GENERATED_BODY()
-
-	/** The component that is currently live */
-	UPROPERTY(transient)
-	TObjectPtr<UStaticMeshComponent> Component = nullptr;
-
-	/** The pool this component will go into when released */
-	FPooledNumberPopComponentList* Pool = nullptr;
 
-	/** The world time that this component will be released to the pool */
-	float ReleaseTime = 0.0f;
+	/** The world time that each slot expires at, or 0 if the slot is free */
+	TArray<float> ReleaseTimes;
 
-	FLiveNumberPopEntry()
-	{}
+	/** The slot that will be handed out next */
+	int32 NextIndex = 0;
 
-	FLiveNumberPopEntry(UStaticMeshComponent* InComponent, FPooledNumberPopComponentList* InPool, float InReleaseTime)
-		: Component(InComponent), Pool(InPool), ReleaseTime(InReleaseTime)
-	{}
+	/** Number of slots that are currently showing a number */
+	int32 NumLive = 0;
 };
 
+/** Maximum number of digits (including the sign slot) a number pop can format */
+static constexpr int32 MaxNumberPopDigits = 16;
+
 /** Struct that holds the info for a new damage number */
 struct FTempNumberPopInfo
 {
 	UStaticMeshComponent* StaticMeshComponent = nullptr;
 
-	TArray<UMaterialInstanceDynamic*> MeshMIDs;
+	TArray<UMaterialInstanceDynamic*, TInlineAllocator<4>> MeshMIDs;
 
-	TArray<int32> DamageNumberArray;
+	TArray<int32, TInlineAllocator<MaxNumberPopDigits>> DamageNumberArray;
 };
 
 
 UCLASS(Blueprintable)
-class UEqNumberPopComponent_MeshText : public UEqNumberPopComponent
+class EQZEROGAME_API UEqNumberPopComponent_MeshText : public UEqNumberPopComponent
 {
 	GENERATED_BODY()
 
@@ -68,14 +63,24 @@ public:
 	virtual void AddNumberPop(const FEqNumberPopRequest& NewRequest) override;
 	//~End of UEqNumberPopComponent interface
 
+	//~UActorComponent interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~End of UActorComponent interface
+
 protected:
 	void SetMaterialParameters(const FEqNumberPopRequest& Request, FTempNumberPopInfo& NewDamageNumberInfo, const FTransform& CameraTransform, const FVector& NumberLocation);
 
 	FLinearColor DetermineColor(const FEqNumberPopRequest& Request) const;
 	UStaticMesh* DetermineStaticMesh(const FEqNumberPopRequest& Request) const;
 
-	/** Releases components back to the pool that have exceeded their lifespan */
-	void ReleaseNextComponents();
+	/** Hands out the next slot of the ring for the given mesh, recycling the oldest live pop when the ring is full */
+	UStaticMeshComponent* AcquireComponent(UStaticMesh* Mesh, float ReleaseTime);
+
+	UStaticMeshComponent* CreatePopComponent(UStaticMesh* Mesh);
+
+	/** Hides every live pop that has exceeded its lifespan, in a single sweep */
+	void ReleaseExpiredComponents(float CurrentTime);
 
 	/** Style patterns to attempt to apply to the incoming number pops */
 	UPROPERTY(EditDefaultsOnly, Category="Number Pop|Style")
@@ -84,6 +89,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Number Pop|Style")
 	float ComponentLifespan;
 
+	/** Maximum number of pops of one mesh that can be visible at once; the oldest pop is recycled when exceeded */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style", meta = (ClampMin = 1))
+	int32 MaxLivePopsPerMesh;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
 	float DistanceFromCameraBeforeDoublingSize;
 
@@ -129,10 +138,8 @@ protected:
 	TArray<FName> DurationParameterNames;
 
 	UPROPERTY(Transient)
-	TMap<TObjectPtr<UStaticMesh>, FPooledNumberPopComponentList> PooledComponentMap;
-
-	UPROPERTY(transient)
-	TArray<FLiveNumberPopEntry> LiveComponents;
+	TMap<TObjectPtr<UStaticMesh>, FNumberPopMeshRing> MeshRings;
 
-	FTimerHandle ReleaseTimerHandle;
+	/** Number of live pops across all rings, ticking is disabled when this reaches zero */
+	int32 NumLivePops = 0;
 };
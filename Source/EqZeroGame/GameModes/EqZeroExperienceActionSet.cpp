@@ -38,6 +38,33 @@ EDataValidationResult UEqZeroExperienceActionSet::IsDataValid(FDataValidationCon
 		++EntryIndex;
 	}
 
+	Result = CombineDataValidationResults(Result, ValidatePreloadAssets(PreloadAssets, PreloadPrimaryAssets, Context));
+
+	return Result;
+}
+
+EDataValidationResult UEqZeroExperienceActionSet::ValidatePreloadAssets(const TArray<FSoftObjectPath>& InPreloadAssets, const TArray<FPrimaryAssetId>& InPreloadPrimaryAssets, FDataValidationContext& Context)
+{
+	EDataValidationResult Result = EDataValidationResult::Valid;
+
+	for (int32 PreloadIndex = 0; PreloadIndex < InPreloadAssets.Num(); ++PreloadIndex)
+	{
+		if (InPreloadAssets[PreloadIndex].IsNull())
+		{
+			Result = EDataValidationResult::Invalid;
+			Context.AddError(FText::Format(LOCTEXT("PreloadAssetIsNull", "Null entry at index {0} in PreloadAssets"), FText::AsNumber(PreloadIndex)));
+		}
+	}
+
+	for (int32 PreloadIndex = 0; PreloadIndex < InPreloadPrimaryAssets.Num(); ++PreloadIndex)
+	{
+		if (!InPreloadPrimaryAssets[PreloadIndex].IsValid())
+		{
+			Result = EDataValidationResult::Invalid;
+			Context.AddError(FText::Format(LOCTEXT("PreloadPrimaryAssetIsInvalid", "Invalid entry at index {0} in PreloadPrimaryAssets"), FText::AsNumber(PreloadIndex)));
+		}
+	}
+
 	return Result;
 }
 #endif
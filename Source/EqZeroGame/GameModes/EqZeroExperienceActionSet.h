@@ -11,7 +11,7 @@ class UGameFeatureAction;
 /**
  * 技能集, 一组UGameFeatureAction 和 一组名字
  */
-UCLASS(BlueprintType, NotBlueprintable)
+UCLASS(MinimalAPI, BlueprintType, NotBlueprintable)
 class UEqZeroExperienceActionSet : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
@@ -25,6 +25,11 @@ public:
 #endif
 	//~End of UObject interface
 
+#if WITH_EDITOR
+	// 检查预加载列表里的空项，体验定义也用这个
+	static EDataValidationResult ValidatePreloadAssets(const TArray<FSoftObjectPath>& InPreloadAssets, const TArray<FPrimaryAssetId>& InPreloadPrimaryAssets, class FDataValidationContext& Context);
+#endif
+
 	//~UPrimaryDataAsset interface
 #if WITH_EDITORONLY_DATA
 	virtual void UpdateAssetBundleData() override;
@@ -37,4 +42,12 @@ public:
 
 	UPROPERTY(EditAnywhere, Category="Feature Dependencies")
 	TArray<FString> GameFeaturesToEnable;
+
+	// 体验加载时一起异步加载的资源，比如只被 Action 引用的武器、Cue、界面，不然会在对局里第一次用到时才加载
+	UPROPERTY(EditAnywhere, Category="Preload")
+	TArray<FSoftObjectPath> PreloadAssets;
+
+	// 体验加载时一起加载的主资产，Bundle 和体验本身相同
+	UPROPERTY(EditAnywhere, Category="Preload")
+	TArray<FPrimaryAssetId> PreloadPrimaryAssets;
 };
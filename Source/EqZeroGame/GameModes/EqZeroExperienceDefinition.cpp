@@ -39,6 +39,8 @@ EDataValidationResult UEqZeroExperienceDefinition::IsDataValid(FDataValidationCo
 		++EntryIndex;
 	}
 
+	Result = CombineDataValidationResults(Result, UEqZeroExperienceActionSet::ValidatePreloadAssets(PreloadAssets, PreloadPrimaryAssets, Context));
+
 	// Make sure users didn't subclass from a BP of this (it's fine and expected to subclass once in BP, just not twice)
 	if (!GetClass()->IsNative())
 	{
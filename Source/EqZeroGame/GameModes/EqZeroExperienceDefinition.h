@@ -13,7 +13,7 @@ class UEqZeroExperienceActionSet;
 /**
  * 体验定义
  */
-UCLASS(BlueprintType, Const)
+UCLASS(MinimalAPI, BlueprintType, Const)
 class UEqZeroExperienceDefinition : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
@@ -45,4 +45,12 @@ public:
 
 	UPROPERTY(EditDefaultsOnly, Category=Gameplay)
 	TArray<TObjectPtr<UEqZeroExperienceActionSet>> ActionSets;
+
+	// 体验加载时一起异步加载的资源，比如只被 Action 引用的武器、Cue、界面，不然会在对局里第一次用到时才加载
+	UPROPERTY(EditDefaultsOnly, Category="Preload")
+	TArray<FSoftObjectPath> PreloadAssets;
+
+	// 体验加载时一起加载的主资产，Bundle 和体验本身相同
+	UPROPERTY(EditDefaultsOnly, Category="Preload")
+	TArray<FPrimaryAssetId> PreloadPrimaryAssets;
 };
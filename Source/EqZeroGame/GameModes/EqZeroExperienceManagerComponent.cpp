@@ -12,7 +12,10 @@
 #include "GameFeatureAction.h"
 #include "GameFeaturesSubsystemSettings.h"
 #include "TimerManager.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/PlatformTime.h"
 #include "EqZeroLogChannels.h"
+#include "AbilitySystem/EqZeroGameplayCueManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroExperienceManagerComponent)
 
@@ -126,23 +129,70 @@ void UEqZeroExperienceManagerComponent::StartExperienceLoad()
 	check(CurrentExperience != nullptr);
 	check(LoadState == EEqZeroExperienceLoadState::Unloaded);
 
+	// GameData 和默认 PawnData 由启动任务异步加载，等它们完成再开始，不然体验里第一次用到时会退回到阻塞加载
+	// 等待期间 LoadState 还是 Unloaded，加载屏会一直显示
+	UEqZeroAssetManager& AssetManager = UEqZeroAssetManager::Get();
+	if (!AssetManager.AreStartupJobsComplete())
+	{
+		UE_LOG(LogEqZeroExperience, Log, TEXT("EXPERIENCE: Waiting for asset manager startup jobs before loading %s (%s)"),
+			*CurrentExperience->GetPrimaryAssetId().ToString(),
+			*GetClientServerContextString(this));
+
+		AssetManager.CallOrRegister_OnStartupJobsComplete(FSimpleMulticastDelegate::FDelegate::CreateWeakLambda(this, [this]()
+			{
+				// 等待期间世界可能已经拆掉了
+				if (IsRegistered() && (LoadState == EEqZeroExperienceLoadState::Unloaded))
+				{
+					StartExperienceLoad();
+				}
+			}));
+		return;
+	}
+
 	UE_LOG(LogEqZeroExperience, Log, TEXT("EXPERIENCE: StartExperienceLoad(CurrentExperience = %s, %s)"),
 		*CurrentExperience->GetPrimaryAssetId().ToString(),
 		*GetClientServerContextString(this));
 
 	LoadState = EEqZeroExperienceLoadState::Loading;
 
-	UEqZeroAssetManager& AssetManager = UEqZeroAssetManager::Get();
-
 	TSet<FPrimaryAssetId> BundleAssetList;
 	TSet<FSoftObjectPath> RawAssetList;
 
+	LoadStartTime = FPlatformTime::Seconds();
+
+	// 体验和 ActionSet 声明的预加载资源加入同一次异步加载
+	// NumPreloadAssets 只统计这些预加载项，不算体验和 ActionSet 本身
+	NumPreloadAssets = 0;
+	auto AddPreloadAssets = [this, &BundleAssetList, &RawAssetList](const TArray<FSoftObjectPath>& PreloadAssets, const TArray<FPrimaryAssetId>& PreloadPrimaryAssets)
+	{
+		for (const FSoftObjectPath& AssetPath : PreloadAssets)
+		{
+			bool bAlreadyInSet = true;
+			if (!AssetPath.IsNull())
+			{
+				RawAssetList.Add(AssetPath, &bAlreadyInSet);
+			}
+			NumPreloadAssets += bAlreadyInSet ? 0 : 1;
+		}
+		for (const FPrimaryAssetId& AssetId : PreloadPrimaryAssets)
+		{
+			bool bAlreadyInSet = true;
+			if (AssetId.IsValid())
+			{
+				BundleAssetList.Add(AssetId, &bAlreadyInSet);
+			}
+			NumPreloadAssets += bAlreadyInSet ? 0 : 1;
+		}
+	};
+
 	BundleAssetList.Add(CurrentExperience->GetPrimaryAssetId());
+	AddPreloadAssets(CurrentExperience->PreloadAssets, CurrentExperience->PreloadPrimaryAssets);
 	for (const TObjectPtr<UEqZeroExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
 	{
 		if (ActionSet != nullptr)
 		{
 			BundleAssetList.Add(ActionSet->GetPrimaryAssetId());
+			AddPreloadAssets(ActionSet->PreloadAssets, ActionSet->PreloadPrimaryAssets);
 		}
 	}
 
@@ -188,6 +238,7 @@ void UEqZeroExperienceManagerComponent::StartExperienceLoad()
 	{
 		Handle = BundleLoadHandle.IsValid() ? BundleLoadHandle : RawLoadHandle;
 	}
+	ExperienceLoadHandle = Handle;
 
 	FStreamableDelegate OnAssetsLoadedDelegate = FStreamableDelegate::CreateUObject(this, &ThisClass::OnExperienceLoadComplete);
 	if (!Handle.IsValid() || Handle->HasLoadCompleted())
@@ -206,14 +257,7 @@ void UEqZeroExperienceManagerComponent::StartExperienceLoad()
 			}));
 	}
 
-	// This set of assets gets preloaded, but we don't block the start of the experience based on it
-	// 这组资源会被预加载，但我们不会因为它而阻塞体验的开始
-	TSet<FPrimaryAssetId> PreloadAssetList;
-	//@TODO: Determine assets to preload (but not blocking-ly)
-	if (PreloadAssetList.Num() > 0)
-	{
-		AssetManager.ChangeBundleStateForPrimaryAssets(PreloadAssetList.Array(), BundlesToLoad, {});
-	}
+	// 预加载资源已经由 PreloadAssets / PreloadPrimaryAssets 声明并合入上面的加载，体验生效前就会全部就绪
 }
 
 void UEqZeroExperienceManagerComponent::OnExperienceLoadComplete()
@@ -221,9 +265,12 @@ void UEqZeroExperienceManagerComponent::OnExperienceLoadComplete()
 	check(LoadState == EEqZeroExperienceLoadState::Loading);
 	check(CurrentExperience != nullptr);
 
-	UE_LOG(LogEqZeroExperience, Log, TEXT("EXPERIENCE: OnExperienceLoadComplete(CurrentExperience = %s, %s)"),
+	AssetsLoadedTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogEqZeroExperience, Log, TEXT("EXPERIENCE: OnExperienceLoadComplete(CurrentExperience = %s, %s) assets loaded in %.3fs"),
 		*CurrentExperience->GetPrimaryAssetId().ToString(),
-		*GetClientServerContextString(this));
+		*GetClientServerContextString(this),
+		AssetsLoadedTime - LoadStartTime);
 
 	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
 	// 查找我们的 GameFeaturePlugins 的 URL - 过滤掉重复项和没有有效映射的项
@@ -343,8 +390,31 @@ void UEqZeroExperienceManagerComponent::OnExperienceFullLoadCompleted()
 		}
 	}
 
+	// Cue 目录在上面的 Action 激活时已经注册好了，这里开始异步预加载，避免第一次播放时同步加载卡顿
+	if (UEqZeroGameplayCueManager* GCM = UEqZeroGameplayCueManager::Get())
+	{
+		GCM->PreloadGameplayCuesForExperience(CurrentExperience);
+	}
+
 	LoadState = EEqZeroExperienceLoadState::Loaded;
 
+	const double LoadEndTime = FPlatformTime::Seconds();
+	UE_LOG(LogEqZeroExperience, Log, TEXT("EXPERIENCE: %s loaded in %.3fs (assets %.3fs, game features and actions %.3fs, %d preload assets, %d game features, %s)"),
+		*CurrentExperience->GetPrimaryAssetId().ToString(),
+		LoadEndTime - LoadStartTime,
+		AssetsLoadedTime - LoadStartTime,
+		LoadEndTime - AssetsLoadedTime,
+		NumPreloadAssets,
+		GameFeaturePluginURLs.Num(),
+		*GetClientServerContextString(this));
+
+#if !UE_BUILD_SHIPPING
+	VerifyPreloadedAssets();
+#endif
+
+	// 加载屏不再每帧轮询，状态变化时主动通知
+	ILoadingProcessInterface::NotifyLoadingScreenStateChanged(this);
+
 	OnExperienceLoaded_HighPriority.Broadcast(CurrentExperience);
 	OnExperienceLoaded_HighPriority.Clear();
 
@@ -392,6 +462,7 @@ void UEqZeroExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPl
 	if (LoadState == EEqZeroExperienceLoadState::Loaded)
 	{
 		LoadState = EEqZeroExperienceLoadState::Deactivating;
+		ILoadingProcessInterface::NotifyLoadingScreenStateChanged(this);
 
 		// Make sure we won't complete the transition prematurely if someone registers as a pauser but fires immediately
 		// 确保如果有人注册为暂停器但立即触发，我们不会过早完成转换
@@ -447,7 +518,7 @@ bool UEqZeroExperienceManagerComponent::ShouldShowLoadingScreen(FString& OutReas
 {
 	if (LoadState != EEqZeroExperienceLoadState::Loaded)
 	{
-		OutReason = TEXT("Experience still loading");
+		OutReason = UEqZeroAssetManager::Get().AreStartupJobsComplete() ? TEXT("Experience still loading") : TEXT("Waiting for asset manager startup jobs");
 		return true;
 	}
 	else
@@ -456,10 +527,52 @@ bool UEqZeroExperienceManagerComponent::ShouldShowLoadingScreen(FString& OutReas
 	}
 }
 
+void UEqZeroExperienceManagerComponent::VerifyPreloadedAssets() const
+{
+	UEqZeroAssetManager& AssetManager = UEqZeroAssetManager::Get();
+
+	// 没在内存里的资源之后第一次使用会同步加载，说明配置或者加载流程有问题
+	auto VerifyList = [&AssetManager, this](const UPrimaryDataAsset* Context, const TArray<FSoftObjectPath>& PreloadAssets, const TArray<FPrimaryAssetId>& PreloadPrimaryAssets)
+	{
+		for (const FSoftObjectPath& AssetPath : PreloadAssets)
+		{
+			if (!AssetPath.IsNull() && (AssetPath.ResolveObject() == nullptr))
+			{
+				UE_LOG(LogEqZeroExperience, Warning, TEXT("EXPERIENCE: Preload asset %s declared by %s is not resident after load (%s)"),
+					*AssetPath.ToString(), *Context->GetPrimaryAssetId().ToString(), *GetClientServerContextString(this));
+			}
+		}
+		for (const FPrimaryAssetId& AssetId : PreloadPrimaryAssets)
+		{
+			if (AssetId.IsValid() && (AssetManager.GetPrimaryAssetObject(AssetId) == nullptr))
+			{
+				UE_LOG(LogEqZeroExperience, Warning, TEXT("EXPERIENCE: Preload primary asset %s declared by %s is not resident after load (%s)"),
+					*AssetId.ToString(), *Context->GetPrimaryAssetId().ToString(), *GetClientServerContextString(this));
+			}
+		}
+	};
+
+	VerifyList(CurrentExperience, CurrentExperience->PreloadAssets, CurrentExperience->PreloadPrimaryAssets);
+	for (const TObjectPtr<UEqZeroExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			VerifyList(ActionSet, ActionSet->PreloadAssets, ActionSet->PreloadPrimaryAssets);
+		}
+	}
+}
+
 void UEqZeroExperienceManagerComponent::OnAllActionsDeactivated()
 {
 	//@TODO: We actually only deactivated and didn't fully unload...
 	LoadState = EEqZeroExperienceLoadState::Unloaded;
 	CurrentExperience = nullptr;
+	ExperienceLoadHandle.Reset();
+
+	// 体验预加载的 Cue 不再保留
+	if (UEqZeroGameplayCueManager* GCM = UEqZeroGameplayCueManager::Get())
+	{
+		GCM->ReleasePreloadedGameplayCues();
+	}
 	//@TODO:	GEngine->ForceGarbageCollection(true);
 }
@@ -11,6 +11,7 @@
 namespace UE::GameFeatures { struct FResult; }
 
 class UEqZeroExperienceDefinition;
+struct FStreamableHandle;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnEqZeroExperienceLoaded, const UEqZeroExperienceDefinition* /*Experience*/);
 
@@ -85,6 +86,9 @@ private:
 	void OnActionDeactivationCompleted();
 	void OnAllActionsDeactivated();
 
+	// 检查体验和 ActionSet 里声明的预加载资源是否都已经在内存里了
+	void VerifyPreloadedAssets() const;
+
 private:
 	UPROPERTY(ReplicatedUsing=OnRep_CurrentExperience)
 	TObjectPtr<const UEqZeroExperienceDefinition> CurrentExperience;
@@ -97,6 +101,14 @@ private:
 	int32 NumObservedPausers = 0;
 	int32 NumExpectedPausers = 0;
 
+	// 持有体验加载的句柄，保证 PreloadAssets 这类散装资源在体验生效期间不被 GC
+	TSharedPtr<FStreamableHandle> ExperienceLoadHandle;
+
+	// 加载耗时统计
+	double LoadStartTime = 0.0;
+	double AssetsLoadedTime = 0.0;
+	int32 NumPreloadAssets = 0;
+
 	/**
 	 * Delegate called when the experience has finished loading just before others
 	 * (e.g., subsystems that set up for regular gameplay)
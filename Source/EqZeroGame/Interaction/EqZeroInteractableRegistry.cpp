@@ -0,0 +1,420 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqZeroInteractableRegistry.h"
+
+#include "CollisionQueryParams.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "IInteractableTarget.h"
+#include "InteractionStatics.h"
+#include "UObject/ScriptInterface.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroInteractableRegistry)
+
+UEqZeroInteractableRegistry::UEqZeroInteractableRegistry()
+{
+}
+
+bool UEqZeroInteractableRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEqZeroInteractableRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// 不依赖可交互物自己注册，生成/销毁/流送的 Actor 都在这里处理
+	UWorld* World = GetWorld();
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &ThisClass::HandleActorDestroyed));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::HandleLevelAddedToWorld);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::HandleLevelRemovedFromWorld);
+}
+
+void UEqZeroInteractableRegistry::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 关卡里摆放的 Actor 不会走生成回调
+	for (ULevel* Level : InWorld.GetLevels())
+	{
+		HandleLevelAddedToWorld(Level, &InWorld);
+	}
+}
+
+void UEqZeroInteractableRegistry::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	for (TPair<FObjectKey, FTrackedRootComponent>& Pair : TrackedRootComponents)
+	{
+		if (USceneComponent* RootComponent = Pair.Value.Component.Get())
+		{
+			RootComponent->TransformUpdated.Remove(Pair.Value.TransformUpdatedHandle);
+		}
+	}
+
+	TrackedRootComponents.Reset();
+	Cells.Reset();
+	EntryCells.Reset();
+	MaxEntryRadius = 0.0f;
+
+	Super::Deinitialize();
+}
+
+void UEqZeroInteractableRegistry::RegisterActorInteractables(AActor* Actor)
+{
+	UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+	if (UEqZeroInteractableRegistry* Registry = World ? World->GetSubsystem<UEqZeroInteractableRegistry>() : nullptr)
+	{
+		TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
+		UInteractionStatics::GetInteractableTargetsFromActor(Actor, InteractableTargets);
+		for (const TScriptInterface<IInteractableTarget>& InteractableTarget : InteractableTargets)
+		{
+			Registry->RegisterInteractable(InteractableTarget);
+		}
+	}
+}
+
+void UEqZeroInteractableRegistry::UnregisterActorInteractables(AActor* Actor)
+{
+	UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+	if (UEqZeroInteractableRegistry* Registry = World ? World->GetSubsystem<UEqZeroInteractableRegistry>() : nullptr)
+	{
+		TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
+		UInteractionStatics::GetInteractableTargetsFromActor(Actor, InteractableTargets);
+		for (const TScriptInterface<IInteractableTarget>& InteractableTarget : InteractableTargets)
+		{
+			Registry->UnregisterInteractable(InteractableTarget);
+		}
+	}
+}
+
+void UEqZeroInteractableRegistry::RegisterInteractable(TScriptInterface<IInteractableTarget> Target)
+{
+	const FObjectKey Key(Target.GetObject());
+	if (EntryCells.Contains(Key))
+	{
+		UpdateInteractable(Target);
+		return;
+	}
+
+	FRegistryEntry Entry;
+	if (!ComputeEntryBounds(Target, Entry))
+	{
+		return;
+	}
+
+	AddEntry(Entry);
+	TrackRootComponent(Entry.Actor.Get());
+}
+
+void UEqZeroInteractableRegistry::UnregisterInteractable(TScriptInterface<IInteractableTarget> Target)
+{
+	UObject* Object = Target.GetObject();
+	if (Object && RemoveEntry(FObjectKey(Object)))
+	{
+		UntrackRootComponent(UInteractionStatics::GetActorFromInteractableTarget(Target));
+	}
+}
+
+void UEqZeroInteractableRegistry::UpdateInteractable(TScriptInterface<IInteractableTarget> Target)
+{
+	const FObjectKey Key(Target.GetObject());
+	const FIntPoint* OldCell = EntryCells.Find(Key);
+	if (!OldCell)
+	{
+		return;
+	}
+
+	FRegistryEntry NewEntry;
+	if (!ComputeEntryBounds(Target, NewEntry))
+	{
+		return;
+	}
+
+	MaxEntryRadius = FMath::Max(MaxEntryRadius, NewEntry.Radius);
+
+	// 还在原来的格子里就原地更新，不用挪
+	const FIntPoint NewCell = GetCellForLocation(NewEntry.Location);
+	if (NewCell == *OldCell)
+	{
+		if (TArray<FRegistryEntry>* CellEntries = Cells.Find(NewCell))
+		{
+			if (FRegistryEntry* Entry = CellEntries->FindByPredicate([&Key](const FRegistryEntry& Candidate) { return Candidate.Key == Key; }))
+			{
+				*Entry = NewEntry;
+				return;
+			}
+		}
+	}
+
+	RemoveEntry(Key);
+	AddEntry(NewEntry);
+}
+
+void UEqZeroInteractableRegistry::TrackRootComponent(AActor* Actor)
+{
+	USceneComponent* RootComponent = Actor ? Actor->GetRootComponent() : nullptr;
+	if (!RootComponent)
+	{
+		return;
+	}
+
+	FTrackedRootComponent& Tracked = TrackedRootComponents.FindOrAdd(FObjectKey(Actor));
+	if (Tracked.NumEntries++ == 0 && RootComponent->Mobility == EComponentMobility::Movable)
+	{
+		// 静态的可交互物不会移动，不用监听
+		Tracked.Component = RootComponent;
+		Tracked.TransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &ThisClass::HandleRootComponentTransformUpdated);
+	}
+}
+
+void UEqZeroInteractableRegistry::UntrackRootComponent(AActor* Actor)
+{
+	const FObjectKey ActorKey(Actor);
+	FTrackedRootComponent* Tracked = TrackedRootComponents.Find(ActorKey);
+	if (!Tracked || --Tracked->NumEntries > 0)
+	{
+		return;
+	}
+
+	if (USceneComponent* RootComponent = Tracked->Component.Get())
+	{
+		RootComponent->TransformUpdated.Remove(Tracked->TransformUpdatedHandle);
+	}
+	TrackedRootComponents.Remove(ActorKey);
+}
+
+void UEqZeroInteractableRegistry::HandleRootComponentTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	AActor* Actor = UpdatedComponent ? UpdatedComponent->GetOwner() : nullptr;
+	if (!Actor)
+	{
+		return;
+	}
+
+	TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
+	UInteractionStatics::GetInteractableTargetsFromActor(Actor, InteractableTargets);
+	for (const TScriptInterface<IInteractableTarget>& InteractableTarget : InteractableTargets)
+	{
+		UpdateInteractable(InteractableTarget);
+	}
+}
+
+void UEqZeroInteractableRegistry::HandleActorSpawned(AActor* Actor)
+{
+	RegisterActorInteractables(Actor);
+}
+
+void UEqZeroInteractableRegistry::HandleActorDestroyed(AActor* Actor)
+{
+	UnregisterActorInteractables(Actor);
+}
+
+void UEqZeroInteractableRegistry::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (!Level || World != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		RegisterActorInteractables(Actor);
+	}
+}
+
+void UEqZeroInteractableRegistry::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	// Level 为空表示整个世界在清理，Deinitialize 会处理
+	if (!Level || World != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		UnregisterActorInteractables(Actor);
+	}
+}
+
+bool UEqZeroInteractableRegistry::DoesComponentPassQuery(const UPrimitiveComponent* Primitive, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params)
+{
+	if (!Primitive->IsRegistered() || !Primitive->IsQueryCollisionEnabled() || Primitive->GetCollisionResponseToChannel(TraceChannel) == ECR_Ignore)
+	{
+		return false;
+	}
+
+	if (Params.GetIgnoredComponents().Contains(Primitive->GetUniqueID()))
+	{
+		return false;
+	}
+
+	switch (Params.MobilityType)
+	{
+	case EQueryMobilityType::Static:
+		return Primitive->Mobility == EComponentMobility::Static;
+	case EQueryMobilityType::Dynamic:
+		return Primitive->Mobility != EComponentMobility::Static;
+	default:
+		return true;
+	}
+}
+
+bool UEqZeroInteractableRegistry::IsQueryCollisionEnabled(const AActor* Actor, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params)
+{
+	if (!Actor || !Actor->GetActorEnableCollision())
+	{
+		return false;
+	}
+
+	bool bPassesQuery = false;
+	Actor->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors=*/ false, [&bPassesQuery, TraceChannel, &Params](const UPrimitiveComponent* Primitive)
+	{
+		if (!bPassesQuery && DoesComponentPassQuery(Primitive, TraceChannel, Params))
+		{
+			bPassesQuery = true;
+		}
+	});
+
+	return bPassesQuery;
+}
+
+template <typename FuncType>
+void UEqZeroInteractableRegistry::ForEachEntryInRange(const FVector& Origin, float Radius, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, FuncType&& Func) const
+{
+	const float SearchRadius = Radius + MaxEntryRadius;
+	const FIntPoint MinCell = GetCellForLocation(Origin - FVector(SearchRadius));
+	const FIntPoint MaxCell = GetCellForLocation(Origin + FVector(SearchRadius));
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const TArray<FRegistryEntry>* CellEntries = Cells.Find(FIntPoint(CellX, CellY));
+			if (!CellEntries)
+			{
+				continue;
+			}
+
+			for (const FRegistryEntry& Entry : *CellEntries)
+			{
+				UObject* Object = Entry.Target.Get();
+				if (Object && FVector::DistSquared(Origin, Entry.Location) <= FMath::Square(Radius + Entry.Radius)
+					&& IsQueryCollisionEnabled(Entry.Actor.Get(), TraceChannel, Params))
+				{
+					Func(Object);
+				}
+			}
+		}
+	}
+}
+
+void UEqZeroInteractableRegistry::QueryInteractables(const FVector& Origin, float Radius, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params,
+	TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets) const
+{
+	ForEachEntryInRange(Origin, Radius, TraceChannel, Params, [&OutInteractableTargets](UObject* Object)
+	{
+		OutInteractableTargets.AddUnique(TScriptInterface<IInteractableTarget>(Object));
+	});
+}
+
+void UEqZeroInteractableRegistry::QueryInteractableDeltas(const FVector& Origin, float Radius, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params,
+	TSet<FObjectKey>& InOutTargetsInRange, TArray<TScriptInterface<IInteractableTarget>>& OutEntered, TArray<FObjectKey>& OutLeft) const
+{
+	TSet<FObjectKey> TargetsInRange;
+	TargetsInRange.Reserve(InOutTargetsInRange.Num());
+
+	ForEachEntryInRange(Origin, Radius, TraceChannel, Params, [&](UObject* Object)
+	{
+		const FObjectKey Key(Object);
+		TargetsInRange.Add(Key);
+		if (!InOutTargetsInRange.Contains(Key))
+		{
+			OutEntered.Add(TScriptInterface<IInteractableTarget>(Object));
+		}
+	});
+
+	for (const FObjectKey& Key : InOutTargetsInRange)
+	{
+		if (!TargetsInRange.Contains(Key))
+		{
+			OutLeft.Add(Key);
+		}
+	}
+
+	InOutTargetsInRange = MoveTemp(TargetsInRange);
+}
+
+FIntPoint UEqZeroInteractableRegistry::GetCellForLocation(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+bool UEqZeroInteractableRegistry::ComputeEntryBounds(TScriptInterface<IInteractableTarget> Target, FRegistryEntry& OutEntry) const
+{
+	AActor* Actor = UInteractionStatics::GetActorFromInteractableTarget(Target);
+	if (!Actor)
+	{
+		return false;
+	}
+
+	// 原来的球形检测是和可交互物的碰撞体重叠，这里用碰撞体的包围球来近似
+	FVector BoundsOrigin;
+	FVector BoundsExtent;
+	Actor->GetActorBounds(/*bOnlyCollidingComponents=*/ true, BoundsOrigin, BoundsExtent);
+
+	OutEntry.Key = FObjectKey(Target.GetObject());
+	OutEntry.Target = Target.GetObject();
+	OutEntry.Actor = Actor;
+	OutEntry.Location = BoundsExtent.IsNearlyZero() ? Actor->GetActorLocation() : BoundsOrigin;
+	OutEntry.Radius = BoundsExtent.Size();
+	return true;
+}
+
+void UEqZeroInteractableRegistry::AddEntry(const FRegistryEntry& Entry)
+{
+	const FIntPoint Cell = GetCellForLocation(Entry.Location);
+	MaxEntryRadius = FMath::Max(MaxEntryRadius, Entry.Radius);
+	Cells.FindOrAdd(Cell).Add(Entry);
+	EntryCells.Add(Entry.Key, Cell);
+}
+
+bool UEqZeroInteractableRegistry::RemoveEntry(const FObjectKey& Key)
+{
+	FIntPoint Cell;
+	if (!EntryCells.RemoveAndCopyValue(Key, Cell))
+	{
+		return false;
+	}
+
+	if (TArray<FRegistryEntry>* CellEntries = Cells.Find(Cell))
+	{
+		const int32 EntryIndex = CellEntries->IndexOfByPredicate([&Key](const FRegistryEntry& Entry)
+		{
+			return Entry.Key == Key;
+		});
+
+		if (EntryIndex != INDEX_NONE)
+		{
+			CellEntries->RemoveAtSwap(EntryIndex);
+		}
+
+		if (CellEntries->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+
+	return true;
+}
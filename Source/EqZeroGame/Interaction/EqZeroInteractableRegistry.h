@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "EqZeroInteractableRegistry.generated.h"
+
+template <typename InterfaceType> class TScriptInterface;
+
+class AActor;
+class IInteractableTarget;
+class ULevel;
+class UObject;
+class UPrimitiveComponent;
+class USceneComponent;
+struct FCollisionQueryParams;
+enum class EUpdateTransformFlags : int32;
+enum class ETeleportType : uint8;
+
+/**
+ * 场景里所有可交互物的空间索引
+ * 世界开始游戏、Actor 生成/销毁、关卡流送加入/移除时，自动把 Actor 自身和它身上实现了 IInteractableTarget 的组件
+ * 注册/反注册到一个 XY 平面的网格中，运行时才添加的可交互组件需要手动调用 RegisterActorInteractables。
+ * 扫描的 Pawn 不再每次做球形碰撞检测，而是只查附近的格子，拿到进入/离开范围的差量。
+ * 可移动的可交互物会监听根组件的 TransformUpdated（移动和附加都会触发），自动更新所在的格子；
+ * 查询时和原来的重叠检测一样，按传入的通道和 FCollisionQueryParams 过滤。
+ */
+UCLASS()
+class EQZEROGAME_API UEqZeroInteractableRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UEqZeroInteractableRegistry();
+
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~End of UWorldSubsystem interface
+
+	/** 注册 Actor 自身以及它身上实现了 IInteractableTarget 的组件 */
+	static void RegisterActorInteractables(AActor* Actor);
+
+	/** 反注册 Actor 自身以及它身上实现了 IInteractableTarget 的组件 */
+	static void UnregisterActorInteractables(AActor* Actor);
+
+	void RegisterInteractable(TScriptInterface<IInteractableTarget> Target);
+	void UnregisterInteractable(TScriptInterface<IInteractableTarget> Target);
+
+	/** 可交互物移动后调用，重新计算它所在的格子，可移动的根组件会自动调用 */
+	void UpdateInteractable(TScriptInterface<IInteractableTarget> Target);
+
+	/**
+	 * 收集 Origin 半径 Radius 范围内的可交互物（考虑可交互物自身的包围球）
+	 * 和 OverlapMultiByChannel 一样，Actor 上至少要有一个碰撞组件响应 TraceChannel，并且没有被 Params 忽略
+	 */
+	void QueryInteractables(const FVector& Origin, float Radius, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params,
+		TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets) const;
+
+	/**
+	 * 和上一次的结果 InOutTargetsInRange 对比，只输出进入和离开范围的可交互物
+	 * InOutTargetsInRange 会被更新为这一次的结果
+	 */
+	void QueryInteractableDeltas(const FVector& Origin, float Radius, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params,
+		TSet<FObjectKey>& InOutTargetsInRange, TArray<TScriptInterface<IInteractableTarget>>& OutEntered, TArray<FObjectKey>& OutLeft) const;
+
+	int32 GetNumRegisteredInteractables() const { return EntryCells.Num(); }
+
+private:
+	struct FRegistryEntry
+	{
+		FObjectKey Key;
+		TWeakObjectPtr<UObject> Target;
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location = FVector::ZeroVector;
+		float Radius = 0.0f;
+	};
+
+	// 监听中的可移动根组件，同一个 Actor 上的多个可交互物共用一个
+	struct FTrackedRootComponent
+	{
+		TWeakObjectPtr<USceneComponent> Component;
+		FDelegateHandle TransformUpdatedHandle;
+		int32 NumEntries = 0;
+	};
+
+	FIntPoint GetCellForLocation(const FVector& Location) const;
+	bool ComputeEntryBounds(TScriptInterface<IInteractableTarget> Target, FRegistryEntry& OutEntry) const;
+	void AddEntry(const FRegistryEntry& Entry);
+	bool RemoveEntry(const FObjectKey& Key);
+
+	void TrackRootComponent(AActor* Actor);
+	void UntrackRootComponent(AActor* Actor);
+	void HandleRootComponentTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	void HandleActorSpawned(AActor* Actor);
+	void HandleActorDestroyed(AActor* Actor);
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
+	/** 和重叠检测一致：碰撞开启，并且有组件不忽略 TraceChannel、没有被 Params 忽略 */
+	static bool IsQueryCollisionEnabled(const AActor* Actor, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params);
+	static bool DoesComponentPassQuery(const UPrimitiveComponent* Primitive, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params);
+
+	template <typename FuncType>
+	void ForEachEntryInRange(const FVector& Origin, float Radius, ECollisionChannel TraceChannel, const FCollisionQueryParams& Params, FuncType&& Func) const;
+
+private:
+	// 格子的边长，太小的话查询要遍历很多格子，太大的话每个格子里的可交互物太多
+	float CellSize = 1000.0f;
+
+	// 已注册的可交互物中最大的包围球半径，查询时需要把范围扩大这么多
+	float MaxEntryRadius = 0.0f;
+
+	TMap<FIntPoint, TArray<FRegistryEntry>> Cells;
+	TMap<FObjectKey, FIntPoint> EntryCells;
+
+	TMap<FObjectKey, FTrackedRootComponent> TrackedRootComponents;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
@@ -17,7 +17,7 @@ struct FOverlapResult;
 
 /**  */
 UCLASS()
-class UInteractionStatics : public UBlueprintFunctionLibrary
+class EQZEROGAME_API UInteractionStatics : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
@@ -10,6 +10,7 @@
 #include "Interaction/InteractionOption.h"
 #include "Interaction/InteractionQuery.h"
 #include "Interaction/InteractionStatics.h"
+#include "Interaction/EqZeroInteractableRegistry.h"
 #include "Physics/EqZeroCollisionChannels.h"
 #include "TimerManager.h"
 #include "DrawDebugHelpers.h"
@@ -24,6 +25,14 @@ FAutoConsoleVariableRef CVarDebugInteractionScan(
 	ECVF_Default
 );
 
+static int32 UseInteractableRegistry = 0;
+FAutoConsoleVariableRef CVarUseInteractableRegistry(
+	TEXT("EqZero.Interaction.UseRegistry"),
+	UseInteractableRegistry,
+	TEXT("Use the interactable spatial registry instead of a sphere overlap query when scanning for nearby interactables. The registry tracks actors present at world begin play, spawned, or streamed in; interactable components added to an actor later must be registered with UEqZeroInteractableRegistry::RegisterActorInteractables."),
+	ECVF_Default
+);
+
 UAbilityTask_GrantNearbyInteraction::UAbilityTask_GrantNearbyInteraction(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -71,46 +80,123 @@ void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
 		}
 #endif
 
-		// 球形碰撞检测
-		TArray<FOverlapResult> OverlapResults;
-		World->OverlapMultiByChannel(OUT OverlapResults, ActorOwner->GetActorLocation(),
-			FQuat::Identity, EqZero_TraceChannel_Interaction, FCollisionShape::MakeSphere(InteractionScanRange), Params);
+		TArray<TScriptInterface<IInteractableTarget>> EnteredTargets;
+		TArray<FObjectKey> LeftTargets;
 
-		if (OverlapResults.Num() > 0)
+		UEqZeroInteractableRegistry* Registry = UseInteractableRegistry ? World->GetSubsystem<UEqZeroInteractableRegistry>() : nullptr;
+		if (Registry)
 		{
+			// 从空间索引里只拿进入/离开范围的差量
+			Registry->QueryInteractableDeltas(ActorOwner->GetActorLocation(), InteractionScanRange, EqZero_TraceChannel_Interaction, Params, TargetsInRange, OUT EnteredTargets, OUT LeftTargets);
+		}
+		else
+		{
+			// 球形碰撞检测
+			TArray<FOverlapResult> OverlapResults;
+			World->OverlapMultiByChannel(OUT OverlapResults, ActorOwner->GetActorLocation(),
+				FQuat::Identity, EqZero_TraceChannel_Interaction, FCollisionShape::MakeSphere(InteractionScanRange), Params);
+
 			// 从重叠结果中获取所有的可交互目标
 			TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
 			UInteractionStatics::AppendInteractableTargetsFromOverlapResults(OverlapResults, OUT InteractableTargets);
-			
-			FInteractionQuery InteractionQuery;
-			InteractionQuery.RequestingAvatar = ActorOwner;
-			InteractionQuery.RequestingController = Cast<AController>(ActorOwner->GetOwner());
-
-			// 遍历可交互的目标
-			TArray<FInteractionOption> Options;
-			for (TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
+
+			TSet<FObjectKey> NewTargetsInRange;
+			for (const TScriptInterface<IInteractableTarget>& InteractableTarget : InteractableTargets)
 			{
-				// InteractiveTarget 就是场景中实现了可交互接口的 Actor，从中收集 Options
-				FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, Options);
-				InteractiveTarget->GatherInteractionOptions(InteractionQuery, InteractionBuilder);
+				const FObjectKey TargetKey(InteractableTarget.GetObject());
+				NewTargetsInRange.Add(TargetKey);
+				if (!TargetsInRange.Contains(TargetKey))
+				{
+					EnteredTargets.Add(InteractableTarget);
+				}
 			}
 
-			// 根据收集的Options检查是否有交互限制
-			for (FInteractionOption& Option : Options)
+			for (const FObjectKey& TargetKey : TargetsInRange)
 			{
-				if (Option.InteractionAbilityToGrant)
+				if (!NewTargetsInRange.Contains(TargetKey))
 				{
-					// 赋予玩家这个对应的交互技能
-					FObjectKey ObjectKey(Option.InteractionAbilityToGrant);
-					if (!InteractionAbilityCache.Find(ObjectKey))
-					{
-						FGameplayAbilitySpec Spec(Option.InteractionAbilityToGrant, 1, INDEX_NONE, this);
-						FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
-						InteractionAbilityCache.Add(ObjectKey, Handle);
-					}
+					LeftTargets.Add(TargetKey);
 				}
 			}
+
+			TargetsInRange = MoveTemp(NewTargetsInRange);
 		}
+
+		RemoveAbilitiesForTargets(LeftTargets);
+		GrantAbilitiesForTargets(ActorOwner, EnteredTargets);
 	}
 }
 
+void UAbilityTask_GrantNearbyInteraction::GrantAbilitiesForTargets(AActor* ActorOwner, const TArray<TScriptInterface<IInteractableTarget>>& EnteredTargets)
+{
+	if (EnteredTargets.Num() == 0)
+	{
+		return;
+	}
+
+	FInteractionQuery InteractionQuery;
+	InteractionQuery.RequestingAvatar = ActorOwner;
+	InteractionQuery.RequestingController = Cast<AController>(ActorOwner->GetOwner());
+
+	// 遍历新进入范围的可交互目标
+	TArray<FInteractionOption> Options;
+	for (const TScriptInterface<IInteractableTarget>& InteractiveTarget : EnteredTargets)
+	{
+		// InteractiveTarget 就是场景中实现了可交互接口的 Actor，从中收集 Options
+		Options.Reset();
+		FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, Options);
+		InteractiveTarget->GatherInteractionOptions(InteractionQuery, InteractionBuilder);
+
+		TArray<FObjectKey>& GrantedAbilities = AbilitiesGrantedByTarget.FindOrAdd(FObjectKey(InteractiveTarget.GetObject()));
+
+		// 根据收集的Options检查是否有交互限制
+		for (FInteractionOption& Option : Options)
+		{
+			if (Option.InteractionAbilityToGrant)
+			{
+				// 赋予玩家这个对应的交互技能
+				FObjectKey ObjectKey(Option.InteractionAbilityToGrant);
+				if (GrantedAbilities.Contains(ObjectKey))
+				{
+					continue;
+				}
+
+				FGrantedInteractionAbility& GrantedAbility = InteractionAbilityCache.FindOrAdd(ObjectKey);
+				if (!GrantedAbility.Handle.IsValid())
+				{
+					FGameplayAbilitySpec Spec(Option.InteractionAbilityToGrant, 1, INDEX_NONE, this);
+					GrantedAbility.Handle = AbilitySystemComponent->GiveAbility(Spec);
+				}
+
+				++GrantedAbility.RefCount;
+				GrantedAbilities.Add(ObjectKey);
+			}
+		}
+	}
+}
+
+void UAbilityTask_GrantNearbyInteraction::RemoveAbilitiesForTargets(const TArray<FObjectKey>& LeftTargets)
+{
+	for (const FObjectKey& TargetKey : LeftTargets)
+	{
+		TArray<FObjectKey> GrantedAbilities;
+		if (!AbilitiesGrantedByTarget.RemoveAndCopyValue(TargetKey, GrantedAbilities))
+		{
+			continue;
+		}
+
+		for (const FObjectKey& AbilityKey : GrantedAbilities)
+		{
+			FGrantedInteractionAbility* GrantedAbility = InteractionAbilityCache.Find(AbilityKey);
+			if (GrantedAbility && --GrantedAbility->RefCount <= 0)
+			{
+				// 正在交互中的技能等结束后再移除
+				if (AbilitySystemComponent.IsValid())
+				{
+					AbilitySystemComponent->SetRemoveAbilityOnEnd(GrantedAbility->Handle);
+				}
+				InteractionAbilityCache.Remove(AbilityKey);
+			}
+		}
+	}
+}
@@ -2,14 +2,18 @@
 #pragma once
 
 #include "Abilities/Tasks/AbilityTask.h"
+#include "GameplayAbilitySpecHandle.h"
+#include "UObject/ObjectKey.h"
 
 #include "AbilityTask_GrantNearbyInteraction.generated.h"
 
+template <typename InterfaceType> class TScriptInterface;
+
+class AActor;
+class IInteractableTarget;
 class UGameplayAbility;
 class UObject;
 struct FFrame;
-struct FGameplayAbilitySpecHandle;
-struct FObjectKey;
 
 UCLASS()
 class UAbilityTask_GrantNearbyInteraction : public UAbilityTask
@@ -27,10 +31,28 @@ private:
 
 	void QueryInteractables();
 
+	// 只处理进入/离开扫描范围的可交互物，增量的赋予/移除交互技能
+	void GrantAbilitiesForTargets(AActor* ActorOwner, const TArray<TScriptInterface<IInteractableTarget>>& EnteredTargets);
+	void RemoveAbilitiesForTargets(const TArray<FObjectKey>& LeftTargets);
+
 	float InteractionScanRange = 100;
 	float InteractionScanRate = 0.100;
 
 	FTimerHandle QueryTimerHandle;
 
-	TMap<FObjectKey, FGameplayAbilitySpecHandle> InteractionAbilityCache;
+	struct FGrantedInteractionAbility
+	{
+		FGameplayAbilitySpecHandle Handle;
+
+		// 范围内有多少个可交互物需要这个技能，减到0就移除
+		int32 RefCount = 0;
+	};
+
+	TMap<FObjectKey, FGrantedInteractionAbility> InteractionAbilityCache;
+
+	// 当前在扫描范围内的可交互物
+	TSet<FObjectKey> TargetsInRange;
+
+	// 每个可交互物贡献了哪些交互技能，离开范围的时候用来减引用
+	TMap<FObjectKey, TArray<FObjectKey>> AbilitiesGrantedByTarget;
 };
@@ -6,6 +6,8 @@
 
 #include "EqZeroInventoryItemDefinition.generated.h"
 
+#define UE_API EQZEROGAME_API
+
 template <typename T> class TSubclassOf;
 
 class UEqZeroInventoryItemInstance;
@@ -28,13 +30,13 @@ public:
 /**
  * UEqZeroInventoryItemDefinition
  */
-UCLASS(Blueprintable, Const, Abstract)
+UCLASS(MinimalAPI, Blueprintable, Const, Abstract)
 class UEqZeroInventoryItemDefinition : public UObject
 {
 	GENERATED_BODY()
 
 public:
-	UEqZeroInventoryItemDefinition(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+	UE_API UEqZeroInventoryItemDefinition(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Display)
 	FText DisplayName;
@@ -54,3 +56,5 @@ class UEqZeroInventoryFunctionLibrary : public UBlueprintFunctionLibrary
 	UFUNCTION(BlueprintCallable, meta=(DeterminesOutputType=FragmentClass))
 	static const UEqZeroInventoryItemFragment* FindItemDefinitionFragment(TSubclassOf<UEqZeroInventoryItemDefinition> ItemDef, TSubclassOf<UEqZeroInventoryItemFragment> FragmentClass);
 };
+
+#undef UE_API
@@ -10,7 +10,7 @@
 class UEqZeroEquipmentDefinition;
 class UObject;
 
-UCLASS()
+UCLASS(MinimalAPI)
 class UInventoryFragment_EquippableItem : public UEqZeroInventoryItemFragment
 {
 	GENERATED_BODY()
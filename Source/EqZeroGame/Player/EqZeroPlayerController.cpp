@@ -8,6 +8,7 @@
 #include "EqZeroCheatManager.h"
 #include "EqZeroPlayerState.h"
 #include "Camera/EqZeroPlayerCameraManager.h"
+#include "Cosmetics/EqZeroPawnComponent_CharacterParts.h"
 #include "UI/EqZeroHUD.h"
 #include "AbilitySystem/EqZeroAbilitySystemComponent.h"
 #include "EngineUtils.h"
@@ -431,19 +432,34 @@ void AEqZeroPlayerController::UpdateHiddenComponents(const FVector& ViewLocation
 	ViewTargetPawn->GetComponents(PawnComponents);
 	AddToHiddenComponents(PawnComponents);
 
-	// 隐藏子Actor上的组件（如ChildActorComponent生成的B_Manny、B_Rifle等）
+	// 隐藏子Actor上的组件（如ChildActorComponent生成的B_Rifle等）
+	TArray<AActor*, TInlineAllocator<8>> ChildActors;
 	TInlineComponentArray<UChildActorComponent*> ChildActorComponents;
 	ViewTargetPawn->GetComponents(ChildActorComponents);
 	for (UChildActorComponent* CAC : ChildActorComponents)
 	{
 		if (AActor* ChildActor = CAC->GetChildActor())
 		{
-			TInlineComponentArray<UPrimitiveComponent*> ChildPrimitives;
-			ChildActor->GetComponents(ChildPrimitives);
-			AddToHiddenComponents(ChildPrimitives);
+			ChildActors.AddUnique(ChildActor);
 		}
 	}
 
+	// 装扮部件（如B_Manny）可能是从 Actor 池取的，不一定挂在 ChildActorComponent 上
+	if (const UEqZeroPawnComponent_CharacterParts* CharacterParts = ViewTargetPawn->FindComponentByClass<UEqZeroPawnComponent_CharacterParts>())
+	{
+		for (AActor* PartActor : CharacterParts->GetCharacterPartActors())
+		{
+			ChildActors.AddUnique(PartActor);
+		}
+	}
+
+	for (AActor* ChildActor : ChildActors)
+	{
+		TInlineComponentArray<UPrimitiveComponent*> ChildPrimitives;
+		ChildActor->GetComponents(ChildPrimitives);
+		AddToHiddenComponents(ChildPrimitives);
+	}
+
 	bHideViewTargetPawnNextFrame = false;
 
 }
@@ -0,0 +1,196 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "System/EqZeroActorPoolSubsystem.h"
+
+#include "Components/ActorComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EqZeroLogChannels.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroActorPoolSubsystem)
+
+namespace EqZeroActorPool
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("EqZero.ActorPool.Enabled"),
+		bEnabled,
+		TEXT("Reuse pooled actors (character parts, equipment) instead of spawning and destroying them."),
+		ECVF_Default);
+
+	static int32 MaxPooledActorsPerClass = 16;
+	static FAutoConsoleVariableRef CVarMaxPooledActorsPerClass(
+		TEXT("EqZero.ActorPool.MaxPerClass"),
+		MaxPooledActorsPerClass,
+		TEXT("Maximum number of parked actors kept per class in each world, extra released actors are destroyed."),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdActorPoolStats(
+		TEXT("EqZero.ActorPool.Stats"),
+		TEXT("Dump the spawn/reuse counters and parked actors of the actor pool in the current world."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+			{
+				if (UEqZeroActorPoolSubsystem* Pool = UEqZeroActorPoolSubsystem::Get(InWorld))
+				{
+					UE_LOG(LogEqZero, Display, TEXT("Actor pool: spawned %llu, reused %llu, released %llu, destroyed %llu, parked %d"),
+						Pool->GetNumSpawned(), Pool->GetNumReused(), Pool->GetNumReleased(), Pool->GetNumDestroyed(), Pool->GetNumPooledActors());
+				}
+			}));
+}
+
+UEqZeroActorPoolSubsystem::UEqZeroActorPoolSubsystem()
+{
+}
+
+UEqZeroActorPoolSubsystem* UEqZeroActorPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UEqZeroActorPoolSubsystem>() : nullptr;
+}
+
+bool UEqZeroActorPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEqZeroActorPoolSubsystem::Deinitialize()
+{
+	EmptyPool();
+
+	Super::Deinitialize();
+}
+
+AActor* UEqZeroActorPoolSubsystem::AcquireActor(TSubclassOf<AActor> ActorClass, AActor* Owner, APawn* Instigator)
+{
+	UWorld* World = GetWorld();
+	if (ActorClass == nullptr || World == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (EqZeroActorPool::bEnabled)
+	{
+		if (FEqZeroActorPoolList* List = PooledActors.Find(ActorClass))
+		{
+			while (List->Actors.Num() > 0)
+			{
+				AActor* Actor = List->Actors.Pop(EAllowShrinking::No);
+
+				// 关卡卸载之类的情况下池里的 Actor 可能已经被销毁了
+				if (IsValid(Actor))
+				{
+					UnparkActor(Actor, Owner, Instigator);
+					++NumReused;
+					return Actor;
+				}
+			}
+		}
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = Owner;
+	SpawnParams.Instigator = Instigator;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* Actor = World->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParams);
+	if (Actor)
+	{
+		++NumSpawned;
+	}
+	return Actor;
+}
+
+void UEqZeroActorPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	++NumReleased;
+
+	UWorld* World = GetWorld();
+	const bool bCanPool = EqZeroActorPool::bEnabled && (World != nullptr) && !World->bIsTearingDown && (Actor->GetWorld() == World);
+	FEqZeroActorPoolList& List = PooledActors.FindOrAdd(Actor->GetClass());
+	if (!bCanPool || List.Actors.Num() >= EqZeroActorPool::MaxPooledActorsPerClass)
+	{
+		Actor->Destroy();
+		++NumDestroyed;
+		return;
+	}
+
+	ParkActor(Actor);
+	List.Actors.Add(Actor);
+}
+
+void UEqZeroActorPoolSubsystem::EmptyPool()
+{
+	for (TPair<TObjectPtr<UClass>, FEqZeroActorPoolList>& Pair : PooledActors)
+	{
+		for (AActor* Actor : Pair.Value.Actors)
+		{
+			if (IsValid(Actor))
+			{
+				Actor->Destroy();
+				++NumDestroyed;
+			}
+		}
+	}
+	PooledActors.Reset();
+}
+
+int32 UEqZeroActorPoolSubsystem::GetNumPooledActors() const
+{
+	int32 Result = 0;
+	for (const TPair<TObjectPtr<UClass>, FEqZeroActorPoolList>& Pair : PooledActors)
+	{
+		Result += Pair.Value.Actors.Num();
+	}
+	return Result;
+}
+
+void UEqZeroActorPoolSubsystem::ParkActor(AActor* Actor)
+{
+	Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	Actor->ForEachComponent(false, [](UActorComponent* Component)
+		{
+			Component->SetComponentTickEnabled(false);
+		});
+	Actor->SetOwner(nullptr);
+	Actor->SetInstigator(nullptr);
+
+	// 复制的 Actor（比如装备）停在池里时不需要再同步，最后一次更新把隐藏状态发出去之后就休眠
+	if (Actor->GetIsReplicated() && Actor->HasAuthority())
+	{
+		Actor->SetNetDormancy(DORM_DormantAll);
+	}
+}
+
+void UEqZeroActorPoolSubsystem::UnparkActor(AActor* Actor, AActor* Owner, APawn* Instigator)
+{
+	// 恢复成刚生成时的状态
+	const AActor* ActorCDO = Actor->GetClass()->GetDefaultObject<AActor>();
+
+	if (Actor->GetIsReplicated() && Actor->HasAuthority())
+	{
+		Actor->SetNetDormancy(ActorCDO->NetDormancy);
+		Actor->FlushNetDormancy();
+	}
+
+	Actor->SetOwner(Owner);
+	Actor->SetInstigator(Instigator);
+	Actor->SetActorHiddenInGame(ActorCDO->IsHidden());
+	Actor->SetActorEnableCollision(ActorCDO->GetActorEnableCollision());
+	Actor->SetActorTickEnabled(ActorCDO->PrimaryActorTick.bStartWithTickEnabled);
+	Actor->ForEachComponent(false, [](UActorComponent* Component)
+		{
+			Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+		});
+	Actor->SetActorTransform(FTransform::Identity, false, nullptr, ETeleportType::ResetPhysics);
+}
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+
+#include "EqZeroActorPoolSubsystem.generated.h"
+
+class AActor;
+class APawn;
+class UObject;
+
+USTRUCT()
+struct FEqZeroActorPoolList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> Actors;
+};
+
+/**
+ * 按类缓存的 Actor 池，每个世界一个
+ * 装扮部件、装备这类 Actor 换装、重生、切枪时会反复生成销毁，回收时只是分离、隐藏、关闭碰撞和 Tick（复制的 Actor 还会休眠），下次取同类时直接复用
+ */
+UCLASS()
+class EQZEROGAME_API UEqZeroActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UEqZeroActorPoolSubsystem();
+
+	static UEqZeroActorPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	//~UWorldSubsystem interface
+	virtual void Deinitialize() override;
+	//~End of UWorldSubsystem interface
+
+	/**
+	 * 取一个 ActorClass 的 Actor，池里没有就在原点生成一个
+	 * 复用的 Actor 会恢复成类默认的显示、碰撞和 Tick 状态，调用方负责附加
+	 */
+	AActor* AcquireActor(TSubclassOf<AActor> ActorClass, AActor* Owner, APawn* Instigator);
+
+	/** 回收 Actor，池满了或者世界正在销毁时直接销毁 */
+	void ReleaseActor(AActor* Actor);
+
+	/** 销毁池里所有的 Actor */
+	void EmptyPool();
+
+	int32 GetNumPooledActors() const;
+
+	uint64 GetNumSpawned() const { return NumSpawned; }
+	uint64 GetNumReused() const { return NumReused; }
+	uint64 GetNumReleased() const { return NumReleased; }
+	uint64 GetNumDestroyed() const { return NumDestroyed; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void ParkActor(AActor* Actor);
+	void UnparkActor(AActor* Actor, AActor* Owner, APawn* Instigator);
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FEqZeroActorPoolList> PooledActors;
+
+	uint64 NumSpawned = 0;
+	uint64 NumReused = 0;
+	uint64 NumReleased = 0;
+	uint64 NumDestroyed = 0;
+};
@@ -5,12 +5,15 @@
 #include "EqZeroGameplayTags.h"
 #include "EqZeroGameData.h"
 #include "AbilitySystemGlobals.h"
+#include "AbilitySystem/EqZeroGameplayCueManager.h"
 #include "Character/EqZeroPawnData.h"
 #include "Misc/App.h"
 #include "Stats/StatsMisc.h"
 #include "Engine/Engine.h"
 #include "Misc/ScopedSlowTask.h"
 #include "EqZeroAssetManagerStartupJob.h"
+#include "Algo/AllOf.h"
+#include "Containers/Ticker.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroAssetManager)
 
@@ -26,9 +29,22 @@ static FAutoConsoleCommand CVarDumpLoadedAssets(
 
 //////////////////////////////////////////////////////////////////////
 
-#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FEqZeroAssetManagerStartupJob(#JobFunc, [this](const FEqZeroAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
+#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add_GetRef(FEqZeroAssetManagerStartupJob(#JobFunc, [this](const FEqZeroAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
 
+// 声明在另一个任务完成之后才开始，DependencyJobFunc 要和那个任务的写法完全一致，对不上会在 DoAllStartupJobs 里断言
+#define STARTUP_JOB_WEIGHTED_AFTER(JobFunc, JobWeight, DependencyJobFunc) STARTUP_JOB_WEIGHTED(JobFunc, JobWeight).Dependencies.Add(TEXT(#DependencyJobFunc))
+
+namespace EqZeroAssetManagerCVars
+{
+	static bool bAsyncStartupJobs = true;
+	static FAutoConsoleVariableRef CVarAsyncStartupJobs(
+		TEXT("EqZero.AssetManager.AsyncStartupJobs"),
+		bAsyncStartupJobs,
+		TEXT("Run independent startup jobs concurrently without blocking on their async loads. When disabled, jobs run serially and wait for each load."),
+		ECVF_Default);
+}
+
 //////////////////////////////////////////////////////////////////////
 
 UEqZeroAssetManager::UEqZeroAssetManager()
@@ -109,15 +125,16 @@ void UEqZeroAssetManager::StartInitialLoading()
 	// This does all of the scanning, need to do this now even if loads are deferred
 	Super::StartInitialLoading();
 
-    // TODO cwl 目前先不预加载
-
-	// STARTUP_JOB(InitializeGameplayCueManager());
+	STARTUP_JOB(InitializeGameplayCueManager());
 
 	{
 		// Load base game data asset
-		STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+		STARTUP_JOB_WEIGHTED_AFTER(StartLoadGameData(StartupJob, LoadHandle), 25.f, InitializeGameplayCueManager());
 	}
 
+	// 默认 PawnData 不依赖其他任务，和 GameData 同时加载
+	STARTUP_JOB_WEIGHTED(StartLoadDefaultPawnData(StartupJob, LoadHandle), 5.f);
+
 	// Run all the queued up startup jobs
 	DoAllStartupJobs();
 }
@@ -126,15 +143,58 @@ void UEqZeroAssetManager::InitializeGameplayCueManager()
 {
 	SCOPED_BOOT_TIMING("UEqZeroAssetManager::InitializeGameplayCueManager");
 
-	// TODO: Initialize custom GameplayCueManager if needed
-	// For now, we'll use the default GAS GameplayCueManager
-    // 这里有个提取加载需要加载的 Cues 的机会，现在还没写 Cue Manager
-	UAbilitySystemGlobals::Get().GetGameplayCueManager();
+	// 提前创建 Cue Manager，Cue 的预加载在体验加载完成后由 UEqZeroExperienceManagerComponent 发起
+	UEqZeroGameplayCueManager* GCM = UEqZeroGameplayCueManager::Get();
+	check(GCM);
 }
 
 
+void UEqZeroAssetManager::StartLoadGameData(const FEqZeroAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& OutLoadHandle)
+{
+	OutLoadHandle = StartLoadGameDataOfClass(UEqZeroGameData::StaticClass(), EqZeroGameDataPath, UEqZeroGameData::StaticClass()->GetFName(), StartupJob.LoadCompletedDelegate);
+}
+
+void UEqZeroAssetManager::StartLoadDefaultPawnData(const FEqZeroAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& OutLoadHandle)
+{
+	if (DefaultPawnData.IsNull())
+	{
+		return;
+	}
+
+	// 游戏模式第一次取默认 PawnData 时就不用同步加载了
+	// 任务结束后句柄会释放，靠 LoadedAssets 保持引用
+	FSimpleDelegate OnLoadCompleted = StartupJob.LoadCompletedDelegate;
+	FStreamableDelegate OnPawnDataLoaded = FStreamableDelegate::CreateWeakLambda(this, [this, OnLoadCompleted]()
+		{
+			if (const UEqZeroPawnData* LoadedPawnData = DefaultPawnData.Get())
+			{
+				AddLoadedAsset(LoadedPawnData);
+			}
+			OnLoadCompleted.ExecuteIfBound();
+		});
+
+	OutLoadHandle = GetStreamableManager().RequestAsyncLoad(DefaultPawnData.ToSoftObjectPath(), OnPawnDataLoaded, FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("StartLoadDefaultPawnData"));
+	if (!OutLoadHandle.IsValid())
+	{
+		return;
+	}
+
+	// 已经在内存里的话句柄直接完成，任务会马上结束并释放句柄，这里先把引用加上
+	if (OutLoadHandle->HasLoadCompleted())
+	{
+		OnPawnDataLoaded.ExecuteIfBound();
+		return;
+	}
+
+	OutLoadHandle->BindCancelDelegate(OnPawnDataLoaded);
+}
+
 const UEqZeroGameData& UEqZeroAssetManager::GetGameData()
 {
+	// 走到这里说明调用方没等 CallOrRegister_OnStartupJobsComplete，下面会阻塞等 GameData 加载完
+	UE_CLOG(!bStartupJobsComplete && !GIsEditor && !GameDataMap.Contains(UEqZeroGameData::StaticClass()), LogEqZero, Warning,
+		TEXT("GameData requested before startup jobs completed, blocking on its load"));
+
 	return GetOrLoadTypedGameData<UEqZeroGameData>(EqZeroGameDataPath);
 }
 
@@ -192,59 +252,262 @@ UPrimaryDataAsset* UEqZeroAssetManager::LoadGameDataOfClass(TSubclassOf<UPrimary
 }
 
 
+TSharedPtr<FStreamableHandle> UEqZeroAssetManager::StartLoadGameDataOfClass(TSubclassOf<UPrimaryDataAsset> DataClass, const TSoftObjectPtr<UPrimaryDataAsset>& DataClassPath, FPrimaryAssetType PrimaryAssetType, FSimpleDelegate OnLoadCompleted)
+{
+	if (GameDataMap.Contains(DataClass))
+	{
+		return nullptr;
+	}
+
+	// 编辑器里会从 PostLoad 递归进来，保持同步加载
+	if (GIsEditor || DataClassPath.IsNull() || !EqZeroAssetManagerCVars::bAsyncStartupJobs)
+	{
+		LoadGameDataOfClass(DataClass, DataClassPath, PrimaryAssetType);
+		return nullptr;
+	}
+
+	UE_LOG(LogEqZero, Log, TEXT("Loading GameData asynchronously: %s ..."), *DataClassPath.ToString());
+
+	TSharedPtr<FStreamableHandle> Handle = LoadPrimaryAssetsWithType(PrimaryAssetType);
+	if (!Handle.IsValid())
+	{
+		LoadGameDataOfClass(DataClass, DataClassPath, PrimaryAssetType);
+		return nullptr;
+	}
+
+	// 完成时写入 GameDataMap；体验加载会等启动任务完成，如果还有人提前要用，GetGameData 会报警告并阻塞等到加载完
+	TWeakPtr<FStreamableHandle> WeakHandle = Handle;
+	FStreamableDelegate OnGameDataLoaded = FStreamableDelegate::CreateWeakLambda(this, [this, WeakHandle, DataClass, DataClassPath, PrimaryAssetType, OnLoadCompleted]()
+		{
+			if (!GameDataMap.Contains(DataClass))
+			{
+				TSharedPtr<FStreamableHandle> LoadedHandle = WeakHandle.Pin();
+				if (UPrimaryDataAsset* Asset = LoadedHandle.IsValid() ? Cast<UPrimaryDataAsset>(LoadedHandle->GetLoadedAsset()) : nullptr)
+				{
+					GameDataMap.Add(DataClass, Asset);
+					UE_LOG(LogEqZero, Log, TEXT("    ... GameData loaded: %s"), *DataClassPath.ToString());
+				}
+				else
+				{
+					// 走一次同步加载，失败的话那边会报 Fatal
+					LoadGameDataOfClass(DataClass, DataClassPath, PrimaryAssetType);
+				}
+			}
+
+			OnLoadCompleted.ExecuteIfBound();
+		});
+
+	if (Handle->HasLoadCompleted())
+	{
+		OnGameDataLoaded.ExecuteIfBound();
+		return nullptr;
+	}
+
+	Handle->BindCompleteDelegate(OnGameDataLoaded);
+	Handle->BindCancelDelegate(OnGameDataLoaded);
+	return Handle;
+}
+
 void UEqZeroAssetManager::DoAllStartupJobs()
 {
 	SCOPED_BOOT_TIMING("UEqZeroAssetManager::DoAllStartupJobs");
-	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
+	StartupJobsStartTime = FPlatformTime::Seconds();
 
-	if (IsRunningDedicatedServer())
+	bStartupJobsComplete = false;
+	NumStartupJobsRemaining = StartupJobs.Num();
+	StartupJobTimings.Reset();
+
+	if (StartupJobs.Num() == 0)
+	{
+		OnAllStartupJobsCompleted();
+		return;
+	}
+
+	// 依赖按任务名匹配，名字写错不能悄悄忽略
+	for (const FEqZeroAssetManagerStartupJob& StartupJob : StartupJobs)
 	{
-		// No need for periodic progress updates, just run the jobs
-		for (const FEqZeroAssetManagerStartupJob& StartupJob : StartupJobs)
+		for (const FString& DependencyName : StartupJob.Dependencies)
 		{
-			StartupJob.DoJob();
+			checkf(StartupJobs.ContainsByPredicate([&DependencyName](const FEqZeroAssetManagerStartupJob& Job) { return Job.JobName == DependencyName; }),
+				TEXT("Startup job \"%s\" depends on unknown job \"%s\". The dependency must match the other job's STARTUP_JOB text exactly."), *StartupJob.JobName, *DependencyName);
 		}
 	}
-	else
+
+	// No need for periodic progress updates on a dedicated server
+	if (!IsRunningDedicatedServer())
+	{
+		for (FEqZeroAssetManagerStartupJob& StartupJob : StartupJobs)
+		{
+			StartupJob.SubstepProgressDelegate.BindWeakLambda(this, [this](float NewProgress)
+				{
+					UpdateStartupJobsProgress();
+				});
+		}
+	}
+
+	// 关掉异步时按添加顺序一个一个执行并等待，和原来的行为一致
+	if (!EqZeroAssetManagerCVars::bAsyncStartupJobs)
+	{
+		for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
+		{
+			if (TSharedPtr<FStreamableHandle> Handle = StartupJobs[JobIndex].StartJob())
+			{
+				Handle->WaitUntilComplete(0.0f, false);
+			}
+			OnStartupJobCompleted(JobIndex);
+		}
+		return;
+	}
+
+	StartReadyStartupJobs();
+}
+
+void UEqZeroAssetManager::StartReadyStartupJobs()
+{
+	// 任务同步完成时会回调进来，由最外层的循环继续处理
+	if (bStartingStartupJobs)
 	{
-		if (StartupJobs.Num() > 0)
+		return;
+	}
+	TGuardValue<bool> StartingGuard(bStartingStartupJobs, true);
+
+	auto IsJobCompleted = [this](const FString& JobName)
+	{
+		const FEqZeroAssetManagerStartupJob* Dependency = StartupJobs.FindByPredicate([&JobName](const FEqZeroAssetManagerStartupJob& Job) { return Job.JobName == JobName; });
+		check(Dependency);
+		return Dependency->State == FEqZeroAssetManagerStartupJob::EState::Completed;
+	};
+
+	bool bStartedAnyJob = true;
+	while (bStartedAnyJob && !bStartupJobsComplete)
+	{
+		bStartedAnyJob = false;
+
+		int32 NumRunningJobs = 0;
+		for (int32 JobIndex = 0; JobIndex < StartupJobs.Num(); ++JobIndex)
 		{
-			float TotalJobValue = 0.0f;
-			for (const FEqZeroAssetManagerStartupJob& StartupJob : StartupJobs)
+			FEqZeroAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+			if (StartupJob.State == FEqZeroAssetManagerStartupJob::EState::Running)
+			{
+				++NumRunningJobs;
+				continue;
+			}
+
+			if ((StartupJob.State != FEqZeroAssetManagerStartupJob::EState::Pending) || !Algo::AllOf(StartupJob.Dependencies, IsJobCompleted))
 			{
-				TotalJobValue += StartupJob.JobWeight;
+				continue;
 			}
 
-			float AccumulatedJobValue = 0.0f;
+			bStartedAnyJob = true;
+
+			// 句柄上的回调是任务自己的（写入 GameDataMap、AddLoadedAsset），不能覆盖，由任务在回调里通知完成
+			StartupJob.LoadCompletedDelegate.BindWeakLambda(this, [this, JobIndex]()
+				{
+					OnStartupJobCompleted(JobIndex);
+				});
+
+			if (StartupJob.StartJob().IsValid())
+			{
+				++NumRunningJobs;
+			}
+			else
+			{
+				OnStartupJobCompleted(JobIndex);
+			}
+		}
+
+		// 没有在跑的任务但还有等待中的，说明依赖有环，忽略依赖直接跑
+		if (!bStartedAnyJob && (NumRunningJobs == 0) && (NumStartupJobsRemaining > 0))
+		{
 			for (FEqZeroAssetManagerStartupJob& StartupJob : StartupJobs)
 			{
-				const float JobValue = StartupJob.JobWeight;
-				StartupJob.SubstepProgressDelegate.BindLambda([This = this, AccumulatedJobValue, JobValue, TotalJobValue](float NewProgress)
+				if (StartupJob.State == FEqZeroAssetManagerStartupJob::EState::Pending)
 				{
-					const float SubstepAdjustment = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
-					const float OverallPercentWithSubstep = (AccumulatedJobValue + SubstepAdjustment) / TotalJobValue;
+					UE_LOG(LogEqZero, Error, TEXT("Startup job \"%s\" has unresolvable dependencies (cycle?), running it anyway"), *StartupJob.JobName);
+					StartupJob.Dependencies.Reset();
+					bStartedAnyJob = true;
+				}
+			}
+		}
+	}
+}
 
-					This->UpdateInitialGameContentLoadPercent(OverallPercentWithSubstep);
-				});
+void UEqZeroAssetManager::OnStartupJobCompleted(int32 JobIndex)
+{
+	if (!StartupJobs.IsValidIndex(JobIndex) || (StartupJobs[JobIndex].State == FEqZeroAssetManagerStartupJob::EState::Completed))
+	{
+		return;
+	}
+
+	FEqZeroAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+	StartupJob.FinishJob();
 
-				StartupJob.DoJob();
+	FEqZeroAssetManagerStartupJobTiming& Timing = StartupJobTimings.AddDefaulted_GetRef();
+	Timing.JobName = StartupJob.JobName;
+	Timing.StartOffset = StartupJob.StartTime - StartupJobsStartTime;
+	Timing.Duration = StartupJob.EndTime - StartupJob.StartTime;
+
+	--NumStartupJobsRemaining;
+	if (NumStartupJobsRemaining == 0)
+	{
+		OnAllStartupJobsCompleted();
+	}
+	else if (EqZeroAssetManagerCVars::bAsyncStartupJobs)
+	{
+		StartReadyStartupJobs();
+	}
+}
 
-				StartupJob.SubstepProgressDelegate.Unbind();
+void UEqZeroAssetManager::OnAllStartupJobsCompleted()
+{
+	StartupJobsDuration = FPlatformTime::Seconds() - StartupJobsStartTime;
+	bStartupJobsComplete = true;
 
-				AccumulatedJobValue += JobValue;
+	UpdateInitialGameContentLoadPercent(1.0f);
 
-				UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
-			}
-		}
-		else
+	// 任务可能还在自己的完成回调里，不能直接清空数组，下一帧再清
+	for (FEqZeroAssetManagerStartupJob& StartupJob : StartupJobs)
+	{
+		StartupJob.SubstepProgressDelegate.Unbind();
+	}
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float DeltaTime)
 		{
-			UpdateInitialGameContentLoadPercent(1.0f);
-		}
+			StartupJobs.Empty();
+			return false;
+		}));
+
+	UE_LOG(LogEqZero, Display, TEXT("All startup jobs took %.2f seconds to complete"), StartupJobsDuration);
+
+	OnStartupJobsComplete.Broadcast();
+	OnStartupJobsComplete.Clear();
+}
+
+void UEqZeroAssetManager::CallOrRegister_OnStartupJobsComplete(FSimpleMulticastDelegate::FDelegate&& Delegate)
+{
+	if (bStartupJobsComplete)
+	{
+		Delegate.Execute();
+	}
+	else
+	{
+		OnStartupJobsComplete.Add(MoveTemp(Delegate));
 	}
+}
 
-	StartupJobs.Empty();
+void UEqZeroAssetManager::UpdateStartupJobsProgress()
+{
+	float TotalJobValue = 0.0f;
+	float AccumulatedJobValue = 0.0f;
+	for (const FEqZeroAssetManagerStartupJob& StartupJob : StartupJobs)
+	{
+		TotalJobValue += StartupJob.JobWeight;
+		AccumulatedJobValue += StartupJob.Progress * StartupJob.JobWeight;
+	}
 
-	UE_LOG(LogEqZero, Display, TEXT("All startup jobs took %.2f seconds to complete"), FPlatformTime::Seconds() - AllStartupJobsStartTime);
+	if (TotalJobValue > 0.0f)
+	{
+		UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+	}
 }
 
 void UEqZeroAssetManager::UpdateInitialGameContentLoadPercent(float GameContentPercent)
@@ -33,6 +33,8 @@ class EQZEROGAME_API UEqZeroAssetManager : public UAssetManager
 {
 	GENERATED_BODY()
 
+	friend struct FEqZeroAssetManagerTestAccess;
+
 public:
 
 	UEqZeroAssetManager();
@@ -51,6 +53,15 @@ public:
 	const UEqZeroGameData& GetGameData();
 	const UEqZeroPawnData* GetDefaultPawnData() const;
 
+	// 启动任务是否全部完成，完成前访问 GameData 之类的资源会退回到阻塞加载，所以体验加载会等到这之后才开始
+	bool AreStartupJobsComplete() const { return bStartupJobsComplete; }
+
+	// 启动任务全部完成后回调，已经完成则立即调用
+	void CallOrRegister_OnStartupJobsComplete(FSimpleMulticastDelegate::FDelegate&& Delegate);
+
+	const TArray<FEqZeroAssetManagerStartupJobTiming>& GetStartupJobTimings() const { return StartupJobTimings; }
+	double GetStartupJobsDuration() const { return StartupJobsDuration; }
+
 protected:
 	template <typename GameDataClass>
 	const GameDataClass& GetOrLoadTypedGameData(const TSoftObjectPtr<GameDataClass>& DataPath)
@@ -79,6 +90,9 @@ protected:
 
 	UPrimaryDataAsset* LoadGameDataOfClass(TSubclassOf<UPrimaryDataAsset> DataClass, const TSoftObjectPtr<UPrimaryDataAsset>& DataClassPath, FPrimaryAssetType PrimaryAssetType);
 
+	// 异步版本，返回加载中的句柄，加载完成后写入 GameDataMap 再执行 OnLoadCompleted；编辑器里和 LoadGameDataOfClass 一样同步加载，这时返回空句柄且不执行 OnLoadCompleted
+	TSharedPtr<FStreamableHandle> StartLoadGameDataOfClass(TSubclassOf<UPrimaryDataAsset> DataClass, const TSoftObjectPtr<UPrimaryDataAsset>& DataClassPath, FPrimaryAssetType PrimaryAssetType, FSimpleDelegate OnLoadCompleted = FSimpleDelegate());
+
 protected:
 	UPROPERTY(Config)
 	TSoftObjectPtr<UEqZeroGameData> EqZeroGameDataPath;
@@ -91,17 +105,38 @@ protected:
 
 private:
 	// Flushes the StartupJobs array. Processes all startup work.
+	// 依赖满足的任务会同时开始，异步加载不在这里等待
 	void DoAllStartupJobs();
 
+	// 开始所有依赖已经完成的任务
+	void StartReadyStartupJobs();
+	void OnStartupJobCompleted(int32 JobIndex);
+	void OnAllStartupJobsCompleted();
+
 	// Sets up the ability system
 	void InitializeGameplayCueManager();
 
+	// 启动任务：异步加载 GameData 和默认 PawnData，返回未完成的句柄时在加载回调里调用 StartupJob.NotifyLoadCompleted
+	void StartLoadGameData(const FEqZeroAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& OutLoadHandle);
+	void StartLoadDefaultPawnData(const FEqZeroAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& OutLoadHandle);
+
+	// 汇总所有任务的进度
+	void UpdateStartupJobsProgress();
+
 	// Called periodically during loads, could be used to feed the status to a loading screen
 	void UpdateInitialGameContentLoadPercent(float GameContentPercent);
 
 	// The list of tasks to execute on startup. Used to track startup progress.
 	TArray<FEqZeroAssetManagerStartupJob> StartupJobs;
 
+	TArray<FEqZeroAssetManagerStartupJobTiming> StartupJobTimings;
+	FSimpleMulticastDelegate OnStartupJobsComplete;
+	double StartupJobsStartTime = 0.0;
+	double StartupJobsDuration = 0.0;
+	int32 NumStartupJobsRemaining = 0;
+	bool bStartupJobsComplete = false;
+	bool bStartingStartupJobs = false;
+
 private:
 	UPROPERTY()
 	TSet<TObjectPtr<const UObject>> LoadedAssets;
@@ -23,3 +23,43 @@ TSharedPtr<FStreamableHandle> FEqZeroAssetManagerStartupJob::DoJob() const
 
 	return Handle;
 }
+
+TSharedPtr<FStreamableHandle> FEqZeroAssetManagerStartupJob::StartJob()
+{
+	check(State == EState::Pending);
+
+	State = EState::Running;
+	StartTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogEqZero, Display, TEXT("Startup job \"%s\" starting"), *JobName);
+	JobFunc(*this, LoadHandle);
+
+	if (LoadHandle.IsValid() && !LoadHandle->HasLoadCompleted())
+	{
+		LoadHandle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FEqZeroAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
+		return LoadHandle;
+	}
+
+	LoadHandle.Reset();
+	return nullptr;
+}
+
+void FEqZeroAssetManagerStartupJob::FinishJob()
+{
+	if (State == EState::Completed)
+	{
+		return;
+	}
+
+	if (LoadHandle.IsValid())
+	{
+		LoadHandle->BindUpdateDelegate(FStreamableUpdateDelegate());
+		LoadHandle.Reset();
+	}
+
+	State = EState::Completed;
+	EndTime = FPlatformTime::Seconds();
+	UpdateSubstepProgress(1.0f);
+
+	UE_LOG(LogEqZero, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, EndTime - StartTime);
+}
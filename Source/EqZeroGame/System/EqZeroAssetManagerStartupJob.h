@@ -6,18 +6,50 @@
 
 DECLARE_DELEGATE_OneParam(FEqZeroAssetManagerStartupJobSubstepProgress, float /*NewProgress*/);
 
-/** 
+/** 启动任务的耗时记录 */
+struct FEqZeroAssetManagerStartupJobTiming
+{
+	FString JobName;
+
+	// 相对所有启动任务开始的时间
+	double StartOffset = 0.0;
+	double Duration = 0.0;
+};
+
+/**
  * 处理来自可流式处理句柄的进度报告
- * Handles reporting progress from streamable handles 
+ * Handles reporting progress from streamable handles
  */
 struct FEqZeroAssetManagerStartupJob
 {
+	enum class EState : uint8
+	{
+		Pending,
+		Running,
+		Completed
+	};
+
 	FEqZeroAssetManagerStartupJobSubstepProgress SubstepProgressDelegate;
+
+	// 异步任务加载完成（或取消）时在任务自己的回调里执行，通知资源管理器这个任务结束了
+	// 句柄上的完成回调归任务自己用，资源管理器不会覆盖
+	FSimpleDelegate LoadCompletedDelegate;
 	TFunction<void(const FEqZeroAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)> JobFunc;
 	FString JobName;
 	float JobWeight;
 	mutable double LastUpdate = 0;
 
+	// 依赖的其他任务的 JobName，全部完成后这个任务才会开始，没有依赖的任务之间并行加载
+	TArray<FString> Dependencies;
+
+	EState State = EState::Pending;
+	mutable float Progress = 0.0f;
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+
+	// 异步加载中的句柄，完成后释放
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
 	/** Simple job that is all synchronous */
 	FEqZeroAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FEqZeroAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight)
 		: JobFunc(InJobFunc)
@@ -28,8 +60,18 @@ struct FEqZeroAssetManagerStartupJob
 	/** Perform actual loading, will return a handle if it created one */
 	TSharedPtr<FStreamableHandle> DoJob() const;
 
+	/** 执行任务但不等待加载，返回加载中的句柄，由调用方在完成时调用 FinishJob */
+	TSharedPtr<FStreamableHandle> StartJob();
+	void FinishJob();
+
+	void NotifyLoadCompleted() const
+	{
+		LoadCompletedDelegate.ExecuteIfBound();
+	}
+
 	void UpdateSubstepProgress(float NewProgress) const
 	{
+		Progress = FMath::Clamp(NewProgress, 0.0f, 1.0f);
 		SubstepProgressDelegate.ExecuteIfBound(NewProgress);
 	}
 
@@ -39,9 +81,9 @@ struct FEqZeroAssetManagerStartupJob
 		{
 			// StreamableHandle::GetProgress traverses() a large graph and is quite expensive
 			double Now = FPlatformTime::Seconds();
-			if (LastUpdate - Now > 1.0 / 60)
+			if (Now - LastUpdate > 1.0 / 60)
 			{
-				SubstepProgressDelegate.Execute(StreamableHandle->GetProgress());
+				UpdateSubstepProgress(StreamableHandle->GetProgress());
 				LastUpdate = Now;
 			}
 		}
@@ -5,9 +5,13 @@
 #include "CommonSessionSubsystem.h"
 #include "CommonUserSubsystem.h"
 #include "Components/GameFrameworkComponentManager.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
 #include "HAL/IConsoleManager.h"
 #include "EqZeroGameplayTags.h"
+#include "EqZeroLogChannels.h"
 #include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 #include "Player/EqZeroPlayerController.h"
 #include "Player/EqZeroLocalPlayer.h"
 #include "GameFramework/PlayerState.h"
@@ -21,6 +25,8 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroGameInstance)
 
+CSV_DEFINE_CATEGORY(EqZeroScript, true);
+
 namespace EqZero
 {
 	static bool bTestEncryption = false;
@@ -83,6 +89,102 @@ namespace EqZero
 			}));
 #endif // UE_BUILD_SHIPPING
 #endif // UE_WITH_DTLS
+
+	// JS 堆的查看命令，无头服务器上没法连调试器时用来查脚本泄漏
+	// 快照和采样结果写到 Saved/Profiling/JsHeap 下，可以直接用 Chrome DevTools 的 Memory 面板打开
+	static puerts::FJsEnv* GetGameScriptForCommand(UWorld* InWorld)
+	{
+		UEqZeroGameInstance* GameInstance = InWorld ? Cast<UEqZeroGameInstance>(InWorld->GetGameInstance()) : nullptr;
+		puerts::FJsEnv* GameScript = GameInstance ? GameInstance->GetGameScript() : nullptr;
+		if (!GameScript)
+		{
+			UE_LOG(LogEqZero, Warning, TEXT("No game script environment"));
+		}
+		return GameScript;
+	}
+
+	static FString MakeJsHeapProfilePath(const TCHAR* Extension)
+	{
+		const FString OutputDir = FPaths::ProfilingDir() / TEXT("JsHeap");
+		IFileManager::Get().MakeDirectory(*OutputDir, true);
+		return OutputDir / FString::Printf(TEXT("JsHeap_%s.%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), Extension);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdScriptHeapStats(
+		TEXT("EqZero.Script.HeapStats"),
+		TEXT("Dump the JS heap statistics and per-space usage of the game script environment."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+			{
+				puerts::FJsEnv* GameScript = GetGameScriptForCommand(InWorld);
+				puerts::FJsHeapStatistics Statistics;
+				if (!GameScript || !GameScript->GetHeapStatistics(Statistics))
+				{
+					return;
+				}
+
+				UE_LOG(LogEqZero, Display, TEXT("JS heap: used %.2f MB, total %.2f MB, physical %.2f MB, limit %.2f MB, malloced %.2f MB, external %.2f MB, native contexts %llu, detached contexts %llu"),
+					Statistics.UsedHeapSize / 1048576.0, Statistics.TotalHeapSize / 1048576.0, Statistics.TotalPhysicalSize / 1048576.0,
+					Statistics.HeapSizeLimit / 1048576.0, Statistics.MallocedMemory / 1048576.0, Statistics.ExternalMemory / 1048576.0,
+					Statistics.NumberOfNativeContexts, Statistics.NumberOfDetachedContexts);
+				for (const puerts::FJsHeapSpaceStatistics& Space : Statistics.Spaces)
+				{
+					UE_LOG(LogEqZero, Display, TEXT("  %-24s used %10.2f KB / size %10.2f KB, available %10.2f KB"),
+						*Space.Name, Space.UsedSize / 1024.0, Space.SpaceSize / 1024.0, Space.AvailableSize / 1024.0);
+				}
+			}));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdScriptHeapSnapshot(
+		TEXT("EqZero.Script.HeapSnapshot"),
+		TEXT("Write a .heapsnapshot of the game script environment to Saved/Profiling/JsHeap."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+			{
+				if (puerts::FJsEnv* GameScript = GetGameScriptForCommand(InWorld))
+				{
+					const FString FilePath = MakeJsHeapProfilePath(TEXT("heapsnapshot"));
+					if (GameScript->WriteHeapSnapshot(FilePath))
+					{
+						UE_LOG(LogEqZero, Display, TEXT("Wrote JS heap snapshot to %s"), *FilePath);
+					}
+				}
+			}));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdScriptStartHeapSampling(
+		TEXT("EqZero.Script.StartHeapSampling"),
+		TEXT("Start sampling JS heap allocations. Usage: EqZero.Script.StartHeapSampling [SampleIntervalBytes=32768]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+			{
+				if (puerts::FJsEnv* GameScript = GetGameScriptForCommand(InWorld))
+				{
+					const uint64 SampleInterval = InArgs.Num() > 0 ? FMath::Max<uint64>(FCString::Strtoui64(*InArgs[0], nullptr, 10), 1) : 32768;
+					if (GameScript->StartHeapSampling(SampleInterval))
+					{
+						UE_LOG(LogEqZero, Display, TEXT("JS heap sampling started, interval %llu bytes"), SampleInterval);
+					}
+					else
+					{
+						UE_LOG(LogEqZero, Warning, TEXT("JS heap sampling is already running or not supported"));
+					}
+				}
+			}));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdScriptStopHeapSampling(
+		TEXT("EqZero.Script.StopHeapSampling"),
+		TEXT("Stop sampling JS heap allocations and write a .heapprofile to Saved/Profiling/JsHeap."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+			{
+				if (puerts::FJsEnv* GameScript = GetGameScriptForCommand(InWorld))
+				{
+					const FString FilePath = MakeJsHeapProfilePath(TEXT("heapprofile"));
+					if (GameScript->StopHeapSampling(FilePath))
+					{
+						UE_LOG(LogEqZero, Display, TEXT("Wrote JS sampling heap profile to %s"), *FilePath);
+					}
+					else
+					{
+						UE_LOG(LogEqZero, Warning, TEXT("JS heap sampling is not running"));
+					}
+				}
+			}));
 };
 
 UEqZeroGameInstance::UEqZeroGameInstance(const FObjectInitializer& ObjectInitializer)
@@ -172,6 +274,24 @@ void UEqZeroGameInstance::Init()
 	TArray<TPair<FString, UObject*>> Arguments;
 	Arguments.Add(TPair<FString, UObject*>("GameInstance", this));
 	GameScript->Start("Main", Arguments);
+
+#if CSV_PROFILER
+	ScriptStatsTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickScriptStats), 0.0f);
+#endif
+}
+
+bool UEqZeroGameInstance::TickScriptStats(float DeltaTime)
+{
+#if CSV_PROFILER
+	puerts::FJsHeapStatistics Statistics;
+	if (FCsvProfiler::Get()->IsCapturing() && GameScript.IsValid() && GameScript->GetHeapStatistics(Statistics))
+	{
+		CSV_CUSTOM_STAT(EqZeroScript, JsHeapUsedMB, static_cast<float>(Statistics.UsedHeapSize / 1048576.0), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(EqZeroScript, JsHeapTotalMB, static_cast<float>(Statistics.TotalHeapSize / 1048576.0), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(EqZeroScript, JsExternalMemoryMB, static_cast<float>(Statistics.ExternalMemory / 1048576.0), ECsvCustomStatOp::Set);
+	}
+#endif
+	return true;
 }
 
 void UEqZeroGameInstance::Shutdown()
@@ -181,6 +301,8 @@ void UEqZeroGameInstance::Shutdown()
 		SessionSubsystem->OnPreClientTravelEvent.RemoveAll(this);
 	}
 
+	FTSTicker::GetCoreTicker().RemoveTicker(ScriptStatsTickHandle);
+
 	Super::Shutdown();
 	GameScript.Reset();
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CommonGameInstance.h"
+#include "Containers/Ticker.h"
 #include "InputActionValue.h"
 #include "EqZeroGameInstance.generated.h"
 
@@ -34,6 +35,9 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = "EqZero|Hero")
 	EQZEROGAME_API void OnNativeInputAction(FGameplayTag InputTag, const FInputActionValue& InputActionValue);
 
+	/** 游戏用的脚本环境，EqZero.Script.* 控制台命令通过它查看 JS 堆 */
+	puerts::FJsEnv* GetGameScript() const { return GameScript.Get(); }
+
 protected:
 
 	/** TypeScript调试端口，0表示不启用调试 (只在Debug/Development版本生效) */
@@ -52,5 +56,10 @@ protected:
 	TArray<uint8> DebugTestEncryptionKey;
 
 private:
+	// CSV 采集时记录 JS 堆大小
+	bool TickScriptStats(float DeltaTime);
+
 	TSharedPtr<puerts::FJsEnv> GameScript;
+
+	FTSTicker::FDelegateHandle ScriptStatsTickHandle;
 };
@@ -6,12 +6,48 @@
 #include "Engine/World.h"
 #include "Engine/AssetManager.h"
 #include "Components/MeshComponent.h"
+#include "Cosmetics/EqZeroPawnComponent_CharacterParts.h"
 #include "EqZeroLogChannels.h"
 
 #include "GameModes/EqZeroUserFacingExperienceDefinition.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroSystemStatics)
 
+namespace EqZeroSystemStatics
+{
+	/** 从 Actor 池取的装扮部件不是 ChildActor，bIncludeChildActors 时要单独找出来 */
+	static TArray<AActor*> GetPooledCharacterPartActors(AActor* TargetActor)
+	{
+		TArray<AActor*> Result;
+		if (const UEqZeroPawnComponent_CharacterParts* CharacterParts = TargetActor->FindComponentByClass<UEqZeroPawnComponent_CharacterParts>())
+		{
+			for (AActor* PartActor : CharacterParts->GetCharacterPartActors())
+			{
+				// ChildActorComponent 生成的部件 ForEachComponent 已经遍历过
+				if (PartActor->GetParentActor() == nullptr)
+				{
+					Result.Add(PartActor);
+				}
+			}
+		}
+		return Result;
+	}
+
+	template<typename ComponentType, typename FuncType>
+	static void ForEachComponentIncludingCharacterParts(AActor* TargetActor, bool bIncludeChildActors, const FuncType& Func)
+	{
+		TargetActor->ForEachComponent<ComponentType>(bIncludeChildActors, Func);
+
+		if (bIncludeChildActors)
+		{
+			for (AActor* PartActor : GetPooledCharacterPartActors(TargetActor))
+			{
+				PartActor->ForEachComponent<ComponentType>(bIncludeChildActors, Func);
+			}
+		}
+	}
+}
+
 TSoftObjectPtr<UObject> UEqZeroSystemStatics::GetTypedSoftObjectReferenceFromPrimaryAssetId(FPrimaryAssetId PrimaryAssetId, TSubclassOf<UObject> ExpectedAssetType)
 {
 	if (UAssetManager* Manager = UAssetManager::GetIfInitialized())
@@ -77,7 +113,7 @@ void UEqZeroSystemStatics::SetScalarParameterValueOnAllMeshComponents(AActor* Ta
 {
 	if (TargetActor != nullptr)
 	{
-		TargetActor->ForEachComponent<UMeshComponent>(bIncludeChildActors, [=](UMeshComponent* InComponent)
+		EqZeroSystemStatics::ForEachComponentIncludingCharacterParts<UMeshComponent>(TargetActor, bIncludeChildActors, [=](UMeshComponent* InComponent)
 		{
 			InComponent->SetScalarParameterValueOnMaterials(ParameterName, ParameterValue);
 		});
@@ -88,7 +124,7 @@ void UEqZeroSystemStatics::SetVectorParameterValueOnAllMeshComponents(AActor* Ta
 {
 	if (TargetActor != nullptr)
 	{
-		TargetActor->ForEachComponent<UMeshComponent>(bIncludeChildActors, [=](UMeshComponent* InComponent)
+		EqZeroSystemStatics::ForEachComponentIncludingCharacterParts<UMeshComponent>(TargetActor, bIncludeChildActors, [=](UMeshComponent* InComponent)
 		{
 			InComponent->SetVectorParameterValueOnMaterials(ParameterName, ParameterValue);
 		});
@@ -107,6 +143,16 @@ TArray<UActorComponent*> UEqZeroSystemStatics::FindComponentsByClass(AActor* Tar
 	{
 		TargetActor->GetComponents(ComponentClass, /*out*/ Components, bIncludeChildActors);
 
+		if (bIncludeChildActors)
+		{
+			for (AActor* PartActor : EqZeroSystemStatics::GetPooledCharacterPartActors(TargetActor))
+			{
+				TArray<UActorComponent*> PartComponents;
+				PartActor->GetComponents(ComponentClass, /*out*/ PartComponents, bIncludeChildActors);
+				Components.Append(PartComponents);
+			}
+		}
+
 	}
 	return MoveTemp(Components);
 }
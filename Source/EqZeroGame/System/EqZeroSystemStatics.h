@@ -15,7 +15,7 @@ class UObject;
 struct FFrame;
 
 UCLASS()
-class UEqZeroSystemStatics : public UBlueprintFunctionLibrary
+class EQZEROGAME_API UEqZeroSystemStatics : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
@@ -168,12 +168,14 @@ void UEqZeroFrontendStateComponent::FlowStep_TryShowPressStartScreen(FControlFlo
 				{
 				case EAsyncWidgetLayerState::AfterPush:
 					bShouldShowLoadingScreen = false;
+					ILoadingProcessInterface::NotifyLoadingScreenStateChanged(this);
 					Screen->OnDeactivated().AddWeakLambda(this, [this, SubFlow]() {
 						SubFlow->ContinueFlow();
 					});
 					break;
 				case EAsyncWidgetLayerState::Canceled:
 					bShouldShowLoadingScreen = false;
+					ILoadingProcessInterface::NotifyLoadingScreenStateChanged(this);
 					SubFlow->ContinueFlow();
 					return;
 				}
@@ -254,10 +256,12 @@ void UEqZeroFrontendStateComponent::FlowStep_TryShowMainScreen(FControlFlowNodeR
 				{
 				case EAsyncWidgetLayerState::AfterPush:
 					bShouldShowLoadingScreen = false;
+					ILoadingProcessInterface::NotifyLoadingScreenStateChanged(this);
 					SubFlow->ContinueFlow();
 					return;
 				case EAsyncWidgetLayerState::Canceled:
 					bShouldShowLoadingScreen = false;
+					ILoadingProcessInterface::NotifyLoadingScreenStateChanged(this);
 					SubFlow->ContinueFlow();
 					return;
 				}
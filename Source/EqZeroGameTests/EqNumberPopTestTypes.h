@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Feedback/NumberPops/EqNumberPopComponent_MeshText.h"
+
+#include "EqNumberPopTestTypes.generated.h"
+
+class UStaticMesh;
+
+/**
+ * UEqNumberPopComponent_MeshTextTest
+ *
+ *	自动化测试用的网格数字弹出组件，暴露环形缓冲区的状态
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UEqNumberPopComponent_MeshTextTest : public UEqNumberPopComponent_MeshText
+{
+	GENERATED_BODY()
+
+public:
+	/** 用一个匹配所有请求的样式指定网格 */
+	void SetupForTest(UStaticMesh* Mesh, int32 InMaxLivePopsPerMesh, float InComponentLifespan);
+
+	int32 GetNumRingSlots(UStaticMesh* Mesh) const;
+	SIZE_T GetRingAllocatedSize(UStaticMesh* Mesh) const;
+	int32 GetNumVisibleSlots(UStaticMesh* Mesh) const;
+	int32 GetNumLivePops() const { return NumLivePops; }
+
+	void ReleaseExpiredForTest(float CurrentTime) { ReleaseExpiredComponents(CurrentTime); }
+};
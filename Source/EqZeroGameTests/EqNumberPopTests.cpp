@@ -0,0 +1,115 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqNumberPopTestTypes.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Feedback/NumberPops/EqDamagePopStyle.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqNumberPopTestTypes)
+
+void UEqNumberPopComponent_MeshTextTest::SetupForTest(UStaticMesh* Mesh, int32 InMaxLivePopsPerMesh, float InComponentLifespan)
+{
+	UEqDamagePopStyle* Style = NewObject<UEqDamagePopStyle>(this);
+	Style->bOverrideMesh = true;
+	Style->TextMesh = Mesh;
+	Style->MatchPattern = FGameplayTagQuery::MakeQuery_MatchNoTags(FGameplayTagContainer());
+
+	Styles.Reset();
+	Styles.Add(Style);
+
+	MaxLivePopsPerMesh = InMaxLivePopsPerMesh;
+	ComponentLifespan = InComponentLifespan;
+}
+
+int32 UEqNumberPopComponent_MeshTextTest::GetNumRingSlots(UStaticMesh* Mesh) const
+{
+	const FNumberPopMeshRing* Ring = MeshRings.Find(Mesh);
+	return Ring ? Ring->Components.Num() : 0;
+}
+
+SIZE_T UEqNumberPopComponent_MeshTextTest::GetRingAllocatedSize(UStaticMesh* Mesh) const
+{
+	const FNumberPopMeshRing* Ring = MeshRings.Find(Mesh);
+	return Ring ? (Ring->Components.GetAllocatedSize() + Ring->ReleaseTimes.GetAllocatedSize()) : 0;
+}
+
+int32 UEqNumberPopComponent_MeshTextTest::GetNumVisibleSlots(UStaticMesh* Mesh) const
+{
+	int32 NumVisible = 0;
+	if (const FNumberPopMeshRing* Ring = MeshRings.Find(Mesh))
+	{
+		for (const UStaticMeshComponent* Component : Ring->Components)
+		{
+			if (Component && !Component->bHiddenInGame)
+			{
+				++NumVisible;
+			}
+		}
+	}
+	return NumVisible;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/StaticMesh.h"
+#include "EqZeroTestWorld.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectArray.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqNumberPopRingNoAllocationTest, "EqZero.Feedback.NumberPops.WarmRingDoesNotAllocate", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqNumberPopRingNoAllocationTest::RunTest(const FString& Parameters)
+{
+	UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Engine cube mesh"), Mesh))
+	{
+		return false;
+	}
+
+	FEqZeroScopedTestWorld TestWorld;
+
+	const int32 Capacity = 8;
+	AActor* Owner = TestWorld->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+	UEqNumberPopComponent_MeshTextTest* NumberPops = NewObject<UEqNumberPopComponent_MeshTextTest>(Owner);
+	NumberPops->SetupForTest(Mesh, Capacity, 1.0f);
+	NumberPops->RegisterComponent();
+
+	FEqNumberPopRequest Request;
+	Request.WorldLocation = FVector(100.0f, 0.0f, 0.0f);
+
+	// 预热：把环填满
+	for (int32 Index = 0; Index < Capacity; ++Index)
+	{
+		Request.NumberToDisplay = Index * 1234;
+		NumberPops->AddNumberPop(Request);
+	}
+	TestEqual(TEXT("Ring grows to capacity"), NumberPops->GetNumRingSlots(Mesh), Capacity);
+	TestEqual(TEXT("Live pops after warm-up"), NumberPops->GetNumLivePops(), Capacity);
+
+	const int32 NumObjectsAfterWarmUp = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	const SIZE_T RingSizeAfterWarmUp = NumberPops->GetRingAllocatedSize(Mesh);
+
+	// 预热之后继续弹出，环满了回收最旧的，不应该再创建组件、MID 或者扩容
+	for (int32 Index = 0; Index < 1000; ++Index)
+	{
+		Request.NumberToDisplay = (Index % 3 == 0) ? -Index : Index * 7919;
+		NumberPops->AddNumberPop(Request);
+	}
+
+	TestEqual(TEXT("No UObjects created by a warm ring"), GUObjectArray.GetObjectArrayNumMinusAvailable(), NumObjectsAfterWarmUp);
+	TestEqual(TEXT("Ring storage did not grow"), NumberPops->GetRingAllocatedSize(Mesh), RingSizeAfterWarmUp);
+	TestEqual(TEXT("Ring stays at capacity"), NumberPops->GetNumRingSlots(Mesh), Capacity);
+	TestEqual(TEXT("Live pops capped at capacity"), NumberPops->GetNumLivePops(), Capacity);
+	TestEqual(TEXT("Visible slots capped at capacity"), NumberPops->GetNumVisibleSlots(Mesh), Capacity);
+
+	// 全部过期后只是隐藏，组件仍留在环里
+	NumberPops->ReleaseExpiredForTest(TestWorld->GetTimeSeconds() + 10.0f);
+	TestEqual(TEXT("No live pops after expiry"), NumberPops->GetNumLivePops(), 0);
+	TestEqual(TEXT("No visible slots after expiry"), NumberPops->GetNumVisibleSlots(Mesh), 0);
+	TestEqual(TEXT("Expired slots are kept"), NumberPops->GetNumRingSlots(Mesh), Capacity);
+	TestEqual(TEXT("Expiry does not create UObjects"), GUObjectArray.GetObjectArrayNumMinusAvailable(), NumObjectsAfterWarmUp);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "System/EqZeroAssetManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/EqZeroPawnData.h"
+#include "Engine/Engine.h"
+#include "Misc/AutomationTest.h"
+#include "System/EqZeroGameData.h"
+#include "UObject/UObjectGlobals.h"
+
+struct FEqZeroAssetManagerTestAccess
+{
+	static const UPrimaryDataAsset* FindGameData(const UEqZeroAssetManager& AssetManager)
+	{
+		const TObjectPtr<UPrimaryDataAsset>* GameData = AssetManager.GameDataMap.Find(UEqZeroGameData::StaticClass());
+		return GameData ? GameData->Get() : nullptr;
+	}
+
+	static bool HasGameDataPath(const UEqZeroAssetManager& AssetManager)
+	{
+		return !AssetManager.EqZeroGameDataPath.IsNull();
+	}
+
+	static const TSoftObjectPtr<UEqZeroPawnData>& GetDefaultPawnDataPath(const UEqZeroAssetManager& AssetManager)
+	{
+		return AssetManager.DefaultPawnData;
+	}
+
+	static bool IsInLoadedAssets(const UEqZeroAssetManager& AssetManager, const UObject* Asset)
+	{
+		return AssetManager.LoadedAssets.Contains(Asset);
+	}
+};
+
+namespace EqZeroAssetManagerTests
+{
+	// 不走 GetGameData / GetDefaultPawnData，它们在没加载时会退回同步加载，测不出启动任务有没有做完
+	void TestStartupData(FAutomationTestBase& Test, const UEqZeroAssetManager& AssetManager, const TCHAR* Stage)
+	{
+		if (FEqZeroAssetManagerTestAccess::HasGameDataPath(AssetManager))
+		{
+			Test.TestNotNull(FString::Printf(TEXT("%s: GameData job filled GameDataMap"), Stage), FEqZeroAssetManagerTestAccess::FindGameData(AssetManager));
+		}
+
+		const TSoftObjectPtr<UEqZeroPawnData>& DefaultPawnData = FEqZeroAssetManagerTestAccess::GetDefaultPawnDataPath(AssetManager);
+		if (!DefaultPawnData.IsNull())
+		{
+			const UEqZeroPawnData* PawnData = DefaultPawnData.Get();
+			Test.TestNotNull(FString::Printf(TEXT("%s: default PawnData is loaded"), Stage), PawnData);
+			Test.TestTrue(FString::Printf(TEXT("%s: default PawnData is held in LoadedAssets"), Stage), FEqZeroAssetManagerTestAccess::IsInLoadedAssets(AssetManager, PawnData));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroAssetManagerStartupDataKeptTest, "EqZero.AssetManager.StartupJobs.GameDataAndPawnDataKept", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroAssetManagerStartupDataKeptTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroAssetManagerTests;
+
+	const UEqZeroAssetManager* AssetManager = GEngine ? Cast<UEqZeroAssetManager>(GEngine->AssetManager) : nullptr;
+	if (!AssetManager)
+	{
+		AddInfo(TEXT("AssetManagerClassName is not EqZeroAssetManager, nothing to check"));
+		return true;
+	}
+
+	if (!TestTrue(TEXT("Startup jobs completed"), AssetManager->AreStartupJobsComplete()))
+	{
+		return false;
+	}
+
+	TestStartupData(*this, *AssetManager, TEXT("After startup"));
+
+	// 启动任务结束时会释放自己的加载句柄，GC 之后资源还要在
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	TestStartupData(*this, *AssetManager, TEXT("After GC"));
+
+	for (const FEqZeroAssetManagerStartupJobTiming& Timing : AssetManager->GetStartupJobTimings())
+	{
+		AddInfo(FString::Printf(TEXT("%s: started at %.3fs, took %.3fs"), *Timing.JobName, Timing.StartOffset, Timing.Duration));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Camera/EqZeroCameraMode_ThirdPerson.h"
+
+#include "EqZeroCameraModeTestTypes.generated.h"
+
+/**
+ * UEqZeroCameraMode_ThirdPersonTest
+ *
+ *	自动化测试用的第三人称摄像机模式，把防穿透检测暴露出来单独驱动
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UEqZeroCameraMode_ThirdPersonTest : public UEqZeroCameraMode_ThirdPerson
+{
+	GENERATED_BODY()
+
+public:
+	void RunPreventCameraPenetration(const AActor& ViewTarget, const FVector& SafeLoc, FVector& CameraLoc, float DeltaTime, float& DistBlockedPct)
+	{
+		PreventCameraPenetration(ViewTarget, SafeLoc, CameraLoc, DeltaTime, DistBlockedPct, !bDoPredictiveAvoidance);
+		bResetInterpolation = false;
+	}
+
+	void SetResetInterpolation(bool bReset)
+	{
+		bResetInterpolation = bReset;
+	}
+};
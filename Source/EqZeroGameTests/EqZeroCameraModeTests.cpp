@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqZeroCameraModeTestTypes.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroCameraModeTestTypes)
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/BoxComponent.h"
+#include "EqZeroTestWorld.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+namespace EqZeroCameraModeTests
+{
+	static AActor* SpawnBlockingBox(UWorld* World, const FVector& Location, const FVector& BoxExtent)
+	{
+		AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location));
+		UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+		Box->SetBoxExtent(BoxExtent);
+		Box->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		Box->SetCollisionResponseToAllChannels(ECR_Block);
+		Actor->SetRootComponent(Box);
+		Box->RegisterComponent();
+		Box->SetWorldLocation(Location);
+		return Actor;
+	}
+
+	struct FPenetrationResult
+	{
+		float DistBlockedPct = 1.0f;
+		FVector CameraLoc = FVector::ZeroVector;
+	};
+
+	// 跑若干帧防穿透检测，异步结果在世界 Tick 之后才能取到，所以每帧之间都 Tick 一次
+	static FPenetrationResult RunFrames(FEqZeroScopedTestWorld& TestWorld, const AActor& ViewTarget, bool bAsync, const FVector& SafeLoc, const FVector& DesiredCameraLoc, int32 NumFrames)
+	{
+		UEqZeroCameraMode_ThirdPersonTest* CameraMode = NewObject<UEqZeroCameraMode_ThirdPersonTest>(const_cast<AActor*>(&ViewTarget));
+		CameraMode->bUseAsyncPenetrationTraces = bAsync;
+		CameraMode->PenetrationBlendInTime = 0.0f;
+		CameraMode->PenetrationBlendOutTime = 0.0f;
+		CameraMode->SetResetInterpolation(true);
+
+		FPenetrationResult Result;
+		const float DeltaTime = 1.0f / 60.0f;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Result.CameraLoc = DesiredCameraLoc;
+			CameraMode->RunPreventCameraPenetration(ViewTarget, SafeLoc, Result.CameraLoc, DeltaTime, Result.DistBlockedPct);
+			TestWorld.Tick(DeltaTime);
+		}
+
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroCameraPenetrationAsyncTraceTest, "EqZero.Camera.ThirdPerson.AsyncPenetrationMatchesSync", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroCameraPenetrationAsyncTraceTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroCameraModeTests;
+
+	FEqZeroScopedTestWorld TestWorld;
+
+	AActor* ViewTarget = TestWorld->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+	const FVector SafeLoc = FVector::ZeroVector;
+	const FVector DesiredCameraLoc(-400.0f, 0.0f, 0.0f);
+
+	// 预测射线的检测间隔最长 5 帧，多跑几轮保证每条射线都至少取回过一次异步结果
+	const int32 NumFrames = 16;
+
+	// 没有阻挡：两条路径都应该保持在期望位置
+	{
+		const FPenetrationResult SyncResult = RunFrames(TestWorld, *ViewTarget, false, SafeLoc, DesiredCameraLoc, NumFrames);
+		const FPenetrationResult AsyncResult = RunFrames(TestWorld, *ViewTarget, true, SafeLoc, DesiredCameraLoc, NumFrames);
+
+		TestEqual(TEXT("Unblocked sync DistBlockedPct"), SyncResult.DistBlockedPct, 1.0f);
+		TestEqual(TEXT("Unblocked async DistBlockedPct"), AsyncResult.DistBlockedPct, SyncResult.DistBlockedPct, KINDA_SMALL_NUMBER);
+		TestEqual(TEXT("Unblocked async CameraLoc"), AsyncResult.CameraLoc, SyncResult.CameraLoc, KINDA_SMALL_NUMBER);
+	}
+
+	// 身后有墙：异步结果晚一帧，收敛后要和同步路径一致
+	AActor* Wall = SpawnBlockingBox(TestWorld.Get(), FVector(-200.0f, 0.0f, 0.0f), FVector(20.0f, 500.0f, 500.0f));
+	{
+		const FPenetrationResult SyncResult = RunFrames(TestWorld, *ViewTarget, false, SafeLoc, DesiredCameraLoc, NumFrames);
+		const FPenetrationResult AsyncResult = RunFrames(TestWorld, *ViewTarget, true, SafeLoc, DesiredCameraLoc, NumFrames);
+
+		TestTrue(TEXT("Wall blocks the sync camera"), SyncResult.DistBlockedPct < 1.0f);
+		TestEqual(TEXT("Blocked async DistBlockedPct"), AsyncResult.DistBlockedPct, SyncResult.DistBlockedPct, KINDA_SMALL_NUMBER);
+		TestEqual(TEXT("Blocked async CameraLoc"), AsyncResult.CameraLoc, SyncResult.CameraLoc, KINDA_SMALL_NUMBER);
+	}
+
+	// 带 IgnoreCameraCollision 标签的墙两条路径都要忽略
+	Wall->Tags.Add(TEXT("IgnoreCameraCollision"));
+	{
+		const FPenetrationResult SyncResult = RunFrames(TestWorld, *ViewTarget, false, SafeLoc, DesiredCameraLoc, NumFrames);
+		const FPenetrationResult AsyncResult = RunFrames(TestWorld, *ViewTarget, true, SafeLoc, DesiredCameraLoc, NumFrames);
+
+		TestEqual(TEXT("Ignored wall sync DistBlockedPct"), SyncResult.DistBlockedPct, 1.0f);
+		TestEqual(TEXT("Ignored wall async DistBlockedPct"), AsyncResult.DistBlockedPct, SyncResult.DistBlockedPct, KINDA_SMALL_NUMBER);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "AbilitySystem/EqZeroTaggedActor.h"
+#include "GameFramework/Character.h"
+
+#include "EqZeroCharacterPartTestTypes.generated.h"
+
+class UEqZeroPawnComponent_CharacterParts;
+
+/**
+ * AEqZeroCharacterPartTestActor
+ *
+ *	自动化测试用的装扮部件，只有一个场景根组件，走 ChildActorComponent
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class AEqZeroCharacterPartTestActor : public AEqZeroTaggedActor
+{
+	GENERATED_BODY()
+
+public:
+	AEqZeroCharacterPartTestActor(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
+
+/**
+ * AEqZeroPooledCharacterPartTestActor
+ *
+ *	打开了 bAllowCharacterPartPooling 的测试部件
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class AEqZeroPooledCharacterPartTestActor : public AEqZeroCharacterPartTestActor
+{
+	GENERATED_BODY()
+
+public:
+	AEqZeroPooledCharacterPartTestActor(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
+
+/**
+ * AEqZeroCharacterPartTestPawn
+ *
+ *	带装扮组件的测试角色
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class AEqZeroCharacterPartTestPawn : public ACharacter
+{
+	GENERATED_BODY()
+
+public:
+	AEqZeroCharacterPartTestPawn(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	UEqZeroPawnComponent_CharacterParts* GetCharacterParts() const { return CharacterParts; }
+
+private:
+	UPROPERTY()
+	TObjectPtr<UEqZeroPawnComponent_CharacterParts> CharacterParts;
+};
@@ -0,0 +1,216 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqZeroCharacterPartTestTypes.h"
+
+#include "Components/SceneComponent.h"
+#include "Cosmetics/EqZeroPawnComponent_CharacterParts.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroCharacterPartTestTypes)
+
+AEqZeroCharacterPartTestActor::AEqZeroCharacterPartTestActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+AEqZeroPooledCharacterPartTestActor::AEqZeroPooledCharacterPartTestActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bAllowCharacterPartPooling = true;
+}
+
+AEqZeroCharacterPartTestPawn::AEqZeroCharacterPartTestPawn(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	CharacterParts = CreateDefaultSubobject<UEqZeroPawnComponent_CharacterParts>(TEXT("CharacterParts"));
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EqZeroTestWorld.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "System/EqZeroActorPoolSubsystem.h"
+#include "System/EqZeroSystemStatics.h"
+
+namespace EqZeroCharacterPartTests
+{
+	constexpr int32 NumPawns = 64;
+	constexpr int32 NumPartsPerPawn = 5;
+	constexpr int32 NumRespawns = 4;
+
+	struct FScopedConsoleVariable
+	{
+		FScopedConsoleVariable(const TCHAR* Name, const TCHAR* Value)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (CVar)
+			{
+				PreviousValue = CVar->GetString();
+				CVar->Set(Value, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedConsoleVariable()
+		{
+			if (CVar)
+			{
+				CVar->Set(*PreviousValue, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* CVar = nullptr;
+		FString PreviousValue;
+	};
+
+	/** 生成 NumPawns 个角色，每个加 NumPartsPerPawn 个部件，返回花的秒数 */
+	static double SpawnPawnsWithParts(UWorld* World, TSubclassOf<AActor> PartClass, TArray<AEqZeroCharacterPartTestPawn*>& OutPawns)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		FEqZeroCharacterPart Part;
+		Part.PartClass = PartClass;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 PawnIndex = 0; PawnIndex < NumPawns; ++PawnIndex)
+		{
+			AEqZeroCharacterPartTestPawn* Pawn = World->SpawnActor<AEqZeroCharacterPartTestPawn>(FVector(PawnIndex * 200.0, 0.0, 0.0), FRotator::ZeroRotator, SpawnParameters);
+			for (int32 PartIndex = 0; PartIndex < NumPartsPerPawn; ++PartIndex)
+			{
+				Pawn->GetCharacterParts()->AddCharacterPart(Part);
+			}
+			OutPawns.Add(Pawn);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	/** 销毁角色，部件跟着 EndPlay 一起回收或销毁，返回花的秒数 */
+	static double DestroyPawns(TArray<AEqZeroCharacterPartTestPawn*>& Pawns)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (AEqZeroCharacterPartTestPawn* Pawn : Pawns)
+		{
+			Pawn->Destroy();
+		}
+		Pawns.Reset();
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	/** 每个角色都拿到 NumPartsPerPawn 个可见、挂在自己身上的部件，并且装扮之外的调用方也能找到它们 */
+	static void TestPawnParts(FAutomationTestBase& Test, const TCHAR* What, const TArray<AEqZeroCharacterPartTestPawn*>& Pawns, TSubclassOf<AActor> PartClass, bool bExpectChildActors)
+	{
+		int32 NumMissingParts = 0;
+		int32 NumWrongParts = 0;
+		int32 NumUnreachableParts = 0;
+		for (AEqZeroCharacterPartTestPawn* Pawn : Pawns)
+		{
+			const TArray<AActor*> PartActors = Pawn->GetCharacterParts()->GetCharacterPartActors();
+			NumMissingParts += NumPartsPerPawn - PartActors.Num();
+
+			const TArray<UActorComponent*> ReachableComponents = UEqZeroSystemStatics::FindComponentsByClass(Pawn, USceneComponent::StaticClass(), /*bIncludeChildActors=*/ true);
+			for (const AActor* PartActor : PartActors)
+			{
+				const bool bCorrect = PartActor->IsA(PartClass)
+					&& !PartActor->IsHidden()
+					&& (PartActor->GetAttachParentActor() == Pawn)
+					&& ((PartActor->GetParentActor() == Pawn) == bExpectChildActors);
+				NumWrongParts += bCorrect ? 0 : 1;
+				NumUnreachableParts += ReachableComponents.Contains(PartActor->GetRootComponent()) ? 0 : 1;
+			}
+		}
+
+		Test.TestEqual(FString::Printf(TEXT("%s: missing parts"), What), NumMissingParts, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: parts with the wrong class, visibility or attachment"), What), NumWrongParts, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: parts not reached through bIncludeChildActors"), What), NumUnreachableParts, 0);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroCharacterPartRespawnTest, "EqZero.Cosmetics.CharacterParts.Respawn", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroCharacterPartRespawnTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroCharacterPartTests;
+
+	const FScopedConsoleVariable EnablePool(TEXT("EqZero.ActorPool.Enabled"), TEXT("1"));
+	const FScopedConsoleVariable MaxPerClass(TEXT("EqZero.ActorPool.MaxPerClass"), *LexToString(NumPawns * NumPartsPerPawn));
+
+	FEqZeroScopedTestWorld TestWorld;
+	UEqZeroActorPoolSubsystem* ActorPool = UEqZeroActorPoolSubsystem::Get(TestWorld.Get());
+	if (!TestNotNull(TEXT("Actor pool"), ActorPool))
+	{
+		return false;
+	}
+
+	const int32 NumParts = NumPawns * NumPartsPerPawn;
+	TArray<AEqZeroCharacterPartTestPawn*> Pawns;
+
+	// 没打开池化的部件类照旧走 ChildActorComponent，不碰池
+	{
+		double SpawnSeconds = 0.0;
+		double DestroySeconds = 0.0;
+		for (int32 Round = 0; Round < NumRespawns; ++Round)
+		{
+			SpawnSeconds += SpawnPawnsWithParts(TestWorld.Get(), AEqZeroCharacterPartTestActor::StaticClass(), Pawns);
+			TestPawnParts(*this, TEXT("Child actor parts"), Pawns, AEqZeroCharacterPartTestActor::StaticClass(), /*bExpectChildActors=*/ true);
+			DestroySeconds += DestroyPawns(Pawns);
+			TestWorld.Tick();
+		}
+
+		TestEqual(TEXT("Child actor parts: nothing spawned from the pool"), ActorPool->GetNumSpawned(), 0ull);
+		TestEqual(TEXT("Child actor parts: nothing released to the pool"), ActorPool->GetNumReleased(), 0ull);
+		AddInfo(FString::Printf(TEXT("Child actor parts: %d respawns of %d pawns x %d parts, spawn %.3f ms, destroy %.3f ms"),
+			NumRespawns, NumPawns, NumPartsPerPawn, SpawnSeconds * 1000.0, DestroySeconds * 1000.0));
+	}
+
+	// 池化的部件只在第一轮生成，之后每轮都复用
+	{
+		double SpawnSeconds = 0.0;
+		double DestroySeconds = 0.0;
+		for (int32 Round = 0; Round < NumRespawns; ++Round)
+		{
+			SpawnSeconds += SpawnPawnsWithParts(TestWorld.Get(), AEqZeroPooledCharacterPartTestActor::StaticClass(), Pawns);
+			TestPawnParts(*this, TEXT("Pooled parts"), Pawns, AEqZeroPooledCharacterPartTestActor::StaticClass(), /*bExpectChildActors=*/ false);
+			DestroySeconds += DestroyPawns(Pawns);
+			TestWorld.Tick();
+
+			TestEqual(TEXT("Pooled parts: every part is parked after the pawns are destroyed"), ActorPool->GetNumPooledActors(), NumParts);
+		}
+
+		TestEqual(TEXT("Pooled parts: spawned"), ActorPool->GetNumSpawned(), static_cast<uint64>(NumParts));
+		TestEqual(TEXT("Pooled parts: reused"), ActorPool->GetNumReused(), static_cast<uint64>(NumParts * (NumRespawns - 1)));
+		TestEqual(TEXT("Pooled parts: released"), ActorPool->GetNumReleased(), static_cast<uint64>(NumParts * NumRespawns));
+		AddInfo(FString::Printf(TEXT("Pooled parts: %d respawns of %d pawns x %d parts, spawned %llu, reused %llu, spawn %.3f ms, destroy %.3f ms"),
+			NumRespawns, NumPawns, NumPartsPerPawn, ActorPool->GetNumSpawned(), ActorPool->GetNumReused(), SpawnSeconds * 1000.0, DestroySeconds * 1000.0));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroCharacterPartNoPoolFallbackTest, "EqZero.Cosmetics.CharacterParts.NoPoolFallback", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroCharacterPartNoPoolFallbackTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroCharacterPartTests;
+
+	// 预览世界没有 Actor 池，打开了池化的部件也要正常生成
+	FEqZeroScopedTestWorld TestWorld(EWorldType::GamePreview);
+	TestNull(TEXT("No actor pool in a preview world"), UEqZeroActorPoolSubsystem::Get(TestWorld.Get()));
+
+	TArray<AEqZeroCharacterPartTestPawn*> Pawns;
+	SpawnPawnsWithParts(TestWorld.Get(), AEqZeroPooledCharacterPartTestActor::StaticClass(), Pawns);
+	TestPawnParts(*this, TEXT("Preview world"), Pawns, AEqZeroPooledCharacterPartTestActor::StaticClass(), /*bExpectChildActors=*/ true);
+
+	AEqZeroCharacterPartTestPawn* Pawn = Pawns[0];
+	const TArray<AActor*> PartActors = Pawn->GetCharacterParts()->GetCharacterPartActors();
+	Pawn->GetCharacterParts()->RemoveAllCharacterParts();
+	TestEqual(TEXT("Preview world: parts removed"), Pawn->GetCharacterParts()->GetCharacterPartActors().Num(), 0);
+	TestFalse(TEXT("Preview world: removed parts are destroyed"), PartActors.ContainsByPredicate([](const AActor* PartActor) { return IsValid(PartActor); }));
+
+	DestroyPawns(Pawns);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,435 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/EqZeroCharacter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+namespace EqZeroCharacterTests
+{
+	/** 模拟一次网络发送：服务器写，客户端读出一份新的结构 */
+	static FSharedRepMovement SendOverNetwork(const FSharedRepMovement& ServerMovement, int64& OutNumBits)
+	{
+		FSharedRepMovement MovementToWrite = ServerMovement;
+		FBitWriter Writer(1024, /*bAllowResize=*/ true);
+		bool bSuccess = true;
+		MovementToWrite.NetSerialize(Writer, nullptr, bSuccess);
+		OutNumBits = Writer.GetNumBits();
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		FSharedRepMovement ClientMovement;
+		ClientMovement.NetSerialize(Reader, nullptr, bSuccess);
+		return ClientMovement;
+	}
+
+	static FSharedRepMovement MakeMovement(FRandomStream& Random, const FVector& Location, const FRotator& Rotation, const FVector& Velocity)
+	{
+		FSharedRepMovement Movement;
+		Movement.RepMovement.LocationQuantizationLevel = EVectorQuantization::RoundTwoDecimals;
+		Movement.RepMovement.RotationQuantizationLevel = ERotatorQuantization::ShortComponents;
+		Movement.RepMovement.VelocityQuantizationLevel = EVectorQuantization::RoundWholeNumber;
+		Movement.RepMovement.Location = Location;
+		Movement.RepMovement.Rotation = Rotation;
+		Movement.RepMovement.LinearVelocity = Velocity;
+		Movement.RepMovementMode = static_cast<uint8>(Random.RandRange(0, 5));
+		Movement.bProxyIsJumpForceApplied = Random.RandRange(0, 1) != 0;
+		Movement.bIsCrouched = Random.RandRange(0, 1) != 0;
+		Movement.RepTimeStamp = Random.FRandRange(0.0f, 1000.0f);
+		Movement.Quantize();
+		return Movement;
+	}
+
+	static FVector RandomVector(FRandomStream& Random, float Extent)
+	{
+		return FVector(Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent));
+	}
+
+	static FRotator RandomRotator(FRandomStream& Random)
+	{
+		return FRotator(Random.FRandRange(-89.0f, 89.0f), Random.FRandRange(0.0f, 360.0f), Random.FRandRange(-180.0f, 180.0f));
+	}
+
+	constexpr int32 NumRecordedCharacters = 64;
+	constexpr float RecordedNetRate = 30.0f;
+	constexpr float RecordedSeconds = 20.0f;
+
+	/** 录制的一帧：服务器 UpdateSharedReplication 时角色的原始状态，没有量化 */
+	struct FRecordedMovementSample
+	{
+		float Time = 0.0f;
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		FVector Velocity = FVector::ZeroVector;
+		uint8 MovementMode = MOVE_Walking;
+		bool bIsCrouched = false;
+	};
+
+	/**
+	 * 按固定种子模拟一局 64 人的移动并按网络频率采样：站立、走、跑、蹲走之间切换，边跑边转向，偶尔跳跃
+	 * 每个角色一条轨迹，结果只取决于种子
+	 */
+	static TArray<TArray<FRecordedMovementSample>> RecordMovementCorpus()
+	{
+		const float DeltaTime = 1.0f / RecordedNetRate;
+		const int32 NumSamples = FMath::RoundToInt32(RecordedSeconds * RecordedNetRate);
+		const float Gravity = -980.0f;
+
+		TArray<TArray<FRecordedMovementSample>> Corpus;
+		for (int32 CharacterIndex = 0; CharacterIndex < NumRecordedCharacters; ++CharacterIndex)
+		{
+			FRandomStream Random(2900 + CharacterIndex);
+			const float GroundZ = Random.FRandRange(0.0f, 2000.0f);
+			FVector Location(Random.FRandRange(-40000.0f, 40000.0f), Random.FRandRange(-40000.0f, 40000.0f), GroundZ);
+			float Yaw = Random.FRandRange(-180.0f, 180.0f);
+			float TurnRate = 0.0f;
+			float TargetSpeed = 0.0f;
+			float VerticalSpeed = 0.0f;
+			bool bIsCrouched = false;
+			bool bIsFalling = false;
+			float NextStateTime = 0.0f;
+			FVector Velocity = FVector::ZeroVector;
+
+			TArray<FRecordedMovementSample>& Samples = Corpus.AddDefaulted_GetRef();
+			for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+			{
+				const float Time = SampleIndex * DeltaTime;
+				if (Time >= NextStateTime && !bIsFalling)
+				{
+					const float Roll = Random.FRand();
+					bIsCrouched = (Roll >= 0.9f);
+					TargetSpeed = (Roll < 0.2f) ? 0.0f : (Roll < 0.5f) ? 300.0f : (Roll < 0.9f) ? 600.0f : 200.0f;
+					TurnRate = (Random.FRand() < 0.3f) ? 0.0f : Random.FRandRange(-120.0f, 120.0f);
+					NextStateTime = Time + Random.FRandRange(0.5f, 3.0f);
+				}
+
+				if (!bIsFalling && !bIsCrouched && TargetSpeed > 0.0f && Random.FRand() < 0.01f)
+				{
+					bIsFalling = true;
+					VerticalSpeed = 420.0f;
+				}
+
+				Yaw = FRotator::NormalizeAxis(Yaw + TurnRate * DeltaTime);
+				const FVector DesiredVelocity = FRotator(0.0f, Yaw, 0.0f).Vector() * TargetSpeed;
+				Velocity = FMath::VInterpConstantTo(FVector(Velocity.X, Velocity.Y, 0.0f), DesiredVelocity, DeltaTime, 2048.0f);
+
+				if (bIsFalling)
+				{
+					VerticalSpeed += Gravity * DeltaTime;
+					Location.Z += VerticalSpeed * DeltaTime;
+					if (Location.Z <= GroundZ)
+					{
+						Location.Z = GroundZ;
+						VerticalSpeed = 0.0f;
+						bIsFalling = false;
+					}
+				}
+				Velocity.Z = bIsFalling ? VerticalSpeed : 0.0f;
+				Location += FVector(Velocity.X, Velocity.Y, 0.0f) * DeltaTime;
+
+				FRecordedMovementSample& Sample = Samples.AddDefaulted_GetRef();
+				Sample.Time = 1000.0f + Time;
+				Sample.Location = Location;
+				Sample.Rotation = FRotator(0.0f, Yaw, 0.0f);
+				Sample.Velocity = Velocity;
+				Sample.MovementMode = bIsFalling ? MOVE_Falling : MOVE_Walking;
+				Sample.bIsCrouched = bIsCrouched;
+			}
+		}
+		return Corpus;
+	}
+
+	/** 改动前的格式：每次都是完整的 FRepMovement 加上模式、跳跃、下蹲和时间戳 */
+	static FSharedRepMovement SendLegacyOverNetwork(const FSharedRepMovement& ServerMovement, int64& OutNumBits)
+	{
+		bool bSuccess = true;
+		FBitWriter Writer(1024, /*bAllowResize=*/ true);
+		{
+			FSharedRepMovement Movement = ServerMovement;
+			Movement.RepMovement.NetSerialize(Writer, nullptr, bSuccess);
+			Writer << Movement.RepMovementMode;
+			Writer << Movement.bProxyIsJumpForceApplied;
+			Writer << Movement.bIsCrouched;
+			uint8 bHasTimeStamp = (Movement.RepTimeStamp != 0.f);
+			Writer.SerializeBits(&bHasTimeStamp, 1);
+			if (bHasTimeStamp)
+			{
+				Writer << Movement.RepTimeStamp;
+			}
+		}
+		OutNumBits = Writer.GetNumBits();
+
+		// 量化精度不在线上，客户端用的是和服务器相同的默认值
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		FSharedRepMovement ClientMovement;
+		ClientMovement.RepMovement.LocationQuantizationLevel = ServerMovement.RepMovement.LocationQuantizationLevel;
+		ClientMovement.RepMovement.RotationQuantizationLevel = ServerMovement.RepMovement.RotationQuantizationLevel;
+		ClientMovement.RepMovement.VelocityQuantizationLevel = ServerMovement.RepMovement.VelocityQuantizationLevel;
+		ClientMovement.RepMovement.NetSerialize(Reader, nullptr, bSuccess);
+		Reader << ClientMovement.RepMovementMode;
+		Reader << ClientMovement.bProxyIsJumpForceApplied;
+		Reader << ClientMovement.bIsCrouched;
+		uint8 bHasTimeStamp = 0;
+		Reader.SerializeBits(&bHasTimeStamp, 1);
+		if (bHasTimeStamp)
+		{
+			Reader << ClientMovement.RepTimeStamp;
+		}
+		return ClientMovement;
+	}
+
+	/** 客户端还原出来的状态和录制的原始状态之间的最大误差 */
+	struct FQuantizationError
+	{
+		double Location = 0.0;
+		double Rotation = 0.0;
+		double Velocity = 0.0;
+
+		void Add(const FSharedRepMovement& ClientMovement, const FRecordedMovementSample& Sample)
+		{
+			Location = FMath::Max(Location, (ClientMovement.RepMovement.Location - Sample.Location).GetAbsMax());
+			Rotation = FMath::Max(Rotation, (ClientMovement.RepMovement.Rotation - Sample.Rotation).GetNormalized().GetManhattanDistance(FRotator::ZeroRotator));
+			Velocity = FMath::Max(Velocity, (ClientMovement.RepMovement.LinearVelocity - Sample.Velocity).GetAbsMax());
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroSharedRepMovementRoundTripTest, "EqZero.Character.SharedRepMovement.RoundTrip", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroSharedRepMovementRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroCharacterTests;
+
+	FRandomStream Random(29);
+	const double LocationTolerance = 0.01;
+	const double VelocityTolerance = 1.0;
+	const double RotationTolerance = 360.0 / 65536.0;
+
+	auto TestMovementEqual = [&](const TCHAR* What, const FSharedRepMovement& Actual, const FSharedRepMovement& Expected)
+	{
+		TestTrue(FString::Printf(TEXT("%s location"), What), Actual.RepMovement.Location.Equals(Expected.RepMovement.Location, LocationTolerance));
+		TestTrue(FString::Printf(TEXT("%s rotation"), What), Actual.RepMovement.Rotation.Equals(Expected.RepMovement.Rotation, RotationTolerance));
+		TestTrue(FString::Printf(TEXT("%s velocity"), What), Actual.RepMovement.LinearVelocity.Equals(Expected.RepMovement.LinearVelocity, VelocityTolerance));
+		TestEqual(FString::Printf(TEXT("%s movement mode"), What), Actual.RepMovementMode, Expected.RepMovementMode);
+		TestEqual(FString::Printf(TEXT("%s jump force"), What), Actual.bProxyIsJumpForceApplied, Expected.bProxyIsJumpForceApplied);
+		TestEqual(FString::Printf(TEXT("%s crouched"), What), Actual.bIsCrouched, Expected.bIsCrouched);
+		TestEqual(FString::Printf(TEXT("%s timestamp"), What), Actual.RepTimeStamp, Expected.RepTimeStamp);
+	};
+
+	int64 TotalKeyframeBits = 0;
+	int64 TotalDeltaBits = 0;
+	int32 NumDeltas = 0;
+
+	for (int32 Iteration = 0; Iteration < 200; ++Iteration)
+	{
+		// 关键帧：完整发送，量化精度跟着一起过去
+		FSharedRepMovement ServerKeyframe = MakeMovement(Random, RandomVector(Random, 100000.0f), RandomRotator(Random), RandomVector(Random, 1000.0f));
+		ServerKeyframe.bIsKeyframe = true;
+		ServerKeyframe.KeyframeId = static_cast<uint8>(Iteration);
+
+		int64 KeyframeBits = 0;
+		const FSharedRepMovement ClientKeyframe = SendOverNetwork(ServerKeyframe, KeyframeBits);
+		TotalKeyframeBits += KeyframeBits;
+
+		TestTrue(TEXT("Keyframe flag survives"), ClientKeyframe.bIsKeyframe);
+		TestEqual(TEXT("Keyframe id survives"), ClientKeyframe.KeyframeId, ServerKeyframe.KeyframeId);
+		TestEqual(TEXT("Keyframe location quantization"), ClientKeyframe.RepMovement.LocationQuantizationLevel, ServerKeyframe.RepMovement.LocationQuantizationLevel);
+		TestEqual(TEXT("Keyframe rotation quantization"), ClientKeyframe.RepMovement.RotationQuantizationLevel, ServerKeyframe.RepMovement.RotationQuantizationLevel);
+		TestEqual(TEXT("Keyframe velocity quantization"), ClientKeyframe.RepMovement.VelocityQuantizationLevel, ServerKeyframe.RepMovement.VelocityQuantizationLevel);
+		TestMovementEqual(TEXT("Keyframe"), ClientKeyframe, ServerKeyframe);
+
+		// 差量：小范围移动，旋转偶尔跨越 0/360
+		for (int32 Step = 0; Step < 4; ++Step)
+		{
+			FRotator Rotation = ServerKeyframe.RepMovement.Rotation + FRotator(Random.FRandRange(-10.0f, 10.0f), Random.FRandRange(-30.0f, 30.0f), 0.0f);
+			if (Step == 3)
+			{
+				Rotation.Yaw = FRotator::NormalizeAxis(ServerKeyframe.RepMovement.Rotation.Yaw + 180.0f);
+			}
+
+			FSharedRepMovement ServerDelta = MakeMovement(Random,
+				ServerKeyframe.RepMovement.Location + RandomVector(Random, 500.0f),
+				Rotation,
+				ServerKeyframe.RepMovement.LinearVelocity + RandomVector(Random, 200.0f));
+
+			if (!TestTrue(TEXT("Small move encodes as a delta"), ServerDelta.EncodeDelta(ServerKeyframe)))
+			{
+				continue;
+			}
+
+			int64 DeltaBits = 0;
+			FSharedRepMovement ClientDelta = SendOverNetwork(ServerDelta, DeltaBits);
+			TotalDeltaBits += DeltaBits;
+			++NumDeltas;
+
+			TestFalse(TEXT("Delta flag survives"), ClientDelta.bIsKeyframe);
+			TestTrue(TEXT("Delta resolves against its keyframe"), ClientDelta.ResolveDelta(ClientKeyframe));
+			TestMovementEqual(TEXT("Delta"), ClientDelta, ServerDelta);
+
+			// 换了关键帧的客户端必须丢掉这个差量
+			FSharedRepMovement OtherKeyframe = ClientKeyframe;
+			OtherKeyframe.KeyframeId = static_cast<uint8>(ClientKeyframe.KeyframeId + 1);
+			FSharedRepMovement StaleDelta = SendOverNetwork(ServerDelta, DeltaBits);
+			TestFalse(TEXT("Delta rejects a different keyframe"), StaleDelta.ResolveDelta(OtherKeyframe));
+		}
+
+		// 超出范围或者量化精度变了，必须退回关键帧
+		FSharedRepMovement FarMove = MakeMovement(Random, ServerKeyframe.RepMovement.Location + FVector(20000.0f, 0.0f, 0.0f), ServerKeyframe.RepMovement.Rotation, ServerKeyframe.RepMovement.LinearVelocity);
+		TestFalse(TEXT("Out of range move needs a keyframe"), FarMove.EncodeDelta(ServerKeyframe));
+
+		FSharedRepMovement RequantizedMove = MakeMovement(Random, ServerKeyframe.RepMovement.Location, ServerKeyframe.RepMovement.Rotation, ServerKeyframe.RepMovement.LinearVelocity);
+		RequantizedMove.RepMovement.LocationQuantizationLevel = EVectorQuantization::RoundWholeNumber;
+		TestFalse(TEXT("Quantization change needs a keyframe"), RequantizedMove.EncodeDelta(ServerKeyframe));
+	}
+
+	if (NumDeltas > 0)
+	{
+		const double AverageKeyframeBits = static_cast<double>(TotalKeyframeBits) / 200.0;
+		const double AverageDeltaBits = static_cast<double>(TotalDeltaBits) / NumDeltas;
+		AddInfo(FString::Printf(TEXT("Average keyframe %.1f bits, average delta %.1f bits"), AverageKeyframeBits, AverageDeltaBits));
+		TestTrue(TEXT("Deltas are smaller than keyframes"), AverageDeltaBits < AverageKeyframeBits);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroSharedRepMovementBandwidthTest, "EqZero.Character.SharedRepMovement.Bandwidth", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FEqZeroSharedRepMovementBandwidthTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroCharacterTests;
+
+	const AEqZeroCharacter* CharacterDefaults = GetDefault<AEqZeroCharacter>();
+	const TArray<TArray<FRecordedMovementSample>> Corpus = RecordMovementCorpus();
+
+	int64 NumSamples = 0;
+	int64 LegacyBits = 0;
+	int64 LegacySends = 0;
+	int64 NewBits = 0;
+	int64 NewSends = 0;
+	int64 NumKeyframes = 0;
+	int64 NumUnresolved = 0;
+	FQuantizationError LegacyError;
+	FQuantizationError NewError;
+
+	for (const TArray<FRecordedMovementSample>& Samples : Corpus)
+	{
+		// 和 AEqZeroCharacter::UpdateSharedReplication 相同的发送规则
+		FSharedRepMovement LegacyLastSent;
+		bool bLegacyHasSent = false;
+
+		FSharedRepMovement ServerKeyframe;
+		FSharedRepMovement ServerLastSent;
+		bool bHasServerKeyframe = false;
+		double NextKeyframeTime = 0.0;
+
+		FSharedRepMovement ClientKeyframe;
+		bool bHasClientKeyframe = false;
+
+		for (const FRecordedMovementSample& Sample : Samples)
+		{
+			++NumSamples;
+
+			// 旧格式：位置两位小数，旋转和速度用 FRepMovement 的默认精度
+			FSharedRepMovement LegacyMovement;
+			LegacyMovement.RepMovement.Location = Sample.Location;
+			LegacyMovement.RepMovement.Rotation = Sample.Rotation;
+			LegacyMovement.RepMovement.LinearVelocity = Sample.Velocity;
+			LegacyMovement.RepMovementMode = Sample.MovementMode;
+			LegacyMovement.bIsCrouched = Sample.bIsCrouched;
+			LegacyMovement.RepTimeStamp = Sample.Time;
+			if (!bLegacyHasSent || !LegacyMovement.Equals(LegacyLastSent, nullptr))
+			{
+				int64 Bits = 0;
+				const FSharedRepMovement ClientMovement = SendLegacyOverNetwork(LegacyMovement, Bits);
+				LegacyBits += Bits;
+				++LegacySends;
+				LegacyError.Add(ClientMovement, Sample);
+				LegacyLastSent = LegacyMovement;
+				bLegacyHasSent = true;
+			}
+
+			FSharedRepMovement Movement;
+			Movement.RepMovement.LocationQuantizationLevel = CharacterDefaults->SharedRepLocationQuantization;
+			Movement.RepMovement.RotationQuantizationLevel = CharacterDefaults->SharedRepRotationQuantization;
+			Movement.RepMovement.VelocityQuantizationLevel = CharacterDefaults->SharedRepVelocityQuantization;
+			Movement.RepMovement.Location = Sample.Location;
+			Movement.RepMovement.Rotation = Sample.Rotation;
+			Movement.RepMovement.LinearVelocity = Sample.Velocity;
+			Movement.RepMovementMode = Sample.MovementMode;
+			Movement.bIsCrouched = Sample.bIsCrouched;
+			Movement.RepTimeStamp = Sample.Time;
+			Movement.Quantize();
+
+			const bool bKeyframeDue = !bHasServerKeyframe || (Sample.Time >= NextKeyframeTime);
+			const bool bChanged = !bHasServerKeyframe || !Movement.Equals(ServerLastSent, nullptr);
+			if (!bChanged && !(bKeyframeDue && !ServerLastSent.bIsKeyframe))
+			{
+				continue;
+			}
+
+			if (bKeyframeDue || !Movement.EncodeDelta(ServerKeyframe))
+			{
+				Movement.bIsKeyframe = true;
+				Movement.KeyframeId = bHasServerKeyframe ? static_cast<uint8>(ServerKeyframe.KeyframeId + 1) : 0;
+				ServerKeyframe = Movement;
+				bHasServerKeyframe = true;
+				NextKeyframeTime = Sample.Time + CharacterDefaults->SharedRepKeyframeInterval;
+				++NumKeyframes;
+			}
+			ServerLastSent = Movement;
+
+			int64 Bits = 0;
+			FSharedRepMovement ClientMovement = SendOverNetwork(Movement, Bits);
+			NewBits += Bits;
+			++NewSends;
+
+			if (ClientMovement.bIsKeyframe)
+			{
+				ClientKeyframe = ClientMovement;
+				bHasClientKeyframe = true;
+			}
+			else if (!bHasClientKeyframe || !ClientMovement.ResolveDelta(ClientKeyframe))
+			{
+				++NumUnresolved;
+				continue;
+			}
+			NewError.Add(ClientMovement, Sample);
+		}
+	}
+
+	const double Seconds = RecordedSeconds;
+	const double LegacyBitsPerSample = static_cast<double>(LegacyBits) / NumSamples;
+	const double NewBitsPerSample = static_cast<double>(NewBits) / NumSamples;
+	const double Saving = 1.0 - NewBitsPerSample / LegacyBitsPerSample;
+	const double LegacyBitsPerCharacterSecond = LegacyBits / (NumRecordedCharacters * Seconds);
+	const double NewBitsPerCharacterSecond = NewBits / (NumRecordedCharacters * Seconds);
+
+	AddInfo(FString::Printf(TEXT("%lld samples from %d characters at %.0f Hz over %.0f s"), NumSamples, NumRecordedCharacters, RecordedNetRate, Seconds));
+	AddInfo(FString::Printf(TEXT("Old: %lld sends, %.1f bits/sample, %.0f bits/s per character"), LegacySends, LegacyBitsPerSample, LegacyBitsPerCharacterSecond));
+	AddInfo(FString::Printf(TEXT("New: %lld sends (%lld keyframes), %.1f bits/sample, %.0f bits/s per character, %.1f%% saving"), NewSends, NumKeyframes, NewBitsPerSample, NewBitsPerCharacterSecond, Saving * 100.0));
+	AddInfo(FString::Printf(TEXT("64-player server sends %.2f Mbit/s old, %.2f Mbit/s new (every character to 63 clients)"),
+		LegacyBitsPerCharacterSecond * NumRecordedCharacters * (NumRecordedCharacters - 1) / 1e6, NewBitsPerCharacterSecond * NumRecordedCharacters * (NumRecordedCharacters - 1) / 1e6));
+	AddInfo(FString::Printf(TEXT("Max error old: location %.4f, rotation %.4f, velocity %.4f; new: location %.4f, rotation %.4f, velocity %.4f"),
+		LegacyError.Location, LegacyError.Rotation, LegacyError.Velocity, NewError.Location, NewError.Rotation, NewError.Velocity));
+
+	TestEqual(TEXT("Every delta resolves against the client's keyframe"), NumUnresolved, 0ll);
+
+	// 差量只在静止时补发关键帧，发送次数最多比旧格式多出关键帧的个数
+	TestTrue(TEXT("New format sends at most one extra keyframe per interval"), NewSends <= LegacySends + NumKeyframes);
+	TestTrue(TEXT("New format saves at least 15% of the bits per sample"), Saving >= 0.15);
+
+	// 精度和旧格式相同，差量编码不能带来额外的误差
+	TestTrue(TEXT("Location error stays within half a quantization step"), NewError.Location <= 0.5 / 100.0 + UE_KINDA_SMALL_NUMBER);
+	TestTrue(TEXT("Velocity error stays within half a quantization step"), NewError.Velocity <= 0.5 + UE_KINDA_SMALL_NUMBER);
+	TestTrue(TEXT("Location error is no worse than the old format"), NewError.Location <= LegacyError.Location + UE_KINDA_SMALL_NUMBER);
+	TestTrue(TEXT("Rotation error is no worse than the old format"), NewError.Rotation <= LegacyError.Rotation + UE_KINDA_SMALL_NUMBER);
+	TestTrue(TEXT("Velocity error is no worse than the old format"), NewError.Velocity <= LegacyError.Velocity + UE_KINDA_SMALL_NUMBER);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,281 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Cosmetics/EqZeroCosmeticAnimationTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimSingleNodeInstance.h"
+#include "Engine/SkeletalMesh.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+namespace EqZeroCosmeticSelectionTests
+{
+	constexpr int32 NumTags = 24;
+	constexpr int32 NumMeshes = 8;
+	constexpr int32 NumRuleSets = 50;
+	constexpr int32 MaxRulesPerSet = 20;
+	constexpr int32 NumQueriesPerSet = 200;
+	constexpr int32 NumBenchmarkSelections = 100000;
+
+	struct FScopedCacheSelection
+	{
+		explicit FScopedCacheSelection(bool bCache)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(TEXT("EqZero.Cosmetics.CacheSelection")))
+		{
+			if (CVar)
+			{
+				bPrevious = CVar->GetBool();
+				CVar->Set(bCache, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedCacheSelection()
+		{
+			if (CVar)
+			{
+				CVar->Set(bPrevious, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* CVar = nullptr;
+		bool bPrevious = true;
+	};
+
+	/** 用项目里已注册的标签，按名字排序保证随机结果稳定 */
+	static TArray<FGameplayTag> GetTestTags()
+	{
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, /*OnlyIncludeDictionaryTags=*/ false);
+		TArray<FGameplayTag> Tags;
+		AllTags.GetGameplayTagArray(Tags);
+		Tags.Sort([](const FGameplayTag& A, const FGameplayTag& B) { return A.GetTagName().LexicalLess(B.GetTagName()); });
+		Tags.SetNum(FMath::Min(Tags.Num(), NumTags));
+		return Tags;
+	}
+
+	static FGameplayTagContainer MakeRandomTags(FRandomStream& Random, const TArray<FGameplayTag>& Tags, int32 MaxNumTags)
+	{
+		FGameplayTagContainer Result;
+		const int32 NumToAdd = Random.RandRange(0, MaxNumTags);
+		for (int32 Index = 0; Index < NumToAdd; ++Index)
+		{
+			Result.AddTag(Tags[Random.RandHelper(Tags.Num())]);
+		}
+		return Result;
+	}
+
+	/** 同样的标签换一个添加顺序，哈希必须命中同一个结果 */
+	static FGameplayTagContainer ReverseTagOrder(const FGameplayTagContainer& CosmeticTags)
+	{
+		TArray<FGameplayTag> TagArray;
+		CosmeticTags.GetGameplayTagArray(TagArray);
+
+		FGameplayTagContainer Result;
+		for (int32 Index = TagArray.Num() - 1; Index >= 0; --Index)
+		{
+			Result.AddTag(TagArray[Index]);
+		}
+		return Result;
+	}
+
+	static TSubclassOf<UAnimInstance> SelectLayerUncached(const FEqZeroAnimLayerSelectionSet& RuleSet, const FGameplayTagContainer& CosmeticTags)
+	{
+		const FScopedCacheSelection DisableCache(false);
+		return RuleSet.SelectBestLayer(CosmeticTags);
+	}
+
+	static USkeletalMesh* SelectBodyStyleUncached(const FEqZeroAnimBodyStyleSelectionSet& RuleSet, const FGameplayTagContainer& CosmeticTags)
+	{
+		const FScopedCacheSelection DisableCache(false);
+		return RuleSet.SelectBestBodyStyle(CosmeticTags);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroCosmeticSelectionCacheTest, "EqZero.Cosmetics.Selection.CachedMatchesUncached", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroCosmeticSelectionCacheTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroCosmeticSelectionTests;
+
+	const TArray<FGameplayTag> Tags = GetTestTags();
+	if (Tags.Num() < 4)
+	{
+		AddWarning(TEXT("Not enough gameplay tags registered to build the selection corpus"));
+		return true;
+	}
+
+	const FScopedCacheSelection EnableCache(true);
+
+	TArray<USkeletalMesh*> Meshes;
+	for (int32 MeshIndex = 0; MeshIndex < NumMeshes; ++MeshIndex)
+	{
+		Meshes.Add(NewObject<USkeletalMesh>(GetTransientPackage()));
+	}
+
+	// 空的层和网格会被跳过，也要覆盖到
+	const TSubclassOf<UAnimInstance> Layers[] = { nullptr, UAnimInstance::StaticClass(), UAnimSingleNodeInstance::StaticClass() };
+
+	FRandomStream Random(0xC05E7);
+	int32 NumLayerMismatches = 0;
+	int32 NumBodyStyleMismatches = 0;
+	int32 NumRuleHits = 0;
+	int32 NumSelections = 0;
+
+	for (int32 SetIndex = 0; SetIndex < NumRuleSets; ++SetIndex)
+	{
+		FEqZeroAnimLayerSelectionSet LayerSet;
+		LayerSet.DefaultLayer = UAnimInstance::StaticClass();
+		FEqZeroAnimBodyStyleSelectionSet BodyStyleSet;
+
+		const int32 NumRules = Random.RandRange(0, MaxRulesPerSet);
+		for (int32 RuleIndex = 0; RuleIndex < NumRules; ++RuleIndex)
+		{
+			FEqZeroAnimLayerSelectionEntry& LayerRule = LayerSet.LayerRules.AddDefaulted_GetRef();
+			LayerRule.Layer = Layers[Random.RandHelper(UE_ARRAY_COUNT(Layers))];
+			LayerRule.RequiredTags = MakeRandomTags(Random, Tags, 3);
+
+			FEqZeroAnimBodyStyleSelectionEntry& BodyStyleRule = BodyStyleSet.MeshRules.AddDefaulted_GetRef();
+			BodyStyleRule.Mesh = (Random.FRand() < 0.1f) ? nullptr : Meshes[Random.RandHelper(Meshes.Num())];
+			BodyStyleRule.RequiredTags = MakeRandomTags(Random, Tags, 3);
+		}
+
+		for (int32 QueryIndex = 0; QueryIndex < NumQueriesPerSet; ++QueryIndex)
+		{
+			// 一半的查询直接用某条规则的标签再加几个，保证有足够多的命中
+			FGameplayTagContainer CosmeticTags = MakeRandomTags(Random, Tags, 6);
+			if ((QueryIndex % 2 == 0) && (NumRules > 0))
+			{
+				CosmeticTags.AppendTags(BodyStyleSet.MeshRules[Random.RandHelper(NumRules)].RequiredTags);
+				CosmeticTags.AppendTags(LayerSet.LayerRules[Random.RandHelper(NumRules)].RequiredTags);
+			}
+
+			const TSubclassOf<UAnimInstance> ExpectedLayer = SelectLayerUncached(LayerSet, CosmeticTags);
+			USkeletalMesh* ExpectedMesh = SelectBodyStyleUncached(BodyStyleSet, CosmeticTags);
+			NumRuleHits += (ExpectedMesh != nullptr) ? 1 : 0;
+
+			// 第一次算出结果，第二次命中缓存，第三次换了标签顺序
+			const FGameplayTagContainer QueryVariants[] = { CosmeticTags, CosmeticTags, ReverseTagOrder(CosmeticTags) };
+			for (const FGameplayTagContainer& Query : QueryVariants)
+			{
+				NumLayerMismatches += (LayerSet.SelectBestLayer(Query) != ExpectedLayer) ? 1 : 0;
+				NumBodyStyleMismatches += (BodyStyleSet.SelectBestBodyStyle(Query) != ExpectedMesh) ? 1 : 0;
+				++NumSelections;
+			}
+		}
+
+		// 运行时改了规则内容，调过 InvalidateSelectionCache 之后要用新规则
+		if (NumRules > 0)
+		{
+			const FGameplayTagContainer CosmeticTags = MakeRandomTags(Random, Tags, 6);
+			BodyStyleSet.SelectBestBodyStyle(CosmeticTags);
+			LayerSet.SelectBestLayer(CosmeticTags);
+
+			BodyStyleSet.MeshRules[0].RequiredTags = CosmeticTags;
+			BodyStyleSet.MeshRules[0].Mesh = Meshes[0];
+			BodyStyleSet.InvalidateSelectionCache();
+			LayerSet.LayerRules[0].RequiredTags = CosmeticTags;
+			LayerSet.LayerRules[0].Layer = UAnimSingleNodeInstance::StaticClass();
+			LayerSet.InvalidateSelectionCache();
+
+			TestTrue(TEXT("Invalidated body style cache picks up the changed rule"), BodyStyleSet.SelectBestBodyStyle(CosmeticTags) == Meshes[0]);
+			TestTrue(TEXT("Invalidated layer cache picks up the changed rule"), LayerSet.SelectBestLayer(CosmeticTags) == UAnimSingleNodeInstance::StaticClass());
+		}
+
+		// 加了规则不用手动失效
+		{
+			const FGameplayTagContainer CosmeticTags = MakeRandomTags(Random, Tags, 6);
+			BodyStyleSet.SelectBestBodyStyle(CosmeticTags);
+
+			FEqZeroAnimBodyStyleSelectionEntry& AddedRule = BodyStyleSet.MeshRules.AddDefaulted_GetRef();
+			AddedRule.Mesh = Meshes[1];
+			TestTrue(TEXT("Added rule changes the cached result"), BodyStyleSet.SelectBestBodyStyle(CosmeticTags) == SelectBodyStyleUncached(BodyStyleSet, CosmeticTags));
+		}
+	}
+
+	// 编辑器里改资产时会推进全局版本号
+	{
+		FEqZeroAnimBodyStyleSelectionSet BodyStyleSet;
+		FEqZeroAnimBodyStyleSelectionEntry& Rule = BodyStyleSet.MeshRules.AddDefaulted_GetRef();
+		Rule.Mesh = Meshes[2];
+		Rule.RequiredTags.AddTag(Tags[0]);
+
+		const FGameplayTagContainer CosmeticTags(Tags[0]);
+		TestTrue(TEXT("Global generation: before the change"), BodyStyleSet.SelectBestBodyStyle(CosmeticTags) == Meshes[2]);
+
+		BodyStyleSet.MeshRules[0].RequiredTags = FGameplayTagContainer(Tags[1]);
+		FEqZeroCosmeticSelectionCache::BumpGlobalGeneration();
+		TestNull(TEXT("Global generation: after the change"), BodyStyleSet.SelectBestBodyStyle(CosmeticTags));
+	}
+
+	TestEqual(TEXT("Anim layer selections that differ from the uncached scan"), NumLayerMismatches, 0);
+	TestEqual(TEXT("Body style selections that differ from the uncached scan"), NumBodyStyleMismatches, 0);
+	TestTrue(TEXT("Corpus hits some rules"), NumRuleHits > 0);
+	AddInfo(FString::Printf(TEXT("%d rule sets, %d selections compared, %d queries matched a body style rule"), NumRuleSets, NumSelections, NumRuleHits));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroCosmeticSelectionBenchmarkTest, "EqZero.Cosmetics.Selection.Benchmark", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FEqZeroCosmeticSelectionBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroCosmeticSelectionTests;
+
+	const TArray<FGameplayTag> Tags = GetTestTags();
+	if (Tags.Num() < 4)
+	{
+		AddWarning(TEXT("Not enough gameplay tags registered to run the benchmark"));
+		return true;
+	}
+
+	// 和角色上的配置差不多：二十条规则，换装和重生时只会出现少数几种标签组合
+	FRandomStream Random(0xB0D1);
+	FEqZeroAnimBodyStyleSelectionSet BodyStyleSet;
+	for (int32 RuleIndex = 0; RuleIndex < MaxRulesPerSet; ++RuleIndex)
+	{
+		FEqZeroAnimBodyStyleSelectionEntry& Rule = BodyStyleSet.MeshRules.AddDefaulted_GetRef();
+		Rule.Mesh = NewObject<USkeletalMesh>(GetTransientPackage());
+		Rule.RequiredTags = MakeRandomTags(Random, Tags, 3);
+	}
+
+	TArray<FGameplayTagContainer> Queries;
+	for (int32 QueryIndex = 0; QueryIndex < 16; ++QueryIndex)
+	{
+		Queries.Add(MakeRandomTags(Random, Tags, 6));
+	}
+
+	auto TimeSelections = [&BodyStyleSet, &Queries](bool bCache, TArray<USkeletalMesh*>& OutResults)
+	{
+		const FScopedCacheSelection ScopedCache(bCache);
+		OutResults.Reset(Queries.Num());
+		for (const FGameplayTagContainer& Query : Queries)
+		{
+			OutResults.Add(BodyStyleSet.SelectBestBodyStyle(Query));
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumBenchmarkSelections; ++Iteration)
+		{
+			BodyStyleSet.SelectBestBodyStyle(Queries[Iteration % Queries.Num()]);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	TArray<USkeletalMesh*> CachedResults;
+	TArray<USkeletalMesh*> UncachedResults;
+	const double CachedSeconds = TimeSelections(/*bCache=*/ true, CachedResults);
+	const double UncachedSeconds = TimeSelections(/*bCache=*/ false, UncachedResults);
+
+	TestTrue(TEXT("Cached and uncached selections match"), CachedResults == UncachedResults);
+	AddInfo(FString::Printf(TEXT("%d selections over %d rules: cached %.3f ms, uncached %.3f ms"), NumBenchmarkSelections, BodyStyleSet.MeshRules.Num(), CachedSeconds * 1000.0, UncachedSeconds * 1000.0));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
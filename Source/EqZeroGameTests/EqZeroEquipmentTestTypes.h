@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Equipment/EqZeroEquipmentDefinition.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Inventory/EqZeroInventoryItemDefinition.h"
+
+#include "EqZeroEquipmentTestTypes.generated.h"
+
+class UEqZeroEquipmentManagerComponent;
+class UEqZeroInventoryManagerComponent;
+class UEqZeroQuickBarComponent;
+
+/**
+ * AEqZeroEquipmentTestActor
+ *
+ *	自动化测试用的装备 Actor，只有一个场景根组件
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class AEqZeroEquipmentTestActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AEqZeroEquipmentTestActor();
+};
+
+/**
+ * UEqZeroPooledEquipmentTestDefinition
+ *
+ *	生成两个打开了 bAllowPooling 的测试 Actor 的装备
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UEqZeroPooledEquipmentTestDefinition : public UEqZeroEquipmentDefinition
+{
+	GENERATED_BODY()
+
+public:
+	UEqZeroPooledEquipmentTestDefinition(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
+
+/**
+ * UEqZeroPooledEquipmentTestItem
+ *
+ *	可装备的测试道具，装备定义是 UEqZeroPooledEquipmentTestDefinition
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UEqZeroPooledEquipmentTestItem : public UEqZeroInventoryItemDefinition
+{
+	GENERATED_BODY()
+
+public:
+	UEqZeroPooledEquipmentTestItem(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
+
+/**
+ * AEqZeroEquipmentTestPawn
+ *
+ *	带装备管理组件的测试 Pawn
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class AEqZeroEquipmentTestPawn : public APawn
+{
+	GENERATED_BODY()
+
+public:
+	AEqZeroEquipmentTestPawn(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+private:
+	UPROPERTY()
+	TObjectPtr<UEqZeroEquipmentManagerComponent> EquipmentManager;
+};
+
+/**
+ * AEqZeroQuickBarTestController
+ *
+ *	带背包和快捷栏的测试 Controller
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class AEqZeroQuickBarTestController : public AController
+{
+	GENERATED_BODY()
+
+public:
+	AEqZeroQuickBarTestController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	UEqZeroInventoryManagerComponent* GetInventory() const { return Inventory; }
+	UEqZeroQuickBarComponent* GetQuickBar() const { return QuickBar; }
+
+private:
+	UPROPERTY()
+	TObjectPtr<UEqZeroInventoryManagerComponent> Inventory;
+
+	UPROPERTY()
+	TObjectPtr<UEqZeroQuickBarComponent> QuickBar;
+};
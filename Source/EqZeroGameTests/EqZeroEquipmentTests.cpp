@@ -0,0 +1,218 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqZeroEquipmentTestTypes.h"
+
+#include "Components/SceneComponent.h"
+#include "Equipment/EqZeroEquipmentManagerComponent.h"
+#include "Equipment/EqZeroQuickBarComponent.h"
+#include "Inventory/EqZeroInventoryManagerComponent.h"
+#include "Inventory/InventoryFragment_EquippableItem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroEquipmentTestTypes)
+
+AEqZeroEquipmentTestActor::AEqZeroEquipmentTestActor()
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+UEqZeroPooledEquipmentTestDefinition::UEqZeroPooledEquipmentTestDefinition(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// 一件装备两个 Actor，类似武器加挂件
+	for (int32 ActorIndex = 0; ActorIndex < 2; ++ActorIndex)
+	{
+		FEqZeroEquipmentActorToSpawn& SpawnInfo = ActorsToSpawn.AddDefaulted_GetRef();
+		SpawnInfo.ActorToSpawn = AEqZeroEquipmentTestActor::StaticClass();
+		SpawnInfo.AttachTransform = FTransform(FVector(0.0f, 10.0f * ActorIndex, 0.0f));
+		SpawnInfo.bAllowPooling = true;
+	}
+}
+
+UEqZeroPooledEquipmentTestItem::UEqZeroPooledEquipmentTestItem(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	UInventoryFragment_EquippableItem* Equippable = CreateDefaultSubobject<UInventoryFragment_EquippableItem>(TEXT("Equippable"));
+	Equippable->EquipmentDefinition = UEqZeroPooledEquipmentTestDefinition::StaticClass();
+	Fragments.Add(Equippable);
+}
+
+AEqZeroEquipmentTestPawn::AEqZeroEquipmentTestPawn(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	EquipmentManager = CreateDefaultSubobject<UEqZeroEquipmentManagerComponent>(TEXT("EquipmentManager"));
+}
+
+AEqZeroQuickBarTestController::AEqZeroQuickBarTestController(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	Inventory = CreateDefaultSubobject<UEqZeroInventoryManagerComponent>(TEXT("Inventory"));
+	QuickBar = CreateDefaultSubobject<UEqZeroQuickBarComponent>(TEXT("QuickBar"));
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EngineUtils.h"
+#include "EqZeroTestWorld.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "System/EqZeroActorPoolSubsystem.h"
+
+namespace EqZeroEquipmentTests
+{
+	constexpr int32 NumCycles = 10000;
+	constexpr int32 CheckInterval = 500;
+	constexpr int32 NumActorsPerItem = 2;
+
+	struct FScopedConsoleVariable
+	{
+		FScopedConsoleVariable(const TCHAR* Name, const TCHAR* Value)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (CVar)
+			{
+				PreviousValue = CVar->GetString();
+				CVar->Set(Value, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedConsoleVariable()
+		{
+			if (CVar)
+			{
+				CVar->Set(*PreviousValue, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* CVar = nullptr;
+		FString PreviousValue;
+	};
+
+	struct FEquipmentActorCounts
+	{
+		// 世界里所有有效的测试装备 Actor，包括池里停放的
+		int32 NumAlive = 0;
+
+		// 挂在 Pawn 上并且可见的
+		int32 NumEquipped = 0;
+	};
+
+	static FEquipmentActorCounts CountEquipmentActors(UWorld* World, const APawn* Pawn)
+	{
+		FEquipmentActorCounts Counts;
+		for (TActorIterator<AEqZeroEquipmentTestActor> It(World); It; ++It)
+		{
+			++Counts.NumAlive;
+			if (It->GetAttachParentActor() == Pawn && !It->IsHidden())
+			{
+				++Counts.NumEquipped;
+			}
+		}
+		return Counts;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroQuickBarEquipStressTest, "EqZero.Equipment.QuickBar.EquipCycleStress", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroQuickBarEquipStressTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroEquipmentTests;
+
+	const FScopedConsoleVariable EnablePool(TEXT("EqZero.ActorPool.Enabled"), TEXT("1"));
+
+	double UnpooledSeconds = 0.0;
+	for (const bool bPoolActors : { false, true })
+	{
+		const TCHAR* ModeName = bPoolActors ? TEXT("Pooled") : TEXT("Unpooled");
+		const FScopedConsoleVariable PoolEquipmentActors(TEXT("EqZero.Equipment.PoolActors"), bPoolActors ? TEXT("1") : TEXT("0"));
+
+		// 快捷栏切换会广播 GameplayMessage，需要 GameInstance
+		FEqZeroScopedTestWorld TestWorld(EWorldType::Game, /*bWithGameInstance=*/ true);
+		UEqZeroActorPoolSubsystem* ActorPool = UEqZeroActorPoolSubsystem::Get(TestWorld.Get());
+		if (!TestNotNull(*FString::Printf(TEXT("%s: actor pool"), ModeName), ActorPool))
+		{
+			return false;
+		}
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AEqZeroEquipmentTestPawn* Pawn = TestWorld->SpawnActor<AEqZeroEquipmentTestPawn>(SpawnParameters);
+		AEqZeroQuickBarTestController* Controller = TestWorld->SpawnActor<AEqZeroQuickBarTestController>(SpawnParameters);
+		if (!TestNotNull(*FString::Printf(TEXT("%s: pawn"), ModeName), Pawn) || !TestNotNull(*FString::Printf(TEXT("%s: controller"), ModeName), Controller))
+		{
+			return false;
+		}
+		Controller->Possess(Pawn);
+
+		// 每个槽位放一个可装备道具，切换时总是先卸下再装备
+		UEqZeroQuickBarComponent* QuickBar = Controller->GetQuickBar();
+		const int32 NumSlots = QuickBar->GetSlots().Num();
+		for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+		{
+			QuickBar->AddItemToSlot(SlotIndex, Controller->GetInventory()->AddItemDefinition(UEqZeroPooledEquipmentTestItem::StaticClass()));
+		}
+		if (!TestTrue(*FString::Printf(TEXT("%s: quick bar has several filled slots"), ModeName), NumSlots >= 2 && QuickBar->GetNextFreeItemSlot() == INDEX_NONE))
+		{
+			return false;
+		}
+
+		int32 MaxAlive = 0;
+		int32 NumBadCheckpoints = 0;
+		double Seconds = 0.0;
+		for (int32 Cycle = 0; Cycle < NumCycles; Cycle += CheckInterval)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Step = 0; Step < CheckInterval; ++Step)
+			{
+				QuickBar->CycleActiveSlotForward();
+			}
+			Seconds += FPlatformTime::Seconds() - StartTime;
+
+			TestWorld.Tick();
+
+			// 任何时候都只有当前槽位的装备 Actor 活着，并且挂在 Pawn 上可见
+			const FEquipmentActorCounts Counts = CountEquipmentActors(TestWorld.Get(), Pawn);
+			MaxAlive = FMath::Max(MaxAlive, Counts.NumAlive);
+			NumBadCheckpoints += (Counts.NumAlive == NumActorsPerItem && Counts.NumEquipped == NumActorsPerItem) ? 0 : 1;
+		}
+
+		TestEqual(*FString::Printf(TEXT("%s: active slot after %d cycles"), ModeName, NumCycles), QuickBar->GetActiveSlotIndex(), (NumCycles - 1) % NumSlots);
+		TestEqual(*FString::Printf(TEXT("%s: live equipment actors never exceed one item's worth"), ModeName), MaxAlive, NumActorsPerItem);
+		TestEqual(*FString::Printf(TEXT("%s: every checkpoint has exactly the equipped actors attached and visible"), ModeName), NumBadCheckpoints, 0);
+
+		const uint64 NumSwitches = NumCycles - 1;
+		if (bPoolActors)
+		{
+			// 只有第一次装备真正生成，之后每次切换都是先回收再复用
+			TestEqual(TEXT("Pooled: spawned"), ActorPool->GetNumSpawned(), static_cast<uint64>(NumActorsPerItem));
+			TestEqual(TEXT("Pooled: reused"), ActorPool->GetNumReused(), NumSwitches * NumActorsPerItem);
+			TestEqual(TEXT("Pooled: released"), ActorPool->GetNumReleased(), NumSwitches * NumActorsPerItem);
+			TestEqual(TEXT("Pooled: destroyed"), ActorPool->GetNumDestroyed(), 0ull);
+
+			// 卸下最后一件装备，Actor 停放在池里而不是销毁
+			QuickBar->RemoveItemFromSlot(QuickBar->GetActiveSlotIndex());
+			const FEquipmentActorCounts Counts = CountEquipmentActors(TestWorld.Get(), Pawn);
+			TestEqual(TEXT("Pooled: unequipped actors are parked"), ActorPool->GetNumPooledActors(), NumActorsPerItem);
+			TestEqual(TEXT("Pooled: parked actors stay alive"), Counts.NumAlive, NumActorsPerItem);
+			TestEqual(TEXT("Pooled: parked actors are detached or hidden"), Counts.NumEquipped, 0);
+		}
+		else
+		{
+			TestEqual(TEXT("Unpooled: nothing spawned from the pool"), ActorPool->GetNumSpawned(), 0ull);
+			TestEqual(TEXT("Unpooled: nothing released to the pool"), ActorPool->GetNumReleased(), 0ull);
+		}
+
+		AddInfo(FString::Printf(TEXT("%s: %d quick bar switches x %d actors in %.2f ms (%.2f us/switch)%s"),
+			ModeName, NumCycles, NumActorsPerItem, Seconds * 1000.0, Seconds * 1e6 / NumCycles,
+			bPoolActors && Seconds > 0.0 ? *FString::Printf(TEXT(", %.2fx vs unpooled"), UnpooledSeconds / Seconds) : TEXT("")));
+		if (!bPoolActors)
+		{
+			UnpooledSeconds = Seconds;
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameModes/EqZeroExperienceManagerComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Containers/Ticker.h"
+#include "EqZeroTestWorld.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameModes/EqZeroExperienceActionSet.h"
+#include "GameModes/EqZeroExperienceDefinition.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+#include "System/EqZeroAssetManager.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace EqZeroExperienceTests
+{
+	// 每个体验都要加载 GameFeature，数量有上限
+	constexpr int32 MaxExperiencesToTest = 4;
+	constexpr int32 MaxLoadTicks = 3000;
+
+	struct FDeclaredPreloads
+	{
+		TArray<FSoftObjectPath> Assets;
+		TArray<FPrimaryAssetId> PrimaryAssets;
+
+		bool IsEmpty() const { return Assets.IsEmpty() && PrimaryAssets.IsEmpty(); }
+	};
+
+	static FDeclaredPreloads GatherDeclaredPreloads(const UEqZeroExperienceDefinition* Experience)
+	{
+		FDeclaredPreloads Preloads;
+		auto AddList = [&Preloads](const TArray<FSoftObjectPath>& PreloadAssets, const TArray<FPrimaryAssetId>& PreloadPrimaryAssets)
+		{
+			for (const FSoftObjectPath& AssetPath : PreloadAssets)
+			{
+				if (!AssetPath.IsNull())
+				{
+					Preloads.Assets.AddUnique(AssetPath);
+				}
+			}
+			for (const FPrimaryAssetId& AssetId : PreloadPrimaryAssets)
+			{
+				if (AssetId.IsValid())
+				{
+					Preloads.PrimaryAssets.AddUnique(AssetId);
+				}
+			}
+		};
+
+		AddList(Experience->PreloadAssets, Experience->PreloadPrimaryAssets);
+		for (const TObjectPtr<UEqZeroExperienceActionSet>& ActionSet : Experience->ActionSets)
+		{
+			if (ActionSet != nullptr)
+			{
+				AddList(ActionSet->PreloadAssets, ActionSet->PreloadPrimaryAssets);
+			}
+		}
+		return Preloads;
+	}
+
+	// 体验定义是蓝图类，CDO 上才有配置
+	static const UEqZeroExperienceDefinition* LoadExperienceDefinition(const FPrimaryAssetId& ExperienceId)
+	{
+		const UClass* ExperienceClass = Cast<UClass>(UEqZeroAssetManager::Get().GetPrimaryAssetPath(ExperienceId).TryLoad());
+		return ExperienceClass ? Cast<UEqZeroExperienceDefinition>(ExperienceClass->GetDefaultObject()) : nullptr;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroExperiencePreloadNoSyncLoadTest, "EqZero.Experience.Preload.NoSyncLoadsAfterLoad", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroExperiencePreloadNoSyncLoadTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroExperienceTests;
+
+	UEqZeroAssetManager& AssetManager = UEqZeroAssetManager::Get();
+
+	// 只测声明了预加载资源的体验
+	TArray<FPrimaryAssetId> AllExperienceIds;
+	AssetManager.GetPrimaryAssetIdList(FPrimaryAssetType("EqZeroExperienceDefinition"), AllExperienceIds);
+	AllExperienceIds.Sort([](const FPrimaryAssetId& A, const FPrimaryAssetId& B) { return A.ToString() < B.ToString(); });
+
+	TArray<FPrimaryAssetId> ExperienceIds;
+	for (const FPrimaryAssetId& ExperienceId : AllExperienceIds)
+	{
+		const UEqZeroExperienceDefinition* Experience = LoadExperienceDefinition(ExperienceId);
+		if (Experience && !GatherDeclaredPreloads(Experience).IsEmpty())
+		{
+			ExperienceIds.Add(ExperienceId);
+			if (ExperienceIds.Num() >= MaxExperiencesToTest)
+			{
+				break;
+			}
+		}
+	}
+
+	if (ExperienceIds.IsEmpty())
+	{
+		AddInfo(FString::Printf(TEXT("None of the %d experiences declare preload assets, nothing to check"), AllExperienceIds.Num()));
+		return true;
+	}
+
+	for (const FPrimaryAssetId& ExperienceId : ExperienceIds)
+	{
+		const FString ExperienceName = ExperienceId.ToString();
+		const FDeclaredPreloads Preloads = GatherDeclaredPreloads(LoadExperienceDefinition(ExperienceId));
+
+		// 体验管理器只需要一个有权威的 GameState，GameFeature Action 会用到 GameInstance
+		FEqZeroScopedTestWorld TestWorld(EWorldType::Game, /*bWithGameInstance=*/ true);
+		AGameStateBase* GameState = TestWorld->SpawnActor<AGameStateBase>();
+		if (!TestNotNull(*FString::Printf(TEXT("%s: game state"), *ExperienceName), GameState))
+		{
+			return false;
+		}
+
+		UEqZeroExperienceManagerComponent* ExperienceManager = NewObject<UEqZeroExperienceManagerComponent>(GameState, TEXT("ExperienceManagerComponent"));
+		ExperienceManager->RegisterComponent();
+		ExperienceManager->SetCurrentExperience(ExperienceId);
+
+		// 推进异步加载、GameFeature 状态机和世界计时器，直到体验加载完成
+		for (int32 Tick = 0; Tick < MaxLoadTicks && !ExperienceManager->IsExperienceLoaded(); ++Tick)
+		{
+			ProcessAsyncLoading(/*bUseTimeLimit=*/ true, /*bUseFullTimeLimit=*/ false, 0.005);
+			FTSTicker::GetCoreTicker().Tick(1.0f / 60.0f);
+			TestWorld.Tick();
+			FPlatformProcess::Sleep(0.001f);
+		}
+		if (!TestTrue(*FString::Printf(TEXT("%s: experience finished loading"), *ExperienceName), ExperienceManager->IsExperienceLoaded()))
+		{
+			GameState->Destroy();
+			continue;
+		}
+
+		// 加载完成后再用到声明过的资源，不能触发任何同步加载
+		TArray<FString> SyncLoadedPackages;
+		const FDelegateHandle SyncLoadHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddLambda([&SyncLoadedPackages](const FString& PackageName)
+		{
+			SyncLoadedPackages.Add(PackageName);
+		});
+
+		for (const FSoftObjectPath& AssetPath : Preloads.Assets)
+		{
+			TestNotNull(*FString::Printf(TEXT("%s: preload asset %s"), *ExperienceName, *AssetPath.ToString()), AssetPath.TryLoad());
+		}
+		for (const FPrimaryAssetId& AssetId : Preloads.PrimaryAssets)
+		{
+			TestNotNull(*FString::Printf(TEXT("%s: preload primary asset %s"), *ExperienceName, *AssetId.ToString()), AssetManager.GetPrimaryAssetPath(AssetId).TryLoad());
+		}
+
+		FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadHandle);
+
+		for (const FString& PackageName : SyncLoadedPackages)
+		{
+			AddError(FString::Printf(TEXT("%s: synchronously loaded %s after the experience finished loading"), *ExperienceName, *PackageName));
+		}
+		AddInfo(FString::Printf(TEXT("%s: %d preload assets and %d preload primary assets resident, %d synchronous loads"),
+			*ExperienceName, Preloads.Assets.Num(), Preloads.PrimaryAssets.Num(), SyncLoadedPackages.Num()));
+
+		// 停用体验启用的 GameFeature，下一个体验从干净的状态开始
+		GameState->Destroy();
+		for (int32 Tick = 0; Tick < 60; ++Tick)
+		{
+			FTSTicker::GetCoreTicker().Tick(1.0f / 60.0f);
+			TestWorld.Tick();
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// 自动化测试和测试用的类型，Shipping 不编译这个模块
+public class EqZeroGameTests : ModuleRules
+{
+	public EqZeroGameTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[] {
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"PhysicsCore",
+				"GameplayTags",
+				"GameplayTasks",
+				"GameplayAbilities",
+				"ModularGameplay",
+				"Json",
+				"EqZeroGame",
+			}
+		);
+	}
+}
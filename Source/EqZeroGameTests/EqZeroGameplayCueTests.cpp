@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilitySystem/EqZeroGameplayCueManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
+#include "EqZeroTestWorld.h"
+#include "GameFramework/Actor.h"
+#include "GameplayCueSet.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectGlobals.h"
+
+struct FEqZeroGameplayCueManagerTestAccess
+{
+	static bool IsPreloading(const UEqZeroGameplayCueManager& CueManager)
+	{
+		return !CueManager.CuesBeingPreloaded.IsEmpty();
+	}
+
+	static bool IsPreloaded(const UEqZeroGameplayCueManager& CueManager, const UClass* CueClass)
+	{
+		return CueManager.PreloadedCueClasses.Contains(CueClass);
+	}
+};
+
+namespace EqZeroGameplayCueTests
+{
+	// 用例数量有上限，工程里 Cue 很多时测试也不会太慢
+	constexpr int32 MaxCuesToTest = 16;
+	constexpr int32 NumRepeats = 5;
+	constexpr int32 MaxPreloadTicks = 600;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroGameplayCuePreloadNoSyncLoadTest, "EqZero.GameplayCues.Preload.NoSyncLoadsAfterPreload", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroGameplayCuePreloadNoSyncLoadTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroGameplayCueTests;
+
+	UEqZeroGameplayCueManager* CueManager = UEqZeroGameplayCueManager::Get();
+	UGameplayCueSet* RuntimeCueSet = CueManager ? CueManager->GetRuntimeCueSet() : nullptr;
+	if (!RuntimeCueSet)
+	{
+		AddInfo(TEXT("No EqZero gameplay cue manager or runtime cue set, nothing to check"));
+		return true;
+	}
+
+	// 只挑还没加载的 Cue，已经在内存里的测不出同步加载
+	TArray<FString> CuePaths;
+	TArray<FGameplayTag> CueTags;
+	for (const FGameplayCueNotifyData& CueData : RuntimeCueSet->GameplayCueData)
+	{
+		if (CueData.LoadedGameplayCueClass == nullptr && CueData.GameplayCueNotifyObj.IsValid() && CueData.GameplayCueNotifyObj.ResolveObject() == nullptr)
+		{
+			CuePaths.Add(CueData.GameplayCueNotifyObj.ToString());
+			CueTags.Add(CueData.GameplayCueTag);
+			if (CuePaths.Num() >= MaxCuesToTest)
+			{
+				break;
+			}
+		}
+	}
+
+	if (CuePaths.IsEmpty())
+	{
+		AddInfo(TEXT("Every runtime gameplay cue is already loaded, nothing to check"));
+		return true;
+	}
+
+	FEqZeroScopedTestWorld TestWorld;
+
+	TSharedPtr<FStreamableHandle> PreloadHandle = CueManager->PreloadGameplayCuesInPaths(CuePaths);
+	if (!TestTrue(TEXT("Preload request issued"), PreloadHandle.IsValid()))
+	{
+		return false;
+	}
+	PreloadHandle->WaitUntilComplete(0.0f, false);
+
+	// 完成回调可能推迟到下一帧才执行
+	for (int32 Tick = 0; Tick < MaxPreloadTicks && FEqZeroGameplayCueManagerTestAccess::IsPreloading(*CueManager); ++Tick)
+	{
+		FTSTicker::GetCoreTicker().Tick(1.0f / 60.0f);
+		TestWorld.Tick();
+	}
+	if (!TestFalse(TEXT("Preload finished"), FEqZeroGameplayCueManagerTestAccess::IsPreloading(*CueManager)))
+	{
+		return false;
+	}
+
+	for (const FString& CuePath : CuePaths)
+	{
+		const UClass* CueClass = Cast<UClass>(FSoftObjectPath(CuePath).ResolveObject());
+		TestTrue(FString::Printf(TEXT("%s is held by the cue manager"), *CuePath), CueClass && FEqZeroGameplayCueManagerTestAccess::IsPreloaded(*CueManager, CueClass));
+	}
+
+	// 预加载之后反复播放这些 Cue，不能再触发任何同步加载
+	TArray<FString> SyncLoadedPackages;
+	const FDelegateHandle SyncLoadHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddLambda([&SyncLoadedPackages](const FString& PackageName)
+	{
+		SyncLoadedPackages.Add(PackageName);
+	});
+
+	AActor* Target = TestWorld->SpawnActor<AActor>();
+	FGameplayCueParameters CueParameters;
+	for (int32 Repeat = 0; Repeat < NumRepeats; ++Repeat)
+	{
+		for (const FGameplayTag& CueTag : CueTags)
+		{
+			CueManager->HandleGameplayCue(Target, CueTag, EGameplayCueEvent::Executed, CueParameters);
+		}
+		CueManager->FlushPendingCues();
+		TestWorld.Tick();
+	}
+
+	FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadHandle);
+
+	for (const FString& PackageName : SyncLoadedPackages)
+	{
+		AddError(FString::Printf(TEXT("Synchronously loaded %s while firing preloaded gameplay cues"), *PackageName));
+	}
+	AddInfo(FString::Printf(TEXT("Fired %d preloaded cues %d times with %d synchronous loads"), CueTags.Num(), NumRepeats, SyncLoadedPackages.Num()));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
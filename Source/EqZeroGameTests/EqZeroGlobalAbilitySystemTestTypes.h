@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "AbilitySystemInterface.h"
+#include "GameFramework/Actor.h"
+#include "GameplayEffect.h"
+
+#include "EqZeroGlobalAbilitySystemTestTypes.generated.h"
+
+class UEqZeroAbilitySystemComponent;
+class UEqZeroCombatSet;
+
+/**
+ * AEqZeroGlobalAbilityTestActor
+ *
+ *	自动化测试用的目标，自带 ASC 和 CombatSet，自己就是 Owner 和 Avatar
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class AEqZeroGlobalAbilityTestActor : public AActor, public IAbilitySystemInterface
+{
+	GENERATED_BODY()
+
+public:
+	AEqZeroGlobalAbilityTestActor();
+
+	//~AActor interface
+	virtual void BeginPlay() override;
+	//~End of AActor interface
+
+	//~IAbilitySystemInterface
+	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
+	//~End of IAbilitySystemInterface
+
+	UEqZeroAbilitySystemComponent* GetEqZeroAbilitySystemComponent() const { return AbilitySystemComponent; }
+
+private:
+	UPROPERTY()
+	TObjectPtr<UEqZeroAbilitySystemComponent> AbilitySystemComponent;
+
+	UPROPERTY()
+	TObjectPtr<UEqZeroCombatSet> CombatSet;
+};
+
+/**
+ * UEqZeroGlobalTestEffect_Flat
+ *
+ *	BaseHeal +10，不依赖上下文，可以共用 Spec
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UEqZeroGlobalTestEffect_Flat : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UEqZeroGlobalTestEffect_Flat();
+};
+
+/**
+ * UEqZeroGlobalTestEffect_SourceCapture
+ *
+ *	BaseHeal 加上 Source 的 BaseDamage，必须每个目标用自己的上下文
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UEqZeroGlobalTestEffect_SourceCapture : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UEqZeroGlobalTestEffect_SourceCapture();
+};
+
+/**
+ * UEqZeroGlobalTestEffect_SetByCaller
+ *
+ *	BaseHeal 加上调用方设置的数值，共用的 Spec 上没有这个值，不能共用
+ */
+UCLASS(NotBlueprintable, HideDropdown, Transient)
+class UEqZeroGlobalTestEffect_SetByCaller : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UEqZeroGlobalTestEffect_SetByCaller();
+};
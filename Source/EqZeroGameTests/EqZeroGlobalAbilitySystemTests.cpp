@@ -0,0 +1,329 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqZeroGlobalAbilitySystemTestTypes.h"
+
+#include "AbilitySystem/Attributes/EqZeroCombatSet.h"
+#include "AbilitySystem/EqZeroAbilitySystemComponent.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroGlobalAbilitySystemTestTypes)
+
+AEqZeroGlobalAbilityTestActor::AEqZeroGlobalAbilityTestActor()
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	AbilitySystemComponent = CreateDefaultSubobject<UEqZeroAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+	CombatSet = CreateDefaultSubobject<UEqZeroCombatSet>(TEXT("CombatSet"));
+}
+
+void AEqZeroGlobalAbilityTestActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AbilitySystemComponent->InitAbilityActorInfo(this, this);
+}
+
+UAbilitySystemComponent* AEqZeroGlobalAbilityTestActor::GetAbilitySystemComponent() const
+{
+	return AbilitySystemComponent;
+}
+
+UEqZeroGlobalTestEffect_Flat::UEqZeroGlobalTestEffect_Flat()
+{
+	DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+	FGameplayModifierInfo& Modifier = Modifiers.AddDefaulted_GetRef();
+	Modifier.Attribute = UEqZeroCombatSet::GetBaseHealAttribute();
+	Modifier.ModifierOp = EGameplayModOp::Additive;
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(10.0f));
+}
+
+UEqZeroGlobalTestEffect_SourceCapture::UEqZeroGlobalTestEffect_SourceCapture()
+{
+	DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+	FAttributeBasedFloat SourceDamage;
+	SourceDamage.BackingAttribute = FGameplayEffectAttributeCaptureDefinition(UEqZeroCombatSet::GetBaseDamageAttribute(), EGameplayEffectAttributeCaptureSource::Source, /*bSnapshot=*/ true);
+
+	FGameplayModifierInfo& Modifier = Modifiers.AddDefaulted_GetRef();
+	Modifier.Attribute = UEqZeroCombatSet::GetBaseHealAttribute();
+	Modifier.ModifierOp = EGameplayModOp::Additive;
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(SourceDamage);
+}
+
+UEqZeroGlobalTestEffect_SetByCaller::UEqZeroGlobalTestEffect_SetByCaller()
+{
+	DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+	FSetByCallerFloat SetByCaller;
+	SetByCaller.DataName = TEXT("GlobalTestHeal");
+
+	FGameplayModifierInfo& Modifier = Modifiers.AddDefaulted_GetRef();
+	Modifier.Attribute = UEqZeroCombatSet::GetBaseHealAttribute();
+	Modifier.ModifierOp = EGameplayModOp::Additive;
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCaller);
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystem/EqZeroGlobalAbilitySystem.h"
+#include "EqZeroTestWorld.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+struct FEqZeroGlobalAbilitySystemTestAccess
+{
+	static void ProcessFrame(UEqZeroGlobalAbilitySystem& GlobalAbilitySystem, int32 MaxApplications)
+	{
+		GlobalAbilitySystem.ProcessPendingApplications(MaxApplications, /*MaxSeconds=*/ 0.0);
+	}
+
+	static bool UsesSharedSpec(const UEqZeroGlobalAbilitySystem& GlobalAbilitySystem, TSubclassOf<UGameplayEffect> Effect)
+	{
+		const FGlobalAppliedEffectList* Entry = GlobalAbilitySystem.AppliedEffects.Find(Effect);
+		return Entry && Entry->bHasSharedSpec;
+	}
+};
+
+namespace EqZeroGlobalAbilitySystemTests
+{
+	constexpr int32 NumTargets = 128;
+	constexpr int32 NumLateTargets = 16;
+	constexpr int32 MaxApplicationsPerFrame = 16;
+	constexpr float FlatHeal = 10.0f;
+
+	struct FScopedConsoleVariable
+	{
+		FScopedConsoleVariable(const TCHAR* Name, const TCHAR* Value)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (CVar)
+			{
+				PreviousValue = CVar->GetString();
+				CVar->Set(Value, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedConsoleVariable()
+		{
+			if (CVar)
+			{
+				CVar->Set(*PreviousValue, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* CVar = nullptr;
+		FString PreviousValue;
+	};
+
+	struct FTargetState
+	{
+		float BaseHeal = 0.0f;
+		int32 NumActiveEffects = 0;
+
+		bool operator==(const FTargetState& Other) const
+		{
+			return FMath::IsNearlyEqual(BaseHeal, Other.BaseHeal) && (NumActiveEffects == Other.NumActiveEffects);
+		}
+	};
+
+	struct FScenarioResult
+	{
+		TArray<FTargetState> States;
+		TArray<FTargetState> ExpectedStates;
+		bool bFlatUsesSharedSpec = false;
+		bool bSourceCaptureUsesSharedSpec = false;
+		int32 NumFrames = 0;
+		double WorstFrameSeconds = 0.0;
+	};
+
+	/**
+	 * 128 个目标应用两个全局效果，再来 16 个晚注册的目标走补齐
+	 * 补齐的回调里注销一个晚注册的目标，它的效果要被移除，其他目标不能漏
+	 */
+	static FScenarioResult RunScenario(UWorld* World, UEqZeroGlobalAbilitySystem& GlobalAbilitySystem, bool bShareEffectSpecs, bool bTimeSliced)
+	{
+		const FScopedConsoleVariable ShareEffectSpecs(TEXT("EqZero.GlobalAbilitySystem.ShareEffectSpecs"), bShareEffectSpecs ? TEXT("1") : TEXT("0"));
+		const FScopedConsoleVariable MaxPerFrame(TEXT("EqZero.GlobalAbilitySystem.MaxApplicationsPerFrame"), bTimeSliced ? *LexToString(MaxApplicationsPerFrame) : TEXT("0"));
+
+		FScenarioResult Result;
+
+		// 每一帧包括调用本身和之后按预算处理的队列，同步模式下全部在调用里做完
+		auto RunFrames = [&Result, &GlobalAbilitySystem](TFunctionRef<void()> Work)
+		{
+			double StartTime = FPlatformTime::Seconds();
+			Work();
+			do
+			{
+				Result.WorstFrameSeconds = FMath::Max(Result.WorstFrameSeconds, FPlatformTime::Seconds() - StartTime);
+				++Result.NumFrames;
+
+				if (GlobalAbilitySystem.GetNumPendingApplications() == 0)
+				{
+					break;
+				}
+
+				StartTime = FPlatformTime::Seconds();
+				FEqZeroGlobalAbilitySystemTestAccess::ProcessFrame(GlobalAbilitySystem, MaxApplicationsPerFrame);
+			}
+			while (true);
+		};
+
+		TArray<AEqZeroGlobalAbilityTestActor*> Targets;
+		auto SpawnTargets = [&Targets, World](int32 NumToSpawn)
+		{
+			for (int32 Index = 0; Index < NumToSpawn; ++Index)
+			{
+				AEqZeroGlobalAbilityTestActor* Target = World->SpawnActor<AEqZeroGlobalAbilityTestActor>();
+				Target->GetEqZeroAbilitySystemComponent()->SetNumericAttributeBase(UEqZeroCombatSet::GetBaseDamageAttribute(), static_cast<float>(Targets.Num() + 1));
+				Targets.Add(Target);
+			}
+		};
+
+		SpawnTargets(NumTargets);
+		RunFrames([&]()
+			{
+				for (AEqZeroGlobalAbilityTestActor* Target : Targets)
+				{
+					GlobalAbilitySystem.RegisterASC(Target->GetEqZeroAbilitySystemComponent());
+				}
+			});
+
+		RunFrames([&]()
+			{
+				GlobalAbilitySystem.ApplyEffectToAll(UEqZeroGlobalTestEffect_Flat::StaticClass());
+				GlobalAbilitySystem.ApplyEffectToAll(UEqZeroGlobalTestEffect_SourceCapture::StaticClass());
+			});
+
+		// 补齐到第 4 个晚注册的目标时注销已经补齐过的第 0 个，同一帧里后面的目标不能被跳过
+		SpawnTargets(NumLateTargets);
+		AEqZeroGlobalAbilityTestActor* UnregisteredTarget = Targets[NumTargets];
+		AEqZeroGlobalAbilityTestActor* UnregisteringTarget = Targets[NumTargets + 4];
+		UEqZeroGlobalAbilitySystem* GlobalAbilitySystemPtr = &GlobalAbilitySystem;
+		UnregisteringTarget->GetEqZeroAbilitySystemComponent()->GetGameplayAttributeValueChangeDelegate(UEqZeroCombatSet::GetBaseHealAttribute()).AddLambda(
+			[GlobalAbilitySystemPtr, UnregisteredTarget](const FOnAttributeChangeData&)
+			{
+				GlobalAbilitySystemPtr->UnregisterASC(UnregisteredTarget->GetEqZeroAbilitySystemComponent());
+			});
+
+		RunFrames([&]()
+			{
+				for (int32 Index = NumTargets; Index < Targets.Num(); ++Index)
+				{
+					GlobalAbilitySystem.RegisterASC(Targets[Index]->GetEqZeroAbilitySystemComponent());
+				}
+			});
+
+		Result.bFlatUsesSharedSpec = FEqZeroGlobalAbilitySystemTestAccess::UsesSharedSpec(GlobalAbilitySystem, UEqZeroGlobalTestEffect_Flat::StaticClass());
+		Result.bSourceCaptureUsesSharedSpec = FEqZeroGlobalAbilitySystemTestAccess::UsesSharedSpec(GlobalAbilitySystem, UEqZeroGlobalTestEffect_SourceCapture::StaticClass());
+
+		for (AEqZeroGlobalAbilityTestActor* Target : Targets)
+		{
+			UEqZeroAbilitySystemComponent* ASC = Target->GetEqZeroAbilitySystemComponent();
+
+			FTargetState& State = Result.States.AddDefaulted_GetRef();
+			State.BaseHeal = ASC->GetNumericAttribute(UEqZeroCombatSet::GetBaseHealAttribute());
+			State.NumActiveEffects = ASC->GetActiveGameplayEffects().GetNumGameplayEffects();
+
+			FTargetState& ExpectedState = Result.ExpectedStates.AddDefaulted_GetRef();
+			if (Target != UnregisteredTarget)
+			{
+				ExpectedState.BaseHeal = FlatHeal + ASC->GetNumericAttribute(UEqZeroCombatSet::GetBaseDamageAttribute());
+				ExpectedState.NumActiveEffects = 2;
+			}
+		}
+
+		GlobalAbilitySystem.RemoveEffectFromAll(UEqZeroGlobalTestEffect_Flat::StaticClass());
+		GlobalAbilitySystem.RemoveEffectFromAll(UEqZeroGlobalTestEffect_SourceCapture::StaticClass());
+		for (AEqZeroGlobalAbilityTestActor* Target : Targets)
+		{
+			Target->Destroy();
+		}
+
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroGlobalAbilitySystemEquivalenceTest, "EqZero.AbilitySystem.GlobalAbilitySystem.SharedSpecEquivalence", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroGlobalAbilitySystemEquivalenceTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroGlobalAbilitySystemTests;
+
+	FEqZeroScopedTestWorld TestWorld;
+	UEqZeroGlobalAbilitySystem* GlobalAbilitySystem = TestWorld->GetSubsystem<UEqZeroGlobalAbilitySystem>();
+	if (!TestNotNull(TEXT("Global ability system"), GlobalAbilitySystem))
+	{
+		return false;
+	}
+
+	// 原来的做法：每个目标一份 Spec，同一帧全部应用
+	const FScenarioResult Reference = RunScenario(TestWorld.Get(), *GlobalAbilitySystem, /*bShareEffectSpecs=*/ false, /*bTimeSliced=*/ false);
+	TestTrue(TEXT("Per-target synchronous: final state"), Reference.States == Reference.ExpectedStates);
+
+	const FScenarioResult PerTarget = RunScenario(TestWorld.Get(), *GlobalAbilitySystem, /*bShareEffectSpecs=*/ false, /*bTimeSliced=*/ true);
+	TestTrue(TEXT("Per-target time-sliced: final state matches the synchronous path"), PerTarget.States == Reference.States);
+	TestFalse(TEXT("Per-target time-sliced: flat effect does not share its spec"), PerTarget.bFlatUsesSharedSpec);
+
+	const FScenarioResult Shared = RunScenario(TestWorld.Get(), *GlobalAbilitySystem, /*bShareEffectSpecs=*/ true, /*bTimeSliced=*/ true);
+	TestTrue(TEXT("Shared time-sliced: final state matches the synchronous path"), Shared.States == Reference.States);
+	TestTrue(TEXT("Shared time-sliced: flat effect shares its spec"), Shared.bFlatUsesSharedSpec);
+	TestFalse(TEXT("Shared time-sliced: source capture effect keeps a per-target context"), Shared.bSourceCaptureUsesSharedSpec);
+
+	TestTrue(TEXT("Time-sliced application spreads over several frames"), Shared.NumFrames > Reference.NumFrames);
+
+	AddInfo(FString::Printf(TEXT("%d + %d targets, synchronous: %d frames, worst %.3f ms"), NumTargets, NumLateTargets, Reference.NumFrames, Reference.WorstFrameSeconds * 1000.0));
+	AddInfo(FString::Printf(TEXT("Per-target time-sliced: %d frames, worst %.3f ms"), PerTarget.NumFrames, PerTarget.WorstFrameSeconds * 1000.0));
+	AddInfo(FString::Printf(TEXT("Shared time-sliced: %d frames, worst %.3f ms"), Shared.NumFrames, Shared.WorstFrameSeconds * 1000.0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroGlobalAbilitySystemSharedSpecExclusionTest, "EqZero.AbilitySystem.GlobalAbilitySystem.SharedSpecExclusions", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroGlobalAbilitySystemSharedSpecExclusionTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroGlobalAbilitySystemTests;
+
+	IConsoleVariable* ShareEffectSpecsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("EqZero.GlobalAbilitySystem.ShareEffectSpecs"));
+	if (!TestNotNull(TEXT("ShareEffectSpecs console variable"), ShareEffectSpecsCVar))
+	{
+		return false;
+	}
+	if ((ShareEffectSpecsCVar->GetFlags() & ECVF_SetByMask) <= ECVF_SetByConstructor)
+	{
+		TestFalse(TEXT("Sharing effect specs is off by default"), ShareEffectSpecsCVar->GetBool());
+	}
+
+	const FScopedConsoleVariable ShareEffectSpecs(TEXT("EqZero.GlobalAbilitySystem.ShareEffectSpecs"), TEXT("1"));
+
+	FEqZeroScopedTestWorld TestWorld;
+	UEqZeroGlobalAbilitySystem* GlobalAbilitySystem = TestWorld->GetSubsystem<UEqZeroGlobalAbilitySystem>();
+	if (!TestNotNull(TEXT("Global ability system"), GlobalAbilitySystem))
+	{
+		return false;
+	}
+
+	AEqZeroGlobalAbilityTestActor* Target = TestWorld->SpawnActor<AEqZeroGlobalAbilityTestActor>();
+	GlobalAbilitySystem->RegisterASC(Target->GetEqZeroAbilitySystemComponent());
+
+	// 这里不设置 SetByCaller 的值，GAS 会报错，只关心 Spec 有没有共用
+	AddExpectedError(TEXT("GlobalTestHeal"), EAutomationExpectedErrorFlags::Contains, 0, /*IsRegex=*/ false);
+
+	// 调用之后在同一帧里要用到结果，先处理完队列
+	GlobalAbilitySystem->ApplyEffectToAll(UEqZeroGlobalTestEffect_Flat::StaticClass());
+	GlobalAbilitySystem->ApplyEffectToAll(UEqZeroGlobalTestEffect_SetByCaller::StaticClass());
+	GlobalAbilitySystem->FlushPendingApplications();
+
+	TestEqual(TEXT("Flush applies everything"), GlobalAbilitySystem->GetNumPendingApplications(), 0);
+	TestTrue(TEXT("Flat effect shares its spec"), FEqZeroGlobalAbilitySystemTestAccess::UsesSharedSpec(*GlobalAbilitySystem, UEqZeroGlobalTestEffect_Flat::StaticClass()));
+	TestFalse(TEXT("SetByCaller effect keeps a per-target spec"), FEqZeroGlobalAbilitySystemTestAccess::UsesSharedSpec(*GlobalAbilitySystem, UEqZeroGlobalTestEffect_SetByCaller::StaticClass()));
+
+	GlobalAbilitySystem->RemoveEffectFromAll(UEqZeroGlobalTestEffect_Flat::StaticClass());
+	GlobalAbilitySystem->RemoveEffectFromAll(UEqZeroGlobalTestEffect_SetByCaller::StaticClass());
+	GlobalAbilitySystem->UnregisterASC(Target->GetEqZeroAbilitySystemComponent());
+	Target->Destroy();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
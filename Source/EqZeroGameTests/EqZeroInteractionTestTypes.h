@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "Interaction/IInteractableTarget.h"
+
+#include "EqZeroInteractionTestTypes.generated.h"
+
+class USphereComponent;
+
+/**
+ * AEqZeroInteractableTestActor
+ *
+ *	自动化测试用的可交互物，根组件是一个只和 Interaction 通道重叠的球，不手动注册，靠注册表的生成回调
+ */
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown, Transient)
+class AEqZeroInteractableTestActor : public AActor, public IInteractableTarget
+{
+	GENERATED_BODY()
+
+public:
+	AEqZeroInteractableTestActor();
+
+	//~IInteractableTarget interface
+	virtual void GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& OptionBuilder) override {}
+	//~End of IInteractableTarget interface
+
+	USphereComponent* GetSphere() const { return Sphere; }
+
+private:
+	UPROPERTY()
+	TObjectPtr<USphereComponent> Sphere;
+};
@@ -0,0 +1,208 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EqZeroInteractionTestTypes.h"
+
+#include "Components/SphereComponent.h"
+#include "Physics/EqZeroCollisionChannels.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EqZeroInteractionTestTypes)
+
+AEqZeroInteractableTestActor::AEqZeroInteractableTestActor()
+{
+	Sphere = CreateDefaultSubobject<USphereComponent>(TEXT("Sphere"));
+	Sphere->InitSphereRadius(50.0f);
+	Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	Sphere->SetCollisionResponseToAllChannels(ECR_Ignore);
+	Sphere->SetCollisionResponseToChannel(EqZero_TraceChannel_Interaction, ECR_Overlap);
+	RootComponent = Sphere;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CollisionQueryParams.h"
+#include "EqZeroTestWorld.h"
+#include "Engine/OverlapResult.h"
+#include "Interaction/EqZeroInteractableRegistry.h"
+#include "Interaction/InteractionStatics.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+namespace EqZeroInteractionTests
+{
+	static bool ContainsTarget(const TArray<TScriptInterface<IInteractableTarget>>& Targets, const UObject* Object)
+	{
+		return Targets.ContainsByPredicate([Object](const TScriptInterface<IInteractableTarget>& Target)
+		{
+			return Target.GetObject() == Object;
+		});
+	}
+
+	static bool QueryFinds(const UEqZeroInteractableRegistry* Registry, const FVector& Origin, float Radius, const UObject* Object,
+		const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam)
+	{
+		TArray<TScriptInterface<IInteractableTarget>> Targets;
+		Registry->QueryInteractables(Origin, Radius, EqZero_TraceChannel_Interaction, Params, Targets);
+		return ContainsTarget(Targets, Object);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroInteractableRegistryTest, "EqZero.Interaction.Registry.TracksMovementAndCollision", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEqZeroInteractableRegistryTest::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroInteractionTests;
+
+	FEqZeroScopedTestWorld TestWorld;
+	UEqZeroInteractableRegistry* Registry = TestWorld->GetSubsystem<UEqZeroInteractableRegistry>();
+	if (!TestNotNull(TEXT("Registry"), Registry))
+	{
+		return false;
+	}
+
+	const float ScanRadius = 100.0f;
+	const FVector StartLocation(0.0f, 0.0f, 0.0f);
+	const FVector FarLocation(5000.0f, 5000.0f, 0.0f);
+
+	AEqZeroInteractableTestActor* Interactable = TestWorld->SpawnActor<AEqZeroInteractableTestActor>(FTransform(StartLocation));
+	TestEqual(TEXT("Registered on spawn without registering itself"), Registry->GetNumRegisteredInteractables(), 1);
+	TestTrue(TEXT("Found at spawn location"), QueryFinds(Registry, StartLocation, ScanRadius, Interactable));
+
+	// 直接移动
+	Interactable->SetActorLocation(FarLocation);
+	TestFalse(TEXT("Not found at old location after move"), QueryFinds(Registry, StartLocation, ScanRadius, Interactable));
+	TestTrue(TEXT("Found at new location after move"), QueryFinds(Registry, FarLocation, ScanRadius, Interactable));
+
+	// 附加到别的 Actor 上，跟着父节点移动
+	AActor* Parent = TestWorld->SpawnActor<AEqZeroInteractableTestActor>(FTransform(FarLocation));
+	Interactable->AttachToActor(Parent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	Parent->SetActorLocation(StartLocation);
+	TestTrue(TEXT("Found after attached parent moved"), QueryFinds(Registry, StartLocation, ScanRadius, Interactable));
+	TestFalse(TEXT("Not found at old location after attached parent moved"), QueryFinds(Registry, FarLocation, ScanRadius, Interactable));
+	Interactable->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Parent->Destroy();
+
+	// 关闭碰撞或者忽略 Interaction 通道后，和重叠检测一样不再返回
+	Interactable->SetActorEnableCollision(false);
+	TestFalse(TEXT("Actor collision disabled is filtered"), QueryFinds(Registry, StartLocation, ScanRadius, Interactable));
+	Interactable->SetActorEnableCollision(true);
+	TestTrue(TEXT("Actor collision re-enabled is found"), QueryFinds(Registry, StartLocation, ScanRadius, Interactable));
+
+	Interactable->GetSphere()->SetCollisionResponseToChannel(EqZero_TraceChannel_Interaction, ECR_Ignore);
+	TestFalse(TEXT("Ignoring the interaction channel is filtered"), QueryFinds(Registry, StartLocation, ScanRadius, Interactable));
+	Interactable->GetSphere()->SetCollisionResponseToChannel(EqZero_TraceChannel_Interaction, ECR_Overlap);
+
+	// 查询参数和重叠检测一样生效
+	TArray<TScriptInterface<IInteractableTarget>> VisibilityTargets;
+	Registry->QueryInteractables(StartLocation, ScanRadius, ECC_Visibility, FCollisionQueryParams::DefaultQueryParam, VisibilityTargets);
+	TestFalse(TEXT("Other channel is filtered"), ContainsTarget(VisibilityTargets, Interactable));
+
+	FCollisionQueryParams IgnoreSphereParams;
+	IgnoreSphereParams.AddIgnoredComponent(Interactable->GetSphere());
+	TestFalse(TEXT("Ignored component is filtered"), QueryFinds(Registry, StartLocation, ScanRadius, Interactable, IgnoreSphereParams));
+
+	FCollisionQueryParams StaticOnlyParams;
+	StaticOnlyParams.MobilityType = EQueryMobilityType::Static;
+	TestFalse(TEXT("Static-only query skips movable components"), QueryFinds(Registry, StartLocation, ScanRadius, Interactable, StaticOnlyParams));
+
+	Interactable->GetSphere()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	TestFalse(TEXT("Component collision disabled is filtered"), QueryFinds(Registry, StartLocation, ScanRadius, Interactable));
+
+	Interactable->Destroy();
+	TestEqual(TEXT("Unregistered on destroy"), Registry->GetNumRegisteredInteractables(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroInteractableRegistryBenchmark, "EqZero.Interaction.Registry.Benchmark", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FEqZeroInteractableRegistryBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace EqZeroInteractionTests;
+
+	const int32 NumInteractables = 5000;
+	const int32 NumPawns = 100;
+	const int32 NumScans = 10;
+	const float ScanRadius = 500.0f;
+	const float WorldHalfSize = 20000.0f;
+
+	FEqZeroScopedTestWorld TestWorld;
+	UEqZeroInteractableRegistry* Registry = TestWorld->GetSubsystem<UEqZeroInteractableRegistry>();
+	if (!TestNotNull(TEXT("Registry"), Registry))
+	{
+		return false;
+	}
+
+	FRandomStream Random(1234);
+	auto RandomLocation = [&Random, WorldHalfSize]()
+	{
+		return FVector(Random.FRandRange(-WorldHalfSize, WorldHalfSize), Random.FRandRange(-WorldHalfSize, WorldHalfSize), 0.0f);
+	};
+
+	for (int32 Index = 0; Index < NumInteractables; ++Index)
+	{
+		TestWorld->SpawnActor<AEqZeroInteractableTestActor>(FTransform(RandomLocation()));
+	}
+	TestEqual(TEXT("All interactables registered"), Registry->GetNumRegisteredInteractables(), NumInteractables);
+
+	TArray<FVector> PawnLocations;
+	for (int32 Index = 0; Index < NumPawns; ++Index)
+	{
+		PawnLocations.Add(RandomLocation());
+	}
+
+	// 原来的做法：每个 Pawn 每次扫描做一次球形重叠检测
+	int32 NumOverlapTargets = 0;
+	TArray<TArray<TScriptInterface<IInteractableTarget>>> OverlapTargetsPerPawn;
+	OverlapTargetsPerPawn.SetNum(NumPawns);
+	const double OverlapStartTime = FPlatformTime::Seconds();
+	for (int32 Scan = 0; Scan < NumScans; ++Scan)
+	{
+		for (int32 PawnIndex = 0; PawnIndex < NumPawns; ++PawnIndex)
+		{
+			TArray<FOverlapResult> OverlapResults;
+			TestWorld->OverlapMultiByChannel(OverlapResults, PawnLocations[PawnIndex], FQuat::Identity, EqZero_TraceChannel_Interaction, FCollisionShape::MakeSphere(ScanRadius));
+
+			TArray<TScriptInterface<IInteractableTarget>>& Targets = OverlapTargetsPerPawn[PawnIndex];
+			Targets.Reset();
+			UInteractionStatics::AppendInteractableTargetsFromOverlapResults(OverlapResults, Targets);
+			NumOverlapTargets += Targets.Num();
+		}
+	}
+	const double OverlapSeconds = FPlatformTime::Seconds() - OverlapStartTime;
+
+	// 注册表：每次只取差量，Pawn 不动时第一次之后都是空的
+	int32 NumRegistryTargets = 0;
+	TArray<TSet<FObjectKey>> TargetsInRangePerPawn;
+	TargetsInRangePerPawn.SetNum(NumPawns);
+	const double RegistryStartTime = FPlatformTime::Seconds();
+	for (int32 Scan = 0; Scan < NumScans; ++Scan)
+	{
+		for (int32 PawnIndex = 0; PawnIndex < NumPawns; ++PawnIndex)
+		{
+			TArray<TScriptInterface<IInteractableTarget>> Entered;
+			TArray<FObjectKey> Left;
+			Registry->QueryInteractableDeltas(PawnLocations[PawnIndex], ScanRadius, EqZero_TraceChannel_Interaction, FCollisionQueryParams::DefaultQueryParam, TargetsInRangePerPawn[PawnIndex], Entered, Left);
+			NumRegistryTargets += Entered.Num();
+		}
+	}
+	const double RegistrySeconds = FPlatformTime::Seconds() - RegistryStartTime;
+
+	// 注册表用包围球近似，结果应该是重叠检测的超集
+	for (int32 PawnIndex = 0; PawnIndex < NumPawns; ++PawnIndex)
+	{
+		for (const TScriptInterface<IInteractableTarget>& Target : OverlapTargetsPerPawn[PawnIndex])
+		{
+			if (!TargetsInRangePerPawn[PawnIndex].Contains(FObjectKey(Target.GetObject())))
+			{
+				AddError(FString::Printf(TEXT("Registry missed %s for pawn %d"), *GetNameSafe(Target.GetObject()), PawnIndex));
+			}
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("%d pawns x %d interactables x %d scans: overlap %.3f ms (%d targets), registry %.3f ms (%d entered)"),
+		NumPawns, NumInteractables, NumScans, OverlapSeconds * 1000.0, NumOverlapTargets, RegistrySeconds * 1000.0, NumRegistryTargets));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Development/EqZeroScriptBenchmarkCommandlet.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEqZeroScriptBenchmark, "EqZero.Script.Benchmark", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FEqZeroScriptBenchmark::RunTest(const FString& Parameters)
+{
+	// 和命令行 -run=EqZeroScriptBenchmark 跑同一套用例，迭代次数少一些，结果同样写到 Saved/Profiling/ScriptBenchmark
+	const int32 Iterations = 20000;
+	const double TimeoutSeconds = 120.0;
+
+	FString Results;
+	if (!TestTrue(TEXT("Script benchmark finished"), UEqZeroScriptBenchmarkCommandlet::RunBenchmarks(Iterations, TimeoutSeconds, Results)))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Report;
+	if (!TestTrue(TEXT("Results are valid JSON"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Results), Report) && Report.IsValid()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Reported iterations"), static_cast<int32>(Report->GetNumberField(TEXT("iterations"))), Iterations);
+
+	const TArray<TSharedPtr<FJsonValue>>* ResultValues = nullptr;
+	if (!TestTrue(TEXT("Report has results"), Report->TryGetArrayField(TEXT("results"), ResultValues) && ResultValues->Num() > 0))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& ResultValue : *ResultValues)
+	{
+		const TSharedPtr<FJsonObject> Result = ResultValue->AsObject();
+		const FString Name = Result->GetStringField(TEXT("name"));
+		const double NsPerOp = Result->GetNumberField(TEXT("nsPerOp"));
+		TestFalse(TEXT("Case has a name"), Name.IsEmpty());
+		TestTrue(FString::Printf(TEXT("%s measured a positive time"), *Name), NsPerOp > 0.0);
+		AddInfo(FString::Printf(TEXT("%s: %.1f ns/op"), *Name, NsPerOp));
+	}
+
+	const FString OutputPath = UEqZeroScriptBenchmarkCommandlet::GetDefaultOutputPath();
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPath), true);
+	TestTrue(TEXT("Results written"), FFileHelper::SaveStringToFile(Results, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM));
+	AddInfo(FString::Printf(TEXT("Wrote script benchmark results to %s"), *OutputPath));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+/**
+ * FEqZeroScopedTestWorld
+ *
+ *	自动化测试用的临时世界，构造时创建并开始游戏，析构时销毁
+ */
+struct FEqZeroScopedTestWorld
+{
+	explicit FEqZeroScopedTestWorld(EWorldType::Type WorldType = EWorldType::Game, bool bWithGameInstance = false)
+	{
+		if (bWithGameInstance)
+		{
+			// GameInstance 子系统（如 GameplayMessageSubsystem）要求世界有 GameInstance，由它创建 Game 世界
+			GameInstance = NewObject<UGameInstance>(GEngine);
+			GameInstance->AddToRoot();
+			GameInstance->InitializeStandalone(TEXT("EqZeroTestWorld"));
+			World = GameInstance->GetWorld();
+		}
+		else
+		{
+			World = UWorld::CreateWorld(WorldType, /*bInformEngineOfWorld=*/ false, TEXT("EqZeroTestWorld"));
+
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(WorldType);
+			WorldContext.SetCurrentWorld(World);
+		}
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	~FEqZeroScopedTestWorld()
+	{
+		if (GameInstance)
+		{
+			GameInstance->Shutdown();
+		}
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(/*bInformEngineOfWorld=*/ false);
+
+		if (GameInstance)
+		{
+			GameInstance->RemoveFromRoot();
+		}
+	}
+
+	FEqZeroScopedTestWorld(const FEqZeroScopedTestWorld&) = delete;
+	FEqZeroScopedTestWorld& operator=(const FEqZeroScopedTestWorld&) = delete;
+
+	UWorld* Get() const { return World; }
+	UWorld* operator->() const { return World; }
+
+	void Tick(float DeltaSeconds = 1.0f / 60.0f)
+	{
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+
+private:
+	UWorld* World = nullptr;
+	UGameInstance* GameInstance = nullptr;
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
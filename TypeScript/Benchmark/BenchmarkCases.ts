@@ -0,0 +1,163 @@
+import * as UE from 'ue';
+import { blueprint } from 'puerts';
+import { BenchmarkCase } from './BenchmarkRunner';
+
+// =========================================================
+// 脚本基准测试用例
+// 覆盖 UObject 方法调用、属性读写、结构体创建、容器遍历、委托绑定、Mixin 调用、计时器
+// 被测对象是 C++ 的 UEqZeroScriptBenchmarkTarget
+// =========================================================
+
+// 避免结果没被使用导致被优化掉
+let sink = 0;
+
+export function getSink(): number {
+    return sink;
+}
+
+export function createBenchmarkCases(target: UE.EqZeroScriptBenchmarkTarget): BenchmarkCase[] {
+    return [
+        {
+            name: 'UObject.CallInt',
+            run(iterations) {
+                for (let i = 0; i < iterations; ++i) {
+                    sink += target.Add(i, 1);
+                }
+            },
+        },
+        {
+            name: 'UObject.CallStruct',
+            scale: 0.5,
+            run(iterations) {
+                const value = new UE.Vector(1, 2, 3);
+                for (let i = 0; i < iterations; ++i) {
+                    sink += target.ScaleVector(value, 2).X;
+                }
+            },
+        },
+        {
+            name: 'Property.ReadInt',
+            run(iterations) {
+                for (let i = 0; i < iterations; ++i) {
+                    sink += target.IntValue;
+                }
+            },
+        },
+        {
+            name: 'Property.WriteInt',
+            run(iterations) {
+                for (let i = 0; i < iterations; ++i) {
+                    target.IntValue = i;
+                }
+            },
+        },
+        {
+            name: 'Property.ReadVector',
+            run(iterations) {
+                for (let i = 0; i < iterations; ++i) {
+                    sink += target.VectorValue.X;
+                }
+            },
+        },
+        {
+            name: 'Property.WriteVector',
+            scale: 0.5,
+            run(iterations) {
+                const value = new UE.Vector(1, 2, 3);
+                for (let i = 0; i < iterations; ++i) {
+                    value.X = i;
+                    target.VectorValue = value;
+                }
+            },
+        },
+        {
+            name: 'Struct.Create',
+            scale: 0.5,
+            run(iterations) {
+                for (let i = 0; i < iterations; ++i) {
+                    sink += new UE.Vector(i, 0, 0).X;
+                }
+            },
+        },
+        {
+            name: 'Container.ArrayIterate',
+            scale: 0.01,
+            run(iterations) {
+                const array = target.IntArray;
+                for (let i = 0; i < iterations; ++i) {
+                    const num = array.Num();
+                    for (let j = 0; j < num; ++j) {
+                        sink += array.Get(j);
+                    }
+                }
+            },
+        },
+        {
+            name: 'Container.MapIterate',
+            scale: 0.01,
+            run(iterations) {
+                const map = target.NameMap;
+                for (let i = 0; i < iterations; ++i) {
+                    const num = map.Num();
+                    for (let j = 0; j < num; ++j) {
+                        sink += map.Get(map.GetKey(j));
+                    }
+                }
+            },
+        },
+        {
+            name: 'Delegate.AddRemove',
+            scale: 0.1,
+            run(iterations) {
+                const callback = (value: number) => { sink += value; };
+                for (let i = 0; i < iterations; ++i) {
+                    target.OnBenchmarkEvent.Add(callback);
+                    target.OnBenchmarkEvent.Remove(callback);
+                }
+            },
+        },
+        {
+            name: 'Delegate.Broadcast',
+            run(iterations) {
+                const callback = (value: number) => { sink += value; };
+                target.OnBenchmarkEvent.Add(callback);
+                target.BroadcastEvent(iterations);
+                target.OnBenchmarkEvent.Remove(callback);
+            },
+        },
+        {
+            name: 'Mixin.CallFromNative',
+            run(iterations) {
+                sink += target.CallMixinTarget(iterations);
+            },
+        },
+        {
+            name: 'Timer.SetTimeoutChain',
+            scale: 0.001,
+            run() {},
+            runAsync(iterations, done) {
+                let remaining = iterations;
+                const next = () => {
+                    if (--remaining <= 0) {
+                        done();
+                        return;
+                    }
+                    setTimeout(next, 0);
+                };
+                setTimeout(next, 0);
+            },
+        },
+    ];
+}
+
+/** Mixin 用例需要先把 MixinTarget 换成 TypeScript 实现 */
+export function applyBenchmarkMixin(): void {
+    interface BenchmarkTargetMixin extends UE.EqZeroScriptBenchmarkTarget {}
+    class BenchmarkTargetMixin {
+        MixinTarget(Value: number): number {
+            return Value + 1;
+        }
+    }
+
+    blueprint.mixin(UE.EqZeroScriptBenchmarkTarget, BenchmarkTargetMixin);
+}
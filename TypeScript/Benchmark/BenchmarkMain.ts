@@ -0,0 +1,29 @@
+import * as UE from 'ue';
+import { argv } from 'puerts';
+import { BenchmarkRunner } from './BenchmarkRunner';
+import { applyBenchmarkMixin, createBenchmarkCases, getSink } from './BenchmarkCases';
+
+// =========================================================
+// 脚本基准测试入口
+// 由 UEqZeroScriptBenchmarkCommandlet 或自动化测试 EqZero.Script.Benchmark 启动: Start("Benchmark/BenchmarkMain", { Target })
+// 跑完后把 JSON 结果通过 Target.ReportResults 交回 C++ 写文件
+// =========================================================
+(function runScriptBenchmarks() {
+    const target = argv.getByName('Target') as UE.EqZeroScriptBenchmarkTarget;
+    if (!target) {
+        console.error('[Benchmark] Missing Target argument');
+        return;
+    }
+
+    applyBenchmarkMixin();
+
+    const runner = new BenchmarkRunner(target.Iterations);
+    runner.runAll(createBenchmarkCases(target), (results) => {
+        const report = {
+            iterations: target.Iterations,
+            sink: getSink(),
+            results,
+        };
+        target.ReportResults(JSON.stringify(report, null, 2));
+    });
+})();
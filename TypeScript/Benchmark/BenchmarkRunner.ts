@@ -0,0 +1,88 @@
+import * as UE from 'ue';
+
+// =========================================================
+// 脚本基准测试的计时工具
+// 每个用例先预热再计时，结果按 ns/op 输出，方便不同版本之间对比
+// =========================================================
+
+export interface BenchmarkResult {
+    name: string;
+    iterations: number;
+    totalMs: number;
+    nsPerOp: number;
+}
+
+export interface BenchmarkCase {
+    name: string;
+    /** 执行 iterations 次被测操作 */
+    run(iterations: number): void;
+    /** 异步用例（例如计时器），完成时调用 done */
+    runAsync?(iterations: number, done: () => void): void;
+    /** 迭代次数相对默认值的比例，开销大的用例可以调小 */
+    scale?: number;
+}
+
+// Date.now() 只有毫秒精度，用 C++ 的 FPlatformTime::Seconds 计时
+function now(): number {
+    return UE.EqZeroScriptBenchmarkTarget.GetPlatformSeconds() * 1000;
+}
+
+function makeResult(name: string, iterations: number, totalMs: number): BenchmarkResult {
+    return {
+        name,
+        iterations,
+        totalMs,
+        nsPerOp: iterations > 0 ? (totalMs * 1e6) / iterations : 0,
+    };
+}
+
+export class BenchmarkRunner {
+    private readonly results: BenchmarkResult[] = [];
+
+    constructor(private readonly iterations: number) {}
+
+    private iterationsFor(benchmark: BenchmarkCase): number {
+        return Math.max(1, Math.floor(this.iterations * (benchmark.scale ?? 1)));
+    }
+
+    /** 依次执行所有用例，全部完成后回调结果 */
+    runAll(cases: BenchmarkCase[], onComplete: (results: BenchmarkResult[]) => void): void {
+        const runNext = (index: number) => {
+            if (index >= cases.length) {
+                onComplete(this.results);
+                return;
+            }
+
+            const benchmark = cases[index];
+            const iterations = this.iterationsFor(benchmark);
+
+            try {
+                if (benchmark.runAsync) {
+                    const start = now();
+                    benchmark.runAsync(iterations, () => {
+                        this.record(makeResult(benchmark.name, iterations, now() - start));
+                        runNext(index + 1);
+                    });
+                    return;
+                }
+
+                // 预热，让 JIT 和各种缓存先稳定下来
+                benchmark.run(Math.max(1, Math.floor(iterations / 10)));
+
+                const start = now();
+                benchmark.run(iterations);
+                this.record(makeResult(benchmark.name, iterations, now() - start));
+            } catch (e) {
+                console.error(`[Benchmark] ${benchmark.name} failed: ${e}`);
+            }
+            runNext(index + 1);
+        };
+
+        runNext(0);
+    }
+
+    private record(result: BenchmarkResult): void {
+        this.results.push(result);
+        console.log(`[Benchmark] ${result.name}: ${result.nsPerOp.toFixed(1)} ns/op (${result.iterations} iterations, ${result.totalMs.toFixed(3)} ms)`);
+    }
+}